@@ -0,0 +1,140 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <tinyutf8/shared_string.h>
+
+#include "helpers/helpers_corpora.h"
+
+using namespace Helpers_Corpora;
+
+static void BM_Construct_FromUTF8_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		tiny_utf8::string str(data.utf8);
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_Construct_FromUTF8_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_Construct_FromUTF8Parallel_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus((Corpus)state.range(0), 16 << 20);
+	for (auto _ : state)
+	{
+		tiny_utf8::string str = tiny_utf8::string::from_bytes_parallel(data.utf8.data(), data.utf8.size(), (unsigned int)state.range(1));
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_Construct_FromUTF8Parallel_TinyUTF8)
+	->ArgNames({ "corpus", "threads" })
+	->ArgsProduct({ { ASCII, MULTIBYTE_5, MULTIBYTE_60 }, { 1, 2, 4, 8 } }) // 16MiB each
+	->UseRealTime();
+
+static void BM_Construct_StreamDecoder_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	const std::size_t chunk_size = 4093; // Splits codepoints now and then
+	for (auto _ : state)
+	{
+		tiny_utf8::string str;
+		tiny_utf8::stream_decoder decoder(str);
+		for (std::size_t i = 0; i < data.utf8.size(); i += chunk_size)
+			decoder.feed(data.utf8.data() + i, std::min(chunk_size, data.utf8.size() - i));
+		decoder.finish();
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_Construct_StreamDecoder_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_Construct_FromUTF32_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		tiny_utf8::string str(data.utf32.data(), data.utf32.size());
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_Construct_FromUTF32_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_Construct_Copy_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		tiny_utf8::string str(data.tinyutf8);
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_Construct_Copy_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_Construct_Copy_Shared_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	tiny_utf8::shared_string shared(data.tinyutf8);
+	for (auto _ : state)
+	{
+		tiny_utf8::shared_string str(shared);
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_Construct_Copy_Shared_TinyUTF8)->Apply(apply_corpora);
+
+// Names and URLs of 32-60 bytes only fit into the inline buffer of a basic_string with a larger sso capacity
+static const char* medium_string = "https://example.org/stra\xC3\x9F" "e/\xE3\x83\x84/\xE2\x99\xAB?query=\xC3\xA4\xC3\xB6\xC3\xBC&id=42";
+
+static void BM_Construct_Medium_TinyUTF8(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		tiny_utf8::string str(medium_string);
+		benchmark::DoNotOptimize(str.data());
+	}
+}
+BENCHMARK(BM_Construct_Medium_TinyUTF8);
+
+static void BM_Construct_Medium_SSO64_TinyUTF8(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		tiny_utf8::basic_string<char32_t, char, std::allocator<char>, 64> str(medium_string);
+		benchmark::DoNotOptimize(str.data());
+	}
+}
+BENCHMARK(BM_Construct_Medium_SSO64_TinyUTF8);
+
+static void BM_Construct_Copy_StdString(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		std::string str(data.utf8);
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_Construct_Copy_StdString)->Apply(apply_corpora);
+
+static void BM_Construct_Copy_StdU32String(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		std::u32string str(data.utf32);
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_Construct_Copy_StdU32String)->Apply(apply_corpora);
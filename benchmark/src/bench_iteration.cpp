@@ -0,0 +1,199 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+#include <tinyutf8/tinyutf8.h>
+#include <tinyutf8/mapped_string.h>
+
+#include "helpers/helpers_corpora.h"
+
+using namespace Helpers_Corpora;
+
+static void BM_Iterate_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		char32_t sum = 0;
+		for (char32_t cp : data.tinyutf8)
+			sum += cp;
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * data.utf32.size());
+}
+BENCHMARK(BM_Iterate_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_Iterate_Raw_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		char32_t sum = 0;
+		for (auto iter = data.tinyutf8.raw_cbegin(), end = data.tinyutf8.raw_cend(); iter != end; ++iter)
+			sum += *iter;
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * data.utf32.size());
+}
+BENCHMARK(BM_Iterate_Raw_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_Iterate_StdString(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		char32_t sum = 0;
+		for (char c : data.utf8)
+			sum += (unsigned char)c;
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * data.utf32.size());
+}
+BENCHMARK(BM_Iterate_StdString)->Apply(apply_corpora);
+
+static void BM_Iterate_StdU32String(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		char32_t sum = 0;
+		for (char32_t cp : data.utf32)
+			sum += cp;
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * data.utf32.size());
+}
+BENCHMARK(BM_Iterate_StdU32String)->Apply(apply_corpora);
+
+static void BM_ToCodepoints_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	std::u32string result(data.utf32.size(), U'\0');
+	for (auto _ : state)
+	{
+		data.tinyutf8.to_codepoints(&result[0], result.size());
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_ToCodepoints_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_GetNumCodepoints_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(data.tinyutf8.get_num_codepoints(0, data.tinyutf8.size()));
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_GetNumCodepoints_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_GetNumBytesFromStart_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		std::size_t sum = 0;
+		for (std::size_t index : data.random_indices)
+			sum += data.tinyutf8.get_num_bytes_from_start(index);
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * data.random_indices.size());
+}
+BENCHMARK(BM_GetNumBytesFromStart_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_RandomAccess_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		char32_t sum = 0;
+		for (std::size_t index : data.random_indices)
+			sum += data.tinyutf8[index];
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * data.random_indices.size());
+}
+BENCHMARK(BM_RandomAccess_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_RandomAccess_Trusted_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	tiny_utf8::string trusted(data.utf8, tiny_utf8::validate_utf8);
+	for (auto _ : state)
+	{
+		char32_t sum = 0;
+		for (std::size_t index : data.random_indices)
+			sum += trusted[index];
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * data.random_indices.size());
+}
+BENCHMARK(BM_RandomAccess_Trusted_TinyUTF8)->Apply(apply_corpora);
+
+// Opens a file of 16MiB and accesses random codepoints, building the index on demand or loading it from a sidecar file
+static void BM_OpenAndRandomAccess_Mapped_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus((Corpus)state.range(0), 16 << 20);
+	const char* path = "tinyutf8_bench_mapped.txt";
+	const char* index_path = "tinyutf8_bench_mapped.txt.idx";
+	std::FILE* file = std::fopen(path, "wb");
+	std::fwrite(data.utf8.data(), 1, data.utf8.size(), file);
+	std::fclose(file);
+	tiny_utf8::mapped_string(path).save_index(index_path);
+
+	for (auto _ : state)
+	{
+		tiny_utf8::mapped_string str(path);
+		if (state.range(1))
+			str.load_index(index_path);
+		char32_t sum = 0;
+		for (std::size_t index : data.random_indices)
+			sum += str[index];
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * data.random_indices.size());
+	std::remove(path);
+	std::remove(index_path);
+}
+BENCHMARK(BM_OpenAndRandomAccess_Mapped_TinyUTF8)
+	->ArgNames({ "corpus", "sidecar" })
+	->ArgsProduct({ { ASCII, MULTIBYTE_5, MULTIBYTE_60 }, { 0, 1 } });
+
+static void BM_IsValidUTF8_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(tiny_utf8::is_valid_utf8(data.utf8.data(), data.utf8.size()));
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_IsValidUTF8_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_RandomAccess_StdString(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		char32_t sum = 0;
+		for (std::size_t index : data.random_raw_indices)
+			sum += (unsigned char)data.utf8[index];
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * data.random_raw_indices.size());
+}
+BENCHMARK(BM_RandomAccess_StdString)->Apply(apply_corpora);
+
+static void BM_RandomAccess_StdU32String(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		char32_t sum = 0;
+		for (std::size_t index : data.random_indices)
+			sum += data.utf32[index];
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * data.random_indices.size());
+}
+BENCHMARK(BM_RandomAccess_StdU32String)->Apply(apply_corpora);
@@ -0,0 +1,156 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <tinyutf8/tinyutf8.h>
+#include <tinyutf8/rope.h>
+
+#include "helpers/helpers_corpora.h"
+
+using namespace Helpers_Corpora;
+
+static void BM_PushBack_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		tiny_utf8::string str;
+		for (char32_t cp : data.utf32)
+			str.push_back(cp);
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetItemsProcessed(state.iterations() * data.utf32.size());
+}
+BENCHMARK(BM_PushBack_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_PushBack_StdString(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		std::string str;
+		for (char c : data.utf8)
+			str.push_back(c);
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetItemsProcessed(state.iterations() * data.utf32.size());
+}
+BENCHMARK(BM_PushBack_StdString)->Apply(apply_corpora);
+
+static void BM_PushBack_StdU32String(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		std::u32string str;
+		for (char32_t cp : data.utf32)
+			str.push_back(cp);
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetItemsProcessed(state.iterations() * data.utf32.size());
+}
+BENCHMARK(BM_PushBack_StdU32String)->Apply(apply_corpora);
+
+static void BM_Append_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		tiny_utf8::string str;
+		for (int i = 0; i < 4; i++)
+			str.append(data.tinyutf8);
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size() * 4);
+}
+BENCHMARK(BM_Append_TinyUTF8)->Apply(apply_corpora);
+
+// Concatenating with operator+ (growing an rvalue intermediate) versus concat (a single allocation and merged luts)
+static void BM_Concat_Plus_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	tiny_utf8::string separator(U", ツ, ");
+	for (auto _ : state)
+	{
+		tiny_utf8::string str = data.tinyutf8 + separator + data.tinyutf8 + separator + data.tinyutf8;
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size() * 3);
+}
+BENCHMARK(BM_Concat_Plus_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_Concat_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	tiny_utf8::string separator(U", ツ, ");
+	for (auto _ : state)
+	{
+		tiny_utf8::string str = tiny_utf8::concat(data.tinyutf8, separator, data.tinyutf8, separator, data.tinyutf8);
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size() * 3);
+}
+BENCHMARK(BM_Concat_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_Append_StdString(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		std::string str;
+		for (int i = 0; i < 4; i++)
+			str.append(data.utf8);
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size() * 4);
+}
+BENCHMARK(BM_Append_StdString)->Apply(apply_corpora);
+
+static void BM_Append_StdU32String(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		std::u32string str;
+		for (int i = 0; i < 4; i++)
+			str.append(data.utf32);
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size() * 4);
+}
+BENCHMARK(BM_Append_StdU32String)->Apply(apply_corpora);
+
+// Typing and deleting single codepoints at random positions of a document of 1MiB ("keystrokes")
+static void BM_Keystrokes_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus((Corpus)state.range(0), 1 << 20);
+	tiny_utf8::string str(data.tinyutf8);
+	for (auto _ : state)
+	{
+		for (std::size_t index : data.random_indices)
+		{
+			str.insert(index, U'\u3042');
+			str.erase(index / 2);
+		}
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetItemsProcessed(state.iterations() * data.random_indices.size() * 2);
+}
+BENCHMARK(BM_Keystrokes_TinyUTF8)->ArgName("corpus")->Arg(ASCII)->Arg(MULTIBYTE_5)->Arg(MULTIBYTE_60);
+
+static void BM_Keystrokes_Rope_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus((Corpus)state.range(0), 1 << 20);
+	tiny_utf8::rope rope(data.tinyutf8);
+	for (auto _ : state)
+	{
+		for (std::size_t index : data.random_indices)
+		{
+			rope.insert(index, U'\u3042');
+			rope.erase(index / 2);
+		}
+		benchmark::DoNotOptimize(rope.size());
+	}
+	state.SetItemsProcessed(state.iterations() * data.random_indices.size() * 2);
+}
+BENCHMARK(BM_Keystrokes_Rope_TinyUTF8)->ArgName("corpus")->Arg(ASCII)->Arg(MULTIBYTE_5)->Arg(MULTIBYTE_60);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <tinyutf8/tinyutf8.h>
+
+#include "helpers/helpers_corpora.h"
+
+using namespace Helpers_Corpora;
+
+// Every search looks for a noncharacter, that none of the corpora contain, so it has to scan all of the data
+static const char32_t absent_codepoint = U'\U0010FFFF';
+
+static void BM_Find_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	const char32_t needle = absent_codepoint;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(data.tinyutf8.find(needle));
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_Find_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_RawFind_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	const char32_t needle = absent_codepoint;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(data.tinyutf8.raw_find(needle));
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_RawFind_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_Find_StdString(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	const std::string needle = tiny_utf8::string(1, absent_codepoint).cpp_str();
+	for (auto _ : state)
+		benchmark::DoNotOptimize(data.utf8.find(needle));
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_Find_StdString)->Apply(apply_corpora);
+
+static void BM_Find_StdU32String(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	const char32_t needle = absent_codepoint;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(data.utf32.find(needle));
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_Find_StdU32String)->Apply(apply_corpora);
+
+// Splitting the corpus at its commas, the inner loop of CSV parsing
+
+static void BM_Split_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		std::size_t num_bytes = 0;
+		for (tiny_utf8::string_view token : data.tinyutf8.split(U','))
+			num_bytes += token.size();
+		benchmark::DoNotOptimize(num_bytes);
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_Split_TinyUTF8)->Apply(apply_corpora);
+
+static void BM_Split_FindSubstr_TinyUTF8(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus(state);
+	for (auto _ : state)
+	{
+		std::size_t num_bytes = 0;
+		for (std::size_t start = 0, end; ; start = end + 1)
+		{
+			end = data.tinyutf8.find(U',', start);
+			tiny_utf8::string token = data.tinyutf8.substr(start, end == tiny_utf8::string::npos ? end : end - start);
+			num_bytes += token.size();
+			if (end == tiny_utf8::string::npos)
+				break;
+		}
+		benchmark::DoNotOptimize(num_bytes);
+	}
+	state.SetBytesProcessed(state.iterations() * data.utf8.size());
+}
+BENCHMARK(BM_Split_FindSubstr_TinyUTF8)->Apply(apply_corpora);
@@ -0,0 +1,131 @@
+#include "helpers_corpora.h"
+
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace Helpers_Corpora
+{
+
+namespace
+{
+
+// Deterministic xorshift generator, so runs are comparable across machines and standard libraries
+struct Random
+{
+	std::uint32_t state = 2463534242u;
+
+	std::uint32_t operator()(std::uint32_t bound)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state % bound;
+	}
+};
+
+const char* const corpus_names[NUM_CORPORA] = { "ascii", "multibyte_5", "multibyte_25", "multibyte_60", "emoji" };
+
+std::size_t encoded_size(char32_t cp)
+{
+	return cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+}
+
+char32_t generate_ascii(Random& random)
+{
+	// Mostly letters with some spaces and punctuation, like text
+	static const char chars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789      ,.";
+	return (char32_t)chars[random(sizeof(chars) - 1)];
+}
+
+char32_t generate_multibyte(Random& random)
+{
+	switch (random(10))
+	{
+	case 0: case 1: case 2: case 3:
+		return 0xC0 + random(0xC0);		// Latin-1 supplement and Latin Extended-A (2 bytes)
+	case 4: case 5:
+		return 0x391 + random(0x39);	// Greek (2 bytes)
+	case 6: case 7:
+		return 0x3041 + random(0xBE);	// Hiragana and Katakana (3 bytes)
+	case 8:
+		return 0x4E00 + random(0x5000);	// CJK unified ideographs (3 bytes)
+	default:
+		return 0x1F300 + random(0x350);	// Emojis (4 bytes)
+	}
+}
+
+CorpusData generate_corpus(Corpus corpus, std::size_t num_bytes)
+{
+	static const unsigned multibyte_percentage[NUM_CORPORA] = { 0, 5, 25, 60, 70 };
+
+	CorpusData data;
+	Random random;
+	std::size_t size = 0;
+
+	while (true)
+	{
+		char32_t cp;
+		if (random(100) >= multibyte_percentage[corpus])
+			cp = generate_ascii(random);
+		else if (corpus == EMOJI)
+			cp = 0x1F300 + random(0x350);
+		else
+			cp = generate_multibyte(random);
+
+		// Fill up the remaining bytes with ASCII, so that all corpora of one size have exactly the same number of bytes
+		if (size + encoded_size(cp) > num_bytes)
+		{
+			if (size == num_bytes)
+				break;
+			cp = generate_ascii(random);
+		}
+		data.utf32.push_back(cp);
+		size += encoded_size(cp);
+	}
+
+	data.tinyutf8 = tiny_utf8::string(data.utf32.data(), data.utf32.size());
+	data.utf8 = data.tinyutf8.cpp_str();
+
+	for (std::size_t i = 0; i < 256 && !data.utf32.empty(); i++)
+	{
+		data.random_indices.push_back(random((std::uint32_t)data.utf32.size()));
+		data.random_raw_indices.push_back(random((std::uint32_t)data.utf8.size()));
+	}
+
+	return data;
+}
+
+}
+
+const CorpusData& get_corpus(Corpus corpus, std::size_t num_bytes)
+{
+	static std::map<std::pair<int, std::size_t>, CorpusData> cache;
+
+	std::pair<int, std::size_t> key(corpus, num_bytes);
+	auto iter = cache.find(key);
+	if (iter == cache.end())
+		iter = cache.emplace(key, generate_corpus(corpus, num_bytes)).first;
+	return iter->second;
+}
+
+const CorpusData& get_corpus(benchmark::State& state)
+{
+	const CorpusData& data = get_corpus((Corpus)state.range(0), (std::size_t)state.range(1));
+	state.SetLabel(corpus_names[state.range(0)]);
+	return data;
+}
+
+void apply_corpora(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ArgNames({ "corpus", "bytes" });
+	for (int corpus = 0; corpus < NUM_CORPORA; corpus++)
+	{
+		benchmark->Args({ corpus, 24 });	// Fits into the SSO buffer
+		benchmark->Args({ corpus, 1024 });
+		benchmark->Args({ corpus, 65536 });
+	}
+}
+
+}
+// namespace Helpers_Corpora
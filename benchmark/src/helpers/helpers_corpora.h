@@ -0,0 +1,48 @@
+#ifndef HELPERS_CORPORA
+#define HELPERS_CORPORA
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <tinyutf8/tinyutf8.h>
+
+namespace Helpers_Corpora
+{
+
+//! The kinds of text every benchmark is run with
+enum Corpus : int
+{
+	ASCII = 0,			// Only single byte codepoints
+	MULTIBYTE_5,		// 5% of the codepoints are multibytes (mostly 2 and 3 bytes)
+	MULTIBYTE_25,		// 25% of the codepoints are multibytes
+	MULTIBYTE_60,		// 60% of the codepoints are multibytes
+	EMOJI,				// 70% of the codepoints are 4-byte emojis, the rest are ASCII
+	NUM_CORPORA
+};
+
+//! The same text in all representations that are benchmarked
+struct CorpusData
+{
+	std::string				utf8;
+	std::u32string			utf32;
+	tiny_utf8::string		tinyutf8;
+	std::vector<std::size_t>	random_indices;	// Codepoint indices into utf32/tinyutf8 to access randomly
+	std::vector<std::size_t>	random_raw_indices;	// Byte indices into utf8 to access randomly
+};
+
+//! Returns the (cached) corpus of the supplied kind with approximately 'num_bytes' bytes of UTF-8 data (generated deterministically)
+const CorpusData& get_corpus(Corpus corpus, std::size_t num_bytes);
+
+//! Returns the corpus described by state.range(0) (kind) and state.range(1) (bytes) and labels the benchmark accordingly
+const CorpusData& get_corpus(benchmark::State& state);
+
+//! Registers all kinds of corpora with sizes that fit into the SSO buffer, and ones that need heap memory
+void apply_corpora(benchmark::internal::Benchmark* benchmark);
+
+}
+// namespace Helpers_Corpora
+
+#endif // HELPERS_CORPORA
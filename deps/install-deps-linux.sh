@@ -1,4 +1,4 @@
 #!/bin/bash
 echo "Installing dependencies..."
 sudo apt update
-sudo apt -y install googletest google-mock libgtest-dev libgmock-dev doxygen graphviz
+sudo apt -y install googletest google-mock libgtest-dev libgmock-dev libbenchmark-dev doxygen graphviz
@@ -0,0 +1,686 @@
+/**
+ * Copyright (c) 2015-2021 Jakob Riedle (DuffsDevice)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR 'AS IS' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TINY_UTF8_MAPPED_STRING_H_
+#define _TINY_UTF8_MAPPED_STRING_H_
+
+// Includes
+#include "tinyutf8.h"
+#include <vector> // for std::vector
+#include <cstdio> // for std::fopen, std::fread, std::fwrite
+#if defined(_WIN32)
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h> // for CreateFileA, CreateFileMappingA, MapViewOfFile, UnmapViewOfFile
+#else
+	#include <fcntl.h> // for open
+	#include <unistd.h> // for close
+	#include <sys/mman.h> // for mmap, munmap
+	#include <sys/stat.h> // for fstat
+#endif
+
+namespace tiny_utf8
+{
+	//! Typedef of mapped_string (data type: char)
+	using mapped_string = basic_mapped_string<char32_t, char>;
+	
+	/**
+	 * Read-only UTF-8 string backed by a memory-mapped file. It offers the const interface of basic_string,
+	 * but neither copies the file nor counts its codepoints upfront: The index translating codepoint indices
+	 * into byte positions is built chunk by chunk on first use and only as far as needed.
+	 * It can be saved to a sidecar file (see 'save_index') and loaded on the next run instead of scanning the data again.
+	 *
+	 * @note	Errors opening the file are reported through 'is_open' (as with std::ifstream).
+	 *			The mapped data is not null-terminated and must not be modified by other processes while mapped.
+	 *			Since const member functions extend the index, a basic_mapped_string must not be used by multiple threads at once.
+	 */
+	template<typename ValueType, typename DataType>
+	class basic_mapped_string
+	{
+	public:
+		
+		typedef DataType														data_type;
+		typedef std::size_t														size_type;
+		typedef std::ptrdiff_t													difference_type;
+		typedef ValueType														value_type;
+		typedef std::uint_fast8_t												width_type;
+		typedef basic_string_view<ValueType, DataType>							string_view;
+		typedef tiny_utf8::const_iterator<basic_mapped_string, false>			const_iterator;
+		typedef tiny_utf8::const_reverse_iterator<basic_mapped_string, false>	const_reverse_iterator;
+		typedef tiny_utf8::const_iterator<basic_mapped_string, true>			raw_const_iterator;
+		typedef tiny_utf8::const_reverse_iterator<basic_mapped_string, true>	raw_const_reverse_iterator;
+		typedef const_iterator													iterator; // Mapped strings are read-only
+		typedef const_reverse_iterator											reverse_iterator;
+		typedef raw_const_iterator												raw_iterator;
+		typedef raw_const_reverse_iterator										raw_reverse_iterator;
+		enum : size_type{														npos = (size_type)-1 };
+		enum : size_type{														index_chunk = 4096 }; // Number of bytes per index entry
+	
+	protected: //! Attributes
+		
+		//! Provides the static helpers to walk over UTF-8 data
+		typedef basic_string<ValueType, DataType>	string_type;
+		
+		//! Layout of the start of sidecar index files, which is followed by 'num_entries' index entries
+		struct index_header
+		{
+			std::uint64_t	magic;
+			std::uint64_t	version;
+			std::uint64_t	chunk_size;
+			std::uint64_t	data_size;
+			std::uint64_t	mtime;
+			std::uint64_t	data_hash;
+			std::uint64_t	length;
+			std::uint64_t	num_entries;
+		};
+		enum : std::uint64_t{ index_magic = 0x5844493855594E54ull }; // "TNYU8IDX" (also identifies the byte order)
+		enum : std::uint64_t{ index_version = 1 };
+		enum : size_type{ index_hash_bytes = 65536 }; // Number of bytes at the start and at the end of the data, that sidecar files are checked against
+		
+		const data_type*	t_data;
+		size_type			t_size;		// In bytes
+		std::uint64_t		t_mtime;	// Time of the last modification of the file (as reported by the OS)
+		bool				t_open;
+		
+		/**
+		 * One entry per chunk of 'index_chunk' bytes: The codepoint index of the first codepoint starting
+		 * within the chunk, shifted left by 3, ored with the offset of that codepoint relative to the start of the chunk
+		 */
+		mutable std::vector<std::uint64_t>	t_index;
+		mutable size_type					t_length;	// In codepoints or npos, if the index is not complete yet
+		
+		//! Returns an empty sequence, which is viewed by empty or closed mapped strings
+		static inline const data_type*	get_empty_data() noexcept { static const data_type empty = 0; return &empty; }
+	
+	public:
+		
+		/**
+		 * Default constructor
+		 *
+		 * @note	Creates a closed mapped string
+		 */
+		basic_mapped_string() noexcept :
+			t_data( get_empty_data() )
+			, t_size( 0 )
+			, t_mtime( 0 )
+			, t_open( false )
+			, t_length( 0 )
+		{}
+		/**
+		 * Constructor mapping the supplied file
+		 *
+		 * @param	path	The path of the file to map (check 'is_open' for success)
+		 */
+		explicit basic_mapped_string( const char* path ) noexcept(TINY_UTF8_NOEXCEPT) :
+			basic_mapped_string()
+		{ open( path ); }
+		explicit basic_mapped_string( const std::string& path ) noexcept(TINY_UTF8_NOEXCEPT) :
+			basic_mapped_string()
+		{ open( path.c_str() ); }
+		
+		//! Move constructor and move assignment
+		basic_mapped_string( basic_mapped_string&& other ) noexcept :
+			basic_mapped_string()
+		{ swap( other ); }
+		basic_mapped_string& operator=( basic_mapped_string&& other ) noexcept {
+			basic_mapped_string( std::move( other ) ).swap( *this );
+			return *this;
+		}
+		
+		//! Mappings cannot be copied
+		basic_mapped_string( const basic_mapped_string& ) = delete;
+		basic_mapped_string& operator=( const basic_mapped_string& ) = delete;
+		
+		//! Destructor
+		~basic_mapped_string() noexcept { close(); }
+		
+		//! Swaps the contents of this mapped string with the supplied one
+		void swap( basic_mapped_string& other ) noexcept {
+			std::swap( t_data , other.t_data );
+			std::swap( t_size , other.t_size );
+			std::swap( t_mtime , other.t_mtime );
+			std::swap( t_open , other.t_open );
+			t_index.swap( other.t_index );
+			std::swap( t_length , other.t_length );
+		}
+		
+		
+		/**
+		 * Maps the supplied file, after closing the currently mapped one
+		 *
+		 * @param	path	The path of the file to map
+		 * @return	True, if the file was mapped successfully
+		 */
+		bool open( const char* path ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		inline bool open( const std::string& path ) noexcept(TINY_UTF8_NOEXCEPT) { return open( path.c_str() ); }
+		
+		//! Unmaps the file and discards the index
+		void close() noexcept ;
+		
+		//! Check, whether a file is mapped
+		inline bool is_open() const noexcept { return t_open; }
+		inline explicit operator bool() const noexcept { return t_open; }
+		
+		
+		/**
+		 * Saves the index to a sidecar file (building the rest of it first)
+		 *
+		 * @param	path	The path of the sidecar file to write
+		 * @return	True, if the index was written successfully
+		 */
+		bool save_index( const char* path ) const noexcept(TINY_UTF8_NOEXCEPT) ;
+		inline bool save_index( const std::string& path ) const noexcept(TINY_UTF8_NOEXCEPT) { return save_index( path.c_str() ); }
+		
+		/**
+		 * Loads the index from a sidecar file, if it was saved for the currently mapped data
+		 *
+		 * @note	Sidecar files are matched against the size and modification time of the mapped file
+		 *			as well as a hash of its first and last 64KiB. Modifications in between within the granularity
+		 *			of the modification time, that preserve the size of the file, go unnoticed.
+		 * @param	path	The path of the sidecar file to read
+		 * @return	True, if the index was loaded. Otherwise, the index will be built on demand as before
+		 */
+		bool load_index( const char* path ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		inline bool load_index( const std::string& path ) noexcept(TINY_UTF8_NOEXCEPT) { return load_index( path.c_str() ); }
+		
+		//! Builds the complete index (and counts the codepoints) right away
+		void build_index() const noexcept(TINY_UTF8_NOEXCEPT) { while( !index_complete() ) extend_index(); }
+		
+		//! Check, whether the index covers the whole data
+		inline bool index_complete() const noexcept { return t_index.size() >= get_num_chunks(); }
+		
+		
+		/**
+		 * Returns the mapped data
+		 *
+		 * @note	The data is not null-terminated
+		 * @return	A pointer to the first byte of the file
+		 */
+		inline const data_type* data() const noexcept { return t_data; }
+		
+		//! Returns the number of bytes of the mapped file
+		inline size_type size() const noexcept { return t_size; }
+		
+		/**
+		 * Returns the number of codepoints of the mapped file
+		 *
+		 * @note	Builds the rest of the index on first use
+		 */
+		inline size_type length() const noexcept(TINY_UTF8_NOEXCEPT) {
+			build_index();
+			return t_length;
+		}
+		
+		//! Check, whether the mapped file is empty (or no file is mapped)
+		inline bool empty() const noexcept { return !t_size; }
+		
+		//! Get a view of the whole mapped data
+		inline string_view view() const noexcept { return { t_data , t_size , t_length }; }
+		inline operator string_view() const noexcept { return view(); }
+		
+		
+		/**
+		 * Returns the codepoint at the supplied index
+		 *
+		 * @param	n	The codepoint index of the codepoint to receive
+		 * @return	The codepoint at position 'n'
+		 */
+		inline value_type at( size_type n ) const noexcept(TINY_UTF8_NOEXCEPT) { return raw_at( get_num_bytes_from_start( n ) ); }
+		inline value_type at( size_type n , std::nothrow_t ) const noexcept { return raw_at( get_num_bytes_from_start( n ) , std::nothrow ); }
+		inline value_type operator[]( size_type n ) const noexcept { return at( n , std::nothrow ); }
+		/**
+		 * Returns the codepoint at the supplied byte position
+		 *
+		 * @param	byte_index	The byte position of the codepoint to receive
+		 * @return	The codepoint at the supplied position
+		 */
+		value_type raw_at( size_type byte_index ) const noexcept(TINY_UTF8_NOEXCEPT) {
+			if( byte_index >= t_size ){
+				TINY_UTF8_THROW( "tiny_utf8::basic_mapped_string::(raw_)at" , byte_index >= t_size );
+				return 0;
+			}
+			return view().raw_at( byte_index , std::nothrow );
+		}
+		inline value_type raw_at( size_type byte_index , std::nothrow_t ) const noexcept { return view().raw_at( byte_index , std::nothrow ); }
+		
+		//! Returns the first (last) codepoint of the mapped file
+		inline value_type front() const noexcept { return raw_at( 0 , std::nothrow ); }
+		inline value_type back() const noexcept { return raw_at( raw_back_index() , std::nothrow ); }
+		
+		
+		//! Get an iterator to the beginning (end) of the mapped file
+		inline const_iterator begin() const noexcept { return { 0 , this , 0 }; }
+		inline const_iterator end() const noexcept { return { (difference_type)length() , this , (difference_type)t_size }; }
+		inline const_iterator cbegin() const noexcept { return begin(); }
+		inline const_iterator cend() const noexcept { return end(); }
+		inline raw_const_iterator raw_begin() const noexcept { return { 0 , this }; }
+		inline raw_const_iterator raw_end() const noexcept { return { (difference_type)t_size , this }; }
+		inline raw_const_iterator raw_cbegin() const noexcept { return raw_begin(); }
+		inline raw_const_iterator raw_cend() const noexcept { return raw_end(); }
+		
+		//! Get a reverse iterator to the last codepoint (before the first codepoint) of the mapped file
+		inline const_reverse_iterator rbegin() const noexcept { return { (difference_type)length() - 1 , this , (difference_type)raw_back_index() }; }
+		inline const_reverse_iterator rend() const noexcept { return { -1 , this }; }
+		inline const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+		inline const_reverse_iterator crend() const noexcept { return rend(); }
+		inline raw_const_reverse_iterator raw_rbegin() const noexcept { return { (difference_type)raw_back_index() , this }; }
+		inline raw_const_reverse_iterator raw_rend() const noexcept { return { -1 , this }; }
+		inline raw_const_reverse_iterator raw_crbegin() const noexcept { return raw_rbegin(); }
+		inline raw_const_reverse_iterator raw_crend() const noexcept { return raw_rend(); }
+		
+		
+		/**
+		 * Returns a view of a portion of the mapped file (indexed on codepoint-base)
+		 *
+		 * @param	pos		The codepoint position where the view shall start
+		 * @param	len		The maximum number of codepoints that the view shall have
+		 * @return	The view of the specified codepoints
+		 */
+		string_view substr( size_type pos , size_type len = npos ) const noexcept(TINY_UTF8_NOEXCEPT) {
+			size_type byte_start = get_num_bytes_from_start( pos );
+			if( byte_start == t_size && pos > length() ){
+				TINY_UTF8_THROW( "tiny_utf8::basic_mapped_string::substr" , pos > length() );
+				return {};
+			}
+			if( len == npos )
+				return { t_data + byte_start , t_size - byte_start , t_length == npos ? npos : t_length - pos };
+			size_type byte_count = get_num_bytes( byte_start , len );
+			
+			// If the view ends before the end of the data, it holds exactly 'len' codepoints
+			return { t_data + byte_start , byte_count , byte_start + byte_count < t_size ? len : npos };
+		}
+		/**
+		 * Returns a view of a portion of the mapped file (indexed on byte-base)
+		 *
+		 * @param	start_byte		The byte position where the view shall start
+		 * @param	byte_count		The maximum number of bytes that the view shall have
+		 * @return	The view of the specified bytes
+		 */
+		inline string_view raw_substr( size_type start_byte , size_type byte_count = npos ) const noexcept(TINY_UTF8_NOEXCEPT) {
+			return view().raw_substr( start_byte , byte_count );
+		}
+		
+		
+		/**
+		 * Finds a specific codepoint (pattern) inside the mapped file starting at the supplied codepoint index
+		 *
+		 * @param	cp				The codepoint (pattern) to look for
+		 * @param	start_codepoint	The index of the first codepoint to start looking from
+		 * @return	The codepoint index where and if the codepoint (pattern) was found or npos
+		 */
+		inline size_type find( value_type cp , size_type start_codepoint = 0 ) const noexcept {
+			return to_codepoint_index( raw_find( cp , get_num_bytes_from_start( start_codepoint ) ) );
+		}
+		inline size_type find( string_view pattern , size_type start_codepoint = 0 ) const noexcept {
+			return to_codepoint_index( raw_find( pattern , get_num_bytes_from_start( start_codepoint ) ) );
+		}
+		/**
+		 * Finds a specific codepoint (pattern) inside the mapped file starting at the supplied byte position
+		 *
+		 * @param	cp			The codepoint (pattern) to look for
+		 * @param	start_byte	The byte position of the first codepoint to start looking from
+		 * @return	The byte position where and if the codepoint (pattern) was found or npos
+		 */
+		inline size_type raw_find( value_type cp , size_type start_byte = 0 ) const noexcept { return view().raw_find( cp , start_byte ); }
+		inline size_type raw_find( string_view pattern , size_type start_byte = 0 ) const noexcept { return view().raw_find( pattern , start_byte ); }
+		
+		/**
+		 * Finds the last occourence of a specific codepoint (pattern) inside the mapped file,
+		 * that starts at or before the supplied codepoint index
+		 *
+		 * @param	cp				The codepoint (pattern) to look for
+		 * @param	start_codepoint	The index of the last codepoint, at which the codepoint (pattern) may start
+		 * @return	The codepoint index where and if the codepoint (pattern) was found or npos
+		 */
+		inline size_type rfind( value_type cp , size_type start_codepoint = npos ) const noexcept {
+			return to_codepoint_index( raw_rfind( cp , start_codepoint == npos ? npos : get_num_bytes_from_start( start_codepoint ) ) );
+		}
+		inline size_type rfind( string_view pattern , size_type start_codepoint = npos ) const noexcept {
+			return to_codepoint_index( raw_rfind( pattern , start_codepoint == npos ? npos : get_num_bytes_from_start( start_codepoint ) ) );
+		}
+		/**
+		 * Finds the last occourence of a specific codepoint (pattern) inside the mapped file,
+		 * that starts at or before the supplied byte index
+		 *
+		 * @param	cp				The codepoint (pattern) to look for
+		 * @param	start_byte		The byte index of the last byte, at which the codepoint (pattern) may start
+		 * @return	The byte index where and if the codepoint (pattern) was found or npos
+		 */
+		inline size_type raw_rfind( value_type cp , size_type start_byte = npos ) const noexcept { return view().raw_rfind( cp , start_byte ); }
+		inline size_type raw_rfind( string_view pattern , size_type start_byte = npos ) const noexcept { return view().raw_rfind( pattern , start_byte ); }
+		
+		
+		//! Comparison with views (see 'basic_string_view::compare')
+		inline int compare( string_view view ) const noexcept { return this->view().compare( view ); }
+		inline bool operator==( string_view view ) const noexcept { return this->view() == view; }
+		inline bool operator!=( string_view view ) const noexcept { return this->view() != view; }
+		
+		//! Check, whether the mapped file starts (ends) with the supplied character sequence or codepoint
+		inline bool starts_with( string_view view ) const noexcept { return this->view().starts_with( view ); }
+		inline bool ends_with( string_view view ) const noexcept { return this->view().ends_with( view ); }
+		inline bool starts_with( value_type cp ) const noexcept { return !empty() && front() == cp; }
+		inline bool ends_with( value_type cp ) const noexcept { return !empty() && back() == cp; }
+		
+		
+		//! Get the number of bytes of the codepoint at the supplied byte index
+		inline width_type get_index_bytes( size_type byte_index ) const noexcept { return view().get_index_bytes( byte_index ); }
+		
+		//! Get the number of bytes before a codepoint, that build up a new codepoint
+		inline width_type get_index_pre_bytes( size_type byte_index ) const noexcept { return view().get_index_pre_bytes( byte_index ); }
+		
+		//! Get the byte index of the last codepoint
+		inline size_type raw_back_index() const noexcept { return view().raw_back_index(); }
+		
+		/**
+		 * Counts the number of codepoints
+		 * that are contained within the supplied range of bytes
+		 */
+		size_type get_num_codepoints( size_type byte_start , size_type byte_count ) const noexcept {
+			if( byte_count <= index_chunk )
+				return view().get_num_codepoints( byte_start , byte_count );
+			size_type end_index = byte_start + byte_count;
+			return get_codepoint_index( end_index < byte_start ? t_size : end_index ) - get_codepoint_index( byte_start );
+		}
+		
+		/**
+		 * Counts the number of bytes required to hold the supplied amount of codepoints
+		 * starting at the supplied byte index (or '0' for the '_from_start' version)
+		 */
+		size_type get_num_bytes( size_type byte_start , size_type cp_count ) const noexcept {
+			size_type potential_end_index = byte_start + cp_count;
+			
+			// 'potential_end_index < byte_start' is needed because of potential integer overflow in sum
+			if( potential_end_index > t_size || potential_end_index < byte_start )
+				return t_size - byte_start;
+			if( cp_count <= index_chunk )
+				return view().get_num_bytes( byte_start , cp_count );
+			return get_num_bytes_from_start( get_codepoint_index( byte_start ) + cp_count ) - byte_start;
+		}
+		size_type get_num_bytes_from_start( size_type cp_count ) const noexcept ;
+		
+		
+		//! Get a copy of the mapped data wrapped by an std::string
+		inline std::basic_string<data_type> cpp_str() const noexcept(TINY_UTF8_NOEXCEPT) { return view().cpp_str(); }
+		
+		//! Check whether the mapped data is valid UTF-8 as specified by RFC 3629 (see 'basic_string::is_valid_utf8')
+		inline bool is_valid_utf8() const noexcept { return view().is_valid_utf8(); }
+		
+		/**
+		 * Decodes the codepoints of the mapped file into the supplied output range (see 'basic_string_view::to_codepoints')
+		 *
+		 * @return	The number of codepoints written
+		 */
+		inline size_type to_codepoints( value_type* dest , size_type capacity = npos ) const noexcept { return view().to_codepoints( dest , capacity ); }
+		template<typename OutputIt>
+		inline size_type to_codepoints( OutputIt dest , size_type capacity = npos ) const noexcept(TINY_UTF8_NOEXCEPT) { return view().to_codepoints( dest , capacity ); }
+	
+	protected:
+		
+		//! Get the number of chunks that the index consists of, once it is complete
+		inline size_type get_num_chunks() const noexcept { return ( t_size + index_chunk - 1 ) / index_chunk; }
+		
+		//! Get the codepoint index (byte index) of the first codepoint starting within the supplied chunk
+		inline size_type get_chunk_codepoint_index( size_type chunk ) const noexcept { return (size_type)( t_index[chunk] >> 3 ); }
+		inline size_type get_chunk_byte_index( size_type chunk ) const noexcept { return chunk * index_chunk + (size_type)( t_index[chunk] & 7 ); }
+		
+		//! Adds the entry of the next chunk to the index (and counts all codepoints, once the index is complete)
+		void extend_index() const noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		//! Get the number of codepoints starting before the supplied byte index
+		size_type get_codepoint_index( size_type byte_index ) const noexcept ;
+		
+		//! Converts the result of a byte-based search into a codepoint index
+		inline size_type to_codepoint_index( size_type result ) const noexcept { return result == npos ? npos : get_codepoint_index( result ); }
+		
+		//! Get the value, that sidecar files store to identify the data they were built for
+		std::uint64_t get_data_hash() const noexcept {
+			size_type head_bytes = std::min<size_type>( t_size , index_hash_bytes );
+			return tiny_utf8_detail::hash_mix(
+				tiny_utf8_detail::hash_bytes( (const unsigned char*)t_data , head_bytes )
+				, tiny_utf8_detail::hash_bytes( (const unsigned char*)t_data + t_size - head_bytes , head_bytes )
+			);
+		}
+	};
+} // Namespace 'tiny_utf8'
+
+namespace tiny_utf8
+{
+	template<typename V, typename D>
+	bool basic_mapped_string<V, D>::open( const char* path ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		close();
+		
+		const data_type*	data = get_empty_data();
+		std::uint64_t		size;
+		
+		#if defined(_WIN32)
+			HANDLE file = ::CreateFileA( path , GENERIC_READ , FILE_SHARE_READ , nullptr , OPEN_EXISTING , FILE_ATTRIBUTE_NORMAL , nullptr );
+			if( file == INVALID_HANDLE_VALUE )
+				return false;
+			LARGE_INTEGER	file_size;
+			FILETIME		write_time;
+			if( !::GetFileSizeEx( file , &file_size ) || !::GetFileTime( file , nullptr , nullptr , &write_time ) || (std::uint64_t)file_size.QuadPart > (size_type)-1 ){
+				::CloseHandle( file );
+				return false;
+			}
+			size = (std::uint64_t)file_size.QuadPart;
+			t_mtime = ( (std::uint64_t)write_time.dwHighDateTime << 32 ) | write_time.dwLowDateTime;
+			if( size ){
+				// The view keeps the file (mapping) open, so the handles can be closed right away
+				HANDLE mapping = ::CreateFileMappingA( file , nullptr , PAGE_READONLY , 0 , 0 , nullptr );
+				void* address = mapping ? ::MapViewOfFile( mapping , FILE_MAP_READ , 0 , 0 , 0 ) : nullptr;
+				if( mapping )
+					::CloseHandle( mapping );
+				if( !address ){
+					::CloseHandle( file );
+					return false;
+				}
+				data = (const data_type*)address;
+			}
+			::CloseHandle( file );
+		#else
+			int fd = ::open( path , O_RDONLY );
+			if( fd < 0 )
+				return false;
+			struct stat file_stat;
+			if( ::fstat( fd , &file_stat ) != 0 || !S_ISREG( file_stat.st_mode ) || (std::uint64_t)file_stat.st_size > (size_type)-1 ){
+				::close( fd );
+				return false;
+			}
+			size = (std::uint64_t)file_stat.st_size;
+			t_mtime = (std::uint64_t)file_stat.st_mtime;
+			if( size ){
+				// The mapping keeps the file open, so the descriptor can be closed right away
+				void* mapping = ::mmap( nullptr , (size_type)size , PROT_READ , MAP_PRIVATE , fd , 0 );
+				if( mapping == MAP_FAILED ){
+					::close( fd );
+					return false;
+				}
+				data = (const data_type*)mapping;
+			}
+			::close( fd );
+		#endif
+		
+		t_data = data;
+		t_size = (size_type)size;
+		t_open = true;
+		t_length = t_size ? (size_type)npos : 0;
+		return true;
+	}
+	
+	template<typename V, typename D>
+	void basic_mapped_string<V, D>::close() noexcept
+	{
+		if( t_size ){
+			#if defined(_WIN32)
+				::UnmapViewOfFile( t_data );
+			#else
+				::munmap( (void*)t_data , t_size );
+			#endif
+		}
+		t_data = get_empty_data();
+		t_size = 0;
+		t_mtime = 0;
+		t_open = false;
+		t_length = 0;
+		std::vector<std::uint64_t>().swap( t_index );
+	}
+	
+	template<typename V, typename D>
+	void basic_mapped_string<V, D>::extend_index() const noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		size_type chunk = t_index.size();
+		if( !chunk )
+			t_index.push_back( 0 );
+		else{
+			// Walk from the first codepoint of the previous chunk to the first codepoint of this one
+			size_type start_index = get_chunk_byte_index( chunk - 1 );
+			size_type num_codepoints;
+			size_type next_index = string_type::walk_codepoints( t_data , start_index , chunk * index_chunk , t_size , num_codepoints );
+			t_index.push_back( (std::uint64_t)( get_chunk_codepoint_index( chunk - 1 ) + num_codepoints ) << 3 | ( next_index - chunk * index_chunk ) );
+		}
+		
+		// Count the codepoints of the last chunk, once it is reached
+		if( index_complete() ){
+			size_type start_index = get_chunk_byte_index( chunk );
+			size_type num_codepoints;
+			string_type::walk_codepoints( t_data , start_index , t_size , t_size , num_codepoints );
+			t_length = get_chunk_codepoint_index( chunk ) + num_codepoints;
+		}
+	}
+	
+	template<typename V, typename D>
+	typename basic_mapped_string<V, D>::size_type basic_mapped_string<V, D>::get_codepoint_index( size_type byte_index ) const noexcept
+	{
+		if( byte_index >= t_size )
+			return length();
+		
+		size_type chunk = byte_index / index_chunk;
+		while( t_index.size() <= chunk )
+			extend_index();
+		
+		// Continuation bytes of a codepoint, that spans the chunk boundary, belong to the codepoint before the first one of the chunk
+		size_type start_index = get_chunk_byte_index( chunk );
+		if( byte_index <= start_index )
+			return get_chunk_codepoint_index( chunk );
+		return get_chunk_codepoint_index( chunk ) + view().get_num_codepoints( start_index , byte_index - start_index );
+	}
+	
+	template<typename V, typename D>
+	typename basic_mapped_string<V, D>::size_type basic_mapped_string<V, D>::get_num_bytes_from_start( size_type cp_count ) const noexcept
+	{
+		if( cp_count >= t_size ) // There are never more codepoints than bytes
+			return t_size;
+		if( t_length == t_size ) // Only ASCII?
+			return cp_count;
+		
+		// Extend the index until it covers the requested codepoint
+		while( !index_complete() && ( t_index.empty() || get_chunk_codepoint_index( t_index.size() - 1 ) <= cp_count ) )
+			extend_index();
+		
+		// Find the last chunk whose first codepoint is not after the requested one and walk from there
+		size_type chunk = std::upper_bound(
+			t_index.begin()
+			, t_index.end()
+			, (std::uint64_t)cp_count
+			, []( std::uint64_t codepoint_index , std::uint64_t entry ){ return codepoint_index < ( entry >> 3 ); }
+		) - t_index.begin() - 1;
+		size_type start_index = get_chunk_byte_index( chunk );
+		return start_index + view().get_num_bytes( start_index , cp_count - get_chunk_codepoint_index( chunk ) );
+	}
+	
+	template<typename V, typename D>
+	bool basic_mapped_string<V, D>::save_index( const char* path ) const noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		if( !t_open )
+			return false;
+		build_index();
+		
+		index_header header;
+		header.magic		= index_magic;
+		header.version		= index_version;
+		header.chunk_size	= index_chunk;
+		header.data_size	= t_size;
+		header.mtime		= t_mtime;
+		header.data_hash	= get_data_hash();
+		header.length		= t_length;
+		header.num_entries	= t_index.size();
+		
+		std::FILE* file = std::fopen( path , "wb" );
+		if( !file )
+			return false;
+		bool success = std::fwrite( &header , sizeof(header) , 1 , file ) == 1
+			&& std::fwrite( t_index.data() , sizeof(std::uint64_t) , t_index.size() , file ) == t_index.size();
+		return std::fclose( file ) == 0 && success;
+	}
+	
+	template<typename V, typename D>
+	bool basic_mapped_string<V, D>::load_index( const char* path ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		if( !t_open )
+			return false;
+		
+		std::FILE* file = std::fopen( path , "rb" );
+		if( !file )
+			return false;
+		
+		// Check, whether the sidecar file matches the mapped data
+		index_header header;
+		bool success = std::fread( &header , sizeof(header) , 1 , file ) == 1
+			&& header.magic == index_magic
+			&& header.version == index_version
+			&& header.chunk_size == index_chunk
+			&& header.data_size == t_size
+			&& header.mtime == t_mtime
+			&& header.num_entries == get_num_chunks()
+			&& header.length <= t_size
+			&& header.data_hash == get_data_hash();
+		
+		std::vector<std::uint64_t> index;
+		if( success ){
+			index.resize( (size_type)header.num_entries );
+			success = std::fread( index.data() , sizeof(std::uint64_t) , index.size() , file ) == index.size();
+		}
+		std::fclose( file );
+		
+		// Entries must increase strictly, since every chunk (except the last one) holds codepoints
+		for( size_type chunk = 0 ; success && chunk < index.size() ; ++chunk )
+			success = chunk ? ( index[chunk] >> 3 ) > ( index[chunk - 1] >> 3 ) && ( index[chunk] >> 3 ) <= header.length : !index[chunk];
+		if( !success )
+			return false;
+		
+		t_index.swap( index );
+		t_length = (size_type)header.length;
+		return true;
+	}
+} // Namespace 'tiny_utf8'
+
+#endif // _TINY_UTF8_MAPPED_STRING_H_
@@ -0,0 +1,791 @@
+/**
+ * Copyright (c) 2015-2021 Jakob Riedle (DuffsDevice)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR 'AS IS' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TINY_UTF8_ROPE_H_
+#define _TINY_UTF8_ROPE_H_
+
+// Includes
+#include "tinyutf8.h"
+
+namespace tiny_utf8
+{
+	//! Typedef of rope (data type: char)
+	using rope = basic_rope<char32_t, char>;
+	
+	/**
+	 * UTF-8 string for large documents, that are edited in place (e.g. by text editors).
+	 * The data is split into chunks of at most 'max_chunk_bytes' bytes, each being a basic_string, which form a treap
+	 * (a binary search tree balanced by random node priorities) ordered by position. Every node caches the number of bytes
+	 * and codepoints of its subtree, so that 'at', 'insert', 'erase' and 'replace' take O(log n) (plus the size of one chunk)
+	 * instead of moving the whole tail of the string.
+	 *
+	 * @note	The chunk, that was accessed last, is cached within the rope (see 't_cursor'), which makes iterating O(1) per codepoint.
+	 *			All lookups of single positions update that cache, including the const ones ('at', 'raw_at', 'operator[]', 'front', 'back',
+	 *			iterators and index translations). Only 'substr', 'str', 'cpp_str', 'for_each_chunk' and 'compare' walk the tree without it.
+	 *			Unlike a basic_string, a basic_rope is therefore not thread-safe, even if it is only read:
+	 *			Threads accessing the same rope at once (including a const one) have to synchronize or use copies of their own.
+	 *			Chunks only ever split at codepoint boundaries, so all codepoints (and the UTF-8 data) are the same as
+	 *			within a basic_string holding the same data. To modify ropes, use 'insert', 'erase' and 'replace' (all iterators are const).
+	 */
+	template<typename ValueType, typename DataType, typename Allocator>
+	class basic_rope
+	{
+	public:
+		
+		typedef DataType														data_type;
+		typedef std::size_t														size_type;
+		typedef std::ptrdiff_t													difference_type;
+		typedef ValueType														value_type;
+		typedef Allocator														allocator_type;
+		typedef std::uint_fast8_t												width_type;
+		typedef basic_string<ValueType, DataType, Allocator>					string_type;
+		typedef basic_string_view<ValueType, DataType>							string_view;
+		typedef tiny_utf8::const_iterator<basic_rope, false>					const_iterator;
+		typedef tiny_utf8::const_reverse_iterator<basic_rope, false>			const_reverse_iterator;
+		typedef tiny_utf8::const_iterator<basic_rope, true>						raw_const_iterator;
+		typedef tiny_utf8::const_reverse_iterator<basic_rope, true>				raw_const_reverse_iterator;
+		typedef const_iterator													iterator;
+		typedef const_reverse_iterator											reverse_iterator;
+		typedef raw_const_iterator												raw_iterator;
+		typedef raw_const_reverse_iterator										raw_reverse_iterator;
+		enum : size_type{														npos = (size_type)-1 };
+		enum : size_type{														max_chunk_bytes = 2048 }; // Chunks are built half full, so that most edits fit in place
+	
+	protected: //! Attributes
+		
+		struct node
+		{
+			string_type		chunk;
+			node*			left;
+			node*			right;
+			std::uint32_t	priority;		// Of the treap, i.e. higher than the priorities of all nodes within the subtrees
+			size_type		num_bytes;		// Of the subtree
+			size_type		num_codepoints;	// Of the subtree
+		};
+		typedef typename std::allocator_traits<Allocator>::template rebind_alloc<node>	node_allocator_type;
+		typedef std::allocator_traits<node_allocator_type>								node_allocator_traits;
+		
+		//! The chunk, that was accessed last, together with its position (iterators don't hold one of their own, see 't_cursor')
+		struct cursor
+		{
+			const node*		chunk;
+			size_type		byte_start;
+			size_type		num_bytes;
+			size_type		codepoint_start;
+			size_type		num_codepoints;
+		};
+		
+		node*				t_root;
+		std::uint32_t		t_seed;		// State of the generator of node priorities
+		allocator_type		t_allocator;
+		mutable cursor		t_cursor;	// Written by const lookups as well, which makes concurrent reads of one rope a data race
+	
+	public:
+		
+		/**
+		 * Default constructor
+		 *
+		 * @note	Creates an empty rope
+		 */
+		basic_rope() noexcept(TINY_UTF8_NOEXCEPT) :
+			basic_rope( allocator_type() )
+		{}
+		explicit basic_rope( const allocator_type& alloc ) noexcept(TINY_UTF8_NOEXCEPT) :
+			t_root( nullptr )
+			, t_seed( 2463534242u )
+			, t_allocator( alloc )
+			, t_cursor()
+		{}
+		/**
+		 * Constructor taking UTF-8 data, which is copied into chunks
+		 *
+		 * @param	str		The UTF-8 data to fill the rope with
+		 * @param	alloc	(Optional) The allocator instance to use
+		 */
+		explicit basic_rope( string_view str , const allocator_type& alloc = allocator_type() ) noexcept(TINY_UTF8_NOEXCEPT) :
+			basic_rope( alloc )
+		{ t_root = build( str ); }
+		explicit basic_rope( const data_type* str , const allocator_type& alloc = allocator_type() ) noexcept(TINY_UTF8_NOEXCEPT) :
+			basic_rope( string_view( str ) , alloc )
+		{}
+		explicit basic_rope( const string_type& str ) noexcept(TINY_UTF8_NOEXCEPT) :
+			basic_rope( string_view( str ) , str.get_allocator() )
+		{}
+		/**
+		 * Constructor taking a basic_string
+		 *
+		 * @note	If 'str' fits into one chunk, it becomes that chunk without copying its data
+		 * @param	str		The basic_string to fill the rope with
+		 */
+		explicit basic_rope( string_type&& str ) noexcept(TINY_UTF8_NOEXCEPT) :
+			basic_rope( str.get_allocator() )
+		{
+			if( str.size() > max_chunk_bytes )
+				t_root = build( str );
+			else if( !str.empty() )
+				t_root = create_node( std::move( str ) );
+		}
+		
+		//! Copy constructor and copy assignment (copy all chunks)
+		basic_rope( const basic_rope& other ) noexcept(TINY_UTF8_NOEXCEPT) :
+			basic_rope( other.t_allocator )
+		{ t_root = clone( other.t_root ); }
+		basic_rope& operator=( const basic_rope& other ) noexcept(TINY_UTF8_NOEXCEPT) {
+			if( &other != this )
+				basic_rope( other ).swap( *this );
+			return *this;
+		}
+		
+		//! Move constructor and move assignment
+		basic_rope( basic_rope&& other ) noexcept :
+			basic_rope( other.t_allocator )
+		{ swap( other ); }
+		basic_rope& operator=( basic_rope&& other ) noexcept {
+			basic_rope( std::move( other ) ).swap( *this );
+			return *this;
+		}
+		
+		//! Destructor
+		~basic_rope() noexcept { destroy( t_root ); }
+		
+		//! Swaps the contents of this rope with the supplied one
+		void swap( basic_rope& other ) noexcept {
+			std::swap( t_root , other.t_root );
+			std::swap( t_seed , other.t_seed );
+			std::swap( t_allocator , other.t_allocator );
+			std::swap( t_cursor , other.t_cursor );
+		}
+		
+		//! Returns the allocator used for the chunks
+		inline allocator_type get_allocator() const noexcept { return t_allocator; }
+		
+		
+		//! Returns the number of bytes (code units) of the rope
+		inline size_type size() const noexcept { return get_node_bytes( t_root ); }
+		
+		//! Returns the number of codepoints of the rope
+		inline size_type length() const noexcept { return get_node_codepoints( t_root ); }
+		
+		//! Check, whether the rope is empty
+		inline bool empty() const noexcept { return !t_root; }
+		
+		//! Erases all data of the rope
+		void clear() noexcept {
+			destroy( t_root );
+			t_root = nullptr;
+			t_cursor = cursor();
+		}
+		
+		
+		/**
+		 * Returns the codepoint at the supplied index
+		 *
+		 * @param	n	The codepoint index of the codepoint to receive
+		 * @return	The codepoint at position 'n'
+		 */
+		value_type at( size_type n ) const noexcept(TINY_UTF8_NOEXCEPT) {
+			if( n >= length() ){
+				TINY_UTF8_THROW( "tiny_utf8::basic_rope::at" , n >= length() );
+				return 0;
+			}
+			return at( n , std::nothrow );
+		}
+		value_type at( size_type n , std::nothrow_t ) const noexcept {
+			if( n >= length() )
+				return 0;
+			const node* chunk = find_codepoint( n );
+			return chunk->chunk.at( n - t_cursor.codepoint_start , std::nothrow );
+		}
+		inline value_type operator[]( size_type n ) const noexcept { return at( n , std::nothrow ); }
+		/**
+		 * Returns the codepoint at the supplied byte position
+		 *
+		 * @param	byte_index	The byte position of the codepoint to receive
+		 * @return	The codepoint at the supplied position
+		 */
+		value_type raw_at( size_type byte_index ) const noexcept(TINY_UTF8_NOEXCEPT) {
+			if( byte_index >= size() ){
+				TINY_UTF8_THROW( "tiny_utf8::basic_rope::(raw_)at" , byte_index >= size() );
+				return 0;
+			}
+			return raw_at( byte_index , std::nothrow );
+		}
+		value_type raw_at( size_type byte_index , std::nothrow_t ) const noexcept {
+			if( byte_index >= size() )
+				return 0;
+			const node* chunk = find_byte( byte_index );
+			return chunk->chunk.raw_at( byte_index - t_cursor.byte_start , std::nothrow );
+		}
+		
+		//! Returns the first (last) codepoint of the rope
+		inline value_type front() const noexcept { return raw_at( 0 , std::nothrow ); }
+		inline value_type back() const noexcept { return raw_at( raw_back_index() , std::nothrow ); }
+		
+		
+		//! Get an iterator to the beginning (end) of the rope
+		inline const_iterator begin() const noexcept { return { 0 , this , 0 }; }
+		inline const_iterator end() const noexcept { return { (difference_type)length() , this , (difference_type)size() }; }
+		inline const_iterator cbegin() const noexcept { return begin(); }
+		inline const_iterator cend() const noexcept { return end(); }
+		inline raw_const_iterator raw_begin() const noexcept { return { 0 , this }; }
+		inline raw_const_iterator raw_end() const noexcept { return { (difference_type)size() , this }; }
+		inline raw_const_iterator raw_cbegin() const noexcept { return raw_begin(); }
+		inline raw_const_iterator raw_cend() const noexcept { return raw_end(); }
+		
+		//! Get a reverse iterator to the last codepoint (before the first codepoint) of the rope
+		inline const_reverse_iterator rbegin() const noexcept { return { (difference_type)length() - 1 , this , (difference_type)raw_back_index() }; }
+		inline const_reverse_iterator rend() const noexcept { return { -1 , this }; }
+		inline const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+		inline const_reverse_iterator crend() const noexcept { return rend(); }
+		inline raw_const_reverse_iterator raw_rbegin() const noexcept { return { (difference_type)raw_back_index() , this }; }
+		inline raw_const_reverse_iterator raw_rend() const noexcept { return { -1 , this }; }
+		inline raw_const_reverse_iterator raw_crbegin() const noexcept { return raw_rbegin(); }
+		inline raw_const_reverse_iterator raw_crend() const noexcept { return raw_rend(); }
+		
+		
+		/**
+		 * Inserts UTF-8 data (a codepoint) at the supplied codepoint index
+		 *
+		 * @param	pos		The codepoint index to insert at
+		 * @param	str		The UTF-8 data to insert
+		 * @return	A reference to this rope
+		 */
+		basic_rope& insert( size_type pos , string_view str ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		inline basic_rope& insert( size_type pos , value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) { return insert( pos , string_type( cp , t_allocator ) ); }
+		
+		//! Appends UTF-8 data (a codepoint) to the end of the rope
+		inline basic_rope& append( string_view str ) noexcept(TINY_UTF8_NOEXCEPT) { return insert( length() , str ); }
+		inline basic_rope& push_back( value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) { return insert( length() , cp ); }
+		inline basic_rope& operator+=( string_view str ) noexcept(TINY_UTF8_NOEXCEPT) { return append( str ); }
+		inline basic_rope& operator+=( value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) { return push_back( cp ); }
+		
+		/**
+		 * Erases a portion of the rope
+		 *
+		 * @param	pos		The codepoint index to start erasing from
+		 * @param	len		The number of codepoints to erase
+		 * @return	A reference to this rope
+		 */
+		basic_rope& erase( size_type pos , size_type len = 1 ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		/**
+		 * Replaces a portion of the rope with UTF-8 data (a codepoint)
+		 *
+		 * @param	pos		The codepoint index of the first codepoint to replace
+		 * @param	len		The number of codepoints to replace
+		 * @param	repl	The UTF-8 data to replace them with
+		 * @return	A reference to this rope
+		 */
+		inline basic_rope& replace( size_type pos , size_type len , string_view repl ) noexcept(TINY_UTF8_NOEXCEPT) { return erase( pos , len ).insert( pos , repl ); }
+		inline basic_rope& replace( size_type pos , value_type repl ) noexcept(TINY_UTF8_NOEXCEPT) { return replace( pos , 1 , string_type( repl , t_allocator ) ); }
+		
+		
+		/**
+		 * Returns a portion of the rope (indexed on codepoint-base) as basic_string
+		 *
+		 * @param	pos		The codepoint position where the substring shall start
+		 * @param	len		The maximum number of codepoints that the substring shall have
+		 * @return	The substring
+		 */
+		string_type substr( size_type pos , size_type len = npos ) const noexcept(TINY_UTF8_NOEXCEPT) {
+			string_type result( t_allocator );
+			if( pos > length() ){
+				TINY_UTF8_THROW( "tiny_utf8::basic_rope::substr" , pos > length() );
+				return result;
+			}
+			append_range( t_root , pos , std::min( len , length() - pos ) , result );
+			return result;
+		}
+		
+		//! Convert the rope to a basic_string
+		inline string_type str() const noexcept(TINY_UTF8_NOEXCEPT) { return substr( 0 ); }
+		inline explicit operator string_type() const noexcept(TINY_UTF8_NOEXCEPT) { return str(); }
+		
+		//! Get the data of the rope wrapped by an std::string
+		inline std::basic_string<data_type> cpp_str() const noexcept(TINY_UTF8_NOEXCEPT) {
+			std::basic_string<data_type> result;
+			result.reserve( size() );
+			for_each_chunk( [&result]( string_view chunk ){ result.append( chunk.data() , chunk.size() ); } );
+			return result;
+		}
+		
+		/**
+		 * Calls the supplied function with a string_view of each chunk in order, e.g. to write the rope to a stream
+		 *
+		 * @param	func	The function to call
+		 */
+		template<typename Function>
+		inline void for_each_chunk( Function&& func ) const { for_each_chunk( t_root , func ); }
+		
+		
+		/**
+		 * Compare the rope with the supplied UTF-8 data
+		 *
+		 * @return	0, if they compare equal, <0 if the rope is lexicographically less, >0 otherwise (see 'basic_string::compare')
+		 */
+		int compare( string_view str ) const noexcept {
+			int result = 0;
+			for_each_chunk( [&result, &str]( string_view chunk ){
+				if( !result ){
+					result = std::memcmp( chunk.data() , str.data() , std::min( chunk.size() , str.size() ) );
+					if( !result && chunk.size() > str.size() )
+						result = 1;
+					str.raw_remove_prefix( std::min( chunk.size() , str.size() ) );
+				}
+			});
+			return result || str.empty() ? result : -1;
+		}
+		inline bool operator==( string_view str ) const noexcept { return size() == str.size() && compare( str ) == 0; }
+		inline bool operator!=( string_view str ) const noexcept { return !( *this == str ); }
+		
+		
+		//! Get the number of bytes of the codepoint at the supplied byte index
+		width_type get_index_bytes( size_type byte_index ) const noexcept {
+			if( byte_index >= size() )
+				return 1;
+			const node* chunk = find_byte( byte_index );
+			return chunk->chunk.get_index_bytes( byte_index - t_cursor.byte_start );
+		}
+		
+		//! Get the number of bytes before a codepoint, that build up a new codepoint
+		width_type get_index_pre_bytes( size_type byte_index ) const noexcept {
+			if( !byte_index || byte_index > size() )
+				return 1;
+			const node* chunk = find_byte( byte_index - 1 ); // Chunks never split codepoints
+			return chunk->chunk.get_index_pre_bytes( byte_index - t_cursor.byte_start );
+		}
+		
+		//! Get the byte index of the last codepoint
+		inline size_type raw_back_index() const noexcept { return size() - get_index_pre_bytes( size() ); }
+		
+		/**
+		 * Counts the number of codepoints
+		 * that are contained within the supplied range of bytes
+		 */
+		inline size_type get_num_codepoints( size_type byte_start , size_type byte_count ) const noexcept {
+			size_type end_index = byte_start + byte_count;
+			return get_codepoint_index( end_index < byte_start ? size() : end_index ) - get_codepoint_index( byte_start );
+		}
+		
+		/**
+		 * Counts the number of bytes required to hold the supplied amount of codepoints
+		 * starting at the supplied byte index (or '0' for the '_from_start' version)
+		 */
+		size_type get_num_bytes( size_type byte_start , size_type cp_count ) const noexcept {
+			size_type codepoint_index = get_codepoint_index( byte_start );
+			if( cp_count >= length() - codepoint_index )
+				return size() - byte_start;
+			return get_num_bytes_from_start( codepoint_index + cp_count ) - byte_start;
+		}
+		size_type get_num_bytes_from_start( size_type cp_count ) const noexcept {
+			if( cp_count >= length() )
+				return size();
+			const node* chunk = find_codepoint( cp_count );
+			return t_cursor.byte_start + chunk->chunk.get_num_bytes_from_start( cp_count - t_cursor.codepoint_start );
+		}
+	
+	protected:
+		
+		//! Get the number of bytes (codepoints) of a subtree
+		static inline size_type get_node_bytes( const node* n ) noexcept { return n ? n->num_bytes : 0; }
+		static inline size_type get_node_codepoints( const node* n ) noexcept { return n ? n->num_codepoints : 0; }
+		
+		//! Recomputes the cached counts of a node from its chunk and its children
+		static inline void update( node* n ) noexcept {
+			n->num_bytes = get_node_bytes( n->left ) + n->chunk.size() + get_node_bytes( n->right );
+			n->num_codepoints = get_node_codepoints( n->left ) + n->chunk.length() + get_node_codepoints( n->right );
+		}
+		
+		//! Allocates a node holding the supplied chunk
+		node* create_node( string_type&& chunk ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		//! Destroys a whole subtree
+		void destroy( node* n ) noexcept ;
+		
+		//! Copies a whole subtree
+		node* clone( const node* n ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		//! Builds a subtree from UTF-8 data
+		node* build( string_view str ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		//! Concatenates two subtrees (all nodes of 'l' precede the ones of 'r')
+		static node* merge( node* l , node* r ) noexcept ;
+		
+		//! Same as 'merge', but joins the adjacent chunks of both subtrees, if their data fits into one chunk
+		node* concat( node* l , node* r ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		//! Appends data to the last chunk of a subtree
+		static void append_to_last( node* n , const string_type& str ) noexcept(TINY_UTF8_NOEXCEPT) {
+			if( n->right )
+				append_to_last( n->right , str );
+			else
+				n->chunk.append( str );
+			update( n );
+		}
+		
+		//! Removes the first node of a subtree and returns the new root of the subtree
+		node* remove_first( node* n ) noexcept {
+			if( n->left ){
+				n->left = remove_first( n->left );
+				update( n );
+				return n;
+			}
+			node* right = n->right;
+			n->right = nullptr;
+			destroy( n );
+			return right;
+		}
+		
+		//! Splits a subtree into the first 'pos' codepoints and the rest (possibly splitting the chunk containing the codepoint at 'pos')
+		void split( node* n , size_type pos , node*& l , node*& r ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		//! Inserts (erases) data in place, if the affected chunk has enough room for it (does not become empty)
+		bool insert_in_place( node* n , size_type pos , string_view str ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		bool erase_in_place( node* n , size_type pos , size_type len ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		//! Appends the codepoints [pos,pos+len) of a subtree to 'result'
+		static void append_range( const node* n , size_type pos , size_type len , string_type& result ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		//! Calls 'func' for all chunks of the subtree in order
+		template<typename Function>
+		static void for_each_chunk( const node* n , Function& func ) {
+			for( ; n ; n = n->right ){
+				for_each_chunk( n->left , func );
+				func( string_view( n->chunk ) );
+			}
+		}
+		
+		//! Finds the chunk containing the supplied codepoint index (byte index), which has to be less than 'length()' ('size()'), and moves the cursor to it
+		const node* find_codepoint( size_type codepoint_index ) const noexcept ;
+		const node* find_byte( size_type byte_index ) const noexcept ;
+		
+		//! Get the number of codepoints starting before the supplied byte index
+		size_type get_codepoint_index( size_type byte_index ) const noexcept {
+			if( byte_index >= size() )
+				return length();
+			const node* chunk = find_byte( byte_index );
+			return t_cursor.codepoint_start + chunk->chunk.get_num_codepoints( 0 , byte_index - t_cursor.byte_start );
+		}
+	};
+} // Namespace 'tiny_utf8'
+
+namespace tiny_utf8
+{
+	template<typename V, typename D, typename A>
+	typename basic_rope<V, D, A>::node* basic_rope<V, D, A>::create_node( string_type&& chunk ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		// Xorshift, which is plenty for balancing
+		t_seed ^= t_seed << 13;
+		t_seed ^= t_seed >> 17;
+		t_seed ^= t_seed << 5;
+		
+		node_allocator_type	allocator( t_allocator );
+		node*				n = node_allocator_traits::allocate( allocator , 1 );
+		node_allocator_traits::construct( allocator , n , node{ std::move( chunk ) , nullptr , nullptr , t_seed , 0 , 0 } );
+		update( n );
+		return n;
+	}
+	
+	template<typename V, typename D, typename A>
+	void basic_rope<V, D, A>::destroy( node* n ) noexcept
+	{
+		node_allocator_type allocator( t_allocator );
+		while( n ){
+			destroy( n->left );
+			node* right = n->right;
+			node_allocator_traits::destroy( allocator , n );
+			node_allocator_traits::deallocate( allocator , n , 1 );
+			n = right;
+		}
+	}
+	
+	template<typename V, typename D, typename A>
+	typename basic_rope<V, D, A>::node* basic_rope<V, D, A>::clone( const node* n ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		if( !n )
+			return nullptr;
+		node* result = create_node( string_type( n->chunk ) );
+		result->priority = n->priority;
+		result->left = clone( n->left );
+		result->right = clone( n->right );
+		update( result );
+		return result;
+	}
+	
+	template<typename V, typename D, typename A>
+	typename basic_rope<V, D, A>::node* basic_rope<V, D, A>::build( string_view str ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		node* result = nullptr;
+		while( !str.empty() )
+		{
+			// Cut chunks of about half the maximum size at codepoint boundaries
+			size_type num_bytes = str.size();
+			if( num_bytes > max_chunk_bytes )
+				num_bytes = str.get_num_bytes( 0 , str.get_num_codepoints( 0 , max_chunk_bytes / 2 ) );
+			result = merge( result , create_node( string_type( str.raw_substr( 0 , num_bytes ) , t_allocator ) ) );
+			str.raw_remove_prefix( num_bytes );
+		}
+		return result;
+	}
+	
+	template<typename V, typename D, typename A>
+	typename basic_rope<V, D, A>::node* basic_rope<V, D, A>::merge( node* l , node* r ) noexcept
+	{
+		if( !l )
+			return r;
+		if( !r )
+			return l;
+		if( l->priority > r->priority ){
+			l->right = merge( l->right , r );
+			update( l );
+			return l;
+		}
+		r->left = merge( l , r->left );
+		update( r );
+		return r;
+	}
+	
+	template<typename V, typename D, typename A>
+	typename basic_rope<V, D, A>::node* basic_rope<V, D, A>::concat( node* l , node* r ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		if( !l || !r )
+			return merge( l , r );
+		
+		// Avoid accumulating small chunks through repeated edits
+		node* last = l;
+		node* first = r;
+		while( last->right )
+			last = last->right;
+		while( first->left )
+			first = first->left;
+		if( last->chunk.size() + first->chunk.size() > max_chunk_bytes )
+			return merge( l , r );
+		
+		// Append the first chunk of 'r' to the last one of 'l' and remove its node
+		append_to_last( l , first->chunk );
+		r = remove_first( r );
+		return merge( l , r );
+	}
+	
+	template<typename V, typename D, typename A>
+	void basic_rope<V, D, A>::split( node* n , size_type pos , node*& l , node*& r ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		if( !n ){
+			l = r = nullptr;
+			return;
+		}
+		
+		size_type left_codepoints = get_node_codepoints( n->left );
+		size_type chunk_codepoints = n->chunk.length();
+		if( pos <= left_codepoints ){
+			split( n->left , pos , l , n->left );
+			update( n );
+			r = n;
+		}
+		else if( pos >= left_codepoints + chunk_codepoints ){
+			split( n->right , pos - left_codepoints - chunk_codepoints , n->right , r );
+			update( n );
+			l = n;
+		}
+		else{
+			// Split the chunk itself and put its second half into a new node
+			size_type byte_index = n->chunk.get_num_bytes_from_start( pos - left_codepoints );
+			node* rest = create_node( string_type( n->chunk.raw_substr_view( byte_index ) , t_allocator ) );
+			n->chunk.raw_erase( byte_index , n->chunk.size() - byte_index );
+			r = merge( rest , n->right );
+			n->right = nullptr;
+			update( n );
+			l = n;
+		}
+	}
+	
+	template<typename V, typename D, typename A>
+	bool basic_rope<V, D, A>::insert_in_place( node* n , size_type pos , string_view str ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		if( !n )
+			return false;
+		
+		size_type	left_codepoints = get_node_codepoints( n->left );
+		size_type	chunk_codepoints = n->chunk.length();
+		bool		inserted;
+		if( pos < left_codepoints )
+			inserted = insert_in_place( n->left , pos , str );
+		else if( pos > left_codepoints + chunk_codepoints )
+			inserted = insert_in_place( n->right , pos - left_codepoints - chunk_codepoints , str );
+		else if( ( inserted = n->chunk.size() + str.size() <= max_chunk_bytes ) )
+			n->chunk.insert( pos - left_codepoints , string_type( str , t_allocator ) );
+		if( inserted )
+			update( n );
+		return inserted;
+	}
+	
+	template<typename V, typename D, typename A>
+	bool basic_rope<V, D, A>::erase_in_place( node* n , size_type pos , size_type len ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		size_type	left_codepoints = get_node_codepoints( n->left );
+		size_type	chunk_codepoints = n->chunk.length();
+		bool		erased;
+		if( pos < left_codepoints )
+			erased = erase_in_place( n->left , pos , len );
+		else if( pos >= left_codepoints + chunk_codepoints )
+			erased = erase_in_place( n->right , pos - left_codepoints - chunk_codepoints , len );
+		else if( ( erased = pos - left_codepoints + len <= chunk_codepoints && len < chunk_codepoints ) )
+			n->chunk.erase( pos - left_codepoints , len );
+		if( erased )
+			update( n );
+		return erased;
+	}
+	
+	template<typename V, typename D, typename A>
+	basic_rope<V, D, A>& basic_rope<V, D, A>::insert( size_type pos , string_view str ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		if( pos > length() ){
+			TINY_UTF8_THROW( "tiny_utf8::basic_rope::insert" , pos > length() );
+			return *this;
+		}
+		if( str.empty() )
+			return *this;
+		
+		t_cursor = cursor();
+		if( !insert_in_place( t_root , pos , str ) ){
+			node* l;
+			node* r;
+			split( t_root , pos , l , r );
+			t_root = concat( concat( l , build( str ) ) , r );
+		}
+		return *this;
+	}
+	
+	template<typename V, typename D, typename A>
+	basic_rope<V, D, A>& basic_rope<V, D, A>::erase( size_type pos , size_type len ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		if( pos > length() ){
+			TINY_UTF8_THROW( "tiny_utf8::basic_rope::erase" , pos > length() );
+			return *this;
+		}
+		len = std::min( len , length() - pos );
+		if( !len )
+			return *this;
+		
+		t_cursor = cursor();
+		if( !erase_in_place( t_root , pos , len ) ){
+			node* l;
+			node* m;
+			node* r;
+			split( t_root , pos , l , r );
+			split( r , len , m , r );
+			destroy( m );
+			t_root = concat( l , r );
+		}
+		return *this;
+	}
+	
+	template<typename V, typename D, typename A>
+	void basic_rope<V, D, A>::append_range( const node* n , size_type pos , size_type len , string_type& result ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		for( ; n && len ; n = n->right )
+		{
+			size_type left_codepoints = get_node_codepoints( n->left );
+			size_type chunk_codepoints = n->chunk.length();
+			if( pos < left_codepoints ){
+				size_type count = std::min( len , left_codepoints - pos );
+				append_range( n->left , pos , count , result );
+				pos += count;
+				len -= count;
+			}
+			if( len && pos < left_codepoints + chunk_codepoints ){
+				size_type count = std::min( len , left_codepoints + chunk_codepoints - pos );
+				size_type byte_index = n->chunk.get_num_bytes_from_start( pos - left_codepoints );
+				result.append( n->chunk.data() + byte_index , n->chunk.get_num_bytes( byte_index , count ) );
+				pos += count;
+				len -= count;
+			}
+			pos -= left_codepoints + chunk_codepoints;
+		}
+	}
+	
+	template<typename V, typename D, typename A>
+	const typename basic_rope<V, D, A>::node* basic_rope<V, D, A>::find_codepoint( size_type codepoint_index ) const noexcept
+	{
+		if( t_cursor.chunk && codepoint_index - t_cursor.codepoint_start < t_cursor.num_codepoints )
+			return t_cursor.chunk;
+		
+		const node*	n = t_root;
+		size_type	byte_start = 0;
+		size_type	codepoint_start = 0;
+		while( true )
+		{
+			size_type left_codepoints = get_node_codepoints( n->left );
+			if( codepoint_index < codepoint_start + left_codepoints ){
+				n = n->left;
+				continue;
+			}
+			codepoint_start += left_codepoints;
+			byte_start += get_node_bytes( n->left );
+			size_type chunk_codepoints = n->num_codepoints - left_codepoints - get_node_codepoints( n->right );
+			if( codepoint_index < codepoint_start + chunk_codepoints ){
+				t_cursor = { n , byte_start , n->chunk.size() , codepoint_start , chunk_codepoints };
+				return n;
+			}
+			codepoint_start += chunk_codepoints;
+			byte_start += n->chunk.size();
+			n = n->right;
+		}
+	}
+	
+	template<typename V, typename D, typename A>
+	const typename basic_rope<V, D, A>::node* basic_rope<V, D, A>::find_byte( size_type byte_index ) const noexcept
+	{
+		if( t_cursor.chunk && byte_index - t_cursor.byte_start < t_cursor.num_bytes )
+			return t_cursor.chunk;
+		
+		const node*	n = t_root;
+		size_type	byte_start = 0;
+		size_type	codepoint_start = 0;
+		while( true )
+		{
+			size_type left_bytes = get_node_bytes( n->left );
+			if( byte_index < byte_start + left_bytes ){
+				n = n->left;
+				continue;
+			}
+			byte_start += left_bytes;
+			codepoint_start += get_node_codepoints( n->left );
+			size_type chunk_bytes = n->chunk.size();
+			size_type chunk_codepoints = n->num_codepoints - get_node_codepoints( n->left ) - get_node_codepoints( n->right );
+			if( byte_index < byte_start + chunk_bytes ){
+				t_cursor = { n , byte_start , chunk_bytes , codepoint_start , chunk_codepoints };
+				return n;
+			}
+			byte_start += chunk_bytes;
+			codepoint_start += chunk_codepoints;
+			n = n->right;
+		}
+	}
+} // Namespace 'tiny_utf8'
+
+#endif // _TINY_UTF8_ROPE_H_
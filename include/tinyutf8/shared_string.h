@@ -0,0 +1,291 @@
+/**
+ * Copyright (c) 2015-2021 Jakob Riedle (DuffsDevice)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR 'AS IS' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TINY_UTF8_SHARED_STRING_H_
+#define _TINY_UTF8_SHARED_STRING_H_
+
+// Includes
+#include <atomic> // for std::atomic
+#include "tinyutf8.h"
+
+namespace tiny_utf8
+{
+	//! Typedef of shared_string (data type: char)
+	using shared_string = basic_shared_string<char32_t, char>;
+	
+	/**
+	 * UTF-8 string, whose copies share one immutable, reference counted buffer (copy-on-write).
+	 * Copying a basic_string copies its whole heap buffer (including the lookup table), while copying a basic_shared_string
+	 * only increments an atomic reference count. Strings fitting into the sso buffer are stored inline and copied as usual.
+	 * All const member functions (including 'data' and 'c_str') read the shared buffer, so only modifying ones detach
+	 * (i.e. copy the buffer, if it is shared with other instances).
+	 *
+	 * @note	Instances sharing a buffer may be used by different threads at once, a single instance may not.
+	 *			The reference returned by 'mutate' must not be used after the basic_shared_string was copied.
+	 */
+	template<typename ValueType, typename DataType, typename Allocator>
+	class basic_shared_string
+	{
+	public:
+		
+		typedef DataType														data_type;
+		typedef std::size_t														size_type;
+		typedef std::ptrdiff_t													difference_type;
+		typedef ValueType														value_type;
+		typedef Allocator														allocator_type;
+		typedef basic_string<ValueType, DataType, Allocator>					string_type;
+		typedef basic_string_view<ValueType, DataType>							string_view;
+		typedef typename string_type::const_iterator							const_iterator;
+		typedef typename string_type::const_reverse_iterator					const_reverse_iterator;
+		typedef typename string_type::raw_const_iterator						raw_const_iterator;
+		typedef typename string_type::raw_const_reverse_iterator				raw_const_reverse_iterator;
+		enum : size_type{														npos = (size_type)-1 };
+	
+	protected: //! Attributes
+		
+		struct shared_buffer
+		{
+			std::atomic<size_type>	refs;
+			string_type				string;
+			
+			template<typename T>
+			explicit shared_buffer( T&& str ) : refs( 1 ) , string( std::forward<T>( str ) ) {}
+		};
+		typedef typename std::allocator_traits<Allocator>::template rebind_alloc<shared_buffer>	buffer_allocator_type;
+		typedef std::allocator_traits<buffer_allocator_type>									buffer_allocator_traits;
+		
+		shared_buffer*		t_shared;	// Holds the string, if it doesn't fit into the sso buffer (nullptr otherwise)
+		string_type			t_local;	// Holds small strings (empty otherwise)
+	
+	public:
+		
+		/**
+		 * Default constructor
+		 *
+		 * @note	Creates an empty shared string
+		 */
+		basic_shared_string() noexcept(TINY_UTF8_NOEXCEPT) :
+			t_shared( nullptr )
+		{}
+		explicit basic_shared_string( const allocator_type& alloc ) noexcept(TINY_UTF8_NOEXCEPT) :
+			t_shared( nullptr )
+			, t_local( alloc )
+		{}
+		/**
+		 * Constructor taking over a basic_string
+		 *
+		 * @note	Moving a heap allocated basic_string into a basic_shared_string doesn't copy its data
+		 */
+		basic_shared_string( string_type str ) noexcept(TINY_UTF8_NOEXCEPT) :
+			t_shared( nullptr )
+			, t_local( str.get_allocator() )
+		{ assign_string( std::move( str ) ); }
+		basic_shared_string( const data_type* str , const allocator_type& alloc = allocator_type() ) noexcept(TINY_UTF8_NOEXCEPT) :
+			basic_shared_string( string_type( str , alloc ) )
+		{}
+		basic_shared_string( const value_type* str , const allocator_type& alloc = allocator_type() ) noexcept(TINY_UTF8_NOEXCEPT) :
+			basic_shared_string( string_type( str , alloc ) )
+		{}
+		explicit basic_shared_string( string_view view , const allocator_type& alloc = allocator_type() ) noexcept(TINY_UTF8_NOEXCEPT) :
+			basic_shared_string( string_type( view , alloc ) )
+		{}
+		
+		//! Copy constructor and copy assignment (share the buffer)
+		basic_shared_string( const basic_shared_string& other ) noexcept(TINY_UTF8_NOEXCEPT) :
+			t_shared( other.t_shared )
+			, t_local( other.t_local )
+		{
+			if( t_shared )
+				t_shared->refs.fetch_add( 1 , std::memory_order_relaxed );
+		}
+		basic_shared_string& operator=( const basic_shared_string& other ) noexcept(TINY_UTF8_NOEXCEPT) {
+			if( &other != this )
+				basic_shared_string( other ).swap( *this );
+			return *this;
+		}
+		
+		//! Move constructor and move assignment
+		basic_shared_string( basic_shared_string&& other ) noexcept :
+			t_shared( other.t_shared )
+			, t_local( std::move( other.t_local ) )
+		{ other.t_shared = nullptr; }
+		basic_shared_string& operator=( basic_shared_string&& other ) noexcept {
+			basic_shared_string( std::move( other ) ).swap( *this );
+			return *this;
+		}
+		
+		//! Destructor
+		~basic_shared_string() noexcept { release(); }
+		
+		//! Swaps the contents of this shared string with the supplied one
+		void swap( basic_shared_string& other ) noexcept {
+			std::swap( t_shared , other.t_shared );
+			t_local.swap( other.t_local );
+		}
+		
+		
+		/**
+		 * Returns the basic_string, that this shared string refers to
+		 */
+		inline const string_type& get() const noexcept { return t_shared ? t_shared->string : t_local; }
+		inline const string_type& operator*() const noexcept { return get(); }
+		inline const string_type* operator->() const noexcept { return &get(); }
+		inline operator const string_type&() const noexcept { return get(); }
+		inline operator string_view() const noexcept { return get(); }
+		
+		/**
+		 * Returns the number of basic_shared_strings sharing the buffer of this one (1, if it's held inline)
+		 */
+		inline size_type use_count() const noexcept { return t_shared ? t_shared->refs.load( std::memory_order_relaxed ) : 1; }
+		
+		/**
+		 * Makes sure, that the buffer of this string isn't shared and returns the string to modify it
+		 * 
+		 * @note	The data is only copied, if the buffer is shared with other instances.
+		 *			A small string, that outgrows the sso buffer through the returned reference, is moved into a shared buffer
+		 *			by the next modifier or call to 'mutate' (until then, copies of it copy its data).
+		 * @return	A reference to the (now exclusively owned) basic_string
+		 */
+		string_type& mutate() noexcept(TINY_UTF8_NOEXCEPT) {
+			share_local();
+			if( !t_shared )
+				return t_local;
+			if( t_shared->refs.load( std::memory_order_acquire ) != 1 ){
+				shared_buffer* copy = create_buffer( t_shared->string );
+				release();
+				t_shared = copy;
+			}
+			return t_shared->string;
+		}
+		
+		
+		//! Modifiers (detach from other instances and forward to the according member functions of basic_string)
+		template<typename... Args>
+		basic_shared_string& assign( Args&&... args ) noexcept(TINY_UTF8_NOEXCEPT) { mutate().assign( std::forward<Args>( args )... ); share_local(); return *this; }
+		template<typename... Args>
+		basic_shared_string& append( Args&&... args ) noexcept(TINY_UTF8_NOEXCEPT) { mutate().append( std::forward<Args>( args )... ); share_local(); return *this; }
+		template<typename... Args>
+		basic_shared_string& insert( Args&&... args ) noexcept(TINY_UTF8_NOEXCEPT) { mutate().insert( std::forward<Args>( args )... ); share_local(); return *this; }
+		template<typename... Args>
+		basic_shared_string& erase( Args&&... args ) noexcept(TINY_UTF8_NOEXCEPT) { mutate().erase( std::forward<Args>( args )... ); share_local(); return *this; }
+		template<typename... Args>
+		basic_shared_string& replace( Args&&... args ) noexcept(TINY_UTF8_NOEXCEPT) { mutate().replace( std::forward<Args>( args )... ); share_local(); return *this; }
+		template<typename T>
+		basic_shared_string& operator+=( T&& str ) noexcept(TINY_UTF8_NOEXCEPT) { mutate() += std::forward<T>( str ); share_local(); return *this; }
+		basic_shared_string& push_back( value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) { mutate().push_back( cp ); share_local(); return *this; }
+		void clear() noexcept(TINY_UTF8_NOEXCEPT) { basic_shared_string( get_allocator() ).swap( *this ); }
+		
+		
+		//! Accessors (read the shared buffer)
+		inline const data_type* data() const noexcept { return get().data(); }
+		inline const data_type* c_str() const noexcept { return get().c_str(); }
+		inline size_type size() const noexcept { return get().size(); }
+		inline size_type length() const noexcept { return get().length(); }
+		inline bool empty() const noexcept { return get().empty(); }
+		inline allocator_type get_allocator() const noexcept(TINY_UTF8_NOEXCEPT && std::is_nothrow_copy_constructible<Allocator>()) { return get().get_allocator(); }
+		inline value_type operator[]( size_type n ) const noexcept { return get()[n]; }
+		inline value_type at( size_type n ) const noexcept(TINY_UTF8_NOEXCEPT) { return get().at( n ); }
+		inline value_type front() const noexcept { return get().front(); }
+		inline value_type back() const noexcept { return get().back(); }
+		inline string_type substr( size_type pos , size_type len = string_type::npos ) const noexcept(TINY_UTF8_NOEXCEPT) { return get().substr( pos , len ); }
+		inline std::basic_string<data_type> cpp_str( bool prepend_bom = false ) const noexcept(TINY_UTF8_NOEXCEPT) { return get().cpp_str( prepend_bom ); }
+		template<typename... Args>
+		inline size_type find( Args&&... args ) const noexcept { return get().find( std::forward<Args>( args )... ); }
+		template<typename... Args>
+		inline size_type rfind( Args&&... args ) const noexcept { return get().rfind( std::forward<Args>( args )... ); }
+		
+		//! Iterators
+		inline const_iterator begin() const noexcept { return get().begin(); }
+		inline const_iterator end() const noexcept { return get().end(); }
+		inline const_iterator cbegin() const noexcept { return get().cbegin(); }
+		inline const_iterator cend() const noexcept { return get().cend(); }
+		inline const_reverse_iterator rbegin() const noexcept { return get().rbegin(); }
+		inline const_reverse_iterator rend() const noexcept { return get().rend(); }
+		inline raw_const_iterator raw_begin() const noexcept { return get().raw_begin(); }
+		inline raw_const_iterator raw_end() const noexcept { return get().raw_end(); }
+		
+		//! Comparison
+		inline int compare( const basic_shared_string& other ) const noexcept { return t_shared && t_shared == other.t_shared ? 0 : get().compare( other.get() ); }
+		template<typename T>
+		inline int compare( const T& str ) const noexcept { return get().compare( str ); }
+		inline bool operator==( const basic_shared_string& other ) const noexcept { return compare( other ) == 0; }
+		inline bool operator!=( const basic_shared_string& other ) const noexcept { return compare( other ) != 0; }
+		inline bool operator<( const basic_shared_string& other ) const noexcept { return compare( other ) < 0; }
+		template<typename T>
+		inline bool operator==( const T& str ) const noexcept { return get() == str; }
+		template<typename T>
+		inline bool operator!=( const T& str ) const noexcept { return get() != str; }
+	
+	protected: //! Helpers
+		
+		//! Stores the supplied string inline, or moves it into a new shared buffer
+		void assign_string( string_type&& str ) noexcept(TINY_UTF8_NOEXCEPT) {
+			if( str.sso_active() )
+				t_local = std::move( str );
+			else
+				t_shared = create_buffer( std::move( str ) );
+		}
+		
+		//! Moves the inline string into a new shared buffer, once it outgrew the sso buffer (so copies share it from then on)
+		void share_local() noexcept(TINY_UTF8_NOEXCEPT) {
+			if( !t_shared && !t_local.sso_active() )
+				t_shared = create_buffer( std::move( t_local ) );
+		}
+		
+		template<typename T>
+		shared_buffer* create_buffer( T&& str ) noexcept(TINY_UTF8_NOEXCEPT) {
+			buffer_allocator_type alloc( str.get_allocator() );
+			shared_buffer* buffer = buffer_allocator_traits::allocate( alloc , 1 );
+			buffer_allocator_traits::construct( alloc , buffer , std::forward<T>( str ) );
+			return buffer;
+		}
+		
+		//! Drops the reference to the shared buffer (and destroys it, if it was the last one)
+		void release() noexcept {
+			if( t_shared && t_shared->refs.fetch_sub( 1 , std::memory_order_acq_rel ) == 1 ){
+				buffer_allocator_type alloc( t_shared->string.get_allocator() );
+				buffer_allocator_traits::destroy( alloc , t_shared );
+				buffer_allocator_traits::deallocate( alloc , t_shared , 1 );
+			}
+			t_shared = nullptr;
+		}
+	};
+} // Namespace 'tiny_utf8'
+
+namespace std
+{
+	template<typename V, typename D, typename A>
+	struct hash<tiny_utf8::basic_shared_string<V, D, A> >
+	{
+		//! Yields the same value as hashing the basic_string, that is shared
+		std::size_t operator()( const tiny_utf8::basic_shared_string<V, D, A>& string ) const noexcept {
+			return hash<tiny_utf8::basic_string<V, D, A> >()( string.get() );
+		}
+	};
+}
+
+#endif // _TINY_UTF8_SHARED_STRING_H_
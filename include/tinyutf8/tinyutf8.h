@@ -39,9 +39,44 @@
 #include <cstddef> // for std::size_t and offsetof
 #include <cstdint> // for std::uint8_t, std::uint16_t, std::uint32_t, std::uint_least16_t, std::uint_fast32_t
 #include <initializer_list> // for std::initializer_list
+#include <iterator> // for std::iterator_traits, std::distance
+#include <utility> // for std::pair
 #include <iosfwd> // for std::ostream and std::istream forward declarations
+#include <streambuf> // for std::streambuf (used by 'basic_line_reader')
+#if !defined(TINY_UTF8_NO_THREADS)
+#include <thread> // for std::thread (used by 'basic_string::from_bytes_parallel', #define TINY_UTF8_NO_THREADS to omit it)
+#endif
+#if defined(TINY_UTF8_LAZY_LUT)
+#include <atomic> // for std::atomic (used to publish luts built on first use, see 'basic_string::build_deferred_lut')
+#endif
 #ifdef _MSC_VER
-#include <intrin.h> // for _BitScanReverse, _BitScanReverse64
+#include <intrin.h> // for _BitScanReverse, _BitScanReverse64, _BitScanForward, _BitScanForward64
+#endif
+
+//! Determine the available SIMD instruction sets (#define TINY_UTF8_NO_SIMD to always use the scalar code paths)
+#if !defined(TINY_UTF8_NO_SIMD) && defined(__AVX2__)
+	#include <immintrin.h> // for _mm256_loadu_si256, _mm256_movemask_epi8
+	#define TINY_UTF8_HAS_AVX2 true
+#else
+	#define TINY_UTF8_HAS_AVX2 false
+#endif
+#if !defined(TINY_UTF8_NO_SIMD) && ( defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 ) )
+	#include <emmintrin.h> // for _mm_loadu_si128, _mm_movemask_epi8
+	#define TINY_UTF8_HAS_SSE2 true
+#else
+	#define TINY_UTF8_HAS_SSE2 false
+#endif
+#if !defined(TINY_UTF8_NO_SIMD) && ( defined(__SSSE3__) || defined(__AVX2__) )
+	#include <tmmintrin.h> // for _mm_shuffle_epi8
+	#define TINY_UTF8_HAS_SSSE3 true
+#else
+	#define TINY_UTF8_HAS_SSSE3 false
+#endif
+#if !defined(TINY_UTF8_NO_SIMD) && ( defined(__ARM_NEON) || defined(__ARM_NEON__) ) && defined(__aarch64__)
+	#include <arm_neon.h> // for vld1q_u8, vmaxvq_u8
+	#define TINY_UTF8_HAS_NEON true
+#else
+	#define TINY_UTF8_HAS_NEON false
 #endif
 
 //! Determine the mode of error handling
@@ -94,6 +129,20 @@
 	#define TINY_UTF8_CPP17( ... )
 #endif
 
+//! Create macro that yields 'constexpr', if C++14 or later is present (used for functions containing loops)
+#if TINY_UTF8_CPLUSPLUS >= 201402L
+	#define TINY_UTF8_CPP14_CONSTEXPR constexpr
+#else
+	#define TINY_UTF8_CPP14_CONSTEXPR
+#endif
+
+//! Include polymorphic allocators, if available (used for the pmr typedefs)
+#if TINY_UTF8_CPLUSPLUS >= 201703L && defined(__has_include)
+	#if __has_include(<memory_resource>)
+		#include <memory_resource> // for std::pmr::polymorphic_allocator
+	#endif
+#endif
+
 //! Determine noexcept specifications
 #if defined(TINY_UTF8_NOEXCEPT)
 	#undef TINY_UTF8_NOEXCEPT
@@ -104,6 +153,13 @@
 	#define TINY_UTF8_NOEXCEPT false
 #endif
 
+//! Determine, whether to count hot path events per thread (see tiny_utf8::statistics)
+#if defined(TINY_UTF8_STATS)
+	#define TINY_UTF8_STAT( counter ) void( ++tiny_utf8::tiny_utf8_detail::thread_statistics().counter )
+#else
+	#define TINY_UTF8_STAT( counter ) void()
+#endif
+
 //! Want global declarations?
 #ifdef TINY_UTF8_GLOBAL_NAMESPACE
 inline
@@ -116,9 +172,71 @@ namespace tiny_utf8
 		typename ValueType = char32_t
 		, typename DataType = char
 		, typename Allocator = std::allocator<DataType>
+		, std::size_t SSOCapacity = sizeof(void*) + 3 * sizeof(std::size_t) - 1 // As many bytes as fit into the heap layout (31 on 64 bit)
 	>
 	class basic_string;
 	
+	template<
+		typename ValueType = char32_t
+		, typename DataType = char
+	>
+	class basic_string_view;
+	
+	template<
+		typename ValueType = char32_t
+		, typename DataType = char
+	>
+	class basic_split_range;
+	
+	template<
+		typename ValueType = char32_t
+		, typename DataType = char
+		, typename Allocator = std::allocator<DataType>
+		, std::size_t SSOCapacity = sizeof(void*) + 3 * sizeof(std::size_t) - 1 // The default of basic_string
+	>
+	class basic_string_builder;
+	
+	template<
+		typename ValueType = char32_t
+		, typename DataType = char
+		, typename Allocator = std::allocator<DataType>
+		, std::size_t SSOCapacity = sizeof(void*) + 3 * sizeof(std::size_t) - 1 // The default of basic_string
+	>
+	class basic_stream_decoder;
+	
+	template<
+		typename ValueType = char32_t
+		, typename DataType = char
+		, typename Allocator = std::allocator<DataType>
+		, std::size_t SSOCapacity = sizeof(void*) + 3 * sizeof(std::size_t) - 1 // The default of basic_string
+	>
+	class basic_line_reader;
+	
+	template<
+		typename ValueType = char32_t
+		, typename DataType = char
+	>
+	class basic_mapped_string; // Defined in <tinyutf8/mapped_string.h>
+	
+	template<
+		typename ValueType = char32_t
+		, typename DataType = char
+		, typename Allocator = std::allocator<DataType>
+	>
+	class basic_rope; // Defined in <tinyutf8/rope.h>
+	
+	template<
+		typename ValueType = char32_t
+		, typename DataType = char
+		, typename Allocator = std::allocator<DataType>
+	>
+	class basic_shared_string; // Defined in <tinyutf8/shared_string.h>
+	
+	template<
+		typename DataType = char
+	>
+	class basic_string_literal;
+	
 	//! Typedef of string (data type: char)
 	using string = basic_string<char32_t, char>;
 	using utf8_string = basic_string<char32_t, char>; // For backwards compatibility
@@ -130,6 +248,84 @@ namespace tiny_utf8
 		using u8string = utf8_string;
 	#endif
 	
+	//! Typedef of string_view (data type: char) and u8string_view (data type char8_t)
+	using string_view = basic_string_view<char32_t, char>;
+	#if defined(__cpp_char8_t)
+		using u8string_view = basic_string_view<char32_t, char8_t>;
+	#else
+		using u8string_view = string_view;
+	#endif
+	
+	//! Typedef of split_range (data type: char)
+	using split_range = basic_split_range<char32_t, char>;
+	
+	//! Typedef of string_builder (data type: char)
+	using string_builder = basic_string_builder<char32_t, char>;
+	
+	//! Typedefs of stream_decoder and line_reader (data type: char)
+	using stream_decoder = basic_stream_decoder<char32_t, char>;
+	using line_reader = basic_line_reader<char32_t, char>;
+	
+	//! Typedef of string_literal (data type: char) and u8string_literal (data type char8_t)
+	using string_literal = basic_string_literal<char>;
+	#if defined(__cpp_char8_t)
+		using u8string_literal = basic_string_literal<char8_t>;
+	#else
+		using u8string_literal = string_literal;
+	#endif
+	
+	//! Tag type selecting the validating constructors of basic_string (see 'basic_string::trusted')
+	struct validate_utf8_t{ explicit constexpr validate_utf8_t() noexcept {} };
+	static constexpr validate_utf8_t validate_utf8{};
+	
+	//! Typedefs of strings that obtain their memory from a std::pmr::memory_resource
+	#if defined(__cpp_lib_memory_resource)
+		namespace pmr
+		{
+			template<
+				typename ValueType = char32_t
+				, typename DataType = char
+			>
+			using basic_string = tiny_utf8::basic_string<ValueType, DataType, std::pmr::polymorphic_allocator<DataType>>;
+			using string = basic_string<char32_t, char>;
+			#if defined(__cpp_char8_t)
+				using u8string = basic_string<char32_t, char8_t>;
+			#else
+				using u8string = string;
+			#endif
+		}
+	#endif
+	
+	#if defined(TINY_UTF8_STATS)
+		//! Counters of hot path events of all basic_strings used by one thread (only available with TINY_UTF8_STATS)
+		struct statistics
+		{
+			std::size_t	allocations = 0;		// Heap buffers allocated
+			std::size_t	deallocations = 0;		// Heap buffers deallocated
+			std::size_t	reallocations = 0;		// Heap buffers replaced by a bigger (growth) or smaller one (shrink_to_fit)
+			std::size_t	lut_builds = 0;			// Luts built by decoding the data (as opposed to copying or updating an existing one)
+			std::size_t	lut_drops = 0;			// Heap buffers set up without a lut, although they contain multibytes (see 'is_lut_worth')
+			std::size_t	lut_width_changes = 0;	// Luts copied into a buffer with a different lut width, i.e. one entry at a time
+			std::size_t	linear_scans = 0;		// Index translations (e.g. 'get_num_bytes_from_start') on heap buffers without a lut
+			std::size_t	sso_to_heap = 0;		// Strings that outgrew the SSO buffer
+			std::size_t	heap_to_sso = 0;		// Strings that moved back into the SSO buffer
+		};
+		
+		namespace tiny_utf8_detail
+		{
+			inline statistics& thread_statistics() noexcept {
+				static thread_local statistics stats;
+				return stats;
+			}
+		}
+		
+		//! Get a snapshot of the counters of the calling thread
+		inline statistics get_statistics() noexcept { return tiny_utf8_detail::thread_statistics(); }
+		
+		//! Reset all counters of the calling thread to zero
+		inline void reset_statistics() noexcept { tiny_utf8_detail::thread_statistics() = statistics(); }
+	#endif
+	
 	//! Implementation Detail
 	namespace tiny_utf8_detail
 	{
@@ -137,6 +333,58 @@ namespace tiny_utf8
 		struct read_codepoints_tag{};
 		struct read_bytes_tag{};
 		
+		//! Determines, whether all instances of an allocator compare equal (std::allocator_traits<A>::is_always_equal is C++17)
+		template<typename Allocator, typename = void>
+		struct allocator_is_always_equal : std::is_empty<Allocator>{};
+		template<typename Allocator>
+		struct allocator_is_always_equal<Allocator, decltype(void(Allocator::is_always_equal::value))>
+			: std::integral_constant<bool, Allocator::is_always_equal::value>
+		{};
+		
+		#if !defined(TINY_UTF8_NO_THREADS)
+			//! Runs 'task( i )' for each 'i' in [0, num_tasks) on its own std::thread (the first one on the calling thread) and waits for all of them
+			struct thread_parallel_for
+			{
+				template<typename Task>
+				void operator()( std::size_t num_tasks , const Task& task ) const noexcept(TINY_UTF8_NOEXCEPT) {
+					std::unique_ptr<std::thread[]>	threads( new std::thread[num_tasks] );
+					std::size_t						num_spawned = 1;
+				#if defined(__cpp_exceptions)
+					try{
+						for( ; num_spawned < num_tasks ; ++num_spawned )
+							threads[num_spawned] = std::thread( [&task,num_spawned]{ task( num_spawned ); } );
+					}
+					catch( ... ){} // Run the remaining tasks on the calling thread, if no more threads can be started
+				#else
+					for( ; num_spawned < num_tasks ; ++num_spawned )
+						threads[num_spawned] = std::thread( [&task,num_spawned]{ task( num_spawned ); } );
+				#endif
+					task( 0 );
+					for( std::size_t i = num_spawned ; i < num_tasks ; ++i )
+						task( i );
+					for( std::size_t i = 1 ; i < num_spawned ; ++i )
+						threads[i].join();
+				}
+			};
+		#endif
+		
+		//! Determines the number of bytes of a codepoint exactly like 'basic_string::get_codepoint_bytes' with unlimited data left (usable at compile time)
+		static constexpr inline unsigned int literal_codepoint_bytes( unsigned char first_byte , unsigned int num_ones = 0 ) noexcept {
+			return num_ones < 8 && ( ( first_byte << num_ones ) & 0x80 ) ? literal_codepoint_bytes( first_byte , num_ones + 1 ) : num_ones ? num_ones : 1;
+		}
+		
+		//! Counts either all codepoints or only the multibytes of a literal exactly like 'basic_string::count_multibytes' (usable at compile time with C++14)
+		template<typename T>
+		static TINY_UTF8_CPP14_CONSTEXPR inline std::size_t count_literal_codepoints( const T* str , std::size_t data_len , bool multibytes_only ) noexcept {
+			std::size_t result = 0;
+			for( std::size_t index = 0 ; index < data_len ; ){
+				unsigned int bytes = literal_codepoint_bytes( (unsigned char)str[index] );
+				index += bytes;
+				result += !multibytes_only || bytes > 1 ? 1 : 0;
+			}
+			return result;
+		}
+		
 		//! Count leading zeros utility
 		#if defined(__GNUC__)
 			#define TINY_UTF8_HAS_CLZ true
@@ -166,6 +414,70 @@ namespace tiny_utf8
 		#else
 			#define TINY_UTF8_HAS_CLZ false
 		#endif
+		
+		//! Count trailing zeros utility (the supplied value must not be zero)
+		#if defined(__GNUC__)
+			static inline unsigned int ctz( unsigned int value ) noexcept { return (unsigned int)__builtin_ctz( value ); }
+		#elif defined(_MSC_VER)
+			static inline unsigned int ctz( unsigned int value ) noexcept { unsigned long index; _BitScanForward( &index , value ); return index; }
+		#else
+			static inline unsigned int ctz( unsigned int value ) noexcept { unsigned int result = 0; while( !( value & 0x1 ) ) value >>= 1, ++result; return result; }
+		#endif
+		
+		//! Population count utility (the builtin is only used, if it maps to a single instruction)
+		#if defined(__GNUC__) && ( defined(__POPCNT__) || defined(__aarch64__) )
+			static inline unsigned int popcount( unsigned int value ) noexcept { return (unsigned int)__builtin_popcount( value ); }
+		#else
+			static inline unsigned int popcount( unsigned int value ) noexcept {
+				value = value - ( ( value >> 1 ) & 0x55555555u );
+				value = ( value & 0x33333333u ) + ( ( value >> 2 ) & 0x33333333u );
+				return ( ( ( value + ( value >> 4 ) ) & 0x0F0F0F0Fu ) * 0x01010101u ) >> 24;
+			}
+		#endif
+		
+		//! Adds 'delta' to each of the 'n' supplied values (kept as a plain loop over a fixed width type, so it gets vectorized)
+		template<typename T>
+		static inline void add_to_all( T* values , std::size_t n , std::uint64_t delta ) noexcept {
+			const T d = (T)delta;
+			for( std::size_t i = 0 ; i < n ; ++i )
+				values[i] = (T)( values[i] + d );
+		}
+		
+		/**
+		 * Returns the number of leading bytes within the supplied range that are ASCII, i.e. have their MSB cleared.
+		 * ASCII runs are skipped 32 (AVX2), 16 (SSE2/NEON) or 8 (SWAR) bytes at a time.
+		 */
+		static inline std::size_t ascii_prefix_len( const unsigned char* data , std::size_t len ) noexcept
+		{
+			std::size_t i = 0;
+			#if TINY_UTF8_HAS_AVX2
+				for( ; i + 32 <= len ; i += 32 ){
+					unsigned int mask = (unsigned int)_mm256_movemask_epi8( _mm256_loadu_si256( (const __m256i*)( data + i ) ) );
+					if( mask )
+						return i + ctz( mask );
+				}
+			#endif
+			#if TINY_UTF8_HAS_SSE2
+				for( ; i + 16 <= len ; i += 16 ){
+					unsigned int mask = (unsigned int)_mm_movemask_epi8( _mm_loadu_si128( (const __m128i*)( data + i ) ) );
+					if( mask & 0xFFFF )
+						return i + ctz( mask );
+				}
+			#elif TINY_UTF8_HAS_NEON
+				for( ; i + 16 <= len ; i += 16 )
+					if( vmaxvq_u8( vld1q_u8( data + i ) ) & 0x80 )
+						break; // The exact position is determined below
+			#endif
+			// Check 8 bytes at once (SWAR), the exact position is determined byte-wise
+			for( std::uint64_t word ; i + 8 <= len ; i += 8 ){
+				std::memcpy( &word , data + i , 8 );
+				if( word & 0x8080808080808080uLL )
+					break;
+			}
+			while( i < len && !( data[i] & 0x80 ) )
+				++i;
+			return i;
+		}
 
 		
 		//! Helper to detect little endian
@@ -196,93 +508,881 @@ namespace tiny_utf8
 			} bytes;
 		};
 
-		//! strlen for different character types
-		template<typename T>
-		inline std::size_t strlen( const T* str ){ std::size_t len = 0u; while( *str++ ) ++len; return len; }
-		template<> inline std::size_t strlen<char>( const char* str ){ return std::strlen( str ); }
-	}
-
-
-	template<typename Container, bool RangeCheck>
-	struct codepoint_reference
-	{
-		typename Container::size_type	t_index;
-		Container*						t_instance;
-		
-	public:
-		
-		//! Ctor
-		codepoint_reference( typename Container::size_type index , Container* instance ) noexcept :
-			t_index( index )
-			, t_instance( instance )
-		{}
+		//! Bit masks describing the bytes of a 16 byte block (bit 'i' refers to byte 'i')
+		struct utf8_block_masks
+		{
+			unsigned int	continuation;	// 10xxxxxx
+			unsigned int	lead2;			// 11xxxxxx
+			unsigned int	lead3;			// 111xxxxx
+			unsigned int	lead4;			// 1111xxxx
+			unsigned int	lead5;			// 11111xxx
+		};
 		
-		//! Cast to wide char
-		operator typename Container::value_type() const noexcept( TINY_UTF8_NOEXCEPT || RangeCheck == false ) {
-			if TINY_UTF8_CPP17(constexpr) ( RangeCheck )
-				return static_cast<const Container*>(t_instance)->at( t_index );
-			else
-				return static_cast<const Container*>(t_instance)->at( t_index , std::nothrow );
+		//! Collect the MSB of each byte into an 8 bit mask (bit 'i' refers to the byte at address offset 'i')
+		static inline unsigned int msb_mask( std::uint64_t word ) noexcept {
+			unsigned int mask = (unsigned int)( ( ( word & 0x8080808080808080uLL ) * 0x0002040810204081uLL ) >> 56 );
+			if( !is_little_endian::value ){ // Reverse the bit order
+				mask = ( ( mask & 0xF0u ) >> 4 ) | ( ( mask & 0x0Fu ) << 4 );
+				mask = ( ( mask & 0xCCu ) >> 2 ) | ( ( mask & 0x33u ) << 2 );
+				mask = ( ( mask & 0xAAu ) >> 1 ) | ( ( mask & 0x55u ) << 1 );
+			}
+			return mask;
 		}
 		
-		//! Dereference operator to act as pointer type
-		codepoint_reference& operator*() const noexcept { return *this; }
-		
-		//! Assignment operator
-		codepoint_reference& operator=( typename Container::value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) {
-			t_instance->replace( t_index , cp );
-			return *this;
+		//! Classify the 16 bytes of a block
+		static inline utf8_block_masks get_utf8_block_masks( const unsigned char* data ) noexcept
+		{
+			utf8_block_masks result;
+			#if TINY_UTF8_HAS_SSE2
+				__m128i			block = _mm_loadu_si128( (const __m128i*)data );
+				unsigned int	msb = (unsigned int)_mm_movemask_epi8( block );
+				if( !msb ){ // ASCII only
+					result.continuation = result.lead2 = result.lead3 = result.lead4 = result.lead5 = 0;
+					return result;
+				}
+				// 'max( block , threshold ) == block' <=> 'block >= threshold' (unsigned)
+				result.lead2		= (unsigned int)_mm_movemask_epi8( _mm_cmpeq_epi8( _mm_max_epu8( block , _mm_set1_epi8( (char)0xC0 ) ) , block ) );
+				result.lead3		= (unsigned int)_mm_movemask_epi8( _mm_cmpeq_epi8( _mm_max_epu8( block , _mm_set1_epi8( (char)0xE0 ) ) , block ) );
+				result.lead4		= (unsigned int)_mm_movemask_epi8( _mm_cmpeq_epi8( _mm_max_epu8( block , _mm_set1_epi8( (char)0xF0 ) ) , block ) );
+				result.lead5		= (unsigned int)_mm_movemask_epi8( _mm_cmpeq_epi8( _mm_max_epu8( block , _mm_set1_epi8( (char)0xF8 ) ) , block ) );
+				result.continuation	= msb & ~result.lead2;
+			#else
+				// Word at a time (SWAR): Shifting a word left by 'n' moves bit '7-n' of each byte into its MSB
+				std::uint64_t	words[2];
+				std::memcpy( words , data , 16 );
+				result.continuation = result.lead2 = result.lead3 = result.lead4 = result.lead5 = 0;
+				for( int i = 0 ; i < 2 ; ++i ){
+					std::uint64_t	word = words[i];
+					std::uint64_t	lead2 = word & ( word << 1 );
+					std::uint64_t	lead3 = lead2 & ( word << 2 );
+					std::uint64_t	lead4 = lead3 & ( word << 3 );
+					result.continuation	|= msb_mask( word & ~( word << 1 ) ) << ( i * 8 );
+					result.lead2		|= msb_mask( lead2 ) << ( i * 8 );
+					result.lead3		|= msb_mask( lead3 ) << ( i * 8 );
+					result.lead4		|= msb_mask( lead4 ) << ( i * 8 );
+					result.lead5		|= msb_mask( lead4 & ( word << 4 ) ) << ( i * 8 );
+				}
+			#endif
+			return result;
 		}
-		codepoint_reference& operator=( const codepoint_reference& ref ) noexcept(TINY_UTF8_NOEXCEPT) { return *this = (typename Container::value_type)ref; }
-	};
-
-	template<typename Container, bool RangeCheck>
-	struct raw_codepoint_reference
-	{
-		typename Container::size_type	t_index;
-		Container*						t_instance;
-		
-	public:
 		
-		//! Ctors
-		raw_codepoint_reference( typename Container::size_type raw_index , Container* instance ) noexcept :
-			t_index( raw_index )
-			, t_instance( instance )
-		{}
-		template<bool RC>
-		explicit raw_codepoint_reference( const codepoint_reference<Container, RC>& reference ) noexcept :
-			t_index( reference.t_instance->get_num_bytes_from_start( reference.t_index ) )
-			, t_instance( reference.t_instance )
-		{}
+		/**
+		 * Counts the codepoints at the start of the supplied range 16 bytes at a time, as long as the data is well-formed,
+		 * i.e. each lead byte of up to 4 bytes is followed by exactly the number of continuation bytes it announces.
+		 * Within well-formed data, every byte that is not a continuation byte starts a codepoint.
+		 * Counting stops at the first block that is malformed, contains codepoints truncated by the end of the range or could exceed 'max_codepoints'.
+		 * The caller is supposed to continue with the byte-wise procedure, which yields the same results for malformed data as before.
+		 * 
+		 * @param	num_codepoints	[out] The number of codepoints starting within the processed range
+		 * @return	The number of bytes processed (which is the byte index of the next codepoint)
+		 */
+		static inline std::size_t count_codepoints( const unsigned char* data , std::size_t len , std::size_t max_codepoints , std::size_t& num_codepoints ) noexcept
+		{
+			std::size_t		i = 0;
+			unsigned int	carry = 0; // Continuation bytes expected at the start of the next block
+			num_codepoints = 0;
+			
+			for( std::size_t left ; i < len && num_codepoints + 16 <= max_codepoints ; i += 16 )
+			{
+				utf8_block_masks masks;
+				unsigned int expected = carry;
+				
+				if( ( left = len - i ) >= 16 )
+					masks = get_utf8_block_masks( data + i );
+				else if( len >= 16 ){ // Final block: Classify the last 16 bytes of the range and drop the ones already processed
+					masks = get_utf8_block_masks( data + len - 16 );
+					masks.continuation >>= 16 - left;
+					masks.lead2 >>= 16 - left;
+					masks.lead3 >>= 16 - left;
+					masks.lead4 >>= 16 - left;
+					masks.lead5 >>= 16 - left;
+				}
+				else{ // Final block of a short range: Zero-pad the data (zeros are plain ASCII)
+					unsigned char block[16] = {};
+					for( std::size_t j = 0 ; j < left ; ++j )
+						block[j] = data[i + j];
+					masks = get_utf8_block_masks( block );
+				}
+				
+				// Compute the positions, at which we expect continuation bytes
+				expected |= ( masks.lead2 << 1 ) | ( masks.lead3 << 2 ) | ( masks.lead4 << 3 );
+				if( masks.lead5 || ( expected & 0xFFFFu ) != masks.continuation )
+					break;
+				
+				// Codepoints truncated by the end of the range are only 1 byte wide, which the byte-wise procedure has to handle
+				if( left < 16 + 3 && ( expected >> left ) )
+					break;
+				
+				carry = expected >> 16;
+				num_codepoints += ( left < 16 ? left : 16 ) - popcount( masks.continuation );
+			}
+			
+			// Skip the continuation bytes of the last codepoint (note, that its width only depends on its lead byte)
+			return std::min( i , len ) + popcount( carry );
+		}
 		
-		//! Cast to wide char
-		operator typename Container::value_type() const noexcept( TINY_UTF8_NOEXCEPT || RangeCheck == false ) {
-			if TINY_UTF8_CPP17(constexpr) ( RangeCheck )
-				return static_cast<const Container*>(t_instance)->raw_at( t_index );
-			else
-				return static_cast<const Container*>(t_instance)->raw_at( t_index , std::nothrow );
+		/**
+		 * Same as 'count_codepoints', but for data that is known to be valid UTF-8 (see 'validate_and_count').
+		 * Since every byte, that is not a continuation byte, starts a codepoint, there is nothing to check and counting only stops at 'max_codepoints'.
+		 * 
+		 * @param	num_codepoints	[out] The number of codepoints starting within the processed range (at most 'max_codepoints')
+		 * @return	The number of bytes processed (which is the byte index of the next codepoint)
+		 */
+		static inline std::size_t count_valid_codepoints( const unsigned char* data , std::size_t len , std::size_t max_codepoints , std::size_t& num_codepoints ) noexcept
+		{
+			std::size_t i = 0;
+			num_codepoints = 0;
+			#if TINY_UTF8_HAS_SSE2
+				for( ; i + 16 <= len ; i += 16 ){
+					// '10xxxxxx' are the only bytes, that are less than '0xC0' as signed value
+					unsigned int	starts = ~(unsigned int)_mm_movemask_epi8( _mm_cmplt_epi8( _mm_loadu_si128( (const __m128i*)( data + i ) ) , _mm_set1_epi8( -64 ) ) ) & 0xFFFFu;
+					std::size_t		num_starts = popcount( starts );
+					if( num_codepoints + num_starts > max_codepoints ){ // The codepoint following the last one to count starts within this block
+						for( std::size_t n = max_codepoints - num_codepoints ; n ; --n )
+							starts &= starts - 1;
+						num_codepoints = max_codepoints;
+						return i + ctz( starts );
+					}
+					num_codepoints += num_starts;
+				}
+			#else
+				for( std::uint64_t word ; i + 8 <= len ; i += 8 ){
+					std::memcpy( &word , data + i , 8 );
+					unsigned int	starts = ~msb_mask( word & ~( word << 1 ) ) & 0xFFu;
+					std::size_t		num_starts = popcount( starts );
+					if( num_codepoints + num_starts > max_codepoints )
+						break; // The exact position is determined below
+					num_codepoints += num_starts;
+				}
+			#endif
+			for( ; i < len ; ++i )
+				if( ( data[i] & 0xC0 ) != 0x80 ){
+					if( num_codepoints == max_codepoints )
+						return i;
+					++num_codepoints;
+				}
+			return len;
 		}
 		
-		//! Dereference operator to act as pointer type
-		raw_codepoint_reference& operator*() const noexcept { return *this; }
+		//! Counts the continuation bytes of the supplied range
+		static inline std::size_t count_continuation_bytes( const unsigned char* data , std::size_t len ) noexcept
+		{
+			std::size_t i = 0 , result = 0;
+			#if TINY_UTF8_HAS_SSE2
+				for( ; i + 16 <= len ; i += 16 )
+					result += popcount( (unsigned int)_mm_movemask_epi8( _mm_cmplt_epi8( _mm_loadu_si128( (const __m128i*)( data + i ) ) , _mm_set1_epi8( -64 ) ) ) );
+			#endif
+			for( std::uint64_t word ; i + 8 <= len ; i += 8 ){
+				std::memcpy( &word , data + i , 8 );
+				result += popcount( msb_mask( word & ~( word << 1 ) ) );
+			}
+			for( ; i < len ; ++i )
+				result += ( data[i] & 0xC0 ) == 0x80 ? 1 : 0;
+			return result;
+		}
 		
-		//! Cast to normal (non-raw) codepoint reference
-		template<bool RC>
-		explicit operator codepoint_reference<Container, RC>() const noexcept { return { t_instance->get_num_codepoints( 0 , t_index ) , t_instance }; }
+		#if TINY_UTF8_HAS_SSE2
+			//! Unsigned 'value >= threshold' for each byte
+			static inline __m128i greater_equal_epu8( __m128i value , char threshold ) noexcept {
+				return _mm_cmpeq_epi8( _mm_max_epu8( value , _mm_set1_epi8( threshold ) ) , value );
+			}
+			
+			/**
+			 * Checks each byte of a block against the (up to 3) bytes before it, the last ones of which are taken from the previous block.
+			 * Returns a non-zero byte for each byte, that violates RFC 3629 (as continuation byte or lead byte), except for truncation at the end.
+			 */
+			static inline __m128i get_utf8_block_errors( __m128i block , __m128i prev_block ) noexcept
+			{
+				__m128i	prev1 = _mm_or_si128( _mm_slli_si128( block , 1 ) , _mm_srli_si128( prev_block , 15 ) );
+				__m128i	prev2 = _mm_or_si128( _mm_slli_si128( block , 2 ) , _mm_srli_si128( prev_block , 14 ) );
+				__m128i	prev3 = _mm_or_si128( _mm_slli_si128( block , 3 ) , _mm_srli_si128( prev_block , 13 ) );
+				
+				// Exactly the bytes announced by the lead bytes before them have to be continuation bytes
+				__m128i	continuation = _mm_cmplt_epi8( block , _mm_set1_epi8( -64 ) );
+				__m128i	expected = _mm_or_si128(
+					_mm_or_si128( greater_equal_epu8( prev1 , (char)0xC0 ) , greater_equal_epu8( prev2 , (char)0xE0 ) )
+					, greater_equal_epu8( prev3 , (char)0xF0 )
+				);
+				__m128i	errors = _mm_xor_si128( continuation , expected );
+				
+				// Lead bytes of overlong 2 byte sequences (0xC0, 0xC1) and of sequences exceeding U+10FFFF (0xF5 and above)
+				errors = _mm_or_si128( errors , _mm_cmpeq_epi8( _mm_and_si128( block , _mm_set1_epi8( (char)0xFE ) ) , _mm_set1_epi8( (char)0xC0 ) ) );
+				errors = _mm_or_si128( errors , greater_equal_epu8( block , (char)0xF5 ) );
+				
+				// Second bytes restricted by their lead byte: overlong (0xE0, 0xF0), surrogates (0xED) and too large (0xF4)
+				__m128i	below_a0 = _mm_cmpeq_epi8( _mm_min_epu8( block , _mm_set1_epi8( (char)0x9F ) ) , block );
+				__m128i	below_90 = _mm_cmpeq_epi8( _mm_min_epu8( block , _mm_set1_epi8( (char)0x8F ) ) , block );
+				errors = _mm_or_si128( errors , _mm_and_si128( _mm_cmpeq_epi8( prev1 , _mm_set1_epi8( (char)0xE0 ) ) , below_a0 ) );
+				errors = _mm_or_si128( errors , _mm_andnot_si128( below_a0 , _mm_cmpeq_epi8( prev1 , _mm_set1_epi8( (char)0xED ) ) ) );
+				errors = _mm_or_si128( errors , _mm_and_si128( _mm_cmpeq_epi8( prev1 , _mm_set1_epi8( (char)0xF0 ) ) , below_90 ) );
+				errors = _mm_or_si128( errors , _mm_andnot_si128( below_90 , _mm_cmpeq_epi8( prev1 , _mm_set1_epi8( (char)0xF4 ) ) ) );
+				return errors;
+			}
+			
+			//! Returns a non-zero byte, if the block ends with a lead byte, whose sequence doesn't fit into the block
+			static inline __m128i get_utf8_block_incomplete( __m128i block ) noexcept {
+				return _mm_subs_epu8( block , _mm_setr_epi8( -1 , -1 , -1 , -1 , -1 , -1 , -1 , -1 , -1 , -1 , -1 , -1 , -1 , (char)0xEF , (char)0xDF , (char)0xBF ) );
+			}
+		#endif
 		
-		//! Assignment operator
-		raw_codepoint_reference& operator=( typename Container::value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) {
-			t_instance->raw_replace( t_index , t_instance->get_index_bytes( t_index ) , Container( cp ) );
-			return *this;
-		}
-		raw_codepoint_reference& operator=( const raw_codepoint_reference& ref ) noexcept(TINY_UTF8_NOEXCEPT) { return *this = (typename Container::value_type)ref; }
-	};
+		/**
+		 * Checks, whether the supplied range is valid UTF-8 as specified by RFC 3629, i.e. without overlong encodings, surrogates,
+		 * codepoints above U+10FFFF and sequences truncated by the end of the range, while counting codepoints and multibytes.
+		 * Following Keiser and Lemire, each byte is checked against the bytes before it, 16 bytes at a time (SSE2),
+		 * and the errors are accumulated, such that there is only one branch per 64 bytes. ASCII blocks are skipped.
+		 * 
+		 * @param	num_codepoints	[out] The number of codepoints (only set, if the data is valid)
+		 * @param	num_multibytes	[out] The number of codepoints made of more than one byte (only set, if the data is valid)
+		 * @return	True, if the data is valid UTF-8
+		 */
+		static inline bool validate_and_count( const unsigned char* data , std::size_t len , std::size_t& num_codepoints , std::size_t& num_multibytes ) noexcept
+		{
+			std::size_t i = 0 , num_non_ascii = 0 , num_continuations = 0;
+			#if TINY_UTF8_HAS_SSE2
+				const __m128i	zero = _mm_setzero_si128();
+				__m128i			prev_block = zero;
+				__m128i			errors = zero;
+				for( ; i < len ; i += 16 )
+				{
+					__m128i block;
+					if( len - i >= 16 )
+						block = _mm_loadu_si128( (const __m128i*)( data + i ) );
+					else{ // Final block: Zero-pad the data (zeros are plain ASCII)
+						unsigned char tail[16] = {};
+						std::memcpy( tail , data + i , len - i );
+						block = _mm_loadu_si128( (const __m128i*)tail );
+					}
+					
+					if( unsigned int non_ascii = (unsigned int)_mm_movemask_epi8( block ) ){
+						errors = _mm_or_si128( errors , get_utf8_block_errors( block , prev_block ) );
+						num_non_ascii += popcount( non_ascii );
+						num_continuations += popcount( (unsigned int)_mm_movemask_epi8( _mm_cmplt_epi8( block , _mm_set1_epi8( -64 ) ) ) );
+					}
+					else // ASCII only: Only the previous block could lack continuation bytes
+						errors = _mm_or_si128( errors , get_utf8_block_incomplete( prev_block ) );
+					prev_block = block;
+					
+					if( ( i & 48 ) == 48 && _mm_movemask_epi8( _mm_cmpeq_epi8( errors , zero ) ) != 0xFFFF )
+						return false;
+				}
+				errors = _mm_or_si128( errors , get_utf8_block_incomplete( prev_block ) );
+				if( _mm_movemask_epi8( _mm_cmpeq_epi8( errors , zero ) ) != 0xFFFF )
+					return false;
+			#else
+				while( i < len )
+				{
+					if( data[i] < 0x80 ){ // Skip ASCII runs in bulk
+						i += ascii_prefix_len( data + i , len - i );
+						continue;
+					}
+					
+					unsigned char	lead = data[i];
+					std::size_t		bytes = lead < 0xC2 ? 0 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : lead < 0xF5 ? 4 : 0;
+					if( !bytes || len - i < bytes )
+						return false;
+					
+					// The range of the second byte depends on the lead byte (overlong encodings, surrogates and codepoints above U+10FFFF)
+					unsigned char	second = data[i + 1];
+					if( second < ( lead == 0xE0 ? 0xA0 : lead == 0xF0 ? 0x90 : 0x80 ) || second > ( lead == 0xED ? 0x9F : lead == 0xF4 ? 0x8F : 0xBF ) )
+						return false;
+					for( std::size_t j = 2 ; j < bytes ; ++j )
+						if( ( data[i + j] & 0xC0 ) != 0x80 )
+							return false;
+					
+					num_non_ascii += bytes;
+					num_continuations += bytes - 1;
+					i += bytes;
+				}
+			#endif
+			num_codepoints = len - num_continuations;
+			num_multibytes = num_non_ascii - num_continuations;
+			return true;
+		}
+		
+		#if TINY_UTF8_HAS_SSE2
+			//! Zero-extends the 16 bytes of a block to four blocks of 32 bit lanes
+			static inline void widen_block( __m128i block , __m128i (&result)[4] ) noexcept {
+				const __m128i	zero = _mm_setzero_si128();
+				__m128i			lo = _mm_unpacklo_epi8( block , zero );
+				__m128i			hi = _mm_unpackhi_epi8( block , zero );
+				result[0] = _mm_unpacklo_epi16( lo , zero );
+				result[1] = _mm_unpackhi_epi16( lo , zero );
+				result[2] = _mm_unpacklo_epi16( hi , zero );
+				result[3] = _mm_unpackhi_epi16( hi , zero );
+			}
+			
+			/**
+			 * Decodes all complete codepoints of a 16 byte block at once, if they are well-formed and up to 4 bytes wide.
+			 * The block is expected to start with a codepoint. A codepoint truncated by the end of the block is left to the next block.
+			 * Each byte is masked to its payload bits and the (up to 3) bytes before it are shifted in, if they belong to the same codepoint.
+			 * 
+			 * @param	values		[out] The codepoint ending at byte 'i' (only valid, if bit 'i' of 'ends' is set)
+			 * @param	ends		[out] Bit mask of the bytes, that end a decoded codepoint
+			 * @param	validate	Whether to check the structure of the block (not necessary for valid UTF-8, see 'validate_and_count')
+			 * @return	The number of bytes decoded, or '0' if the block has to be decoded byte-wise
+			 */
+			static inline std::size_t decode_block( const unsigned char* data , std::uint32_t (&values)[16] , unsigned int& ends , bool validate = true ) noexcept
+			{
+				__m128i	block = _mm_loadu_si128( (const __m128i*)data );
+				__m128i	lanes[4];
+				
+				if( !_mm_movemask_epi8( block ) ){ // ASCII only
+					widen_block( block , lanes );
+					for( int i = 0 ; i < 4 ; ++i )
+						_mm_storeu_si128( (__m128i*)values + i , lanes[i] );
+					ends = 0xFFFFu;
+					return 16;
+				}
+				
+				// Classify the bytes ('max( block , threshold ) == block' <=> 'block >= threshold', see 'get_utf8_block_masks')
+				__m128i	ge_80 = _mm_cmplt_epi8( block , _mm_setzero_si128() );
+				__m128i	ge_c0 = _mm_cmpeq_epi8( _mm_max_epu8( block , _mm_set1_epi8( (char)0xC0 ) ) , block );
+				__m128i	ge_e0 = _mm_cmpeq_epi8( _mm_max_epu8( block , _mm_set1_epi8( (char)0xE0 ) ) , block );
+				__m128i	ge_f0 = _mm_cmpeq_epi8( _mm_max_epu8( block , _mm_set1_epi8( (char)0xF0 ) ) , block );
+				__m128i	ge_f8 = _mm_cmpeq_epi8( _mm_max_epu8( block , _mm_set1_epi8( (char)0xF8 ) ) , block );
+				__m128i	continuation = _mm_andnot_si128( ge_c0 , ge_80 );
+				
+				// Validate the block: Every lead byte is followed by exactly the number of continuation bytes it announces
+				unsigned int	continuation_mask = (unsigned int)_mm_movemask_epi8( continuation );
+				unsigned int	expected = ( (unsigned int)_mm_movemask_epi8( ge_c0 ) << 1 )
+					| ( (unsigned int)_mm_movemask_epi8( ge_e0 ) << 2 )
+					| ( (unsigned int)_mm_movemask_epi8( ge_f0 ) << 3 );
+				if( validate && ( _mm_movemask_epi8( ge_f8 ) || ( expected & 0xFFFFu ) != continuation_mask ) )
+					return 0;
+				
+				// Determine the complete codepoints (bit 0 of 'starts' is set, since the first byte is no continuation byte)
+				unsigned int	starts = ~continuation_mask & 0xFFFFu;
+				std::size_t		num_bytes = expected >> 16 ? 31 - clz( starts ) : 16;
+				ends = ( ( starts >> 1 ) | 0x8000u ) & ( ( 1u << num_bytes ) - 1 );
+				
+				// Mask each byte to its payload: 0x7F (ASCII), 0x3F (continuation), 0x1F, 0x0F or 0x07 (lead bytes)
+				__m128i payload = _mm_xor_si128(
+					_mm_xor_si128( _mm_set1_epi8( 0x7F ) , _mm_and_si128( ge_80 , _mm_set1_epi8( 0x40 ) ) )
+					, _mm_xor_si128(
+						_mm_and_si128( ge_c0 , _mm_set1_epi8( 0x20 ) )
+						, _mm_xor_si128( _mm_and_si128( ge_e0 , _mm_set1_epi8( 0x10 ) ) , _mm_and_si128( ge_f0 , _mm_set1_epi8( 0x08 ) ) )
+					)
+				);
+				payload = _mm_and_si128( block , payload );
+				
+				// The payloads of the 1st, 2nd and 3rd byte before each byte, if they belong to the same codepoint
+				__m128i	continuation2 = _mm_and_si128( continuation , _mm_slli_si128( continuation , 1 ) );
+				__m128i	continuation3 = _mm_and_si128( continuation2 , _mm_slli_si128( continuation , 2 ) );
+				__m128i	prev_lanes[3][4];
+				widen_block( _mm_and_si128( _mm_slli_si128( payload , 1 ) , continuation ) , prev_lanes[0] );
+				widen_block( _mm_and_si128( _mm_slli_si128( payload , 2 ) , continuation2 ) , prev_lanes[1] );
+				widen_block( _mm_and_si128( _mm_slli_si128( payload , 3 ) , continuation3 ) , prev_lanes[2] );
+				widen_block( payload , lanes );
+				
+				for( int i = 0 ; i < 4 ; ++i )
+					_mm_storeu_si128(
+						(__m128i*)values + i
+						, _mm_or_si128(
+							_mm_or_si128( lanes[i] , _mm_slli_epi32( prev_lanes[0][i] , 6 ) )
+							, _mm_or_si128( _mm_slli_epi32( prev_lanes[1][i] , 12 ) , _mm_slli_epi32( prev_lanes[2][i] , 18 ) )
+						)
+					);
+				
+				return num_bytes;
+			}
+		#endif
+		
+		/**
+		 * Finds the first occurence of a byte sequence within the supplied range (embedded zeros are treated like any other byte).
+		 * Candidate positions are filtered by comparing the first and the last byte of the needle
+		 * 32 (AVX2) or 16 (SSE2) at a time. The remaining positions are found using memchr on the first byte
+		 * 
+		 * @return	The offset of the first match or std::size_t(-1), if there is none
+		 */
+		static inline std::size_t find_bytes( const unsigned char* haystack , std::size_t haystack_len , const unsigned char* needle , std::size_t needle_len ) noexcept
+		{
+			if( needle_len > haystack_len )
+				return std::size_t(-1);
+			if( !needle_len )
+				return 0;
+			if( needle_len == 1 ){
+				const void* result = std::memchr( haystack , needle[0] , haystack_len );
+				return result ? (const unsigned char*)result - haystack : std::size_t(-1);
+			}
+			
+			std::size_t		i = 0;
+			std::size_t		num_starts = haystack_len - needle_len + 1; // Number of positions, where a match could start
+			unsigned char	first = needle[0];
+			unsigned char	last = needle[needle_len - 1];
+			#if TINY_UTF8_HAS_AVX2
+				const __m256i first_vec = _mm256_set1_epi8( (char)first );
+				const __m256i last_vec = _mm256_set1_epi8( (char)last );
+				for( ; i + 32 <= num_starts ; i += 32 ){
+					__m256i	block_first	= _mm256_loadu_si256( (const __m256i*)( haystack + i ) );
+					__m256i	block_last	= _mm256_loadu_si256( (const __m256i*)( haystack + i + needle_len - 1 ) );
+					for( unsigned int mask = (unsigned int)_mm256_movemask_epi8( _mm256_and_si256( _mm256_cmpeq_epi8( block_first , first_vec ) , _mm256_cmpeq_epi8( block_last , last_vec ) ) ) ; mask ; mask &= mask - 1 )
+						if( std::memcmp( haystack + i + ctz( mask ) , needle , needle_len ) == 0 )
+							return i + ctz( mask );
+				}
+			#endif
+			#if TINY_UTF8_HAS_SSE2
+				const __m128i first_vec16 = _mm_set1_epi8( (char)first );
+				const __m128i last_vec16 = _mm_set1_epi8( (char)last );
+				for( ; i + 16 <= num_starts ; i += 16 ){
+					__m128i	block_first	= _mm_loadu_si128( (const __m128i*)( haystack + i ) );
+					__m128i	block_last	= _mm_loadu_si128( (const __m128i*)( haystack + i + needle_len - 1 ) );
+					for( unsigned int mask = (unsigned int)_mm_movemask_epi8( _mm_and_si128( _mm_cmpeq_epi8( block_first , first_vec16 ) , _mm_cmpeq_epi8( block_last , last_vec16 ) ) ) ; mask ; mask &= mask - 1 )
+						if( std::memcmp( haystack + i + ctz( mask ) , needle , needle_len ) == 0 )
+							return i + ctz( mask );
+				}
+			#endif
+			while( i < num_starts ){
+				const unsigned char* candidate = (const unsigned char*)std::memchr( haystack + i , first , num_starts - i );
+				if( !candidate )
+					break;
+				i = candidate - haystack;
+				if( candidate[needle_len - 1] == last && std::memcmp( candidate , needle , needle_len ) == 0 )
+					return i;
+				++i;
+			}
+			return std::size_t(-1);
+		}
+		
+		/**
+		 * Finds the last occurence of a byte sequence within the supplied range, that starts at or before 'last_start'.
+		 * Candidate positions are filtered 16 (SSE2) at a time in the same way as in 'find_bytes'
+		 * 
+		 * @return	The offset of the last match or std::size_t(-1), if there is none
+		 */
+		static inline std::size_t rfind_bytes( const unsigned char* haystack , std::size_t haystack_len , const unsigned char* needle , std::size_t needle_len , std::size_t last_start ) noexcept
+		{
+			if( needle_len > haystack_len )
+				return std::size_t(-1);
+			
+			std::size_t		num_starts = std::min( last_start , haystack_len - needle_len ) + 1; // Number of positions, where a match could start
+			if( !needle_len )
+				return num_starts - 1;
+			
+			unsigned char	first = needle[0];
+			unsigned char	last = needle[needle_len - 1];
+			#if TINY_UTF8_HAS_SSE2 && TINY_UTF8_HAS_CLZ
+				const __m128i first_vec = _mm_set1_epi8( (char)first );
+				const __m128i last_vec = _mm_set1_epi8( (char)last );
+				for( std::size_t i ; num_starts >= 16 ; num_starts = i ){
+					i = num_starts - 16;
+					__m128i	block_first	= _mm_loadu_si128( (const __m128i*)( haystack + i ) );
+					__m128i	block_last	= _mm_loadu_si128( (const __m128i*)( haystack + i + needle_len - 1 ) );
+					for( unsigned int mask = (unsigned int)_mm_movemask_epi8( _mm_and_si128( _mm_cmpeq_epi8( block_first , first_vec ) , _mm_cmpeq_epi8( block_last , last_vec ) ) ) ; mask ; ){
+						unsigned int bit = sizeof(unsigned int) * 8 - 1 - clz( mask );
+						if( std::memcmp( haystack + i + bit , needle , needle_len ) == 0 )
+							return i + bit;
+						mask &= ~( 1u << bit );
+					}
+				}
+			#endif
+			while( num_starts-- )
+				if( haystack[num_starts] == first && haystack[num_starts + needle_len - 1] == last && std::memcmp( haystack + num_starts , needle , needle_len ) == 0 )
+					return num_starts;
+			return std::size_t(-1);
+		}
+		
+		//! Multiplies two 64 bit values and folds the 128 bit product by xor (the mixing step used for hashing)
+		static inline std::uint64_t hash_mix( std::uint64_t a , std::uint64_t b ) noexcept {
+			#if defined(__SIZEOF_INT128__)
+				__extension__ typedef unsigned __int128 uint128; // Silence -Wpedantic
+				uint128 product = (uint128)a * b;
+				return (std::uint64_t)product ^ (std::uint64_t)( product >> 64 );
+			#elif defined(_MSC_VER) && defined(_M_X64)
+				std::uint64_t high;
+				std::uint64_t low = _umul128( a , b , &high );
+				return low ^ high;
+			#else
+				std::uint64_t	a_low = (std::uint32_t)a, a_high = a >> 32, b_low = (std::uint32_t)b, b_high = b >> 32;
+				std::uint64_t	low_low = a_low * b_low, low_high = a_low * b_high, high_low = a_high * b_low, high_high = a_high * b_high;
+				std::uint64_t	middle = ( low_low >> 32 ) + (std::uint32_t)low_high + (std::uint32_t)high_low;
+				return ( ( middle << 32 ) | (std::uint32_t)low_low ) ^ ( high_high + ( low_high >> 32 ) + ( high_low >> 32 ) + ( middle >> 32 ) );
+			#endif
+		}
+		
+		//! Reads 8 bytes as little endian integer
+		static inline std::uint64_t hash_read( const unsigned char* data ) noexcept {
+			std::uint64_t word;
+			std::memcpy( &word , data , 8 );
+			if( !is_little_endian::value )
+				word = ( word >> 56 ) | ( ( word >> 40 ) & 0xFF00uLL ) | ( ( word >> 24 ) & 0xFF0000uLL ) | ( ( word >> 8 ) & 0xFF000000uLL )
+					| ( ( word << 8 ) & 0xFF00000000uLL ) | ( ( word << 24 ) & 0xFF0000000000uLL ) | ( ( word << 40 ) & 0xFF000000000000uLL ) | ( word << 56 );
+			return word;
+		}
+		
+		//! Secrets of the hash function (odd 64 bit constants with 32 bits set)
+		enum : std::uint64_t{
+			hash_secret0 = 0xa0761d6478bd642fuLL
+			, hash_secret1 = 0xe7037ed1a0b428dbuLL
+			, hash_secret2 = 0x8ebc6af09c88c6e3uLL
+			, hash_secret3 = 0x589965cc75374cc3uLL
+		};
+		
+		//! Mixes 32 bytes (as 4 words) into the seed and finalizes the hash
+		static inline std::size_t hash_finalize( std::uint64_t seed , std::uint64_t a , std::uint64_t b , std::uint64_t c , std::uint64_t d , std::size_t len ) noexcept {
+			seed = hash_mix( a ^ hash_secret1 , b ^ seed ) ^ hash_mix( c ^ hash_secret2 , d ^ seed );
+			return (std::size_t)hash_mix( seed ^ hash_secret0 , (std::uint64_t)len ^ hash_secret3 );
+		}
+		
+		/**
+		 * Hashes 'len' bytes (wyhash-style), 32 at a time.
+		 * If 'len' <= 32, the result only depends on the 32 byte block of the data padded with zeros (see 'hash_block').
+		 */
+		static inline std::size_t hash_bytes( const unsigned char* data , std::size_t len ) noexcept
+		{
+			if( len <= 32 ){
+				unsigned char block[32] = {};
+				std::memcpy( block , data , len );
+				return hash_finalize( hash_secret0 , hash_read( block ) , hash_read( block + 8 ) , hash_read( block + 16 ) , hash_read( block + 24 ) , len );
+			}
+			std::uint64_t seed = hash_secret0;
+			for( std::size_t i = 0 ; len - i > 32 ; i += 32 )
+				seed = hash_mix( hash_read( data + i ) ^ hash_secret1 , hash_read( data + i + 8 ) ^ seed )
+					^ hash_mix( hash_read( data + i + 16 ) ^ hash_secret2 , hash_read( data + i + 24 ) ^ seed );
+			data += len - 32; // The final (possibly overlapping) 32 bytes
+			return hash_finalize( seed , hash_read( data ) , hash_read( data + 8 ) , hash_read( data + 16 ) , hash_read( data + 24 ) , len );
+		}
+		
+		/**
+		 * Computes the same value as 'hash_bytes' for 'len' <= 32 bytes, but directly
+		 * on a block of 32 readable bytes, of which the ones behind 'len' are masked out without branching
+		 */
+		static inline std::size_t hash_block( const unsigned char* block , std::size_t len ) noexcept {
+			std::uint64_t words[4];
+			for( std::size_t i = 0 ; i < 4 ; ++i ){
+				std::size_t num_bytes = std::min<std::size_t>( len - std::min<std::size_t>( len , i * 8 ) , 8 ); // Bytes of 'len' within this word
+				words[i] = hash_read( block + i * 8 ) & ~( ~std::uint64_t(0) << ( num_bytes * 4 ) << ( num_bytes * 4 ) ); // Two shifts avoid shifting by 64
+			}
+			return hash_finalize( hash_secret0 , words[0] , words[1] , words[2] , words[3] , len );
+		}
+		
+		//! Returns the number of leading codepoints within the supplied range that are ASCII (checked 8 at a time)
+		template<typename ValueType>
+		static inline std::size_t ascii_codepoint_prefix_len( const ValueType* str , std::size_t len ) noexcept
+		{
+			std::size_t i = 0;
+			for( ; i + 8 <= len ; i += 8 )
+				if( ( str[i] | str[i+1] | str[i+2] | str[i+3] | str[i+4] | str[i+5] | str[i+6] | str[i+7] ) >= 0x80 )
+					break;
+			while( i < len && str[i] < 0x80 )
+				++i;
+			return i;
+		}
+		
+		/**
+		 * Narrows the leading ASCII codepoints within the supplied range into 'dest' and returns their number.
+		 * 32 bit codepoints are narrowed 16 at a time (SSE2).
+		 */
+		template<typename ValueType, typename DataType>
+		static inline std::size_t narrow_ascii_codepoints( const ValueType* str , std::size_t len , DataType* dest ) noexcept
+		{
+			std::size_t i = 0;
+			#if TINY_UTF8_HAS_SSE2
+				if( sizeof(ValueType) == 4 && sizeof(DataType) == 1 ){
+					for( ; i + 16 <= len ; i += 16 ){
+						__m128i	a = _mm_loadu_si128( (const __m128i*)( str + i ) );
+						__m128i	b = _mm_loadu_si128( (const __m128i*)( str + i + 4 ) );
+						__m128i	c = _mm_loadu_si128( (const __m128i*)( str + i + 8 ) );
+						__m128i	d = _mm_loadu_si128( (const __m128i*)( str + i + 12 ) );
+						__m128i	high_bits = _mm_srli_epi32( _mm_or_si128( _mm_or_si128( a , b ) , _mm_or_si128( c , d ) ) , 7 );
+						if( _mm_movemask_epi8( _mm_cmpeq_epi32( high_bits , _mm_setzero_si128() ) ) != 0xFFFF )
+							break;
+						_mm_storeu_si128( (__m128i*)( dest + i ) , _mm_packus_epi16( _mm_packs_epi32( a , b ) , _mm_packs_epi32( c , d ) ) );
+					}
+				}
+			#endif
+			for( ; i + 8 <= len ; i += 8 ){
+				if( ( str[i] | str[i+1] | str[i+2] | str[i+3] | str[i+4] | str[i+5] | str[i+6] | str[i+7] ) >= 0x80 )
+					break;
+				for( std::size_t j = i ; j < i + 8 ; ++j )
+					dest[j] = (DataType)str[j];
+			}
+			for( ; i < len && str[i] < 0x80 ; ++i )
+				dest[i] = (DataType)str[i];
+			return i;
+		}
+		
+		//! strlen for different character types
+		template<typename T>
+		inline std::size_t strlen( const T* str ){ std::size_t len = 0u; while( *str++ ) ++len; return len; }
+		template<> inline std::size_t strlen<char>( const char* str ){ return std::strlen( str ); }
+		
+		/**
+		 * Non-owning description of a set of codepoints.
+		 * ASCII members are stored as bitmap: Bit 'i' of 'ascii[j]' refers to the codepoint 'i * 16 + j',
+		 * which allows to look up 16 (SSSE3) or 32 (AVX2) bytes at once using byte shuffles.
+		 * Non-ASCII members are searched within 'others' (which may contain ASCII members as well),
+		 * or within 'small_others', if 'others' is nullptr.
+		 */
+		template<typename ValueType>
+		struct codepoint_matcher
+		{
+			enum : std::size_t{	max_small_others = 16 };
+			
+			unsigned char		ascii[16];
+			const ValueType*	others;
+			std::size_t			num_others;
+			bool				others_sorted; // Whether 'others' may be binary searched
+			ValueType			small_others[max_small_others]; // Sorted non-ASCII members of a string with only a few of them
+			
+			codepoint_matcher() noexcept : ascii{} , others( nullptr ) , num_others( 0 ) , others_sorted( true ) , small_others{} {}
+			
+			/**
+			 * Constructs a matcher from the supplied null-terminated string.
+			 * Up to 'max_small_others' non-ASCII members are sorted into 'small_others' (once per search),
+			 * larger sets refer to the string and are searched linearly (precompile them into a codepoint_set instead).
+			 */
+			explicit codepoint_matcher( const ValueType* str ) noexcept : codepoint_matcher() {
+				std::size_t len = 0;
+				for( ; str[len] ; ++len ){
+					if( str[len] < 0x80 )
+						add_ascii( (unsigned char)str[len] );
+					else if( num_others < max_small_others ){
+						// Insertion sort, skipping duplicates
+						ValueType*	end = small_others + num_others;
+						ValueType*	pos = std::lower_bound( small_others , end , str[len] );
+						if( pos == end || *pos != str[len] ){
+							std::copy_backward( pos , end , end + 1 );
+							*pos = str[len];
+							++num_others;
+						}
+					}
+					else if( !others )
+						others = str, others_sorted = false;
+				}
+				if( others )
+					num_others = len;
+			}
+			
+			void add_ascii( unsigned char cp ) noexcept { ascii[cp & 0x0F] |= (unsigned char)( 1u << ( cp >> 4 ) ); }
+			
+			//! Checks, whether the supplied byte is an ASCII member (non-ASCII bytes are never)
+			bool contains_ascii( unsigned char byte ) const noexcept { return ascii[byte & 0x0F] & ( 1u << ( byte >> 4 ) ); }
+			
+			bool contains( ValueType cp ) const noexcept {
+				if( cp < 0x80 )
+					return contains_ascii( (unsigned char)cp );
+				if( !others )
+					return std::binary_search( small_others , small_others + num_others , cp );
+				if( others_sorted )
+					return std::binary_search( others , others + num_others , cp );
+				return std::find( others , others + num_others , cp ) != others + num_others;
+			}
+			
+			#if TINY_UTF8_HAS_AVX2
+				//! Returns a 32 bit mask of the ASCII members within the supplied block
+				unsigned int get_member_mask( __m256i block ) const noexcept {
+					const __m256i	table = _mm256_broadcastsi128_si256( _mm_loadu_si128( (const __m128i*)ascii ) );
+					const __m256i	bits = _mm256_setr_epi8( 1 , 2 , 4 , 8 , 16 , 32 , 64 , -128 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 1 , 2 , 4 , 8 , 16 , 32 , 64 , -128 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 );
+					const __m256i	nibble = _mm256_set1_epi8( 0x0F );
+					__m256i			row = _mm256_shuffle_epi8( table , _mm256_and_si256( block , nibble ) );
+					__m256i			column = _mm256_shuffle_epi8( bits , _mm256_and_si256( _mm256_srli_epi16( block , 4 ) , nibble ) );
+					return ~(unsigned int)_mm256_movemask_epi8( _mm256_cmpeq_epi8( _mm256_and_si256( row , column ) , _mm256_setzero_si256() ) );
+				}
+			#endif
+			#if TINY_UTF8_HAS_SSSE3
+				//! Returns a 16 bit mask of the ASCII members within the supplied block
+				unsigned int get_member_mask( __m128i block ) const noexcept {
+					const __m128i	table = _mm_loadu_si128( (const __m128i*)ascii );
+					const __m128i	bits = _mm_setr_epi8( 1 , 2 , 4 , 8 , 16 , 32 , 64 , -128 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 );
+					const __m128i	nibble = _mm_set1_epi8( 0x0F );
+					__m128i			row = _mm_shuffle_epi8( table , _mm_and_si128( block , nibble ) );
+					__m128i			column = _mm_shuffle_epi8( bits , _mm_and_si128( _mm_srli_epi16( block , 4 ) , nibble ) );
+					return ~(unsigned int)_mm_movemask_epi8( _mm_cmpeq_epi8( _mm_and_si128( row , column ) , _mm_setzero_si128() ) ) & 0xFFFFu;
+				}
+			#endif
+			
+			//! Returns the number of leading bytes, that are ASCII and whose membership equals 'members'
+			std::size_t ascii_span( const unsigned char* data , std::size_t len , bool members ) const noexcept
+			{
+				std::size_t i = 0;
+				#if TINY_UTF8_HAS_AVX2
+					for( ; i + 32 <= len ; i += 32 ){
+						__m256i			block = _mm256_loadu_si256( (const __m256i*)( data + i ) );
+						unsigned int	member_mask = get_member_mask( block );
+						unsigned int	stop_mask = (unsigned int)_mm256_movemask_epi8( block ) | ( members ? ~member_mask : member_mask );
+						if( stop_mask )
+							return i + ctz( stop_mask );
+					}
+				#endif
+				#if TINY_UTF8_HAS_SSSE3
+					for( ; i + 16 <= len ; i += 16 ){
+						__m128i			block = _mm_loadu_si128( (const __m128i*)( data + i ) );
+						unsigned int	member_mask = get_member_mask( block );
+						unsigned int	stop_mask = ( (unsigned int)_mm_movemask_epi8( block ) | ( members ? ~member_mask : member_mask ) ) & 0xFFFFu;
+						if( stop_mask )
+							return i + ctz( stop_mask );
+					}
+				#endif
+				while( i < len && data[i] < 0x80 && contains_ascii( data[i] ) == members )
+					++i;
+				return i;
+			}
+			
+			//! Returns the offset of the first byte that is an ASCII member or 'len', if there is none
+			std::size_t find_ascii_member( const unsigned char* data , std::size_t len ) const noexcept
+			{
+				std::size_t i = 0;
+				#if TINY_UTF8_HAS_AVX2
+					for( ; i + 32 <= len ; i += 32 )
+						if( unsigned int member_mask = get_member_mask( _mm256_loadu_si256( (const __m256i*)( data + i ) ) ) )
+							return i + ctz( member_mask );
+				#endif
+				#if TINY_UTF8_HAS_SSSE3
+					for( ; i + 16 <= len ; i += 16 )
+						if( unsigned int member_mask = get_member_mask( _mm_loadu_si128( (const __m128i*)( data + i ) ) ) )
+							return i + ctz( member_mask );
+				#endif
+				while( i < len && !contains_ascii( data[i] ) )
+					++i;
+				return i;
+			}
+		};
+	}
+	
+	/**
+	 * Precompiled set of codepoints, to be used with find_first_of, find_last_of and the like,
+	 * if the same set is searched for repeatedly.
+	 */
+	template<typename ValueType = char32_t>
+	class basic_codepoint_set
+	{
+	private:
+		
+		std::unique_ptr<ValueType[]>					t_others; // Sorted non-ASCII members
+		tiny_utf8_detail::codepoint_matcher<ValueType>	t_matcher;
+		
+		void assign( const ValueType* str , std::size_t len )
+		{
+			std::size_t num_others = 0;
+			for( std::size_t i = 0 ; i < len ; ++i ){
+				if( str[i] < 0x80 )
+					t_matcher.add_ascii( (unsigned char)str[i] );
+				else
+					++num_others;
+			}
+			if( !num_others )
+				return;
+			t_others.reset( new ValueType[num_others] );
+			t_matcher.others = t_others.get();
+			for( std::size_t i = 0 ; i < len ; ++i )
+				if( str[i] >= 0x80 )
+					t_others[t_matcher.num_others++] = str[i];
+			std::sort( t_others.get() , t_others.get() + num_others );
+			t_matcher.num_others = std::unique( t_others.get() , t_others.get() + num_others ) - t_others.get();
+		}
+		
+	public:
+		
+		//! Constructs a set containing the codepoints of the supplied null-terminated string
+		explicit basic_codepoint_set( const ValueType* str ) { assign( str , tiny_utf8_detail::strlen( str ) ); }
+		//! Constructs a set containing the first 'len' codepoints of the supplied string
+		basic_codepoint_set( const ValueType* str , std::size_t len ) { assign( str , len ); }
+		//! Constructs a set containing the supplied codepoints
+		basic_codepoint_set( std::initializer_list<ValueType> ilist ) { assign( ilist.begin() , ilist.size() ); }
+		
+		basic_codepoint_set( const basic_codepoint_set& set ) : t_matcher( set.t_matcher ) {
+			t_matcher.others = nullptr, t_matcher.num_others = 0;
+			assign( set.t_matcher.others , set.t_matcher.num_others );
+		}
+		basic_codepoint_set( basic_codepoint_set&& ) = default;
+		basic_codepoint_set& operator=( const basic_codepoint_set& set ){
+			if( this != &set )
+				*this = basic_codepoint_set( set );
+			return *this;
+		}
+		basic_codepoint_set& operator=( basic_codepoint_set&& ) = default;
+		
+		//! Checks, whether the set contains the supplied codepoint
+		bool contains( ValueType cp ) const noexcept { return t_matcher.contains( cp ); }
+		
+		//! Get the underlying matcher
+		const tiny_utf8_detail::codepoint_matcher<ValueType>& get_matcher() const noexcept { return t_matcher; }
+	};
+	
+	//! Typedef of codepoint_set
+	using codepoint_set = basic_codepoint_set<char32_t>;
+
+
+	template<typename Container, bool RangeCheck>
+	struct codepoint_reference
+	{
+		typename Container::size_type	t_index;
+		Container*						t_instance;
+		
+	public:
+		
+		//! Ctor
+		codepoint_reference( typename Container::size_type index , Container* instance ) noexcept :
+			t_index( index )
+			, t_instance( instance )
+		{}
+		
+		//! Cast to wide char
+		operator typename Container::value_type() const noexcept( TINY_UTF8_NOEXCEPT || RangeCheck == false ) {
+			if TINY_UTF8_CPP17(constexpr) ( RangeCheck )
+				return static_cast<const Container*>(t_instance)->at( t_index );
+			else
+				return static_cast<const Container*>(t_instance)->at( t_index , std::nothrow );
+		}
+		
+		//! Dereference operator to act as pointer type
+		codepoint_reference& operator*() const noexcept { return *this; }
+		
+		//! Assignment operator
+		codepoint_reference& operator=( typename Container::value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) {
+			t_instance->replace( t_index , cp );
+			return *this;
+		}
+		codepoint_reference& operator=( const codepoint_reference& ref ) noexcept(TINY_UTF8_NOEXCEPT) { return *this = (typename Container::value_type)ref; }
+	};
+
+	template<typename Container, bool RangeCheck>
+	struct raw_codepoint_reference
+	{
+		typename Container::size_type	t_index;
+		Container*						t_instance;
+		
+	public:
+		
+		//! Ctors
+		raw_codepoint_reference( typename Container::size_type raw_index , Container* instance ) noexcept :
+			t_index( raw_index )
+			, t_instance( instance )
+		{}
+		template<bool RC>
+		explicit raw_codepoint_reference( const codepoint_reference<Container, RC>& reference ) noexcept :
+			t_index( reference.t_instance->get_num_bytes_from_start( reference.t_index ) )
+			, t_instance( reference.t_instance )
+		{}
+		
+		//! Cast to wide char
+		operator typename Container::value_type() const noexcept( TINY_UTF8_NOEXCEPT || RangeCheck == false ) {
+			if TINY_UTF8_CPP17(constexpr) ( RangeCheck )
+				return static_cast<const Container*>(t_instance)->raw_at( t_index );
+			else
+				return static_cast<const Container*>(t_instance)->raw_at( t_index , std::nothrow );
+		}
+		
+		//! Dereference operator to act as pointer type
+		raw_codepoint_reference& operator*() const noexcept { return *this; }
+		
+		//! Cast to normal (non-raw) codepoint reference
+		template<bool RC>
+		explicit operator codepoint_reference<Container, RC>() const noexcept { return { t_instance->get_num_codepoints( 0 , t_index ) , t_instance }; }
+		
+		//! Assignment operator
+		raw_codepoint_reference& operator=( typename Container::value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) {
+			t_instance->raw_replace( t_index , t_instance->get_index_bytes( t_index ) , Container( cp ) );
+			return *this;
+		}
+		raw_codepoint_reference& operator=( const raw_codepoint_reference& ref ) noexcept(TINY_UTF8_NOEXCEPT) { return *this = (typename Container::value_type)ref; }
+	};
 
 	// Codepoint-based iterator base
 	template<typename Container, bool Raw>
 	struct iterator_base
 	{
-		template<typename, typename, typename>
+		template<typename, typename, typename, std::size_t>
 		friend class basic_string;
 
 	public:
@@ -297,9 +1397,10 @@ namespace tiny_utf8
 		bool operator!=( const iterator_base& it ) const noexcept { return t_index != it.t_index; }
 
 		//! Ctor
-		iterator_base( difference_type index , Container* instance ) noexcept :
+		iterator_base( difference_type index , Container* instance , difference_type raw_index = -1 ) noexcept :
 			t_index( index )
 			, t_instance( instance )
+			, t_raw_index( raw_index )
 		{}
 
 		//! Default function
@@ -314,7 +1415,7 @@ namespace tiny_utf8
 		difference_type get_index() const noexcept { return t_index; }
 
 		//! Get the index of the codepoint the iterator points to
-		difference_type get_raw_index() const noexcept { return t_instance->get_num_bytes_from_start( t_index ); }
+		difference_type get_raw_index() const noexcept { return t_raw_index >= 0 ? t_raw_index : t_instance->get_num_bytes_from_start( t_index ); }
 
 		//! Get a reference to the codepoint the iterator points to
 		reference get_reference() const noexcept { return t_instance->at( t_index , std::nothrow ); }
@@ -324,26 +1425,73 @@ namespace tiny_utf8
 
 	protected:
 
-		difference_type		t_index;
-		Container*			t_instance = nullptr;
+		difference_type				t_index;
+		Container*					t_instance = nullptr;
+		
+		/**
+		 * Cached byte index of the codepoint at 't_index' or -1, if unknown.
+		 * Only const iterators fill it, which then keep it up to date while moving.
+		 * Mutable iterators always look up the byte index, as writing through
+		 * another iterator (as e.g. std::remove does) may change the widths of preceeding codepoints.
+		 */
+		mutable difference_type		t_raw_index = -1;
 
 	protected:
 
+		//! Get the value that the iterator points to using (and filling) the cached byte index
+		value_type get_cached_value() const noexcept {
+			if( t_raw_index < 0 ){
+				if( t_index < 0 )
+					return get_value(); // Let 'at' handle the error
+				t_raw_index = t_instance->get_num_bytes_from_start( t_index );
+			}
+			return static_cast<const Container*>(t_instance)->raw_at( t_raw_index );
+		}
+		
+		//! Set the cached byte index of the codepoint the iterator points to
+		void cache_raw_index( difference_type raw_index ) noexcept { t_raw_index = raw_index; }
+		
 		//! Advance the iterator n times (negative values allowed!)
-		void advance( difference_type n ) noexcept { t_index += n; }
+		void advance( difference_type n ) noexcept {
+			if( t_raw_index >= 0 ){
+				if( n >= 0 )
+					t_raw_index += t_instance->get_num_bytes( t_raw_index , n );
+				else if( t_index + n >= -n ) // Walking backwards is cheaper than walking from the start
+					for( difference_type i = n ; i < 0 ; ++i )
+						decrement_raw_index();
+				else
+					t_raw_index = -1; // Will be looked up when required
+			}
+			t_index += n;
+		}
 
 		//! Move the iterator one codepoint ahead
-		void increment() noexcept { t_index++; }
+		void increment() noexcept {
+			if( t_raw_index >= 0 )
+				t_raw_index += t_instance->get_index_bytes( t_raw_index );
+			t_index++;
+		}
 
 		//! Move the iterator one codepoint backwards
-		void decrement() noexcept { t_index--; }
+		void decrement() noexcept {
+			if( t_raw_index >= 0 )
+				decrement_raw_index();
+			t_index--;
+		}
+		
+	private:
+		
+		//! Move the cached byte index one codepoint backwards
+		void decrement_raw_index() noexcept {
+			t_raw_index = t_raw_index > 0 ? t_raw_index - t_instance->get_index_pre_bytes( t_raw_index ) : -1;
+		}
 	};
 
 	// (Raw) Byte-based iterator base
 	template<typename Container>
 	struct iterator_base<Container, true>
 	{
-		template<typename, typename, typename>
+		template<typename, typename, typename, std::size_t>
 		friend class basic_string;
 		
 	public:	
@@ -398,6 +1546,10 @@ namespace tiny_utf8
 		Container*			t_instance = nullptr;
 		
 	protected:
+		
+		//! Raw iterators already know their byte index
+		value_type get_cached_value() const noexcept { return get_value(); }
+		void cache_raw_index( difference_type ) noexcept {}
 
 		//! Advance the iterator n times (negative values allowed!)
 		void advance( difference_type n ) noexcept {
@@ -490,13 +1642,23 @@ namespace tiny_utf8
 		typename iterator::reference operator*() const noexcept { return this->get_reference(); }
 	};
 
+	/**
+	 * Since const iterators cannot modify the string, non-raw const iterators
+	 * additionally track the byte index of their codepoint. This way, they
+	 * don't need to look up the codepoint from the start of the string on each access.
+	 */
 	template<typename Container, bool Raw>
 	struct const_iterator : iterator<Container, Raw>
 	{
+		typedef typename iterator_base<Container, Raw>::difference_type difference_type;
+		
 		//! Ctor
-		const_iterator( typename iterator_base<Container, Raw>::difference_type index , const Container* instance ) noexcept :
+		const_iterator( difference_type index , const Container* instance ) noexcept :
 			iterator<Container, Raw>( index , const_cast<Container*>(instance) )
 		{}
+		const_iterator( difference_type index , const Container* instance , difference_type raw_index ) noexcept :
+			iterator<Container, Raw>( index , const_cast<Container*>(instance) )
+		{ this->cache_raw_index( raw_index ); }
 		
 		//! Ctor from non const
 		const_iterator( const iterator<Container, Raw>& other ) noexcept :
@@ -505,15 +1667,62 @@ namespace tiny_utf8
 		const_iterator( const iterator<Container, !Raw>& other ) noexcept :
 			iterator<Container, Raw>( other )
 		{}
+		const_iterator( const const_iterator<Container, !Raw>& other ) noexcept :
+			iterator<Container, Raw>( other )
+		{ this->cache_raw_index( other.get_raw_index() ); }
 		
 		//! Default Functions
 		const_iterator() noexcept = default;
 		const_iterator( const const_iterator& ) noexcept = default;
 		const_iterator& operator=( const const_iterator& ) noexcept = default;
 		
-		//! Returns the (raw) value behind the iterator
-		typename iterator<Container, Raw>::value_type operator*() const noexcept { return this->get_value(); }
-	};
+		//! Increase the Iterator by one
+		const_iterator& operator++() noexcept { // prefix ++iter
+			this->increment();
+			return *this;
+		}
+		const_iterator operator++( int ) noexcept { // postfix iter++
+			const_iterator tmp{ *this };
+			this->increment();
+			return tmp;
+		}
+		
+		//! Decrease the iterator by one
+		const_iterator& operator--() noexcept { // prefix --iter
+			this->decrement();
+			return *this;
+		}
+		const_iterator operator--( int ) noexcept { // postfix iter--
+			const_iterator tmp{ *this };
+			this->decrement();
+			return tmp;
+		}
+		
+		//! Increase the Iterator n times
+		const_iterator operator+( difference_type n ) const noexcept {
+			const_iterator it{*this};
+			it.advance( n );
+			return it;
+		}
+		const_iterator& operator+=( difference_type n ) noexcept {
+			this->advance( n );
+			return *this;
+		}
+		
+		//! Decrease the Iterator n times
+		const_iterator operator-( difference_type n ) const noexcept {
+			const_iterator it{*this};
+			it.advance( -n );
+			return it;
+		}
+		const_iterator& operator-=( difference_type n ) noexcept {
+			this->advance( -n );
+			return *this;
+		}
+		
+		//! Returns the (raw) value behind the iterator
+		typename iterator<Container, Raw>::value_type operator*() const noexcept { return this->get_cached_value(); }
+	};
 
 	template<typename Container, bool Raw>
 	struct reverse_iterator : iterator_base<Container, Raw>
@@ -594,10 +1803,15 @@ namespace tiny_utf8
 	template<typename Container, bool Raw>
 	struct const_reverse_iterator : reverse_iterator<Container, Raw>
 	{
+		typedef typename iterator_base<Container, Raw>::difference_type difference_type;
+		
 		//! Ctor
-		const_reverse_iterator( typename iterator_base<Container, Raw>::difference_type index , const Container* instance ) noexcept :
+		const_reverse_iterator( difference_type index , const Container* instance ) noexcept :
 			reverse_iterator<Container, Raw>( index , const_cast<Container*>(instance) )
 		{}
+		const_reverse_iterator( difference_type index , const Container* instance , difference_type raw_index ) noexcept :
+			reverse_iterator<Container, Raw>( index , const_cast<Container*>(instance) )
+		{ this->cache_raw_index( raw_index ); }
 		
 		//! Ctor from non const
 		const_reverse_iterator( const reverse_iterator<Container, Raw>& other ) noexcept :
@@ -620,8 +1834,52 @@ namespace tiny_utf8
 		const_reverse_iterator( const const_reverse_iterator& ) noexcept = default;
 		const_reverse_iterator& operator=( const const_reverse_iterator& ) noexcept = default;
 		
+		//! Increase the iterator by one
+		const_reverse_iterator& operator++() noexcept { // prefix ++iter
+			this->decrement();
+			return *this;
+		}
+		const_reverse_iterator operator++( int ) noexcept { // postfix iter++
+			const_reverse_iterator tmp{ *this };
+			this->decrement();
+			return tmp;
+		}
+		
+		//! Decrease the Iterator by one
+		const_reverse_iterator& operator--() noexcept { // prefix --iter
+			this->increment();
+			return *this;
+		}
+		const_reverse_iterator operator--( int ) noexcept { // postfix iter--
+			const_reverse_iterator tmp{ *this };
+			this->increment();
+			return tmp;
+		}
+		
+		//! Increase the Iterator n times
+		const_reverse_iterator operator+( difference_type n ) const noexcept {
+			const_reverse_iterator it{*this};
+			it.advance( -n );
+			return it;
+		}
+		const_reverse_iterator& operator+=( difference_type n ) noexcept {
+			this->advance( -n );
+			return *this;
+		}
+		
+		//! Decrease the Iterator n times
+		const_reverse_iterator operator-( difference_type n ) const noexcept {
+			const_reverse_iterator it{*this};
+			it.advance( n );
+			return it;
+		}
+		const_reverse_iterator& operator-=( difference_type n ) noexcept {
+			this->advance( n );
+			return *this;
+		}
+		
 		//! Returns the (raw) value behind the iterator
-		typename iterator<Container, Raw>::value_type operator*() const noexcept { return this->get_value(); }
+		typename iterator<Container, Raw>::value_type operator*() const noexcept { return this->get_cached_value(); }
 		
 		//! Get the underlying iterator instance
 		const_iterator<Container, Raw> base() const noexcept { return { this->t_index , this->t_instance }; }
@@ -698,6 +1956,7 @@ namespace tiny_utf8
 		typename ValueType
 		, typename DataType
 		, typename Allocator
+		, std::size_t SSOCapacity
 	>
 	class basic_string : private Allocator
 	{
@@ -721,22 +1980,35 @@ namespace tiny_utf8
 		typedef tiny_utf8::const_iterator<basic_string, true>				raw_const_iterator;
 		typedef tiny_utf8::reverse_iterator<basic_string, true>				raw_reverse_iterator;
 		typedef tiny_utf8::const_reverse_iterator<basic_string, true>		raw_const_reverse_iterator;
+		typedef basic_codepoint_set<ValueType>								codepoint_set;
+		typedef basic_string_view<ValueType, DataType>						string_view;
+		typedef basic_split_range<ValueType, DataType>						split_range;
+		typedef basic_string_literal<DataType>								string_literal;
 		typedef Allocator													allocator_type;
 		typedef size_type													indicator_type; // Typedef for the lut indicator. Note: Don't change this, because else the buffer will not be a multiple of sizeof(size_type)
 		enum : size_type{													npos = (size_type)-1 };
 		
+		//! Describes a heap buffer of 'capacity' code units, that is handed over to (see 'adopt') or from (see 'release') a basic_string
+		struct heap_buffer
+		{
+			data_type*	data;
+			size_type	data_len; // The number of bytes in use (excluding the trailing '\0')
+			size_type	capacity;
+		};
+		
 	protected: //! Layout specifications
 		
 		/*
 		 * To determine, which layout is active, read either t_sso.data_len, or the last byte of t_non_sso.buffer_size:
 		 * LSB == 0  =>  SSO
 		 * LSB == 1  =>  NON-SSO
+		 * If 'SSOCapacity' makes SSO larger than NON_SSO, t_sso.data_len lies behind t_non_sso and is set to 0x1 explicitly.
 		 */
 		
 		// Layout used, if sso is inactive
 		struct NON_SSO
 		{
-			data_type*		data; // Points to [ <data::char>... | '0'::char | <index::rle>... | <lut_indicator::size_type> ]
+			data_type*		data; // Points to [ <data::char>... | '0'::char | <index::rle>... | <lut_indicator::size_type> | <jump_table>... ]
 			size_type		data_len; // In bytes, excluding the trailing '\0'
 			size_type		buffer_size; // Indicates the size of '::data' minus 'lut_width'
 			size_type		string_len; // Shadows data_len on the last byte
@@ -745,7 +2017,8 @@ namespace tiny_utf8
 		// Layout used, if sso is active
 		struct SSO
 		{
-			enum : size_type{	size = sizeof(NON_SSO)-1 };
+			enum : size_type{	size = sizeof(NON_SSO)-1 > SSOCapacity ? sizeof(NON_SSO)-1 : SSOCapacity };
+			static_assert( size <= 127 , "The sso capacity must not exceed 127 code units, since 'data_len' holds it shifted left by one" );
 			data_type			data[size];
 			unsigned char		data_len; // This field holds ( size - num_characters ) << 1
 			
@@ -761,6 +2034,18 @@ namespace tiny_utf8
 		
 	protected: //! Attributes
 		
+		friend struct std::hash<basic_string>; // Hashes the sso buffer directly
+		template<typename, typename>
+		friend class basic_string_view; // Uses the static helpers to walk over its data
+		template<typename, typename>
+		friend class basic_split_range; // Uses the static search helpers to find delimiters
+		template<typename, typename, typename, std::size_t>
+		friend class basic_string_builder; // Prepares heap buffers that are taken over by 'assign_heap_buffer'
+		template<typename, typename, typename, std::size_t>
+		friend class basic_stream_decoder; // Uses the static helpers to find codepoints split by chunk boundaries
+		template<typename, typename>
+		friend class basic_mapped_string; // Uses the static helpers to build its index
+		
 		union{
 			SSO		t_sso;
 			NON_SSO	t_non_sso;
@@ -793,8 +2078,35 @@ namespace tiny_utf8
 			, _DataType
 		>::type;
 		
+		/**
+		 * With TINY_UTF8_LAZY_LUT, the lut of a newly built string is only marked as deferred: ( trusted << 1 ) | lut_deferred
+		 * Its first random access builds it (see 'build_deferred_lut'), which const readers of other threads might do concurrently.
+		 * The one that sets 'lut_building' fills the lut and the jump table and publishes them by storing the final indicator.
+		 * Both flags are only set while the lut is inactive, whose lut_len bits are 0 otherwise.
+		 */
+		enum : indicator_type{				lut_deferred = 0x4 , lut_building = 0x8 };
+		
+		//! Read the lut indicator (atomically, if the lut might be built concurrently)
+		#if defined(TINY_UTF8_LAZY_LUT)
+		static inline indicator_type		load_lut_indicator( const data_type* lut_base_ptr ) noexcept { return reinterpret_cast<const std::atomic<indicator_type>*>( lut_base_ptr )->load( std::memory_order_acquire ); }
+		#else
+		static inline indicator_type		load_lut_indicator( const data_type* lut_base_ptr ) noexcept { return *(const indicator_type*)lut_base_ptr; }
+		#endif
+		
 		//! Check, if the lut is active using the lut base ptr
-		static inline bool					is_lut_active( const data_type* lut_base_ptr ) noexcept { return *((const unsigned char*)lut_base_ptr) & 0x1; }
+		static inline bool					is_lut_active( const data_type* lut_base_ptr ) noexcept { return basic_string::load_lut_indicator( lut_base_ptr ) & 0x1; }
+		
+		//! Check, if the lut is deferred, i.e. not built yet or being built by another thread (only possible with TINY_UTF8_LAZY_LUT)
+		#if defined(TINY_UTF8_LAZY_LUT)
+		static inline bool					is_lut_deferred( const data_type* lut_base_ptr ) noexcept { return ( basic_string::load_lut_indicator( lut_base_ptr ) & ( lut_deferred | 0x1 ) ) == lut_deferred; }
+		#else
+		static constexpr inline bool		is_lut_deferred( const data_type* ) noexcept { return false; }
+		#endif
+		
+		//! Check, if the data is known to be valid UTF-8 using the lut base ptr (see 'trusted')
+		static inline bool					is_trusted( const data_type* lut_base_ptr ) noexcept { return basic_string::load_lut_indicator( lut_base_ptr ) & 0x2; }
+		static inline void					set_trusted( data_type* lut_base_ptr ) noexcept { *(indicator_type*)lut_base_ptr |= 0x2; }
+		static inline void					reset_trusted( data_type* lut_base_ptr ) noexcept { *(indicator_type*)lut_base_ptr &= ~(indicator_type)0x2; }
 		
 		//! Rounds the supplied value to a multiple of sizeof(size_type)
 		static inline size_type				round_up_to_align( size_type val ) noexcept {
@@ -805,13 +2117,20 @@ namespace tiny_utf8
 		static inline data_type*			get_lut_base_ptr( data_type* buffer , size_type buffer_size ) noexcept { return buffer + buffer_size; }
 		static inline const data_type*		get_lut_base_ptr( const data_type* buffer , size_type buffer_size ) noexcept { return buffer + buffer_size; }
 		
-		//! Construct the lut mode indicator
+		//! Construct the lut mode indicator: ( lut_len << 2 ) | ( trusted << 1 ) | lut_active (the data is not trusted afterwards)
 		static inline void					set_lut_indiciator( data_type* lut_base_ptr , bool active , size_type lut_len = 0 ) noexcept {
-			*(indicator_type*)lut_base_ptr = active ? ( lut_len << 1 ) | 0x1 : 0;
+			if( !active )
+				TINY_UTF8_STAT( lut_drops );
+			*(indicator_type*)lut_base_ptr = active ? ( lut_len << 2 ) | 0x1 : 0;
 		}
-		//! Copy lut indicator
-		static inline void					copy_lut_indicator( data_type* dest , const data_type* source ) noexcept {
-			*(indicator_type*)dest = *(indicator_type*)source;
+		//! Mark the lut as deferred (see 'lut_deferred')
+		static inline void					set_lut_deferred( data_type* lut_base_ptr ) noexcept {
+			*(indicator_type*)lut_base_ptr = lut_deferred;
+		}
+		//! Copy lut indicator (a lut, that is being built by another thread, is deferred in the copy)
+		//! Only an inactive lut has a 'lut_building' flag, an active one holds its lut_len in these bits
+		static inline void					copy_lut_indicator( data_type* dest , indicator_type source_indicator ) noexcept {
+			*(indicator_type*)dest = source_indicator & 0x1 ? source_indicator : source_indicator & ~(indicator_type)lut_building;
 		}
 		
 		//! Determine, whether we will use a 'std::uint8_t', 'std::uint16_t', 'std::uint32_t' or 'std::uint64_t'-based index table.
@@ -828,8 +2147,11 @@ namespace tiny_utf8
 		}
 		
 		//! Determine, whether or not a LUT is worth to set up. General case: worth below 25%. If LUT present <33,3%, otherwise <16,7%
+		//! Strings that will have a jump table (see below) don't suffer from long luts: General case: worth below 33,3%. If LUT present <40%, otherwise <25%
 		static inline bool					is_lut_worth( size_type pot_lut_len , size_type string_len , bool lut_present , bool biased = true ) noexcept {
-			size_type threshold = biased ? ( lut_present ? string_len / 3u : string_len / 6u ) : string_len / 4u;
+			size_type threshold = string_len < jump_table_threshold
+				? ( biased ? ( lut_present ? string_len / 3u : string_len / 6u ) : string_len / 4u )
+				: ( biased ? ( lut_present ? string_len / 5u * 2u : string_len / 4u ) : string_len / 3u );
 			// Note pot_lut_len is supposed to underflow at '0'
 			return size_type( pot_lut_len - 1 ) < threshold;
 		}
@@ -850,10 +2172,88 @@ namespace tiny_utf8
 			return round_up_to_align( data_len + 1 ); // Make the buffer size_type-aligned
 		}
 		
-		//! Same as above but this time including the LUT indicator
+		/**
+		 * Large buffers are followed by a jump table, which allows to skip most of the lut (or data) during lookups:
+		 * [ <jump_table_indicator::size_type> | <entries>... ]
+		 * The indicator holds the number of valid entries and the lut mode the entries were created for: ( num_entries << 1 ) | lut_active
+		 * If the lut is active, entry 'k' holds the number of utf8 data bytes of the multibytes referenced by the first 'k+1' strides of the lut.
+		 * Otherwise, the data is split into chunks of 'jump_table_chunk' bytes and entry 'k' is a 'std::uint16_t' describing chunk 'k':
+		 * ( number of codepoints starting within the chunk << 3 ) | offset of the first codepoint starting within the chunk
+		 */
+		enum : size_type{	jump_table_threshold = 1024 , jump_table_stride = 64 , jump_table_chunk = 256 };
+		
+		//! The limits of 'from_bytes_parallel': Limit the number of tasks (whose results are held on the stack) and the minimum amount of data per task
+		enum : size_type{	max_parallel_tasks = 64 , min_parallel_task_size = 1 << 16 };
+		
+		//! Determine the size of the jump table following the lut indicator (zero, if the buffer is too small to benefit from one)
+		static inline size_type				get_jump_table_size( size_type main_buffer_size ) noexcept {
+			// Note: Each entry covers at least 'jump_table_stride' multibytes, that need at least 3 bytes each (lut entry included),
+			// or 'jump_table_chunk' bytes of data
+			return main_buffer_size < jump_table_threshold ? 0 : round_up_to_align( sizeof(indicator_type) + main_buffer_size / jump_table_stride + sizeof(std::uint64_t) );
+		}
+		
+		//! Same as above but this time including the LUT indicator (and the jump table)
 		static inline size_type				determine_total_buffer_size( size_type main_buffer_size ) noexcept {
-			return main_buffer_size + sizeof(indicator_type); // Add the lut indicator
+			return main_buffer_size + sizeof(indicator_type) + get_jump_table_size( main_buffer_size ); // Add the lut indicator and the jump table
+		}
+		
+		//! Get the jump table base pointer from the lut base ptr
+		static inline data_type*			get_jump_table_base_ptr( data_type* lut_base_ptr ) noexcept { return lut_base_ptr + sizeof(indicator_type); }
+		static inline const data_type*		get_jump_table_base_ptr( const data_type* lut_base_ptr ) noexcept { return lut_base_ptr + sizeof(indicator_type); }
+		
+		//! Get the number of valid jump table entries (given the buffer has a jump table)
+		static inline size_type				get_jump_table_len( const data_type* jump_table_base_ptr , bool lut_active ) noexcept {
+			indicator_type indicator = *(const indicator_type*)jump_table_base_ptr;
+			return ( indicator & 0x1 ) == (indicator_type)lut_active ? indicator >> 1 : 0;
+		}
+		
+		//! Set the jump table indicator
+		static inline void					set_jump_table_len( data_type* jump_table_base_ptr , bool lut_active , size_type num_entries ) noexcept {
+			*(indicator_type*)jump_table_base_ptr = ( num_entries << 1 ) | (indicator_type)lut_active;
+		}
+		
+		//! Get the pointer to a jump table entry
+		static inline data_type*			get_jump_table_entry_ptr( data_type* jump_table_base_ptr , width_type entry_width , size_type n ) noexcept {
+			return jump_table_base_ptr + sizeof(indicator_type) + n * entry_width;
 		}
+		static inline const data_type*		get_jump_table_entry_ptr( const data_type* jump_table_base_ptr , width_type entry_width , size_type n ) noexcept {
+			return jump_table_base_ptr + sizeof(indicator_type) + n * entry_width;
+		}
+		
+		//! Get the number of codepoints starting within the nth chunk (given the lut is inactive)
+		static inline size_type				get_jump_table_chunk_len( const data_type* jump_table_base_ptr , size_type n ) noexcept {
+			return *(const std::uint16_t*)get_jump_table_entry_ptr( jump_table_base_ptr , sizeof(std::uint16_t) , n ) >> 3;
+		}
+		
+		//! Get the byte index of the first codepoint starting within the nth chunk (given the lut is inactive)
+		static inline size_type				get_jump_table_chunk_start( const data_type* jump_table_base_ptr , size_type n ) noexcept {
+			return n * jump_table_chunk + ( *(const std::uint16_t*)get_jump_table_entry_ptr( jump_table_base_ptr , sizeof(std::uint16_t) , n ) & 0x7 );
+		}
+		
+		//! Set the description of the nth chunk (given the lut is inactive)
+		static inline void					set_jump_table_chunk( data_type* jump_table_base_ptr , size_type n , size_type num_codepoints , size_type offset ) noexcept {
+			*(std::uint16_t*)get_jump_table_entry_ptr( jump_table_base_ptr , sizeof(std::uint16_t) , n ) = (std::uint16_t)( ( num_codepoints << 3 ) | offset );
+		}
+		
+		//! Advance 'iter' over all codepoints starting before 'end' and return their number
+		static inline size_type				walk_codepoints( const data_type* buffer , size_type data_len , size_type& iter , size_type end ) noexcept {
+			size_type num_codepoints = 0;
+			while( iter < end ){
+				if( !( buffer[iter] & 0x80 ) ){ // Skip ASCII runs in bulk
+					size_type run = tiny_utf8_detail::ascii_prefix_len( (const unsigned char*)buffer + iter , end - iter );
+					iter += run;
+					num_codepoints += run;
+				}
+				else{
+					iter += basic_string::get_codepoint_bytes( buffer[iter] , data_len - iter );
+					++num_codepoints;
+				}
+			}
+			return num_codepoints;
+		}
+		
+		//! Describe the chunks [first,last) (given the lut is inactive), walking the data from the codepoint starting at 'iter' (at or before the first chunk)
+		static void							set_jump_table_chunks( const data_type* buffer , size_type data_len , data_type* jump_table_base_ptr , size_type iter , size_type first , size_type last ) noexcept ;
 		
 		//! Get the nth index within a multibyte index table
 		static inline size_type				get_lut( const data_type* iter , width_type lut_width ) noexcept {
@@ -875,7 +2275,51 @@ namespace tiny_utf8
 		
 		//! Get the LUT size (given the lut is active!)
 		static inline size_type				get_lut_len( const data_type* lut_base_ptr ) noexcept {
-			return *(indicator_type*)lut_base_ptr >> 1;
+			return basic_string::load_lut_indicator( lut_base_ptr ) >> 2;
+		}
+		
+		//! Get the nth entry of the lut (the lut grows from the lut indicator towards the data)
+		static inline size_type				get_lut_entry( const data_type* lut_base_ptr , width_type lut_width , size_type n ) noexcept {
+			return get_lut( lut_base_ptr - ( n + 1 ) * lut_width , lut_width );
+		}
+		
+		//! Get the number of lut entries that reference multibytes before the supplied byte index
+		static inline size_type				get_lut_rank( const data_type* lut_base_ptr , width_type lut_width , size_type lut_len , size_type byte_index ) noexcept {
+			size_type rank = 0;
+			while( lut_len > 0 ){ // Binary search
+				size_type half = lut_len / 2;
+				if( get_lut_entry( lut_base_ptr , lut_width , rank + half ) < byte_index )
+					rank += half + 1, lut_len -= half + 1;
+				else
+					lut_len = half;
+			}
+			return rank;
+		}
+		
+		//! Add 'delta' (possibly wrapped around, i.e. negative) to the 'num_indices' lut entries located right below 'lut_iter'
+		static inline void					shift_lut( data_type* lut_iter , width_type lut_width , size_type num_indices , size_type delta ) noexcept {
+			switch( lut_width ){
+			case sizeof(std::uint8_t):	tiny_utf8_detail::add_to_all( (std::uint8_t*)lut_iter - num_indices , num_indices , delta ); break;
+			case sizeof(std::uint16_t):	tiny_utf8_detail::add_to_all( (std::uint16_t*)lut_iter - num_indices , num_indices , delta ); break;
+			case sizeof(std::uint32_t):	tiny_utf8_detail::add_to_all( (std::uint32_t*)lut_iter - num_indices , num_indices , delta ); break;
+			case sizeof(std::uint64_t):	tiny_utf8_detail::add_to_all( (std::uint64_t*)lut_iter - num_indices , num_indices , delta ); break;
+			}
+		}
+		
+		//! Get a lower bound for the number of multibytes in data of 'data_len' bytes holding 'string_len' codepoints (no codepoint exceeds 7 bytes)
+		static inline size_type				get_min_lut_len( size_type data_len , size_type string_len ) noexcept {
+			return ( data_len - string_len + 5 ) / 6;
+		}
+		
+		//! Count the utf8 data bytes (i.e. all but the first byte) of the multibytes referenced by the lut entries [first,last)
+		static inline size_type				get_lut_data_bytes( const data_type* buffer , size_type data_len , const data_type* lut_base_ptr , width_type lut_width , size_type first , size_type last ) noexcept {
+			size_type			data_bytes = 0;
+			const data_type*	lut_iter = lut_base_ptr - first * lut_width;
+			for( ; first < last ; ++first ){
+				size_type multibyte_index = basic_string::get_lut( lut_iter -= lut_width , lut_width );
+				data_bytes += basic_string::get_codepoint_bytes( buffer[multibyte_index] , data_len - multibyte_index ) - 1;
+			}
+			return data_bytes;
 		}
 		
 		/**
@@ -934,6 +2378,18 @@ namespace tiny_utf8
 		//! Returns the number of bytes to expect before this one (including this one) that belong to this utf8 char
 		static width_type					get_num_bytes_of_utf8_char_before( const data_type* data_start , size_type index ) noexcept ;
 		
+		/**
+		 * Checks, whether any of the (up to 7) bytes before 'index', but not before 'lower_bound', is a lead byte
+		 * whose codepoint would span the byte at 'index'. If that is not the case, 'index' is guaranteed to be
+		 * the start of a codepoint (given that 'lower_bound' is one). For valid UTF-8 the reverse holds as well.
+		 */
+		static inline bool					is_spanned_by_lead_byte( const data_type* buffer , size_type index , size_type lower_bound , size_type data_len ) noexcept {
+			for( size_type lead_index = std::max( lower_bound , index > 7 ? index - 7 : 0 ) ; lead_index < index ; ++lead_index )
+				if( (unsigned char)buffer[lead_index] >= 0xC0 && lead_index + get_codepoint_bytes( buffer[lead_index] , data_len - lead_index ) > index )
+					return true;
+			return false;
+		}
+		
 		//! Decodes a given input of rle utf8 data to a unicode codepoint, given the number of bytes it's made of
 		static inline value_type			decode_utf8( const data_type* data , width_type num_bytes ) noexcept {
 			value_type cp = (unsigned char)*data;
@@ -956,6 +2412,21 @@ namespace tiny_utf8
 			return num_bytes;
 		}
 		
+		/**
+		 * Decodes up to 'capacity' codepoints of the supplied data exactly like 'decode_utf8_and_len' would.
+		 * Well-formed data is decoded 16 bytes at a time (SSE2), ASCII runs are copied in bulk,
+		 * and everything else (malformed data as well as codepoints of 5 to 7 bytes) is decoded one codepoint at a time.
+		 * 
+		 * @param	bytes_read	[out] The number of bytes decoded
+		 * @param	trusted		Whether the data is known to be valid UTF-8, in which case the blocks are not checked
+		 * @return	The number of codepoints written to 'dest'
+		 */
+		static size_type					decode_codepoints( const data_type* data , size_type data_len , value_type* dest , size_type capacity , size_type& bytes_read , bool trusted = false ) noexcept ;
+		
+		//! Decodes up to 'capacity' codepoints into any output iterator (via a temporary buffer) and returns the number of codepoints written
+		template<typename OutputIt>
+		static size_type					decode_codepoints( const data_type* data , size_type data_len , OutputIt dest , size_type capacity , bool trusted = false ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		
 		/**
 		 * Encodes a given codepoint (expected to use 'cp_bytes') to a character
 		 * buffer capable of holding that many bytes.
@@ -968,7 +2439,7 @@ namespace tiny_utf8
 				case 4: dest[cp_bytes-3] = 0x80 | ((cp >> 12) & 0x3F); TINY_UTF8_FALLTHROUGH
 				case 3: dest[cp_bytes-2] = 0x80 | ((cp >>  6) & 0x3F); TINY_UTF8_FALLTHROUGH
 				case 2: dest[cp_bytes-1] = 0x80 | ((cp >>  0) & 0x3F);
-					dest[0] = (unsigned char)( ( std::uint_least16_t(0xFF00uL) >> cp_bytes ) | ( cp >> ( 6 * cp_bytes - 6 ) ) );
+					dest[0] = (unsigned char)( ( std::uint_least16_t(0xFF00uL) >> cp_bytes ) | ( std::uint_least64_t(cp) >> ( 6 * cp_bytes - 6 ) ) ); // A seven byte lead shifts by 36 bits
 					break;
 				case 1:
 					dest[0] = (unsigned char)cp;
@@ -986,6 +2457,28 @@ namespace tiny_utf8
 			return width;
 		}
 		
+		/**
+		 * Skips the leading ASCII codepoints of a sequence of 'len' codepoints and returns their number.
+		 * This is only done in bulk for pointers. For other iterators, it is a no-op.
+		 */
+		template<typename ForwardIt>
+		static inline size_type				skip_ascii_codepoints( ForwardIt& , size_type ) noexcept { return 0; }
+		static inline size_type				skip_ascii_codepoints( const value_type*& str , size_type len ) noexcept {
+			size_type num_ascii = tiny_utf8_detail::ascii_codepoint_prefix_len( str , len );
+			str += num_ascii;
+			return num_ascii;
+		}
+		
+		//! Same as 'skip_ascii_codepoints', but also writes the skipped codepoints to 'dest' (and advances it)
+		template<typename ForwardIt>
+		static inline size_type				encode_ascii_codepoints( ForwardIt& , size_type , data_type*& ) noexcept { return 0; }
+		static inline size_type				encode_ascii_codepoints( const value_type*& str , size_type len , data_type*& dest ) noexcept {
+			size_type num_ascii = tiny_utf8_detail::narrow_ascii_codepoints( str , len , dest );
+			str += num_ascii;
+			dest += num_ascii;
+			return num_ascii;
+		}
+		
 	protected: //! Non-static helper methods
 		
 		//! Set the main buffer size (also disables SSO)
@@ -1055,8 +2548,78 @@ namespace tiny_utf8
 		//! Returns an std::string with the UTF-8 BOM prepended
 		std::basic_string<data_type> cpp_str_bom() const noexcept ;
 		
+		/**
+		 * Brings the jump table up to date after the buffer (i.e. data or lut) changed and resets the trusted bit (see 'trusted')
+		 * 
+		 * @note	Call this after every modification of a non-sso buffer. Freshly allocated buffers require 'first_changed_byte == 0'
+		 * @param	first_changed_byte	The byte index of the first byte that may have changed
+		 */
+		void				update_jump_table( size_type first_changed_byte ) noexcept ;
+		
+		//! Same as above for the supplied buffer and lut mode (the lut indicator is neither read nor modified)
+		static void			update_jump_table( data_type* buffer , size_type buffer_size , size_type data_len , bool lut_active , size_type lut_len , size_type first_changed_byte ) noexcept ;
+		
+		/**
+		 * Builds the deferred lut (see 'lut_deferred') along with the jump table, if it's worth it and fits into the buffer
+		 * 
+		 * @note	If another thread is building it already, this returns right away (the caller can still use the data)
+		 * @return	True, if the lut is active now
+		 */
+		#if defined(TINY_UTF8_LAZY_LUT)
+		bool				build_deferred_lut() const noexcept ;
+		#else
+		inline bool			build_deferred_lut() const noexcept { return false; }
+		#endif
+		
+		//! Copies the heap buffer of 'str' into the heap buffer of this string, which has the same layout
+		inline void			copy_heap_buffer( const basic_string& str ) noexcept {
+			#if defined(TINY_UTF8_LAZY_LUT)
+			// Another thread might be building the lut of 'str', so copy neither the lut nor the jump table
+			const data_type*	str_lut_base_ptr = basic_string::get_lut_base_ptr( str.t_non_sso.data , str.t_non_sso.buffer_size );
+			indicator_type		str_lut_indicator = basic_string::load_lut_indicator( str_lut_base_ptr );
+			if( ( str_lut_indicator & ( lut_deferred | 0x1 ) ) == lut_deferred ){
+				data_type* lut_base_ptr = basic_string::get_lut_base_ptr( t_non_sso.data , t_non_sso.buffer_size );
+				std::memcpy( t_non_sso.data , str.t_non_sso.data , str.t_non_sso.data_len + 1 );
+				basic_string::copy_lut_indicator( lut_base_ptr , str_lut_indicator );
+				if( basic_string::get_jump_table_size( t_non_sso.buffer_size ) )
+					basic_string::set_jump_table_len( basic_string::get_jump_table_base_ptr( lut_base_ptr ) , false , 0 );
+				return;
+			}
+			#endif
+			std::memcpy( t_non_sso.data , str.t_non_sso.data , basic_string::determine_total_buffer_size( str.t_non_sso.buffer_size ) );
+		}
+		
+		//! Count the utf8 data bytes of the multibytes referenced by the first 'num_entries' lut entries (requires an active lut)
+		size_type			get_lut_prefix_data_bytes( size_type num_entries ) const noexcept ;
+		
+		/**
+		 * Walks over all codepoints starting within [index,stop_index) as if the data ended at 'end_index', well-formed data in bulk.
+		 * @param	num_codepoints	[out] The number of codepoints walked over
+		 * @return	The byte index of the codepoint following them
+		 */
+		static size_type	walk_codepoints( const data_type* buffer , size_type index , size_type stop_index , size_type end_index , size_type& num_codepoints ) noexcept ;
+		
+		/**
+		 * Used to validate hits of byte-wise searches: Returns 'index', if it is the start of a codepoint,
+		 * or the start of the first codepoint after it otherwise (given that 'boundary' is the start of a codepoint before 'index')
+		 */
+		static inline size_type	get_codepoint_start_from( const data_type* buffer , size_type boundary , size_type index , size_type data_len ) noexcept {
+			if( !basic_string::is_spanned_by_lead_byte( buffer , index , boundary , data_len ) )
+				return index;
+			size_type num_codepoints;
+			return basic_string::walk_codepoints( buffer , boundary , index , data_len , num_codepoints );
+		}
+		
+		/**
+		 * Finds the first codepoint 'cp' starting at or after (find) or at or before (rfind) the byte 'index'
+		 * within the supplied data by searching for its encoded bytes and skipping hits inside other codepoints
+		 */
+		static size_type	find_codepoint( const data_type* buffer , size_type data_len , value_type cp , size_type index ) noexcept ;
+		static size_type	rfind_codepoint( const data_type* buffer , size_type data_len , value_type cp , size_type index ) noexcept ;
+		
 		//! Allocates size_type-aligned storage (make sure, total_buffer_size is a multiple of sizeof(size_type)!)
 		inline data_type*		allocate( size_type total_buffer_size ) const noexcept {
+			TINY_UTF8_STAT( allocations );
 			using appropriate_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<size_type>;
 			appropriate_allocator	casted_allocator = (const Allocator&)*this;
 			return reinterpret_cast<data_type*>(
@@ -1069,19 +2632,147 @@ namespace tiny_utf8
 		
 		//! Allocates size_type-aligned storage (make sure, buffer_size is a multiple of sizeof(size_type)!)
 		inline void			deallocate( data_type* buffer , size_type buffer_size ) const noexcept {
+			deallocate_total( buffer , basic_string::determine_total_buffer_size( buffer_size ) );
+		}
+		inline void			deallocate_total( data_type* buffer , size_type total_buffer_size ) const noexcept {
+			TINY_UTF8_STAT( deallocations );
 			using appropriate_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<size_type>;
 			appropriate_allocator	casted_allocator = (const Allocator&)*this;
 			std::allocator_traits<appropriate_allocator>::deallocate(
 				casted_allocator
 				, reinterpret_cast<size_type*>( buffer )
-				, basic_string::determine_total_buffer_size( buffer_size ) / sizeof(size_type) * sizeof(data_type)
+				, total_buffer_size / sizeof(size_type) * sizeof(data_type)
 			);
 		}
 		
+		//! Allocator propagation, as specified by std::allocator_traits<Allocator>::propagate_on_container_*
+		typedef typename std::allocator_traits<Allocator>::propagate_on_container_copy_assignment	propagate_on_copy_assignment;
+		typedef typename std::allocator_traits<Allocator>::propagate_on_container_move_assignment	propagate_on_move_assignment;
+		typedef typename std::allocator_traits<Allocator>::propagate_on_container_swap				propagate_on_swap;
+		
+		//! Checks, whether buffers allocated by the allocator of 'str' may be deallocated by the allocator of this basic_string
+		inline bool			allocator_equals( const basic_string& str ) const noexcept {
+			return tiny_utf8_detail::allocator_is_always_equal<Allocator>::value || (const allocator_type&)*this == (const allocator_type&)str;
+		}
+		
+		//! Copy, move or swap the allocator, if it propagates (allocators like std::pmr::polymorphic_allocator cannot even be assigned)
+		inline void			copy_allocator( const basic_string& str , std::true_type ) { (allocator_type&)*this = (const allocator_type&)str; }
+		inline void			copy_allocator( const basic_string& , std::false_type ) noexcept {}
+		inline void			move_allocator( basic_string& str , std::true_type ) { (allocator_type&)*this = (allocator_type&&)str; }
+		inline void			move_allocator( basic_string& , std::false_type ) noexcept {}
+		inline void			swap_allocator( basic_string& str , std::true_type ) { using std::swap; swap( (allocator_type&)*this , (allocator_type&)str ); }
+		inline void			swap_allocator( basic_string& , std::false_type ) noexcept {}
+		
+		//! Counts the multibytes (return value) and the codepoints of the supplied data
+		static size_type	count_multibytes( const data_type* str , size_type data_len , size_type& string_len ) noexcept ;
+		
+		/**
+		 * Appends data, whose codepoints and multibytes have been counted already, to a string that won't fit into the sso buffer afterwards
+		 * 
+		 * @param	app_lut_base_ptr	The lut base of the data's buffer to copy the indices from, or nullptr to collect them from the data
+		 * @param	app_lut_width		The width of the lut entries at 'app_lut_base_ptr'
+		 * @param	lut_len_hint		The supposed number of multibytes of this string (npos, if unknown). This avoids counting them,
+		 *								if they are too many for a lut anyway. A wrong hint only affects whether a lut is built
+		 */
+		basic_string&		append_data( const data_type* app_buffer , size_type app_data_len , size_type app_string_len , size_type app_lut_len , const data_type* app_lut_base_ptr , width_type app_lut_width , size_type lut_len_hint = npos ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		//! Appends UTF-8 data like 'append( str , data_len )' given a hint on the number of multibytes of this string (see 'append_data') and returns the number of multibytes appended
+		size_type			append_bytes( const data_type* str , size_type data_len , size_type lut_len_hint = npos ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		static inline size_type		count_multibytes( const basic_string& str ) noexcept {
+			size_type string_len;
+			return str.sso_inactive() && str.lut_active() ? basic_string::get_lut_len( basic_string::get_lut_base_ptr( str.t_non_sso.data , str.t_non_sso.buffer_size ) ) : count_multibytes( str.data() , str.size() , string_len );
+		}
+		
+		//! Implementation of 'replace_all' for 'num_replacements' pairs of patterns (.first) and replacements (.second)
+		template<typename Pair>
+		basic_string&		replace_all( const Pair* replacements , size_type num_replacements ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		//! Finds the first byte index at or after 'index', where one of the patterns matches (its index is stored in 'which')
+		template<typename Pair>
+		static size_type	find_replacement( const data_type* buffer , size_type data_len , size_type index , const Pair* replacements , size_type num_replacements , const std::uint64_t (&first_bytes)[4] , size_type& which ) noexcept ;
+		
+		//! Takes over a heap buffer with the supplied layout and metrics (the string must be empty).
+		//! The lut is built in place, if it's worth it and fits into the spare capacity behind the trailing '\0'
+		void				assign_heap_buffer( data_type* buffer , size_type buffer_size , size_type data_len , size_type string_len , size_type num_multibytes ) noexcept ;
+		
+		//! Fills the lut in front of 'lut_base_ptr' with the indices of all multibytes of the supplied data
+		static void			fill_lut( data_type* lut_base_ptr , width_type lut_width , const data_type* str , size_type data_len ) noexcept ;
+		
+		//! Same as above, but only for the multibytes within the bytes [index,end) of the data, where 'index' must be the start of a codepoint
+		static data_type*	fill_lut( data_type* lut_iter , width_type lut_width , const data_type* str , size_type index , size_type end ) noexcept ;
+		
 		//! Constructs an basic_string from a character literal
 		basic_string( const data_type* str , size_type pos , size_type count , size_type data_left , const allocator_type& alloc , tiny_utf8_detail::read_codepoints_tag ) noexcept(TINY_UTF8_NOEXCEPT) ;
 		basic_string( const data_type* str , size_type count , const allocator_type& alloc , tiny_utf8_detail::read_bytes_tag ) noexcept(TINY_UTF8_NOEXCEPT) ;
 		
+		//! Constructs an basic_string from a range of codepoints (forward iterators are measured upfront, input iterators are appended one by one)
+		template<typename InputIt>
+		basic_string( InputIt first , InputIt last , const allocator_type& alloc , std::forward_iterator_tag )
+			noexcept(TINY_UTF8_NOEXCEPT)
+			: basic_string( alloc )
+		{
+			size_type len = (size_type)std::distance( first , last );
+			if( len )
+				init_from_codepoints( first , len );
+		}
+		template<typename InputIt>
+		basic_string( InputIt first , InputIt last , const allocator_type& alloc , std::input_iterator_tag )
+			noexcept(TINY_UTF8_NOEXCEPT)
+			: Allocator( alloc ) 
+			, t_sso()
+		{
+			while( first != last ) push_back( *first++ );
+		}
+		
+		/**
+		 * Fills an empty basic_string with the encoded 'string_len' codepoints starting at 'first' in two passes:
+		 * The first one determines the exact buffer size and whether a lut is worth it, the second encodes the codepoints (and fills the lut)
+		 */
+		template<typename ForwardIt>
+		void init_from_codepoints( ForwardIt first , size_type string_len ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		//! Fills an empty basic_string with 'data_len' bytes of UTF-8 data, whose codepoints and multibytes have already been counted
+		void init_from_bytes( const data_type* str , size_type data_len , size_type string_len , size_type num_multibytes ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		/**
+		 * Describes a piece of a concatenation (see 'concat' and 'join'). The bytes of a codepoint are held by 'encoded' ('data' is nullptr then).
+		 * 'num_multibytes' is npos, if it wasn't counted, in which case the lut entries of the piece are found while copying it.
+		 */
+		struct concat_piece
+		{
+			const data_type*	data;
+			size_type			data_len;
+			size_type			string_len;
+			size_type			num_multibytes;
+			const data_type*	lut_base_ptr;	// The active lut of a basic_string, whose entries are taken over, or nullptr
+			width_type			lut_width;
+			data_type			encoded[8];
+		};
+		
+		//! Describes a basic_string, a view, a null-terminated UTF-8 sequence or a codepoint as piece of a concatenation
+		static concat_piece make_concat_piece( const basic_string& str , bool count = true ) noexcept ;
+		static concat_piece make_concat_piece( string_view view , bool count = true ) noexcept ;
+		static inline concat_piece make_concat_piece( const data_type* str , bool count = true ) noexcept { return basic_string::make_concat_piece( string_view( str ) , count ); }
+		static concat_piece make_concat_piece( value_type cp , bool count = true ) noexcept ;
+		
+		//! Adds the size and counts of 'piece' to 'total'
+		static inline void add_concat_piece( concat_piece& total , const concat_piece& piece ) noexcept {
+			total.data_len += piece.data_len;
+			total.string_len += piece.string_len;
+			total.num_multibytes += piece.num_multibytes;
+		}
+		
+		/**
+		 * Sets up an empty basic_string to hold a concatenation, whose pieces sum up to 'total', with a single allocation
+		 * 
+		 * @param	lut_iter	Receives the lut to be filled by 'write_concat_piece' or nullptr, if the lut is inactive
+		 * @return	False, if the allocation failed
+		 */
+		bool init_concat( const concat_piece& total , data_type*& lut_iter ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		//! Copies the next piece of a concatenation to the byte 'offset' and merges its lut entries (shifted by 'offset') into the lut
+		void write_concat_piece( const concat_piece& piece , size_type& offset , data_type*& lut_iter ) noexcept ;
+		
 	public:
 		
 		/**
@@ -1197,6 +2888,37 @@ namespace tiny_utf8
 			noexcept(TINY_UTF8_NOEXCEPT)
 			: basic_string( str , pos , len , LITLEN - ( str[LITLEN-1] ? 0 : 1 ) , alloc , tiny_utf8_detail::read_codepoints_tag() )
 		{}
+		/**
+		 * Constructor taking a basic_string_literal
+		 * 
+		 * @note	Creates an Instance of type basic_string holding the data of the supplied literal. Since its length
+		 *			and number of multibytes are already known, the data is only copied and the lut is filled in one pass
+		 * @param	lit		The literal to fill the basic_string with (e.g. "Hello ツ"_tu8)
+		 * @param	alloc	(Optional) The allocator instance to use
+		 */
+		inline basic_string( const string_literal& lit , const allocator_type& alloc = allocator_type() )
+			noexcept(TINY_UTF8_NOEXCEPT)
+			: basic_string( alloc )
+		{
+			if( lit.size() )
+				init_from_bytes( lit.data() , lit.size() , lit.length() , lit.num_multibytes() );
+		}
+		/**
+		 * Constructor taking UTF-8 data, that is validated (see 'trusted')
+		 * 
+		 * @note	Creates an Instance of type basic_string holding the supplied data, like 'basic_string( str , data_len )'.
+		 *			The validation also counts the codepoints and multibytes. If the data is valid UTF-8, the string is trusted
+		 *			(given it doesn't fit into the sso buffer), otherwise it is counted once more and constructed as usual
+		 * @param	str			The UTF-8 data to fill the basic_string with
+		 * @param	data_len	The number of bytes of the data
+		 * @param	alloc		(Optional) The allocator instance to use
+		 */
+		basic_string( const data_type* str , size_type data_len , validate_utf8_t , const allocator_type& alloc = allocator_type() ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		template<typename C, typename A>
+		inline basic_string( const std::basic_string<data_type, C, A>& str , validate_utf8_t , const allocator_type& alloc = allocator_type() )
+			noexcept(TINY_UTF8_NOEXCEPT)
+			: basic_string( str.data() , str.size() , validate_utf8 , alloc )
+		{}
 		/**
 		 * Constructor taking an std::string
 		 * 
@@ -1205,7 +2927,7 @@ namespace tiny_utf8
 		 * @param	alloc	(Optional) The allocator instance to use
 		 */
 		template<typename C, typename A>
-		inline basic_string( std::basic_string<data_type, C, A> str , const allocator_type& alloc = allocator_type() )
+		inline basic_string( const std::basic_string<data_type, C, A>& str , const allocator_type& alloc = allocator_type() )
 			noexcept(TINY_UTF8_NOEXCEPT)
 			: basic_string( str.data() , str.size() , alloc , tiny_utf8_detail::read_bytes_tag() )
 		{}
@@ -1218,15 +2940,26 @@ namespace tiny_utf8
 		 * @param	alloc	(Optional) The allocator instance to use
 		 */
 		template<typename C, typename A>
-		inline basic_string( std::basic_string<data_type, C, A> str , size_type len , const allocator_type& alloc = allocator_type() )
+		inline basic_string( const std::basic_string<data_type, C, A>& str , size_type len , const allocator_type& alloc = allocator_type() )
 			noexcept(TINY_UTF8_NOEXCEPT)
 			: basic_string( str.data() , 0 , len , str.size() , alloc , tiny_utf8_detail::read_codepoints_tag() )
 		{}
 		template<typename C, typename A>
-		inline basic_string( std::basic_string<data_type, C, A> str , size_type pos , size_type len , const allocator_type& alloc = allocator_type() )
+		inline basic_string( const std::basic_string<data_type, C, A>& str , size_type pos , size_type len , const allocator_type& alloc = allocator_type() )
 			noexcept(TINY_UTF8_NOEXCEPT)
 			: basic_string( str.data() , pos , len , str.size() , alloc , tiny_utf8_detail::read_codepoints_tag() )
 		{}
+		/**
+		 * Constructor taking a basic_string_view
+		 * 
+		 * @note	Creates an Instance of type basic_string copying the viewed data
+		 * @param	view	The view whose data will be copied (interpreted as UTF-8)
+		 * @param	alloc	(Optional) The allocator instance to use
+		 */
+		explicit inline basic_string( string_view view , const allocator_type& alloc = allocator_type() )
+			noexcept(TINY_UTF8_NOEXCEPT)
+			: basic_string( view.data() , view.size() , alloc , tiny_utf8_detail::read_bytes_tag() )
+		{}
 		/**
 		 * Constructor that fills the string with a certain amount of codepoints
 		 * 
@@ -1268,28 +3001,25 @@ namespace tiny_utf8
 		template<typename InputIt>
 		basic_string( InputIt first , InputIt last , const allocator_type& alloc = allocator_type() )
 			noexcept(TINY_UTF8_NOEXCEPT)
-			: Allocator( alloc ) 
-			, t_sso()
-		{
-			while( first != last ) push_back( *first++ );
-		}
+			: basic_string( first , last , alloc , typename std::iterator_traits<InputIt>::iterator_category() )
+		{}
 		/**
 		 * Copy Constructor that copies the supplied basic_string to construct the string
 		 * 
-		 * @note	Creates an Instance of type basic_string that has the exact same data and allocator as 'str'
+		 * @note	Creates an Instance of type basic_string that has the exact same data as 'str'
+		 *			The allocator is obtained through std::allocator_traits<Allocator>::select_on_container_copy_construction
 		 * @param	str		The basic_string to copy from
 		 */
 		basic_string( const basic_string& str )
 			noexcept(TINY_UTF8_NOEXCEPT)
-			: Allocator( (const allocator_type&)str )
+			: Allocator( std::allocator_traits<Allocator>::select_on_container_copy_construction( (const allocator_type&)str ) )
 		{
 			std::memcpy( (void*)&this->t_sso , (void*)&str.t_sso , sizeof(SSO) ); // Copy data
 			
 			// Create a new buffer, if sso is not active
 			if( str.sso_inactive() ){
-				size_type total_buffer_size = basic_string::determine_total_buffer_size( t_non_sso.buffer_size );
-				t_non_sso.data = this->allocate( total_buffer_size );
-				std::memcpy( t_non_sso.data , str.t_non_sso.data , total_buffer_size );
+				t_non_sso.data = this->allocate( basic_string::determine_total_buffer_size( t_non_sso.buffer_size ) );
+				copy_heap_buffer( str );
 			}
 		}
 		/**
@@ -1307,9 +3037,8 @@ namespace tiny_utf8
 			
 			// Create a new buffer, if sso is not active
 			if( str.sso_inactive() ){
-				size_type total_buffer_size = basic_string::determine_total_buffer_size( t_non_sso.buffer_size );
-				t_non_sso.data = this->allocate( total_buffer_size );
-				std::memcpy( t_non_sso.data , str.t_non_sso.data , total_buffer_size );
+				t_non_sso.data = this->allocate( basic_string::determine_total_buffer_size( t_non_sso.buffer_size ) );
+				copy_heap_buffer( str );
 			}
 		}
 		/**
@@ -1383,14 +3112,23 @@ namespace tiny_utf8
 		 * Move Constructor that moves the supplied basic_string content into the new basic_string
 		 * 
 		 * @note	Creates an Instance of type basic_string that takes all data from 'str'
+		 *			If 'alloc' does not compare equal to the allocator of 'str', the buffer of 'str' is copied instead
 		 * 			The supplied basic_string is invalid afterwards and may not be used anymore
 		 * @param	str		The basic_string to move from
+		 * @param	alloc	The new allocator instance to use
 		 */
 		inline basic_string( basic_string&& str , const allocator_type& alloc )
 			noexcept(TINY_UTF8_NOEXCEPT && std::is_nothrow_copy_constructible<Allocator>())
 			: Allocator( alloc )
 		{
 			std::memcpy( (void*)&this->t_sso , (void*)&str.t_sso , sizeof(SSO) ); // Copy data
+			
+			// The buffer of 'str' can only be taken over, if our allocator is able to deallocate it
+			if( str.sso_inactive() && !allocator_equals( str ) ){
+				t_non_sso.data = this->allocate( basic_string::determine_total_buffer_size( t_non_sso.buffer_size ) );
+				copy_heap_buffer( str );
+				return;
+			}
 			str.set_sso_data_len( 0u ); // Reset old string and enable its SSO-mode (which makes it not care about the buffer anymore)
 		}
 		
@@ -1415,14 +3153,19 @@ namespace tiny_utf8
 		 * Move Assignment operator that moves all data out of the supplied and into this basic_string
 		 * 
 		 * @note	Moves all data from 'str' into this basic_string deleting all data that previously was in there
+		 *			If the allocator does not propagate and compares unequal to the one of 'str', the data is copied instead
 		 *			The supplied basic_string is invalid afterwards and may not be used anymore
 		 * @param	str		The basic_string to move from
 		 * @return	A reference to the string now holding the data (*this)
 		 */
 		inline basic_string& operator=( basic_string&& str ) noexcept(TINY_UTF8_NOEXCEPT && std::is_nothrow_move_assignable<Allocator>()) {
 			if( &str != this ){
+				if( !propagate_on_move_assignment::value && !allocator_equals( str ) ){
+					basic_string( str , (const allocator_type&)*this ).swap( *this );
+					return *this;
+				}
 				clear(); // Reset old data
-				(allocator_type&)*this = (allocator_type&&)str; // Move allocator
+				this->move_allocator( str , propagate_on_move_assignment() ); // Move allocator
 				std::memcpy( (void*)&this->t_sso , (void*)&str.t_sso , sizeof(SSO) ); // Copy data
 				str.set_sso_data_len(0); // Reset old string and enable its SSO-mode (which makes it not care about the buffer anymore)
 			}
@@ -1467,9 +3210,9 @@ namespace tiny_utf8
 			if( &str != this ){
 				data_type tmp[sizeof(SSO)];
 				std::memcpy( &tmp , (void*)&str.t_sso , sizeof(SSO) );
-				std::memcpy( (void*)&str , (void*)&this->t_sso , sizeof(SSO) );
+				std::memcpy( (void*)&str.t_sso , (void*)&this->t_sso , sizeof(SSO) );
 				std::memcpy( (void*)&this->t_sso , &tmp , sizeof(SSO) );
-				std::swap( (allocator_type&)*this , (allocator_type&)str ); // Swap Allocators
+				this->swap_allocator( str , propagate_on_swap() ); // Swap Allocators
 			}
 		}
 		
@@ -1632,7 +3375,7 @@ namespace tiny_utf8
 		 * @return	An iterator class pointing to the beginning of this basic_string
 		 */
 		inline iterator begin() noexcept { return { 0 , this }; }
-		inline const_iterator begin() const noexcept { return { 0 , this }; }
+		inline const_iterator begin() const noexcept { return { 0 , this , 0 }; }
 		inline raw_iterator raw_begin() noexcept { return { 0 , this }; }
 		inline raw_const_iterator raw_begin() const noexcept { return { 0 , this }; }
 		/**
@@ -1641,7 +3384,7 @@ namespace tiny_utf8
 		 * @return	An iterator class pointing to the end of this basic_string, that is pointing behind the last codepoint
 		 */
 		inline iterator end() noexcept { return { (difference_type)length() , this }; }
-		inline const_iterator end() const noexcept { return { (difference_type)length() , this }; }
+		inline const_iterator end() const noexcept { return { (difference_type)length() , this , (difference_type)size() }; }
 		inline raw_iterator raw_end() noexcept { return { (difference_type)size() , this }; }
 		inline raw_const_iterator raw_end() const noexcept { return { (difference_type)size() , this }; }
 		
@@ -1652,7 +3395,7 @@ namespace tiny_utf8
 		 *			that is exactly to the last codepoint
 		 */
 		inline reverse_iterator rbegin() noexcept { return { (difference_type)length() - 1 , this }; }
-		inline const_reverse_iterator rbegin() const noexcept { return { (difference_type)length() - 1 , this }; }
+		inline const_reverse_iterator rbegin() const noexcept { return { (difference_type)length() - 1 , this , (difference_type)raw_back_index() }; }
 		inline raw_reverse_iterator raw_rbegin() noexcept { return { (difference_type)raw_back_index() , this }; }
 		inline raw_const_reverse_iterator raw_rbegin() const noexcept { return { (difference_type)raw_back_index() , this }; }
 		/**
@@ -1673,7 +3416,7 @@ namespace tiny_utf8
 		 * @return	A const iterator class pointing to the beginning of this basic_string,
 		 * 			which cannot alter things inside this basic_string
 		 */
-		inline const_iterator cbegin() const noexcept { return { 0 , this }; }
+		inline const_iterator cbegin() const noexcept { return { 0 , this , 0 }; }
 		inline raw_const_iterator raw_cbegin() const noexcept { return { 0 , this }; }
 		/**
 		 * Get an iterator to the end of the basic_string
@@ -1681,7 +3424,7 @@ namespace tiny_utf8
 		 * @return	A const iterator class, which cannot alter this basic_string, pointing to
 		 *			the end of this basic_string, that is pointing behind the last codepoint
 		 */
-		inline const_iterator cend() const noexcept { return { (difference_type)length() , this }; }
+		inline const_iterator cend() const noexcept { return { (difference_type)length() , this , (difference_type)size() }; }
 		inline raw_const_iterator raw_cend() const noexcept { return { (difference_type)size() , this }; }
 		
 		
@@ -1691,7 +3434,7 @@ namespace tiny_utf8
 		 * @return	A const reverse iterator class, which cannot alter this basic_string, pointing to
 		 *			the end of this basic_string, that is exactly to the last codepoint
 		 */
-		inline const_reverse_iterator crbegin() const noexcept { return { (difference_type)length() - 1 , this }; }
+		inline const_reverse_iterator crbegin() const noexcept { return { (difference_type)length() - 1 , this , (difference_type)raw_back_index() }; }
 		inline raw_const_reverse_iterator raw_crbegin() const noexcept { return { (difference_type)raw_back_index() , this }; }
 		/**
 		 * Get a const reverse iterator to the beginning of this basic_string
@@ -1746,10 +3489,10 @@ namespace tiny_utf8
 		 * @return	A reference to this basic_string, which now has the replaced part in it
 		 */
 		inline basic_string& replace( size_type index , size_type len , value_type repl , size_type n ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return replace( index , len , basic_string( n , repl ) );
+			return replace( index , len , basic_string( n , repl , get_allocator() ) );
 		}
 		inline basic_string& replace( size_type index , size_type len , value_type repl ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return replace( index , len , basic_string( repl ) );
+			return replace( index , len , basic_string( repl , get_allocator() ) );
 		}
 		/**
 		 * Replace a range of codepoints by a number of codepoints
@@ -1761,10 +3504,10 @@ namespace tiny_utf8
 		 * @return	A reference to this basic_string, which now has the replaced part in it
 		 */
 		inline basic_string& replace( raw_iterator first , raw_iterator last , value_type repl , size_type n ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return raw_replace( first.get_raw_index() , last.get_raw_index() - first.get_raw_index() , basic_string( n , repl ) );
+			return raw_replace( first.get_raw_index() , last.get_raw_index() - first.get_raw_index() , basic_string( n , repl , get_allocator() ) );
 		}
 		inline basic_string& replace( raw_iterator first , raw_iterator last , value_type repl ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return raw_replace( first.get_raw_index() , last.get_raw_index() - first.get_raw_index() , basic_string( repl ) );
+			return raw_replace( first.get_raw_index() , last.get_raw_index() - first.get_raw_index() , basic_string( repl , get_allocator() ) );
 		}
 		inline basic_string& replace( raw_iterator first , iterator last , value_type repl , size_type n ) noexcept(TINY_UTF8_NOEXCEPT) { return replace( first , (raw_iterator)last , repl , n ); }
 		inline basic_string& replace( iterator first , raw_iterator last , value_type repl , size_type n ) noexcept(TINY_UTF8_NOEXCEPT) { return replace( (raw_iterator)first , last , repl , n ); }
@@ -1813,6 +3556,29 @@ namespace tiny_utf8
 		 * @return	A reference to this basic_string, which now has the replaced part in it
 		 */
 		basic_string& raw_replace( size_type start_byte , size_type byte_count , const basic_string& repl ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		/**
+		 * Replaces all (non-overlapping) occurences of 'pattern' with 'repl'
+		 * 
+		 * @note	The result is written into a new buffer in a single pass, whose lut is built once
+		 * @param	pattern		The pattern to look for (an empty pattern matches nothing)
+		 * @param	repl		The basic_string to replace all occurences with
+		 * @return	A reference to this basic_string, which now has all occurences replaced
+		 */
+		inline basic_string& replace_all( const basic_string& pattern , const basic_string& repl ) noexcept(TINY_UTF8_NOEXCEPT) {
+			std::pair<const basic_string&, const basic_string&> replacement( pattern , repl );
+			return replace_all( &replacement , 1 );
+		}
+		/**
+		 * Replaces all occurences of several patterns at once (e.g. { { "&" , "&amp;" } , { "<" , "&lt;" } })
+		 * 
+		 * @note	The data is scanned once from left to right. If several patterns match at the same position,
+		 *			the one listed first is replaced. Replacements are not scanned again
+		 * @param	replacements	The pairs of patterns and their replacements
+		 * @return	A reference to this basic_string, which now has all occurences replaced
+		 */
+		inline basic_string& replace_all( std::initializer_list<std::pair<basic_string, basic_string>> replacements ) noexcept(TINY_UTF8_NOEXCEPT) {
+			return replace_all( replacements.begin() , replacements.size() );
+		}
 		
 		
 		/**
@@ -1831,16 +3597,24 @@ namespace tiny_utf8
 		 */
 		basic_string& append( const basic_string& appendix ) noexcept(TINY_UTF8_NOEXCEPT) ;
 		inline basic_string& operator+=( const basic_string& appendix ) noexcept(TINY_UTF8_NOEXCEPT) { return append( appendix ); }
-		
-		
+		/**
+		 * Appends UTF-8 data to the end of this basic_string without constructing a basic_string from it first
+		 * 
+		 * @param	str			The UTF-8 data to append (possibly containing embedded zeros)
+		 * @param	data_len	The number of bytes to append
+		 * @return	A reference to this basic_string, which now has the supplied data appended
+		 */
+		inline basic_string& append( const data_type* str , size_type data_len ) noexcept(TINY_UTF8_NOEXCEPT) { append_bytes( str , data_len ); return *this; }
+		
+		
 		/**
 		 * Appends the supplied codepoint to the end of this basic_string
 		 * 
 		 * @param	cp	The codepoint to be appended
 		 * @return	A reference to this basic_string, which now has the supplied codepoint appended
 		 */
-		inline basic_string& push_back( value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) { return append( basic_string( cp ) ); }
-		inline basic_string& operator+=( value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) { return append( basic_string( cp ) ); }
+		inline basic_string& push_back( value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) { return append( basic_string( cp , get_allocator() ) ); }
+		inline basic_string& operator+=( value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) { return append( basic_string( cp , get_allocator() ) ); }
 		
 		
 		/**
@@ -1856,18 +3630,18 @@ namespace tiny_utf8
 		// with basic_string as first operand
 		friend inline basic_string operator+( basic_string lhs , data_type rhs ) noexcept(TINY_UTF8_NOEXCEPT) { lhs.push_back( rhs ); return lhs; }
 		friend inline basic_string operator+( basic_string lhs , value_type rhs ) noexcept(TINY_UTF8_NOEXCEPT) { lhs.push_back( rhs ); return lhs; }
-		template<typename T> friend inline enable_if_ptr<T, data_type, basic_string> operator+( basic_string lhs , T&& rhs ) noexcept(TINY_UTF8_NOEXCEPT) { lhs.append( basic_string( rhs ) ); return lhs; }
-		template<typename T> friend inline enable_if_ptr<T, value_type, basic_string> operator+( basic_string lhs , T&& rhs ) noexcept(TINY_UTF8_NOEXCEPT) { lhs.append( basic_string( rhs ) ); return lhs; }
-		template<size_type LITLEN> friend inline basic_string operator+( basic_string lhs , const data_type (&rhs)[LITLEN] ) noexcept(TINY_UTF8_NOEXCEPT) { lhs.append( basic_string( rhs ) ); return lhs; }
-		template<size_type LITLEN> friend inline basic_string operator+( basic_string lhs , const value_type (&rhs)[LITLEN] ) noexcept(TINY_UTF8_NOEXCEPT) { lhs.append( basic_string( rhs ) ); return lhs; }
+		template<typename T> friend inline enable_if_ptr<T, data_type, basic_string> operator+( basic_string lhs , T&& rhs ) noexcept(TINY_UTF8_NOEXCEPT) { lhs.append( basic_string( rhs , lhs.get_allocator() ) ); return lhs; }
+		template<typename T> friend inline enable_if_ptr<T, value_type, basic_string> operator+( basic_string lhs , T&& rhs ) noexcept(TINY_UTF8_NOEXCEPT) { lhs.append( basic_string( rhs , lhs.get_allocator() ) ); return lhs; }
+		template<size_type LITLEN> friend inline basic_string operator+( basic_string lhs , const data_type (&rhs)[LITLEN] ) noexcept(TINY_UTF8_NOEXCEPT) { lhs.append( basic_string( rhs , lhs.get_allocator() ) ); return lhs; }
+		template<size_type LITLEN> friend inline basic_string operator+( basic_string lhs , const value_type (&rhs)[LITLEN] ) noexcept(TINY_UTF8_NOEXCEPT) { lhs.append( basic_string( rhs , lhs.get_allocator() ) ); return lhs; }
 		
 		// With basic_string as second operand
 		friend inline basic_string operator+( data_type lhs , basic_string rhs ) noexcept(TINY_UTF8_NOEXCEPT) { rhs.raw_insert( 0 , lhs ); return rhs; }
 		friend inline basic_string operator+( value_type lhs , basic_string rhs ) noexcept(TINY_UTF8_NOEXCEPT) { rhs.raw_insert( 0 , lhs ); return rhs; }
-		template<typename T> friend inline enable_if_ptr<T, data_type, basic_string> operator+( T&& lhs , basic_string rhs ) noexcept(TINY_UTF8_NOEXCEPT) { rhs.prepend( basic_string( lhs ) ); return rhs; }
-		template<typename T> friend inline enable_if_ptr<T, value_type, basic_string> operator+( T&& lhs , basic_string rhs ) noexcept(TINY_UTF8_NOEXCEPT) { rhs.prepend( basic_string( lhs ) ); return rhs; }
-		template<size_type LITLEN> friend inline basic_string operator+( const data_type (&lhs)[LITLEN] , basic_string rhs ) noexcept(TINY_UTF8_NOEXCEPT) { rhs.prepend( basic_string( lhs ) ); return rhs; }
-		template<size_type LITLEN> friend inline basic_string operator+( const value_type (&lhs)[LITLEN] , basic_string rhs ) noexcept(TINY_UTF8_NOEXCEPT) { rhs.prepend( basic_string( lhs ) ); return rhs; }
+		template<typename T> friend inline enable_if_ptr<T, data_type, basic_string> operator+( T&& lhs , basic_string rhs ) noexcept(TINY_UTF8_NOEXCEPT) { rhs.prepend( basic_string( lhs , rhs.get_allocator() ) ); return rhs; }
+		template<typename T> friend inline enable_if_ptr<T, value_type, basic_string> operator+( T&& lhs , basic_string rhs ) noexcept(TINY_UTF8_NOEXCEPT) { rhs.prepend( basic_string( lhs , rhs.get_allocator() ) ); return rhs; }
+		template<size_type LITLEN> friend inline basic_string operator+( const data_type (&lhs)[LITLEN] , basic_string rhs ) noexcept(TINY_UTF8_NOEXCEPT) { rhs.prepend( basic_string( lhs , rhs.get_allocator() ) ); return rhs; }
+		template<size_type LITLEN> friend inline basic_string operator+( const value_type (&lhs)[LITLEN] , basic_string rhs ) noexcept(TINY_UTF8_NOEXCEPT) { rhs.prepend( basic_string( lhs , rhs.get_allocator() ) ); return rhs; }
 		
 		
 		/**
@@ -1878,7 +3652,7 @@ namespace tiny_utf8
 		 * @return	A reference to this basic_string, updated to the new string
 		 */
 		inline basic_string& assign( size_type count , value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return *this = basic_string( count , cp );
+			return *this = basic_string( count , cp , get_allocator() );
 		}
 		/**
 		 * Sets the contents of this string to a copy of the supplied basic_string
@@ -1898,7 +3672,7 @@ namespace tiny_utf8
 		 * @return	A reference to this basic_string, updated to the new string
 		 */
 		inline basic_string& assign( const basic_string& str , size_type pos , size_type count ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return *this = basic_string( str , pos , count );
+			return *this = basic_string( str , pos , count , get_allocator() );
 		}
 		/**
 		 * Moves the contents out of the supplied string into this one
@@ -1917,10 +3691,10 @@ namespace tiny_utf8
 		 */
 		template<typename T>
 		inline basic_string& assign( T&& str , enable_if_ptr<T, data_type>* = {} ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return *this = basic_string( str );
+			return *this = basic_string( str , get_allocator() );
 		}
 		inline basic_string& assign( const data_type* str , size_type len ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return *this = basic_string( str , len );
+			return *this = basic_string( str , len , get_allocator() );
 		}
 		/**
 		 * Assigns an utf8 char literal to this string (with possibly embedded '\0's)
@@ -1929,7 +3703,7 @@ namespace tiny_utf8
 		 */
 		template<size_type LITLEN>
 		inline basic_string& assign( const data_type (&str)[LITLEN] ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return *this = basic_string( str );
+			return *this = basic_string( str , get_allocator() );
 		}
 		/**
 		 * Assigns an utf-32 sequence and the maximum length to read from it (in number of codepoints) to this string
@@ -1939,10 +3713,10 @@ namespace tiny_utf8
 		 */
 		template<typename T>
 		inline basic_string& assign( T&& str , enable_if_ptr<T, value_type>* = {} ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return *this = basic_string( str );
+			return *this = basic_string( str , get_allocator() );
 		}
 		inline basic_string& assign( const value_type* str , size_type len ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return *this = basic_string( str , len );
+			return *this = basic_string( str , len , get_allocator() );
 		}
 		/**
 		 * Assigns an utf-32 char literal to this string (with possibly embedded '\0's)
@@ -1951,7 +3725,7 @@ namespace tiny_utf8
 		 */
 		template<size_type LITLEN>
 		inline basic_string& assign( const value_type (&str)[LITLEN] ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return *this = basic_string( str );
+			return *this = basic_string( str , get_allocator() );
 		}
 		/**
 		 * Assigns the range of codepoints supplied to this string. The resulting string will equal [first,last)
@@ -1962,7 +3736,7 @@ namespace tiny_utf8
 		 */
 		template<typename InputIt>
 		inline basic_string& assign( InputIt first , InputIt last ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return *this = basic_string( first , last );
+			return *this = basic_string( first , last , get_allocator() );
 		}
 		/**
 		 * Assigns the supplied initializer list of codepoints to this string.
@@ -1971,7 +3745,7 @@ namespace tiny_utf8
 		 * @param	ilist	The initializer list with the contents to be applied to this string
 		 */
 		inline basic_string& assign( std::initializer_list<value_type> ilist ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return *this = basic_string( std::move(ilist) );
+			return *this = basic_string( std::move(ilist) , get_allocator() );
 		}
 		
 		
@@ -2003,7 +3777,7 @@ namespace tiny_utf8
 		 * @return	A reference to this basic_string, with the supplied codepoint inserted
 		 */
 		inline basic_string& insert( raw_iterator it , value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return raw_insert( it.get_raw_index() , basic_string( cp ) );
+			return raw_insert( it.get_raw_index() , basic_string( cp , get_allocator() ) );
 		}
 		/**
 		 * Inserts a given basic_string into this basic_string at the supplied iterator position
@@ -2035,7 +3809,7 @@ namespace tiny_utf8
 		 * @return	A reference to this basic_string, with the supplied basic_string inserted
 		 */
 		inline basic_string& raw_insert( size_type pos , value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) {
-			return raw_insert( pos , basic_string( cp ) );
+			return raw_insert( pos , basic_string( cp , get_allocator() ) );
 		}
 		
 		
@@ -2131,6 +3905,40 @@ namespace tiny_utf8
 		basic_string raw_substr( size_type start_byte , size_type byte_count ) const noexcept(TINY_UTF8_NOEXCEPT) ;
 		
 		
+		/**
+		 * Returns a view of a portion of the basic_string (indexed on codepoint-base) without copying it
+		 * 
+		 * @note	The view is invalidated by any modification of this basic_string
+		 * @param	pos		The codepoint position where the view shall start
+		 * @param	len		The maximum number of codepoints that the view shall have
+		 * @return	The view of the specified codepoints
+		 */
+		string_view substr_view( size_type pos , size_type len = basic_string::npos ) const noexcept(TINY_UTF8_NOEXCEPT) {
+			size_type my_size = size(), byte_start = get_num_bytes_from_start( pos );
+			if( byte_start > my_size ){
+				TINY_UTF8_THROW( "tiny_utf8::basic_string::substr_view" , byte_start > my_size );
+				return {};
+			}
+			if( len == basic_string::npos )
+				return { get_buffer() + byte_start , my_size - byte_start , sso_inactive() ? get_non_sso_string_len() - pos : basic_string::npos };
+			size_type byte_count = std::min( get_num_bytes( byte_start , len ) , my_size - byte_start );
+			
+			// If the view ends before the end of the string, it holds exactly 'len' codepoints
+			return { get_buffer() + byte_start , byte_count , byte_start + byte_count < my_size ? len : basic_string::npos };
+		}
+		/**
+		 * Returns a view of a portion of the basic_string (indexed on byte-base) without copying it
+		 * 
+		 * @note	The view is invalidated by any modification of this basic_string
+		 * @param	start_byte		The byte position where the view shall start
+		 * @param	byte_count		The maximum number of bytes that the view shall have
+		 * @return	The view of the specified bytes
+		 */
+		string_view raw_substr_view( size_type start_byte , size_type byte_count = basic_string::npos ) const noexcept(TINY_UTF8_NOEXCEPT) {
+			return string_view( *this ).raw_substr( start_byte , byte_count );
+		}
+		
+		
 		/**
 		 * Finds a specific codepoint inside the basic_string starting at the supplied codepoint index
 		 * 
@@ -2141,10 +3949,11 @@ namespace tiny_utf8
 		size_type find( value_type cp , size_type start_codepoint = 0 ) const noexcept {
 			if( sso_inactive() && start_codepoint >= length() ) // length() is only O(1), if sso is inactive
 				return basic_string::npos;
-			for( const_iterator it = get(start_codepoint) , end = cend() ; it != end ; ++it, ++start_codepoint )
-				if( *it == cp )
-					return start_codepoint;
-			return basic_string::npos;
+			size_type actual_start = get_num_bytes_from_start( start_codepoint );
+			size_type result = raw_find( cp , actual_start );
+			if( result == basic_string::npos )
+				return basic_string::npos;
+			return start_codepoint + get_num_codepoints( actual_start , result - actual_start );
 		}
 		/**
 		 * Finds a specific pattern within the basic_string starting at the supplied codepoint index
@@ -2154,14 +3963,17 @@ namespace tiny_utf8
 		 * @return	The codepoint index where and if the pattern was found or basic_string::npos
 		 */
 		size_type find( const basic_string& pattern , size_type start_codepoint = 0 ) const noexcept {
-			if( sso_inactive() && start_codepoint >= length() ) // length() is only O(1), if sso is inactive
-				return basic_string::npos;
-			size_type actual_start = get_num_bytes_from_start( start_codepoint );
-			const data_type* buffer = get_buffer();
-			const data_type* result = std::strstr( buffer + actual_start , pattern.data() );
-			if( !result )
-				return basic_string::npos;
-			return start_codepoint + get_num_codepoints( actual_start , result - ( buffer + actual_start ) );
+			return find( pattern.data() , start_codepoint , pattern.size() );
+		}
+		/**
+		 * Finds a specific pattern within the basic_string starting at the supplied codepoint index
+		 * 
+		 * @param	pattern			The view of the pattern to look for
+		 * @param	start_codepoint	The index of the first codepoint to start looking from
+		 * @return	The codepoint index where and if the pattern was found or basic_string::npos
+		 */
+		size_type find( string_view pattern , size_type start_codepoint = 0 ) const noexcept {
+			return find( pattern.data() , start_codepoint , pattern.size() );
 		}
 		/**
 		 * Finds a specific pattern within the basic_string starting at the supplied codepoint index
@@ -2171,14 +3983,24 @@ namespace tiny_utf8
 		 * @return	The codepoint index where and if the pattern was found or basic_string::npos
 		 */
 		size_type find( const data_type* pattern , size_type start_codepoint = 0 ) const noexcept {
+			return find( pattern , start_codepoint , tiny_utf8_detail::strlen( pattern ) );
+		}
+		/**
+		 * Finds a specific pattern with possibly embedded zeros within the basic_string starting at the supplied codepoint index
+		 * 
+		 * @param	pattern			Pointer to the bytes to look for
+		 * @param	start_codepoint	The index of the first codepoint to start looking from
+		 * @param	pattern_size	The number of bytes of the pattern
+		 * @return	The codepoint index where and if the pattern was found or basic_string::npos
+		 */
+		size_type find( const data_type* pattern , size_type start_codepoint , size_type pattern_size ) const noexcept {
 			if( sso_inactive() && start_codepoint >= length() ) // length() is only O(1), if sso is inactive
 				return basic_string::npos;
 			size_type actual_start = get_num_bytes_from_start( start_codepoint );
-			const data_type* buffer = get_buffer();
-			const data_type* result = std::strstr( buffer + actual_start , pattern );
-			if( !result )
+			size_type result = raw_find( pattern , actual_start , pattern_size );
+			if( result == basic_string::npos )
 				return basic_string::npos;
-			return start_codepoint + get_num_codepoints( actual_start , result - ( buffer + actual_start ) );
+			return start_codepoint + get_num_codepoints( actual_start , result - actual_start );
 		}
 		/**
 		 * Finds a specific codepoint inside the basic_string starting at the supplied byte position
@@ -2188,13 +4010,7 @@ namespace tiny_utf8
 		 * @return	The byte position where and if the codepoint was found or basic_string::npos
 		 */
 		size_type raw_find( value_type cp , size_type start_byte = 0 ) const noexcept {
-			size_type my_size = size();
-			if( start_byte >= my_size )
-				return basic_string::npos;
-			for( const_iterator it = raw_get(start_byte) , end = raw_get(my_size) ; it != end ; ++it )
-				if( *it == cp )
-					return it - begin();
-			return basic_string::npos;
+			return basic_string::find_codepoint( get_buffer() , size() , cp , start_byte );
 		}
 		/**
 		 * Finds a specific pattern within the basic_string starting at the supplied byte position
@@ -2204,13 +4020,17 @@ namespace tiny_utf8
 		 * @return	The byte position where and if the pattern was found or basic_string::npos
 		 */
 		size_type raw_find( const basic_string& pattern , size_type start_byte = 0 ) const noexcept {
-			if( start_byte >= size() )
-				return basic_string::npos;
-			const data_type* buffer = get_buffer();
-			const data_type* result = std::strstr( buffer + start_byte , pattern.data() );
-			if( !result )
-				return basic_string::npos;
-			return result - buffer;
+			return raw_find( pattern.data() , start_byte , pattern.size() );
+		}
+		/**
+		 * Finds a specific pattern within the basic_string starting at the supplied byte position
+		 * 
+		 * @param	pattern		The view of the pattern to look for
+		 * @param	start_byte	The byte position of the first codepoint to start looking from
+		 * @return	The byte position where and if the pattern was found or basic_string::npos
+		 */
+		size_type raw_find( string_view pattern , size_type start_byte = 0 ) const noexcept {
+			return raw_find( pattern.data() , start_byte , pattern.size() );
 		}
 		/**
 		 * Finds a specific pattern within the basic_string starting at the supplied byte position
@@ -2220,13 +4040,27 @@ namespace tiny_utf8
 		 * @return	The byte position where and if the pattern was found or basic_string::npos
 		 */
 		size_type raw_find( const data_type* pattern , size_type start_byte = 0 ) const noexcept {
-			if( start_byte >= size() )
-				return basic_string::npos;
-			const data_type* buffer = get_buffer();
-			const data_type* result = std::strstr( buffer + start_byte , pattern );
-			if( !result )
+			return raw_find( pattern , start_byte , tiny_utf8_detail::strlen( pattern ) );
+		}
+		/**
+		 * Finds a specific pattern with possibly embedded zeros within the basic_string starting at the supplied byte position
+		 * 
+		 * @param	pattern			Pointer to the bytes to look for
+		 * @param	start_byte		The byte position of the first codepoint to start looking from
+		 * @param	pattern_size	The number of bytes of the pattern
+		 * @return	The byte position where and if the pattern was found or basic_string::npos
+		 */
+		size_type raw_find( const data_type* pattern , size_type start_byte , size_type pattern_size ) const noexcept {
+			size_type my_size = size();
+			if( start_byte >= my_size )
 				return basic_string::npos;
-			return result - buffer;
+			size_type result = tiny_utf8_detail::find_bytes(
+				(const unsigned char*)get_buffer() + start_byte
+				, my_size - start_byte
+				, (const unsigned char*)pattern
+				, pattern_size
+			);
+			return result == basic_string::npos ? basic_string::npos : start_byte + result;
 		}
 		
 		/**
@@ -2238,16 +4072,60 @@ namespace tiny_utf8
 		 * @return	The codepoint index where and if the codepoint was found or basic_string::npos
 		 */
 		size_type rfind( value_type cp , size_type start_codepoint = basic_string::npos ) const noexcept {
-			const_reverse_iterator  end = rend(), it;
-			size_type               string_len = length();
-			if( start_codepoint >= string_len )
-				it = crbegin(), start_codepoint = string_len - 1;
-			else
-				it = rget( start_codepoint );
-			for( ; it != end ; ++it, --start_codepoint )
-				if( *it == cp )
-					return start_codepoint;
-			return basic_string::npos;
+			size_type start_byte = start_codepoint < length() ? get_num_bytes_from_start( start_codepoint ) : basic_string::npos;
+			size_type result = raw_rfind( cp , start_byte );
+			if( result == basic_string::npos )
+				return basic_string::npos;
+			return get_num_codepoints( 0 , result );
+		}
+		/**
+		 * Finds the last occourence of a specific pattern inside the
+		 * basic_string, that starts at or before the supplied codepoint index
+		 * 
+		 * @param	pattern			The pattern to look for
+		 * @param	start_codepoint	The index of the last codepoint, at which the pattern may start
+		 * @return	The codepoint index where and if the pattern was found or basic_string::npos
+		 */
+		size_type rfind( const basic_string& pattern , size_type start_codepoint = basic_string::npos ) const noexcept {
+			return rfind( pattern.data() , start_codepoint , pattern.size() );
+		}
+		/**
+		 * Finds the last occourence of a specific pattern inside the
+		 * basic_string, that starts at or before the supplied codepoint index
+		 * 
+		 * @param	pattern			The view of the pattern to look for
+		 * @param	start_codepoint	The index of the last codepoint, at which the pattern may start
+		 * @return	The codepoint index where and if the pattern was found or basic_string::npos
+		 */
+		size_type rfind( string_view pattern , size_type start_codepoint = basic_string::npos ) const noexcept {
+			return rfind( pattern.data() , start_codepoint , pattern.size() );
+		}
+		/**
+		 * Finds the last occourence of a specific pattern inside the
+		 * basic_string, that starts at or before the supplied codepoint index
+		 * 
+		 * @param	pattern			The pattern to look for
+		 * @param	start_codepoint	The index of the last codepoint, at which the pattern may start
+		 * @return	The codepoint index where and if the pattern was found or basic_string::npos
+		 */
+		size_type rfind( const data_type* pattern , size_type start_codepoint = basic_string::npos ) const noexcept {
+			return rfind( pattern , start_codepoint , tiny_utf8_detail::strlen( pattern ) );
+		}
+		/**
+		 * Finds the last occourence of a specific pattern with possibly embedded zeros inside the
+		 * basic_string, that starts at or before the supplied codepoint index
+		 * 
+		 * @param	pattern			Pointer to the bytes to look for
+		 * @param	start_codepoint	The index of the last codepoint, at which the pattern may start
+		 * @param	pattern_size	The number of bytes of the pattern
+		 * @return	The codepoint index where and if the pattern was found or basic_string::npos
+		 */
+		size_type rfind( const data_type* pattern , size_type start_codepoint , size_type pattern_size ) const noexcept {
+			size_type start_byte = start_codepoint < length() ? get_num_bytes_from_start( start_codepoint ) : basic_string::npos;
+			size_type result = raw_rfind( pattern , start_byte , pattern_size );
+			if( result == basic_string::npos )
+				return basic_string::npos;
+			return get_num_codepoints( 0 , result );
 		}
 		/**
 		 * Finds the last occourence of a specific codepoint inside the
@@ -2257,19 +4135,126 @@ namespace tiny_utf8
 		 * @param	start_codepoint	The byte index of the first codepoint to start looking from (backwards)
 		 * @return	The codepoint index where and if the codepoint was found or basic_string::npos
 		 */
-		size_type raw_rfind( value_type cp , size_type start_byte = basic_string::npos ) const noexcept ;
+		size_type raw_rfind( value_type cp , size_type start_byte = basic_string::npos ) const noexcept {
+			return basic_string::rfind_codepoint( get_buffer() , size() , cp , start_byte );
+		}
+		/**
+		 * Finds the last occourence of a specific pattern inside the
+		 * basic_string, that starts at or before the supplied byte index
+		 * 
+		 * @param	pattern			The pattern to look for
+		 * @param	start_byte		The byte index of the last byte, at which the pattern may start
+		 * @return	The byte index where and if the pattern was found or basic_string::npos
+		 */
+		size_type raw_rfind( const basic_string& pattern , size_type start_byte = basic_string::npos ) const noexcept {
+			return raw_rfind( pattern.data() , start_byte , pattern.size() );
+		}
+		/**
+		 * Finds the last occourence of a specific pattern inside the
+		 * basic_string, that starts at or before the supplied byte index
+		 * 
+		 * @param	pattern			The view of the pattern to look for
+		 * @param	start_byte		The byte index of the last byte, at which the pattern may start
+		 * @return	The byte index where and if the pattern was found or basic_string::npos
+		 */
+		size_type raw_rfind( string_view pattern , size_type start_byte = basic_string::npos ) const noexcept {
+			return raw_rfind( pattern.data() , start_byte , pattern.size() );
+		}
+		/**
+		 * Finds the last occourence of a specific pattern inside the
+		 * basic_string, that starts at or before the supplied byte index
+		 * 
+		 * @param	pattern			The pattern to look for
+		 * @param	start_byte		The byte index of the last byte, at which the pattern may start
+		 * @return	The byte index where and if the pattern was found or basic_string::npos
+		 */
+		size_type raw_rfind( const data_type* pattern , size_type start_byte = basic_string::npos ) const noexcept {
+			return raw_rfind( pattern , start_byte , tiny_utf8_detail::strlen( pattern ) );
+		}
+		/**
+		 * Finds the last occourence of a specific pattern with possibly embedded zeros inside the
+		 * basic_string, that starts at or before the supplied byte index
+		 * 
+		 * @param	pattern			Pointer to the bytes to look for
+		 * @param	start_byte		The byte index of the last byte, at which the pattern may start
+		 * @param	pattern_size	The number of bytes of the pattern
+		 * @return	The byte index where and if the pattern was found or basic_string::npos
+		 */
+		size_type raw_rfind( const data_type* pattern , size_type start_byte , size_type pattern_size ) const noexcept {
+			return tiny_utf8_detail::rfind_bytes( (const unsigned char*)get_buffer() , size() , (const unsigned char*)pattern , pattern_size , start_byte );
+		}
+		
+		//! Find characters in string (the set is either a null-terminated string or a precompiled codepoint_set)
+		size_type find_first_of( const value_type* str , size_type start_codepoint = 0 ) const noexcept { return find_first_of( matcher_type( str ) , start_codepoint , false ); }
+		size_type find_first_of( const codepoint_set& set , size_type start_codepoint = 0 ) const noexcept { return find_first_of( set.get_matcher() , start_codepoint , false ); }
+		size_type raw_find_first_of( const value_type* str , size_type start_byte = 0 ) const noexcept { return raw_find_first_of( matcher_type( str ) , start_byte , false ); }
+		size_type raw_find_first_of( const codepoint_set& set , size_type start_byte = 0 ) const noexcept { return raw_find_first_of( set.get_matcher() , start_byte , false ); }
+		size_type find_last_of( const value_type* str , size_type start_codepoint = basic_string::npos ) const noexcept { return find_last_of( matcher_type( str ) , start_codepoint , false ); }
+		size_type find_last_of( const codepoint_set& set , size_type start_codepoint = basic_string::npos ) const noexcept { return find_last_of( set.get_matcher() , start_codepoint , false ); }
+		size_type raw_find_last_of( const value_type* str , size_type start_byte = basic_string::npos ) const noexcept { return raw_find_last_of( matcher_type( str ) , start_byte , false ); }
+		size_type raw_find_last_of( const codepoint_set& set , size_type start_byte = basic_string::npos ) const noexcept { return raw_find_last_of( set.get_matcher() , start_byte , false ); }
+		
+		//! Find absence of characters in string (the set is either a null-terminated string or a precompiled codepoint_set)
+		size_type find_first_not_of( const value_type* str , size_type start_codepoint = 0 ) const noexcept { return find_first_of( matcher_type( str ) , start_codepoint , true ); }
+		size_type find_first_not_of( const codepoint_set& set , size_type start_codepoint = 0 ) const noexcept { return find_first_of( set.get_matcher() , start_codepoint , true ); }
+		size_type raw_find_first_not_of( const value_type* str , size_type start_byte = 0 ) const noexcept { return raw_find_first_of( matcher_type( str ) , start_byte , true ); }
+		size_type raw_find_first_not_of( const codepoint_set& set , size_type start_byte = 0 ) const noexcept { return raw_find_first_of( set.get_matcher() , start_byte , true ); }
+		size_type find_last_not_of( const value_type* str , size_type start_codepoint = basic_string::npos ) const noexcept { return find_last_of( matcher_type( str ) , start_codepoint , true ); }
+		size_type find_last_not_of( const codepoint_set& set , size_type start_codepoint = basic_string::npos ) const noexcept { return find_last_of( set.get_matcher() , start_codepoint , true ); }
+		size_type raw_find_last_not_of( const value_type* str , size_type start_byte = basic_string::npos ) const noexcept { return raw_find_last_of( matcher_type( str ) , start_byte , true ); }
+		size_type raw_find_last_not_of( const codepoint_set& set , size_type start_byte = basic_string::npos ) const noexcept { return raw_find_last_of( set.get_matcher() , start_byte , true ); }
+		
+		
+		/**
+		 * Splits the string into the tokens, that are separated by the supplied codepoint (pattern)
+		 * 
+		 * @note	The tokens are views, that are found lazily while iterating over the returned range (see basic_split_range).
+		 *			The string has to outlive the range and must not be modified in the meantime.
+		 * @param	cp		The codepoint (pattern) that separates two tokens
+		 * @return	A forward range over all (possibly empty) tokens
+		 */
+		inline split_range split( value_type cp ) const noexcept { return split_range( *this , cp ); }
+		inline split_range split( string_view pattern ) const noexcept { return split_range( *this , pattern ); }
+		/**
+		 * Splits the string into the tokens, that are separated by any codepoint of the supplied set
+		 * 
+		 * @note	The set (either a null-terminated string or a precompiled codepoint_set) has to outlive the range as well
+		 * @param	set		The codepoints, each of which separates two tokens
+		 * @return	A forward range over all (possibly empty) tokens
+		 */
+		inline split_range split_any( const value_type* str ) const noexcept { return split_range( *this , matcher_type( str ) ); }
+		inline split_range split_any( const codepoint_set& set ) const noexcept { return split_range( *this , set.get_matcher() ); }
 		
-		//! Find characters in string
-		size_type find_first_of( const value_type* str , size_type start_codepoint = 0 ) const noexcept ;
-		size_type raw_find_first_of( const value_type* str , size_type start_byte = 0 ) const noexcept ;
-		size_type find_last_of( const value_type* str , size_type start_codepoint = basic_string::npos ) const noexcept ;
-		size_type raw_find_last_of( const value_type* str , size_type start_byte = basic_string::npos ) const noexcept ;
+	private: //! Implementation of the find_*_of family
 		
-		//! Find absence of characters in string
-		size_type find_first_not_of( const value_type* str , size_type start_codepoint = 0 ) const noexcept ;
-		size_type raw_find_first_not_of( const value_type* str , size_type start_byte = 0 ) const noexcept ;
-		size_type find_last_not_of( const value_type* str , size_type start_codepoint = basic_string::npos ) const noexcept ;
-		size_type raw_find_last_not_of( const value_type* str , size_type start_byte = basic_string::npos ) const noexcept ;
+		typedef tiny_utf8::tiny_utf8_detail::codepoint_matcher<value_type>	matcher_type;
+		
+		//! Finds the first codepoint, whose membership within the set differs from 'negate'
+		size_type find_first_of( const matcher_type& set , size_type start_codepoint , bool negate ) const noexcept {
+			if( sso_inactive() && start_codepoint >= length() ) // length() is only O(1), if sso is inactive
+				return basic_string::npos;
+			size_type actual_start = get_num_bytes_from_start( start_codepoint );
+			size_type result = raw_find_first_of( set , actual_start , negate );
+			if( result == basic_string::npos )
+				return basic_string::npos;
+			return start_codepoint + get_num_codepoints( actual_start , result - actual_start );
+		}
+		size_type raw_find_first_of( const matcher_type& set , size_type start_byte , bool negate ) const noexcept {
+			return basic_string::find_first_of_codepoint( get_buffer() , size() , set , start_byte , negate );
+		}
+		static size_type find_first_of_codepoint( const data_type* buffer , size_type data_len , const matcher_type& set , size_type index , bool negate ) noexcept ;
+		
+		//! Finds the last codepoint, whose membership within the set differs from 'negate'
+		size_type find_last_of( const matcher_type& set , size_type start_codepoint , bool negate ) const noexcept {
+			size_type start_byte = start_codepoint < length() ? get_num_bytes_from_start( start_codepoint ) : basic_string::npos;
+			size_type result = raw_find_last_of( set , start_byte , negate );
+			if( result == basic_string::npos )
+				return basic_string::npos;
+			return get_num_codepoints( 0 , result );
+		}
+		size_type raw_find_last_of( const matcher_type& set , size_type start_byte , bool negate ) const noexcept ;
+		
+	public:
 		
 		
 		/**
@@ -2282,6 +4267,15 @@ namespace tiny_utf8
 			size_type my_size = size(), str_size = str.size();
 			return my_size >= str_size && std::memcmp( data() , str.data() , str_size ) == 0;
 		}
+		/**
+		 * Check, whether this string starts with the supplied character sequence
+		 *
+		 * @param	str		The view to compare the start of this string with
+		 * @return	true, if this string starts with the sequence 'str', false otherwise.
+		 */
+		inline bool starts_with( string_view str ) const noexcept {
+			return string_view( get_buffer() , size() ).starts_with( str );
+		}
 		/**
 		 * Check, whether this string ends with the supplied character sequence
 		 *
@@ -2345,12 +4339,13 @@ namespace tiny_utf8
 		 */
 		template<size_type LITLEN>
 		bool starts_with( const value_type (&str)[LITLEN] ) const noexcept {
-			size_type		str_len = str[LITLEN-1] ? LITLEN : LITLEN-1;
-			const_iterator	it = cbegin(), end = cend();
+			size_type			str_len = str[LITLEN-1] ? LITLEN : LITLEN-1;
+			const value_type*	str_iter = str;
+			const_iterator		it = cbegin(), end = cend();
 			while( it != end && str_len ){
-				if( *it != *str )
+				if( *it != *str_iter )
 					return false;
-				++it, ++str, --str_len;
+				++it, ++str_iter, --str_len;
 			}
 			return !str_len;
 		}
@@ -2366,6 +4361,15 @@ namespace tiny_utf8
 			size_type my_size = size(), str_size = str.size();
 			return my_size >= str_size && std::memcmp( data() + my_size - str_size , str.data() , str_size ) == 0;
 		}
+		/**
+		 * Check, whether this string ends with the supplied character sequence
+		 *
+		 * @param	str		The view to compare the end of this string with
+		 * @return	true, if this string ends with the sequence 'str', false otherwise.
+		 */
+		inline bool ends_with( string_view str ) const noexcept {
+			return string_view( get_buffer() , size() ).ends_with( str );
+		}
 		/**
 		 * Check, whether this string ends with the supplied character sequence
 		 *
@@ -2460,6 +4464,15 @@ namespace tiny_utf8
 				result = my_size < str_size ? -1 : 1;
 			return result;
 		}
+		/**
+		 * Compare this string with the supplied view.
+		 *
+		 * @param	str		The view to compare this string with
+		 * @return	The same as for 'compare( const basic_string& str )'
+		 */
+		inline int compare( string_view str ) const noexcept {
+			return string_view( get_buffer() , size() ).compare( str );
+		}
 		/**
 		 * Compare this string with the supplied one.
 		 *
@@ -2567,6 +4580,8 @@ namespace tiny_utf8
 		//! Equality Comparison Operators
 		inline bool operator==( const basic_string& str ) const noexcept { return compare( str ) == 0; }
 		inline bool operator!=( const basic_string& str ) const noexcept { return compare( str ) != 0; }
+		inline bool operator==( string_view str ) const noexcept { return compare( str ) == 0; }
+		inline bool operator!=( string_view str ) const noexcept { return compare( str ) != 0; }
 		inline bool operator==( const std::string& str ) const noexcept { return compare( str ) == 0; }
 		inline bool operator!=( const std::string& str ) const noexcept { return compare( str ) != 0; }
 		template<typename T> inline enable_if_ptr<T, data_type> operator==( T&& str ) const noexcept { return compare( str ) == 0; }
@@ -2583,6 +4598,10 @@ namespace tiny_utf8
 		inline bool operator>=( const basic_string& str ) const noexcept { return compare( str ) >= 0; }
 		inline bool operator<( const basic_string& str ) const noexcept { return compare( str ) < 0; }
 		inline bool operator<=( const basic_string& str ) const noexcept { return compare( str ) <= 0; }
+		inline bool operator>( string_view str ) const noexcept { return compare( str ) > 0; }
+		inline bool operator>=( string_view str ) const noexcept { return compare( str ) >= 0; }
+		inline bool operator<( string_view str ) const noexcept { return compare( str ) < 0; }
+		inline bool operator<=( string_view str ) const noexcept { return compare( str ) <= 0; }
 		inline bool operator>( const std::string& str ) const noexcept { return compare( str ) > 0; }
 		inline bool operator>=( const std::string& str ) const noexcept { return compare( str ) >= 0; }
 		inline bool operator<( const std::string& str ) const noexcept { return compare( str ) < 0; }
@@ -2644,6 +4663,137 @@ namespace tiny_utf8
 	public: //! tinyutf8-specific features
 		
 		
+		/**
+		 * Takes ownership of the supplied UTF-8 data without copying it, replacing the current content of this basic_string.
+		 * The lut is built in place only if it fits into the spare capacity behind the data, the string stays lut-less otherwise.
+		 * 
+		 * @note	The buffer must have been allocated with an allocator equal to the one of this basic_string,
+		 *			i.e. by 'allocate_buffer' or be the result of 'release'. Small strings and buffers, whose capacity
+		 *			cannot hold the data along with the trailing '\0' and the lut indicator, are copied (and the buffer is deallocated)
+		 * @param	buffer		The buffer holding the UTF-8 data (the byte behind the data will be overwritten by a '\0')
+		 * @param	data_len	The number of bytes of the data
+		 * @param	capacity	The number of code units the buffer was allocated with
+		 * @return	A reference to this basic_string now owning the buffer
+		 */
+		basic_string& adopt( data_type* buffer , size_type data_len , size_type capacity ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		inline basic_string& adopt( heap_buffer buffer ) noexcept(TINY_UTF8_NOEXCEPT) { return adopt( buffer.data , buffer.data_len , buffer.capacity ); }
+		
+		
+		/**
+		 * Hands the buffer of this basic_string over to the caller and leaves an empty string behind
+		 * 
+		 * @note	Small strings are moved into a buffer allocated by 'allocate_buffer'. The caller is responsible to
+		 *			either free the buffer using 'deallocate_buffer' or hand it over to a basic_string again using 'adopt'
+		 * @return	The buffer holding the (null-terminated) UTF-8 data
+		 */
+		heap_buffer release() noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		
+		/**
+		 * Allocates a buffer using the allocator of this basic_string, that can be handed over to a basic_string using 'adopt'
+		 * 
+		 * @param	min_capacity	The minimum number of code units of the buffer
+		 * @return	The (uninitialized) buffer with a capacity of at least 'min_capacity' and 'data_len' set to zero
+		 */
+		inline heap_buffer allocate_buffer( size_type min_capacity ) const noexcept(TINY_UTF8_NOEXCEPT) {
+			size_type capacity = basic_string::round_up_to_align( min_capacity );
+			return { this->allocate( capacity ) , 0 , capacity };
+		}
+		
+		//! Deallocates a buffer obtained from 'allocate_buffer' or 'release'
+		inline void deallocate_buffer( heap_buffer buffer ) const noexcept { this->deallocate_total( buffer.data , buffer.capacity ); }
+		
+		
+		/**
+		 * Constructs a basic_string from UTF-8 data like 'basic_string( str , data_len )', but splits the data at codepoint
+		 * boundaries into tasks, that count the codepoints, copy the data and fill the lut concurrently.
+		 * The resulting buffer is byte-identical to the one of the serial construction.
+		 * 
+		 * @note	'parallel_for( num_tasks , task )' must call 'task( i )' for each 'i' in [0, num_tasks) (in any order and possibly concurrently)
+		 *			and return after all of them have finished. Inputs too small to give each task at least 64KiB are constructed serially.
+		 * @param	str			The UTF-8 data to fill the basic_string with
+		 * @param	data_len	The number of bytes of the data
+		 * @param	num_tasks	The number of tasks to split the work into (at most 'max_parallel_tasks')
+		 * @param	parallel_for	The executor to run the tasks with
+		 * @param	alloc		(Optional) The allocator instance to use
+		 * @return	The constructed basic_string
+		 */
+		template<typename ParallelFor>
+		static basic_string from_bytes_parallel( const data_type* str , size_type data_len , size_type num_tasks , ParallelFor&& parallel_for , const allocator_type& alloc = allocator_type() ) noexcept(TINY_UTF8_NOEXCEPT) ;
+	#if !defined(TINY_UTF8_NO_THREADS)
+		/**
+		 * Same as above, but runs the tasks on 'num_threads' std::threads (or as many as there are hardware threads, if zero), one of them being the calling thread
+		 */
+		static inline basic_string from_bytes_parallel( const data_type* str , size_type data_len , unsigned int num_threads = 0 , const allocator_type& alloc = allocator_type() ) noexcept(TINY_UTF8_NOEXCEPT) {
+			return from_bytes_parallel( str , data_len , num_threads ? num_threads : std::max( std::thread::hardware_concurrency() , 1u ) , tiny_utf8_detail::thread_parallel_for() , alloc );
+		}
+	#endif
+		
+		
+		/**
+		 * Concatenates the supplied pieces (basic_strings, views, null-terminated UTF-8 sequences or codepoints) with a single allocation
+		 * 
+		 * @note	The sizes and multibyte counts of basic_strings are O(1), if their lut is active or they don't require unicode.
+		 *			Their lut entries are merged into the one of the result, all other pieces are scanned once for their counts and once for their multibytes.
+		 * @param	pieces	The pieces to concatenate
+		 * @return	The concatenation
+		 */
+		template<typename... Pieces>
+		static basic_string concat( const Pieces&... pieces ) noexcept(TINY_UTF8_NOEXCEPT) {
+			const concat_piece	parts[] = { basic_string::make_concat_piece( pieces )... , concat_piece() }; // The empty piece allows concatenating no pieces
+			concat_piece		total = concat_piece();
+			for( const concat_piece& part : parts )
+				basic_string::add_concat_piece( total , part );
+			
+			basic_string	result;
+			data_type*		lut_iter;
+			size_type		offset = 0;
+			if( result.init_concat( total , lut_iter ) ){
+				for( const concat_piece& part : parts )
+					result.write_concat_piece( part , offset , lut_iter );
+				result.update_jump_table( 0 );
+			}
+			return result;
+		}
+		/**
+		 * Joins the elements of the supplied forward range (e.g. of basic_strings, views or a split_range),
+		 * putting the separator between each two of them, with a single allocation (see 'concat')
+		 * 
+		 * @param	range		The range of pieces to join (which is iterated twice)
+		 * @param	separator	The piece to put between the elements (a basic_string, view, null-terminated UTF-8 sequence or codepoint)
+		 * @param	alloc		(Optional) The allocator instance to use
+		 * @return	The joined basic_string
+		 */
+		template<typename Range, typename Separator>
+		static basic_string join( const Range& range , const Separator& separator , const allocator_type& alloc = allocator_type() ) noexcept(TINY_UTF8_NOEXCEPT) {
+			const concat_piece	sep = basic_string::make_concat_piece( separator );
+			concat_piece		total = concat_piece();
+			bool				first = true;
+			for( const auto& element : range ){
+				if( !first )
+					basic_string::add_concat_piece( total , sep );
+				basic_string::add_concat_piece( total , basic_string::make_concat_piece( element ) );
+				first = false;
+			}
+			
+			// Copy the pieces, whose multibytes don't have to be counted again
+			basic_string	result( alloc );
+			data_type*		lut_iter;
+			size_type		offset = 0;
+			if( !result.init_concat( total , lut_iter ) )
+				return result;
+			first = true;
+			for( const auto& element : range ){
+				if( !first )
+					result.write_concat_piece( sep , offset , lut_iter );
+				result.write_concat_piece( basic_string::make_concat_piece( element , false ) , offset , lut_iter );
+				first = false;
+			}
+			result.update_jump_table( 0 );
+			return result;
+		}
+		
+		
 		/**
 		 * Check whether the data inside this basic_string cannot be iterated by an std::string
 		 * 
@@ -2656,6 +4806,42 @@ namespace tiny_utf8
 		}
 		
 		
+		/**
+		 * Check whether this basic_string is known to hold valid UTF-8 (see 'is_valid_utf8')
+		 * 
+		 * @note	Trusted strings skip the checks for malformed data when translating indices, counting and decoding.
+		 *			Strings become trusted through 'validate' or a validating constructor and stay trusted,
+		 *			until they are modified (copies of them are trusted as well). Strings within the sso buffer are never trusted.
+		 *			Modifying the data through 'data()' doesn't reset the trusted bit (just like it doesn't update the lut)
+		 *			Iterators and element access decode one codepoint at a time, which involves no checks to skip.
+		 *			Only their index translation (e.g. within 'at' and 'operator[]') benefits from the bit.
+		 * @return	True, if the string is trusted
+		 */
+		inline bool trusted() const noexcept { return sso_inactive() && basic_string::is_trusted( basic_string::get_lut_base_ptr( t_non_sso.data , t_non_sso.buffer_size ) ); }
+		
+		
+		/**
+		 * Check whether this basic_string holds valid UTF-8 as specified by RFC 3629 (without overlong encodings, surrogates,
+		 * codepoints above U+10FFFF and truncated sequences), 16 bytes at a time with SSE2
+		 * 
+		 * @return	True, if the string is valid UTF-8
+		 */
+		inline bool is_valid_utf8() const noexcept {
+			std::size_t num_codepoints , num_multibytes;
+			return trusted() || tiny_utf8_detail::validate_and_count( (const unsigned char*)get_buffer() , size() , num_codepoints , num_multibytes );
+		}
+		
+		
+		/**
+		 * Same as 'is_valid_utf8', but the string becomes trusted (see 'trusted'), if it is valid
+		 * 
+		 * @note	Data, that only became valid by joining pieces with truncated codepoints (e.g. through 'append'),
+		 *			was counted piece by piece. In that case, the string length, lut and jump table are rebuilt from the data.
+		 * @return	True, if the string is valid UTF-8
+		 */
+		bool validate() noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		
 		/**
 		 * Determine, if small string optimization is active
 		 * @return	True, if the utf8 data is stored within the basic_string object itself
@@ -2679,9 +4865,26 @@ namespace tiny_utf8
 		 * @return	void
 		 */
 		void to_wide_literal( value_type* dest ) const noexcept {
-			for( const data_type* data = get_buffer(), * data_end = data + size() ; data < data_end ; )
-				data += decode_utf8_and_len( data , *dest++ , data_end - data );
-			*dest = 0;
+			dest[to_codepoints( dest )] = 0;
+		}
+		
+		
+		/**
+		 * Decodes the codepoints of this basic_string into the supplied output range
+		 * 
+		 * @note	Exactly the codepoints of an iteration are written, i.e. at most 'length()' of them
+		 *			(a codepoint truncated by the end of the data is counted once, and thus decoded as its lead byte)
+		 * @param	dest		A buffer or an output iterator to write the codepoints to
+		 * @param	capacity	(Optional) The maximum number of codepoints to write
+		 * @return	The number of codepoints written
+		 */
+		inline size_type to_codepoints( value_type* dest , size_type capacity = basic_string::npos ) const noexcept {
+			size_type bytes_read;
+			return basic_string::decode_codepoints( get_buffer() , size() , dest , std::min( capacity , length() ) , bytes_read , trusted() );
+		}
+		template<typename OutputIt>
+		inline size_type to_codepoints( OutputIt dest , size_type capacity = basic_string::npos ) const noexcept(TINY_UTF8_NOEXCEPT) {
+			return basic_string::decode_codepoints( get_buffer() , size() , dest , std::min( capacity , length() ) , trusted() );
 		}
 		
 		
@@ -2693,73 +4896,1231 @@ namespace tiny_utf8
 		 */
 		inline std::basic_string<data_type> cpp_str( bool prepend_bom = false ) const noexcept(TINY_UTF8_NOEXCEPT) { return prepend_bom ? cpp_str_bom() : std::basic_string<DataType>( c_str() , size() ); }
 	};
-} // Namespace 'tiny_utf8'
-
-
-//! std::hash specialization
-namespace std
-{
-	template<typename V, typename D, typename A>
-	struct hash<tiny_utf8::basic_string<V, D, A> >
-	{
-		std::size_t operator()( const tiny_utf8::basic_string<V, D, A>& string ) const noexcept {
-			using data_type = typename tiny_utf8::basic_string<V, D, A>::data_type;
-			std::hash<data_type>	hasher;
-			std::size_t				size = string.size();
-			std::size_t				result = 0;
-			const data_type*		buffer = string.data();
-			for( std::size_t iterator = 0 ; iterator < size ; ++iterator )
-				result = result * 31u + hasher( buffer[iterator] );
-			return result;
-		}
-	};
-}
-
-//! Stream Operations
-template<typename V, typename D, typename A>
-std::ostream& operator<<( std::ostream& stream , const tiny_utf8::basic_string<V, D, A>& str ) noexcept(TINY_UTF8_NOEXCEPT) {
-	return stream << str.cpp_str();
-}
-template<typename V, typename D, typename A>
-std::istream& operator>>( std::istream& stream , tiny_utf8::basic_string<V, D, A>& str ) noexcept(TINY_UTF8_NOEXCEPT) {
-	std::string tmp;
-	stream >> tmp;
-	str = move(tmp);
-	return stream;
-}
-
-
-// Implementation
-namespace tiny_utf8
-{
-	template<typename V, typename D, typename A>
-	basic_string<V, D, A>::basic_string( basic_string<V, D, A>::size_type count , basic_string<V, D, A>::value_type cp , const typename basic_string<V, D, A>::allocator_type& alloc )
-		noexcept(TINY_UTF8_NOEXCEPT)
-		: A( alloc )
-		, t_sso()
+	
+	
+	/**
+	 * Non-owning view of UTF-8 data (e.g. of a portion of a basic_string) with the same codepoint-based
+	 * and byte-based (raw) access as basic_string. The number of codepoints is counted on demand and cached.
+	 * 
+	 * @note	The viewed data has to outlive the view and is not required to be null-terminated.
+	 *			Modifying a basic_string invalidates all views into it.
+	 */
+	template<typename ValueType, typename DataType>
+	class basic_string_view
 	{
-		if( !count )
-			return;
+	public:
 		
-		width_type	num_bytes_per_cp = get_codepoint_bytes( cp );
-		size_type	data_len = num_bytes_per_cp * count;
-		data_type*	buffer;
+		typedef DataType														data_type;
+		typedef std::size_t														size_type;
+		typedef std::ptrdiff_t													difference_type;
+		typedef ValueType														value_type;
+		typedef std::uint_fast8_t												width_type;
+		typedef tiny_utf8::const_iterator<basic_string_view, false>				const_iterator;
+		typedef tiny_utf8::const_reverse_iterator<basic_string_view, false>		const_reverse_iterator;
+		typedef tiny_utf8::const_iterator<basic_string_view, true>				raw_const_iterator;
+		typedef tiny_utf8::const_reverse_iterator<basic_string_view, true>		raw_const_reverse_iterator;
+		typedef const_iterator													iterator; // Views are read-only
+		typedef const_reverse_iterator											reverse_iterator;
+		typedef raw_const_iterator												raw_iterator;
+		typedef raw_const_reverse_iterator										raw_reverse_iterator;
+		enum : size_type{														npos = (size_type)-1 };
 		
-		// Need to allocate a buffer?
-		if( data_len > basic_string::get_sso_capacity() )
-		{
-			// Determine the buffer size
-			size_type buffer_size	= determine_main_buffer_size( data_len );
-			buffer = this->allocate( determine_total_buffer_size( buffer_size ) );
-		#if defined(TINY_UTF8_NOEXCEPT)
-			if( !buffer )
-				return;
-		#endif
-			t_non_sso.data = buffer;
-			
-			// Set Attributes
-			set_lut_indiciator( buffer + buffer_size , num_bytes_per_cp == 1 , 0 ); // Set lut indicator
-			t_non_sso.buffer_size = buffer_size;
+	protected: //! Attributes
+		
+		//! Provides the static helpers to decode and walk over UTF-8 data
+		typedef basic_string<ValueType, DataType>	string_type;
+		
+		const data_type*	t_data;
+		size_type			t_size;		// In bytes
+		mutable size_type	t_length;	// In codepoints or npos, if not counted yet
+		
+		//! Returns an empty null-terminated sequence, which is viewed by default constructed views
+		static inline const data_type*	get_empty_data() noexcept { static const data_type empty = 0; return &empty; }
+		
+	public:
+		
+		/**
+		 * Default constructor
+		 * 
+		 * @note	Creates a view of zero bytes
+		 */
+		basic_string_view() noexcept :
+			t_data( get_empty_data() )
+			, t_size( 0 )
+			, t_length( 0 )
+		{}
+		/**
+		 * Constructor taking a null-terminated UTF-8 sequence
+		 * 
+		 * @param	str		The UTF-8 sequence to view. The pointer is expected to be valid
+		 */
+		basic_string_view( const data_type* str ) noexcept :
+			t_data( str )
+			, t_size( tiny_utf8_detail::strlen( str ) )
+			, t_length( npos )
+		{}
+		/**
+		 * Constructor taking a UTF-8 sequence with possibly embedded zeros
+		 * 
+		 * @param	str		The UTF-8 sequence to view. The pointer is expected to be valid
+		 * @param	size	The number of bytes to view
+		 * @param	length	(Optional) The number of codepoints within the viewed bytes, if known (npos otherwise)
+		 */
+		basic_string_view( const data_type* str , size_type size , size_type length = npos ) noexcept :
+			t_data( str )
+			, t_size( size )
+			, t_length( length )
+		{}
+		/**
+		 * Constructor taking a basic_string
+		 * 
+		 * @note	The number of codepoints is taken over, if 'str' knows it already (i.e. if it's not small)
+		 * @param	str		The basic_string to view
+		 */
+		template<typename A, std::size_t S>
+		basic_string_view( const basic_string<ValueType, DataType, A, S>& str ) noexcept :
+			t_data( str.data() )
+			, t_size( str.size() )
+			, t_length( str.sso_active() ? npos : str.length() )
+		{}
+		
+		//! Default Functions
+		basic_string_view( const basic_string_view& ) noexcept = default;
+		basic_string_view& operator=( const basic_string_view& ) noexcept = default;
+		
+		
+		/**
+		 * Returns the viewed data
+		 * 
+		 * @note	The data is not necessarily null-terminated
+		 * @return	A pointer to the first byte of the view
+		 */
+		inline const data_type* data() const noexcept { return t_data; }
+		
+		
+		/**
+		 * Returns the number of bytes of the view
+		 * 
+		 * @return	The number of bytes (code units) of the viewed data
+		 */
+		inline size_type size() const noexcept { return t_size; }
+		
+		
+		/**
+		 * Returns the number of codepoints of the view
+		 * 
+		 * @note	Counts the codepoints on first use, unless the count was supplied
+		 * @return	The number of codepoints within the viewed data
+		 */
+		inline size_type length() const noexcept {
+			if( t_length == npos )
+				t_length = get_num_codepoints( 0 , t_size );
+			return t_length;
+		}
+		
+		
+		/**
+		 * Check, whether the view is empty
+		 * 
+		 * @return	True, if the view contains no bytes
+		 */
+		inline bool empty() const noexcept { return !t_size; }
+		
+		
+		/**
+		 * Returns the codepoint at the supplied index
+		 * 
+		 * @param	n	The codepoint index of the codepoint to receive
+		 * @return	The codepoint at position 'n'
+		 */
+		inline value_type at( size_type n ) const noexcept(TINY_UTF8_NOEXCEPT) { return raw_at( get_num_bytes_from_start( n ) ); }
+		inline value_type at( size_type n , std::nothrow_t ) const noexcept { return raw_at( get_num_bytes_from_start( n ) , std::nothrow ); }
+		inline value_type operator[]( size_type n ) const noexcept { return at( n , std::nothrow ); }
+		/**
+		 * Returns the codepoint at the supplied byte position
+		 * 
+		 * @param	byte_index	The byte position of the codepoint to receive
+		 * @return	The codepoint at the supplied position
+		 */
+		value_type raw_at( size_type byte_index ) const noexcept(TINY_UTF8_NOEXCEPT) {
+			if( byte_index >= t_size ){
+				TINY_UTF8_THROW( "tiny_utf8::basic_string_view::(raw_)at" , byte_index >= t_size );
+				return 0;
+			}
+			return raw_at( byte_index , std::nothrow );
+		}
+		value_type raw_at( size_type byte_index , std::nothrow_t ) const noexcept {
+			return byte_index < t_size ? string_type::decode_utf8( t_data + byte_index , get_index_bytes( byte_index ) ) : 0;
+		}
+		
+		//! Returns the first (last) codepoint of the view
+		inline value_type front() const noexcept { return raw_at( 0 , std::nothrow ); }
+		inline value_type back() const noexcept { return raw_at( raw_back_index() , std::nothrow ); }
+		
+		
+		//! Get an iterator to the beginning (end) of the view
+		inline const_iterator begin() const noexcept { return { 0 , this , 0 }; }
+		inline const_iterator end() const noexcept { return { (difference_type)length() , this , (difference_type)t_size }; }
+		inline const_iterator cbegin() const noexcept { return begin(); }
+		inline const_iterator cend() const noexcept { return end(); }
+		inline raw_const_iterator raw_begin() const noexcept { return { 0 , this }; }
+		inline raw_const_iterator raw_end() const noexcept { return { (difference_type)t_size , this }; }
+		inline raw_const_iterator raw_cbegin() const noexcept { return raw_begin(); }
+		inline raw_const_iterator raw_cend() const noexcept { return raw_end(); }
+		
+		//! Get a reverse iterator to the last codepoint (before the first codepoint) of the view
+		inline const_reverse_iterator rbegin() const noexcept { return { (difference_type)length() - 1 , this , (difference_type)raw_back_index() }; }
+		inline const_reverse_iterator rend() const noexcept { return { -1 , this }; }
+		inline const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+		inline const_reverse_iterator crend() const noexcept { return rend(); }
+		inline raw_const_reverse_iterator raw_rbegin() const noexcept { return { (difference_type)raw_back_index() , this }; }
+		inline raw_const_reverse_iterator raw_rend() const noexcept { return { -1 , this }; }
+		inline raw_const_reverse_iterator raw_crbegin() const noexcept { return raw_rbegin(); }
+		inline raw_const_reverse_iterator raw_crend() const noexcept { return raw_rend(); }
+		
+		
+		/**
+		 * Returns a view of a portion of this view (indexed on codepoint-base)
+		 * 
+		 * @param	pos		The codepoint position where the sub-view shall start
+		 * @param	len		The maximum number of codepoints that the sub-view shall have
+		 * @return	The view of the specified codepoints
+		 */
+		basic_string_view substr( size_type pos , size_type len = npos ) const noexcept(TINY_UTF8_NOEXCEPT) {
+			size_type byte_start = get_num_bytes_from_start( pos );
+			if( byte_start == t_size && pos > length() ){
+				TINY_UTF8_THROW( "tiny_utf8::basic_string_view::substr" , pos > length() );
+				return {};
+			}
+			if( len == npos )
+				return { t_data + byte_start , t_size - byte_start , t_length == npos ? npos : t_length - pos };
+			size_type byte_count = get_num_bytes( byte_start , len );
+			
+			// If the sub-view ends before the end of the data, it holds exactly 'len' codepoints
+			return { t_data + byte_start , byte_count , byte_start + byte_count < t_size ? len : npos };
+		}
+		/**
+		 * Returns a view of a portion of this view (indexed on byte-base)
+		 * 
+		 * @param	start_byte		The byte position where the sub-view shall start
+		 * @param	byte_count		The maximum number of bytes that the sub-view shall have
+		 * @return	The view of the specified bytes
+		 */
+		basic_string_view raw_substr( size_type start_byte , size_type byte_count = npos ) const noexcept(TINY_UTF8_NOEXCEPT) {
+			if( start_byte > t_size ){
+				TINY_UTF8_THROW( "tiny_utf8::basic_string_view::(raw_)substr" , start_byte > t_size );
+				return {};
+			}
+			if( !start_byte && byte_count >= t_size )
+				return *this;
+			return { t_data + start_byte , std::min( byte_count , t_size - start_byte ) };
+		}
+		
+		
+		/**
+		 * Shrinks the view by moving its start forward by 'n' codepoints (bytes for the raw version)
+		 * 
+		 * @note	'n' is expected not to exceed the length of the view
+		 */
+		void remove_prefix( size_type n ) noexcept {
+			size_type byte_count = get_num_bytes( 0 , n );
+			t_data += byte_count, t_size -= byte_count;
+			if( t_length != npos )
+				t_length -= std::min( n , t_length );
+		}
+		void raw_remove_prefix( size_type n ) noexcept {
+			t_data += n, t_size -= n;
+			t_length = npos;
+		}
+		/**
+		 * Shrinks the view by moving its end backwards by 'n' codepoints (bytes for the raw version)
+		 * 
+		 * @note	'n' is expected not to exceed the length of the view
+		 */
+		void remove_suffix( size_type n ) noexcept {
+			for( size_type i = 0 ; i < n && t_size ; ++i )
+				t_size -= get_index_pre_bytes( t_size );
+			t_length = npos;
+		}
+		void raw_remove_suffix( size_type n ) noexcept {
+			t_size -= n;
+			t_length = npos;
+		}
+		
+		
+		/**
+		 * Finds a specific codepoint (pattern) inside the view starting at the supplied codepoint index
+		 * 
+		 * @param	cp				The codepoint (pattern) to look for
+		 * @param	start_codepoint	The index of the first codepoint to start looking from
+		 * @return	The codepoint index where and if the codepoint (pattern) was found or npos
+		 */
+		size_type find( value_type cp , size_type start_codepoint = 0 ) const noexcept {
+			size_type actual_start = get_num_bytes_from_start( start_codepoint );
+			return to_codepoint_index( raw_find( cp , actual_start ) , actual_start , start_codepoint );
+		}
+		size_type find( basic_string_view pattern , size_type start_codepoint = 0 ) const noexcept {
+			size_type actual_start = get_num_bytes_from_start( start_codepoint );
+			return to_codepoint_index( raw_find( pattern , actual_start ) , actual_start , start_codepoint );
+		}
+		/**
+		 * Finds a specific codepoint (pattern) inside the view starting at the supplied byte position
+		 * 
+		 * @param	cp			The codepoint (pattern) to look for
+		 * @param	start_byte	The byte position of the first codepoint to start looking from
+		 * @return	The byte position where and if the codepoint (pattern) was found or npos
+		 */
+		size_type raw_find( value_type cp , size_type start_byte = 0 ) const noexcept {
+			return string_type::find_codepoint( t_data , t_size , cp , start_byte );
+		}
+		size_type raw_find( basic_string_view pattern , size_type start_byte = 0 ) const noexcept {
+			if( start_byte >= t_size )
+				return npos;
+			size_type result = tiny_utf8_detail::find_bytes( (const unsigned char*)t_data + start_byte , t_size - start_byte , (const unsigned char*)pattern.t_data , pattern.t_size );
+			return result == npos ? npos : start_byte + result;
+		}
+		
+		/**
+		 * Finds the last occourence of a specific codepoint (pattern) inside the view,
+		 * that starts at or before the supplied codepoint index
+		 * 
+		 * @param	cp				The codepoint (pattern) to look for
+		 * @param	start_codepoint	The index of the last codepoint, at which the codepoint (pattern) may start
+		 * @return	The codepoint index where and if the codepoint (pattern) was found or npos
+		 */
+		size_type rfind( value_type cp , size_type start_codepoint = npos ) const noexcept {
+			return to_codepoint_index( raw_rfind( cp , start_codepoint == npos ? npos : get_num_bytes_from_start( start_codepoint ) ) , 0 , 0 );
+		}
+		size_type rfind( basic_string_view pattern , size_type start_codepoint = npos ) const noexcept {
+			return to_codepoint_index( raw_rfind( pattern , start_codepoint == npos ? npos : get_num_bytes_from_start( start_codepoint ) ) , 0 , 0 );
+		}
+		/**
+		 * Finds the last occourence of a specific codepoint (pattern) inside the view,
+		 * that starts at or before the supplied byte index
+		 * 
+		 * @param	cp				The codepoint (pattern) to look for
+		 * @param	start_byte		The byte index of the last byte, at which the codepoint (pattern) may start
+		 * @return	The byte index where and if the codepoint (pattern) was found or npos
+		 */
+		size_type raw_rfind( value_type cp , size_type start_byte = npos ) const noexcept {
+			return string_type::rfind_codepoint( t_data , t_size , cp , start_byte );
+		}
+		size_type raw_rfind( basic_string_view pattern , size_type start_byte = npos ) const noexcept {
+			return tiny_utf8_detail::rfind_bytes( (const unsigned char*)t_data , t_size , (const unsigned char*)pattern.t_data , pattern.t_size , start_byte );
+		}
+		
+		
+		/**
+		 * Splits the view into the tokens, that are separated by the supplied codepoint (pattern)
+		 * or by any codepoint of the supplied set (see 'basic_string::split' and 'basic_string::split_any')
+		 */
+		inline basic_split_range<ValueType, DataType> split( value_type cp ) const noexcept { return { *this , cp }; }
+		inline basic_split_range<ValueType, DataType> split( basic_string_view pattern ) const noexcept { return { *this , pattern }; }
+		inline basic_split_range<ValueType, DataType> split_any( const value_type* str ) const noexcept { return { *this , tiny_utf8_detail::codepoint_matcher<ValueType>( str ) }; }
+		inline basic_split_range<ValueType, DataType> split_any( const basic_codepoint_set<ValueType>& set ) const noexcept { return { *this , set.get_matcher() }; }
+		
+		
+		/**
+		 * Compare this view with the supplied one.
+		 *
+		 * @param	view	The view to compare this one with
+		 * @return	0	They compare equal
+		 *			<0	Either the value of the first character that does not match is lower in
+		 *			the compared view, or all compared characters match but the compared view is shorter.
+		 *			>0	Either the value of the first character that does not match is greater in
+		 *			the compared view, or all compared characters match but the compared view is longer.
+		 */
+		int compare( basic_string_view view ) const noexcept {
+			size_type	my_size = t_size, view_size = view.t_size;
+			int			result = std::memcmp( t_data , view.t_data , my_size < view_size ? my_size : view_size );
+			if( !result && my_size != view_size )
+				result = my_size < view_size ? -1 : 1;
+			return result;
+		}
+		
+		//! Equality Comparison Operators
+		inline bool operator==( basic_string_view view ) const noexcept { return t_size == view.t_size && compare( view ) == 0; }
+		inline bool operator!=( basic_string_view view ) const noexcept { return !( *this == view ); }
+		
+		//! Lexicographical comparison Operators
+		inline bool operator>( basic_string_view view ) const noexcept { return compare( view ) > 0; }
+		inline bool operator>=( basic_string_view view ) const noexcept { return compare( view ) >= 0; }
+		inline bool operator<( basic_string_view view ) const noexcept { return compare( view ) < 0; }
+		inline bool operator<=( basic_string_view view ) const noexcept { return compare( view ) <= 0; }
+		
+		
+		/**
+		 * Check, whether this view starts (ends) with the supplied character sequence
+		 *
+		 * @param	view	The sequence to compare the start (end) of this view with
+		 * @return	true, if this view starts (ends) with the sequence 'view', false otherwise.
+		 */
+		inline bool starts_with( basic_string_view view ) const noexcept {
+			return t_size >= view.t_size && std::memcmp( t_data , view.t_data , view.t_size ) == 0;
+		}
+		inline bool ends_with( basic_string_view view ) const noexcept {
+			return t_size >= view.t_size && std::memcmp( t_data + t_size - view.t_size , view.t_data , view.t_size ) == 0;
+		}
+		/**
+		 * Check, whether this view starts (ends) with the supplied codepoint
+		 *
+		 * @param	cp		The codepoint to compare the start (end) of this view with
+		 * @return	true, if this view starts (ends) with the codepoint 'cp', false otherwise.
+		 */
+		inline bool starts_with( value_type cp ) const noexcept { return !empty() && front() == cp; }
+		inline bool ends_with( value_type cp ) const noexcept { return !empty() && back() == cp; }
+		
+		
+		//! Get the number of bytes of the codepoint at the supplied byte index
+		inline width_type get_index_bytes( size_type byte_index ) const noexcept {
+			return string_type::get_codepoint_bytes( t_data[byte_index] , t_size - byte_index );
+		}
+		
+		//! Get the number of bytes before a codepoint, that build up a new codepoint
+		inline width_type get_index_pre_bytes( size_type byte_index ) const noexcept {
+			return string_type::get_num_bytes_of_utf8_char_before( t_data , byte_index );
+		}
+		
+		//! Get the byte index of the last codepoint
+		inline size_type raw_back_index() const noexcept { return t_size - get_index_pre_bytes( t_size ); }
+		
+		/**
+		 * Counts the number of codepoints
+		 * that are contained within the supplied range of bytes
+		 */
+		size_type get_num_codepoints( size_type byte_start , size_type byte_count ) const noexcept {
+			size_type end_index = byte_start + byte_count;
+			if( t_length == t_size || end_index <= byte_start ) // Only ASCII?
+				return byte_count;
+			size_type num_codepoints;
+			return byte_count - ( string_type::walk_codepoints( t_data , byte_start , end_index , end_index , num_codepoints ) - byte_start - num_codepoints );
+		}
+		
+		/**
+		 * Counts the number of bytes required to hold the supplied amount of codepoints
+		 * starting at the supplied byte index (or '0' for the '_from_start' version)
+		 */
+		size_type get_num_bytes( size_type byte_start , size_type cp_count ) const noexcept {
+			size_type potential_end_index = byte_start + cp_count;
+			
+			// 'potential_end_index < byte_start' is needed because of potential integer overflow in sum
+			if( potential_end_index > t_size || potential_end_index < byte_start )
+				return t_size - byte_start;
+			if( t_length == t_size ) // Only ASCII?
+				return cp_count;
+			
+			// Walk over well-formed data in bulk, then byte-wise
+			std::size_t	num_codepoints;
+			size_type	index = byte_start + tiny_utf8_detail::count_codepoints( (const unsigned char*)t_data + byte_start , t_size - byte_start , cp_count , num_codepoints );
+			for( cp_count -= num_codepoints ; cp_count > 0 && index < t_size ; --cp_count )
+				index += get_index_bytes( index );
+			return index - byte_start;
+		}
+		inline size_type get_num_bytes_from_start( size_type cp_count ) const noexcept { return get_num_bytes( 0 , cp_count ); }
+		
+		
+		/**
+		 * Get the viewed data wrapped by an std::string
+		 * 
+		 * @return	UTF-8 formatted copy of the viewed data, wrapped inside an std::string
+		 */
+		inline std::basic_string<data_type> cpp_str() const noexcept(TINY_UTF8_NOEXCEPT) { return std::basic_string<data_type>( t_data , t_size ); }
+		
+		
+		/**
+		 * Check whether the viewed data is valid UTF-8 as specified by RFC 3629 (see 'basic_string::is_valid_utf8')
+		 * 
+		 * @return	True, if the viewed data is valid UTF-8
+		 */
+		inline bool is_valid_utf8() const noexcept {
+			std::size_t num_codepoints , num_multibytes;
+			return tiny_utf8_detail::validate_and_count( (const unsigned char*)t_data , t_size , num_codepoints , num_multibytes );
+		}
+		
+		
+		/**
+		 * Decodes the codepoints of the view into the supplied output range
+		 * 
+		 * @note	Exactly the codepoints of an iteration are written, i.e. at most 'length()' of them
+		 * @param	dest		A buffer or an output iterator to write the codepoints to
+		 * @param	capacity	(Optional) The maximum number of codepoints to write
+		 * @return	The number of codepoints written
+		 */
+		inline size_type to_codepoints( value_type* dest , size_type capacity = npos ) const noexcept {
+			size_type bytes_read;
+			return string_type::decode_codepoints( t_data , t_size , dest , get_decode_capacity( capacity ) , bytes_read );
+		}
+		template<typename OutputIt>
+		inline size_type to_codepoints( OutputIt dest , size_type capacity = npos ) const noexcept(TINY_UTF8_NOEXCEPT) {
+			return string_type::decode_codepoints( t_data , t_size , dest , get_decode_capacity( capacity ) );
+		}
+		
+	protected:
+		
+		//! A length supplied by a basic_string might count a truncated codepoint once, that is otherwise decoded byte-wise (see 'to_codepoints')
+		//! Without one, decoding byte-wise yields 'length()' codepoints anyway
+		inline size_type get_decode_capacity( size_type capacity ) const noexcept { return t_length == npos ? capacity : std::min<size_type>( capacity , t_length ); }
+		
+		//! Converts the result of a byte-based search starting at byte 'byte_start' (codepoint 'start_codepoint') into a codepoint index
+		inline size_type to_codepoint_index( size_type result , size_type byte_start , size_type start_codepoint ) const noexcept {
+			return result == npos ? npos : start_codepoint + get_num_codepoints( byte_start , result - byte_start );
+		}
+	};
+	
+	
+	/**
+	 * Lazy forward range over the tokens of a view, that are separated by a codepoint, a pattern or any codepoint of a set.
+	 * Incrementing an iterator searches for the next delimiter in terms of byte offsets using the kernels of 'raw_find'
+	 * ('raw_find_first_of'), so no token is copied and no codepoint index is computed, unless 'index' is asked for.
+	 * 
+	 * @note	n delimiters separate n + 1 (possibly empty) tokens, an empty pattern never matches.
+	 *			The viewed data and the delimiter (pattern or set) have to outlive the range.
+	 */
+	template<typename ValueType, typename DataType>
+	class basic_split_range
+	{
+	public:
+		
+		typedef basic_string_view<ValueType, DataType>			view_type;
+		typedef typename view_type::data_type					data_type;
+		typedef typename view_type::size_type					size_type;
+		typedef typename view_type::value_type					value_type;
+		typedef tiny_utf8_detail::codepoint_matcher<ValueType>	matcher_type;
+		enum : size_type{										npos = (size_type)-1 };
+		
+		class iterator;
+		typedef iterator										const_iterator;
+		
+	protected: //! Attributes
+		
+		//! Provides the static search helpers
+		typedef basic_string<ValueType, DataType>	string_type;
+		
+		enum delimiter_kind : unsigned char{ delimit_codepoint , delimit_pattern , delimit_any };
+		
+		view_type		t_view;
+		view_type		t_pattern;		// The delimiting pattern (delimit_pattern only)
+		matcher_type	t_set;			// The delimiting codepoints (delimit_any only)
+		value_type		t_codepoint;	// The delimiting codepoint (delimit_codepoint only)
+		delimiter_kind	t_kind;
+		
+		/**
+		 * Finds the next delimiter at or after the supplied byte index
+		 * 
+		 * @param	delimiter_size	Receives the number of bytes of the delimiter, if one was found
+		 * @return	The byte index of the delimiter or npos
+		 */
+		size_type find_delimiter( size_type start_byte , size_type& delimiter_size ) const noexcept {
+			size_type result;
+			switch( t_kind ){
+				case delimit_codepoint:
+					delimiter_size = string_type::get_codepoint_bytes( t_codepoint );
+					return string_type::find_codepoint( t_view.data() , t_view.size() , t_codepoint , start_byte );
+				case delimit_pattern:
+					delimiter_size = t_pattern.size();
+					return delimiter_size ? t_view.raw_find( t_pattern , start_byte ) : npos;
+				default:
+					result = string_type::find_first_of_codepoint( t_view.data() , t_view.size() , t_set , start_byte , false );
+					if( result != npos )
+						delimiter_size = t_view.get_index_bytes( result );
+					return result;
+			}
+		}
+		
+	public:
+		
+		/**
+		 * Forward iterator over the tokens of a basic_split_range
+		 */
+		class iterator
+		{
+		public:
+			
+			typedef view_type					value_type;
+			typedef std::ptrdiff_t				difference_type;
+			typedef const view_type*			pointer;
+			typedef view_type					reference; // Tokens are created on demand
+			typedef std::forward_iterator_tag	iterator_category;
+			
+		protected: //! Attributes
+			
+			friend class basic_split_range;
+			
+			const basic_split_range*	t_range;
+			size_type					t_start;		// The byte index of the token or npos past the last token
+			size_type					t_end;			// The byte index of the delimiter following the token (or the size of the view)
+			size_type					t_delimiter_size;
+			mutable size_type			t_counted_bytes;		// Number of bytes whose codepoints are counted already (see 'index')
+			mutable size_type			t_counted_codepoints;
+			
+			iterator( const basic_split_range* range , size_type start ) noexcept :
+				t_range( range )
+				, t_start( start )
+				, t_end( 0 )
+				, t_delimiter_size( 0 )
+				, t_counted_bytes( 0 )
+				, t_counted_codepoints( 0 )
+			{
+				if( start != npos )
+					find_end();
+			}
+			
+			void find_end() noexcept {
+				t_end = t_range->find_delimiter( t_start , t_delimiter_size );
+				if( t_end == npos ) // The token is the last one
+					t_end = t_range->t_view.size(), t_delimiter_size = 0;
+			}
+			
+		public:
+			
+			iterator() noexcept : iterator( nullptr , npos ) {}
+			
+			//! Get the current token
+			inline view_type operator*() const noexcept { return t_range->t_view.raw_substr( t_start , t_end - t_start ); }
+			
+			//! Increase the iterator by one token
+			iterator& operator++() noexcept {
+				if( !t_delimiter_size ) // Was this the last token?
+					t_start = npos;
+				else{
+					t_start = t_end + t_delimiter_size;
+					find_end();
+				}
+				return *this;
+			}
+			inline iterator operator++( int ) noexcept { iterator it = *this; ++*this; return it; }
+			
+			//! Get the byte index of the current token within the view
+			inline size_type raw_index() const noexcept { return t_start; }
+			
+			//! Get the codepoint index of the current token within the view (the codepoints before it are counted incrementally)
+			size_type index() const noexcept {
+				if( t_start == npos )
+					return npos;
+				if( t_start < t_counted_bytes )
+					t_counted_bytes = t_counted_codepoints = 0;
+				t_counted_codepoints += t_range->t_view.get_num_codepoints( t_counted_bytes , t_start - t_counted_bytes );
+				t_counted_bytes = t_start;
+				return t_counted_codepoints;
+			}
+			
+			//! Compare two iterators (of the same range)
+			inline bool operator==( const iterator& it ) const noexcept { return t_start == it.t_start; }
+			inline bool operator!=( const iterator& it ) const noexcept { return t_start != it.t_start; }
+		};
+		
+		//! Constructs a range over the tokens of 'view', that are separated by the supplied codepoint
+		basic_split_range( view_type view , value_type cp ) noexcept :
+			t_view( view )
+			, t_codepoint( cp )
+			, t_kind( delimit_codepoint )
+		{}
+		//! Constructs a range over the tokens of 'view', that are separated by the supplied pattern
+		basic_split_range( view_type view , view_type pattern ) noexcept :
+			t_view( view )
+			, t_pattern( pattern )
+			, t_codepoint( 0 )
+			, t_kind( delimit_pattern )
+		{}
+		//! Constructs a range over the tokens of 'view', that are separated by any codepoint of the supplied set
+		basic_split_range( view_type view , const matcher_type& set ) noexcept :
+			t_view( view )
+			, t_set( set )
+			, t_codepoint( 0 )
+			, t_kind( delimit_any )
+		{}
+		
+		//! Get an iterator to the first token (past the last token)
+		inline iterator begin() const noexcept { return iterator( this , 0 ); }
+		inline iterator end() const noexcept { return iterator( this , npos ); }
+		
+		//! Get the view, that is split
+		inline view_type source() const noexcept { return t_view; }
+	};
+	
+	
+	/**
+	 * Decodes raw UTF-8 data into the supplied output range without constructing a basic_string or a view first
+	 * 
+	 * @param	data		The UTF-8 data to decode
+	 * @param	data_len	The number of bytes to decode
+	 * @param	dest		A buffer of char32_t or an output iterator to write the codepoints to
+	 * @param	capacity	(Optional) The maximum number of codepoints to write
+	 * @return	The number of codepoints written, i.e. at most 'basic_string_view( data , data_len ).length()'
+	 */
+	template<typename DataType, typename OutputIt>
+	inline std::size_t to_codepoints( const DataType* data , std::size_t data_len , OutputIt dest , std::size_t capacity = (std::size_t)-1 ) noexcept(TINY_UTF8_NOEXCEPT) {
+		return basic_string_view<char32_t, DataType>( data , data_len ).to_codepoints( dest , capacity );
+	}
+	
+	
+	/**
+	 * Checks whether raw data is valid UTF-8 as specified by RFC 3629 (see 'basic_string::is_valid_utf8')
+	 * 
+	 * @param	data		The data to check
+	 * @param	data_len	The number of bytes of the data
+	 * @return	True, if the data is valid UTF-8
+	 */
+	template<typename DataType>
+	inline bool is_valid_utf8( const DataType* data , std::size_t data_len ) noexcept {
+		std::size_t num_codepoints , num_multibytes;
+		return tiny_utf8_detail::validate_and_count( (const unsigned char*)data , data_len , num_codepoints , num_multibytes );
+	}
+	
+	
+	/**
+	 * Concatenates the supplied pieces into a tiny_utf8::string with a single allocation (see 'basic_string::concat')
+	 * 
+	 * @param	pieces	The basic_strings, views, null-terminated UTF-8 sequences or codepoints to concatenate
+	 * @return	The concatenation
+	 */
+	template<typename... Pieces>
+	inline string concat( const Pieces&... pieces ) noexcept(TINY_UTF8_NOEXCEPT) { return string::concat( pieces... ); }
+	
+	
+	/**
+	 * Joins the elements of the supplied range into a tiny_utf8::string with a single allocation (see 'basic_string::join')
+	 * 
+	 * @param	range		The forward range of pieces to join
+	 * @param	separator	The piece to put between the elements
+	 * @return	The joined string
+	 */
+	template<typename Range, typename Separator>
+	inline string join( const Range& range , const Separator& separator ) noexcept(TINY_UTF8_NOEXCEPT) { return string::join( range , separator ); }
+	
+	
+	/**
+	 * Wraps a UTF-8 literal together with its number of codepoints and multibytes, which are counted at compile time (with C++14 or later).
+	 * Constructing a basic_string from it therefore skips the counting pass and only copies the data (and fills the lut, if worthwhile).
+	 * 
+	 * @note	Usually created through the user-defined literal '_tu8', e.g. 'constexpr tiny_utf8::string_literal key = "Grüße"_tu8;'
+	 */
+	template<typename DataType>
+	class basic_string_literal
+	{
+	public:
+		
+		typedef DataType		data_type;
+		typedef std::size_t		size_type;
+		
+	protected: //! Attributes
+		
+		const data_type*	t_data;
+		size_type			t_data_len;
+		size_type			t_string_len;
+		size_type			t_num_multibytes;
+		
+	public:
+		
+		/**
+		 * Constructor taking a literal
+		 * 
+		 * @param	str		The UTF-8 literal to describe (a trailing '\0' is not part of the data)
+		 */
+		template<size_type LITLEN>
+		TINY_UTF8_CPP14_CONSTEXPR basic_string_literal( const data_type (&str)[LITLEN] ) noexcept
+			: basic_string_literal( str , LITLEN - ( str[LITLEN-1] ? 0 : 1 ) )
+		{}
+		/**
+		 * Constructor taking a pointer to static UTF-8 data and its size
+		 * 
+		 * @param	str			The UTF-8 data to describe (has to outlive all uses of the basic_string_literal)
+		 * @param	data_len	The number of bytes to describe
+		 */
+		TINY_UTF8_CPP14_CONSTEXPR basic_string_literal( const data_type* str , size_type data_len ) noexcept
+			: t_data( str )
+			, t_data_len( data_len )
+			, t_string_len( tiny_utf8_detail::count_literal_codepoints( str , data_len , false ) )
+			, t_num_multibytes( tiny_utf8_detail::count_literal_codepoints( str , data_len , true ) )
+		{}
+		
+		//! Get the described data
+		constexpr const data_type* data() const noexcept { return t_data; }
+		
+		//! Get the number of bytes of the literal
+		constexpr size_type size() const noexcept { return t_data_len; }
+		
+		//! Get the number of codepoints of the literal
+		constexpr size_type length() const noexcept { return t_string_len; }
+		
+		//! Get the number of multibyte codepoints of the literal
+		constexpr size_type num_multibytes() const noexcept { return t_num_multibytes; }
+	};
+	
+	//! User-defined literals yielding basic_string_literals, e.g. "Hello ツ"_tu8 or u8"Hello ツ"_tu8
+	inline namespace literals
+	{
+		TINY_UTF8_CPP14_CONSTEXPR inline string_literal operator""_tu8( const char* str , std::size_t len ) noexcept { return string_literal( str , len ); }
+		#if defined(__cpp_char8_t)
+			TINY_UTF8_CPP14_CONSTEXPR inline u8string_literal operator""_tu8( const char8_t* str , std::size_t len ) noexcept { return u8string_literal( str , len ); }
+		#endif
+	}
+	
+	
+	/**
+	 * Accumulates UTF-8 data in a heap buffer without maintaining any index on the way.
+	 * 'finalize' then counts the codepoints and builds the lut in one pass and hands the buffer over to a basic_string.
+	 * 
+	 * @note	The buffer has the layout of a basic_string, so a lut of the expected size (see 'reserve')
+	 *			is built right behind the data and no reallocation is needed to finish the string
+	 */
+	template<typename ValueType, typename DataType, typename Allocator, std::size_t SSOCapacity>
+	class basic_string_builder
+	{
+	public:
+		
+		typedef basic_string<ValueType, DataType, Allocator, SSOCapacity>	string_type;
+		typedef typename string_type::data_type					data_type;
+		typedef typename string_type::size_type					size_type;
+		typedef typename string_type::value_type				value_type;
+		typedef typename string_type::width_type				width_type;
+		typedef typename string_type::allocator_type			allocator_type;
+		typedef typename string_type::string_view				string_view;
+		
+	protected: //! Attributes
+		
+		string_type	t_string;		// Provides the allocator and receives the buffer on 'finalize'
+		data_type*	t_buffer;		// Layout like a basic_string buffer of main size 't_buffer_size' (nullptr, if none)
+		size_type	t_buffer_size;
+		size_type	t_size;			// In bytes
+		
+		//! Moves the data into a buffer with a main size of (at least) 'buffer_size' bytes
+		void grow( size_type buffer_size ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		
+		//! Make sure, there is space for 'len' more bytes (and the trailing '\0')
+		inline void make_room( size_type len ) noexcept(TINY_UTF8_NOEXCEPT) {
+			if( t_size + len >= t_buffer_size ) // Grow by a factor of 2 to amortize reallocations
+				grow( std::max<size_type>( t_size + len + 1 , t_buffer_size * 2 ) );
+		}
+		
+	public:
+		
+		/**
+		 * Constructs an empty builder
+		 * 
+		 * @param	alloc	(Optional) The allocator instance to use
+		 */
+		explicit basic_string_builder( const allocator_type& alloc = allocator_type() ) noexcept(TINY_UTF8_NOEXCEPT)
+			: t_string( alloc )
+			, t_buffer( nullptr )
+			, t_buffer_size( 0 )
+			, t_size( 0 )
+		{}
+		/**
+		 * Constructs an empty builder that has room for the expected amount of data (see 'reserve')
+		 */
+		basic_string_builder( size_type expected_bytes , size_type expected_multibytes , const allocator_type& alloc = allocator_type() ) noexcept(TINY_UTF8_NOEXCEPT)
+			: basic_string_builder( alloc )
+		{
+			reserve( expected_bytes , expected_multibytes );
+		}
+		basic_string_builder( basic_string_builder&& builder ) noexcept(TINY_UTF8_NOEXCEPT)
+			: t_string( (string_type&&)builder.t_string )
+			, t_buffer( builder.t_buffer )
+			, t_buffer_size( builder.t_buffer_size )
+			, t_size( builder.t_size )
+		{
+			builder.t_buffer = nullptr;
+			builder.t_buffer_size = builder.t_size = 0;
+		}
+		basic_string_builder( const basic_string_builder& ) = delete;
+		basic_string_builder& operator=( const basic_string_builder& ) = delete;
+		
+		//! Destructor
+		~basic_string_builder() noexcept { clear(); }
+		
+		
+		/**
+		 * Makes sure the builder can hold 'bytes' bytes of data, as well as the lut of a string with 'expected_multibytes' multibytes
+		 * 
+		 * @param	bytes				The number of bytes to reserve
+		 * @param	expected_multibytes	The number of multibyte codepoints the data is expected to contain
+		 */
+		inline void reserve( size_type bytes , size_type expected_multibytes = 0 ) noexcept(TINY_UTF8_NOEXCEPT) {
+			width_type lut_width;
+			size_type buffer_size = string_type::determine_main_buffer_size( bytes , expected_multibytes , &lut_width );
+			if( buffer_size > t_buffer_size )
+				grow( buffer_size );
+		}
+		
+		
+		/**
+		 * Appends UTF-8 data, a codepoint or a string to the accumulated data
+		 * 
+		 * @param	str		The UTF-8 sequence to append (possibly containing embedded zeros)
+		 * @param	len		The number of bytes to append
+		 * @return	A reference to this builder
+		 */
+		inline basic_string_builder& append( const data_type* str , size_type len ) noexcept(TINY_UTF8_NOEXCEPT) {
+			make_room( len );
+			std::memcpy( t_buffer + t_size , str , len );
+			t_size += len;
+			return *this;
+		}
+		template<size_type LITLEN>
+		inline basic_string_builder& append( const data_type (&str)[LITLEN] ) noexcept(TINY_UTF8_NOEXCEPT) {
+			return append( str , LITLEN - ( str[LITLEN-1] ? 0 : 1 ) );
+		}
+		inline basic_string_builder& append( string_view view ) noexcept(TINY_UTF8_NOEXCEPT) { return append( view.data() , view.size() ); }
+		inline basic_string_builder& append( const string_type& str ) noexcept(TINY_UTF8_NOEXCEPT) { return append( str.data() , str.size() ); }
+		inline basic_string_builder& append( value_type cp ) noexcept(TINY_UTF8_NOEXCEPT) {
+			make_room( 7 ); // Enough for any codepoint
+			t_size += string_type::encode_utf8( cp , t_buffer + t_size );
+			return *this;
+		}
+		template<typename T>
+		inline basic_string_builder& operator+=( T&& appendix ) noexcept(TINY_UTF8_NOEXCEPT) { return append( appendix ); }
+		
+		
+		/**
+		 * Returns the number of bytes accumulated so far
+		 */
+		inline size_type size() const noexcept { return t_size; }
+		inline bool empty() const noexcept { return !t_size; }
+		
+		/**
+		 * Returns the number of bytes that can be accumulated without reallocation
+		 */
+		inline size_type capacity() const noexcept { return t_buffer_size ? t_buffer_size - 1 : 0; }
+		
+		/**
+		 * Returns a view of the data accumulated so far
+		 */
+		inline string_view view() const noexcept { return t_buffer ? string_view( t_buffer , t_size ) : string_view(); }
+		
+		
+		/**
+		 * Discards all accumulated data and releases the buffer
+		 */
+		inline void clear() noexcept {
+			if( t_buffer )
+				t_string.deallocate( t_buffer , t_buffer_size );
+			t_buffer = nullptr;
+			t_buffer_size = t_size = 0;
+		}
+		
+		
+		/**
+		 * Hands the accumulated data over to a basic_string, building its lut in a single pass
+		 * 
+		 * @note	The builder is empty afterwards
+		 * @return	The basic_string holding the accumulated data
+		 */
+		string_type finalize() noexcept(TINY_UTF8_NOEXCEPT) ;
+	};
+	
+	
+	/**
+	 * Appends UTF-8 data, that arrives in chunks of arbitrary size (e.g. from a socket or a file), to a basic_string.
+	 * Codepoints split by the boundary of a chunk are held back until the next chunk completes them.
+	 * 
+	 * @note	Each chunk is appended straight from the supplied memory, which updates the lut of the target incrementally.
+	 *			The target ends up exactly like a basic_string constructed from all data at once (malformed data included),
+	 *			once 'finish' was called
+	 */
+	template<typename ValueType, typename DataType, typename Allocator, std::size_t SSOCapacity>
+	class basic_stream_decoder
+	{
+	public:
+		
+		typedef basic_string<ValueType, DataType, Allocator, SSOCapacity>	string_type;
+		typedef typename string_type::data_type					data_type;
+		typedef typename string_type::size_type					size_type;
+		
+	protected: //! Attributes
+		
+		string_type*	t_target;
+		size_type		t_num_multibytes;	// The supposed number of multibytes of the target (a hint for 'append_bytes', that keeps appending linear)
+		data_type		t_pending[16];		// The bytes of the incomplete codepoint (at most 7 from the chunk, plus at most 7 to complete it)
+		size_type		t_num_pending;
+		
+		//! Appends complete codepoints to the target
+		inline void append( const data_type* data , size_type len ) noexcept(TINY_UTF8_NOEXCEPT) {
+			t_num_multibytes += t_target->append_bytes( data , len , t_num_multibytes );
+		}
+		
+	public:
+		
+		/**
+		 * Constructs a decoder appending to the supplied basic_string
+		 * 
+		 * @param	target	The basic_string to append the data to (must outlive the decoder)
+		 */
+		explicit basic_stream_decoder( string_type& target ) noexcept
+			: t_target( &target )
+			, t_num_multibytes( string_type::count_multibytes( target ) )
+			, t_num_pending( 0 )
+		{}
+		
+		//! Destructor (the data of an incomplete codepoint is appended, see 'finish')
+		//! Errors while appending are dropped, since they must not leave a destructor. Call 'finish' explicitly to get them.
+		~basic_stream_decoder() noexcept {
+		#if defined(__cpp_exceptions)
+			try{ finish(); }
+			catch( ... ){}
+		#else
+			finish();
+		#endif
+		}
+		
+		basic_stream_decoder( const basic_stream_decoder& ) = delete;
+		basic_stream_decoder& operator=( const basic_stream_decoder& ) = delete;
+		
+		
+		/**
+		 * Appends the next chunk of data to the target
+		 * 
+		 * @param	chunk	The next bytes of the data
+		 * @param	len		The number of bytes
+		 * @return	A reference to this decoder
+		 */
+		basic_stream_decoder& feed( const data_type* chunk , size_type len ) noexcept(TINY_UTF8_NOEXCEPT) ;
+		inline basic_stream_decoder& operator()( const data_type* chunk , size_type len ) noexcept(TINY_UTF8_NOEXCEPT) { return feed( chunk , len ); }
+		
+		
+		/**
+		 * Appends the bytes held back, after the last chunk was fed
+		 * 
+		 * @note	If the data ended in the middle of a codepoint, these bytes are malformed
+		 * @return	The target
+		 */
+		inline string_type& finish() noexcept(TINY_UTF8_NOEXCEPT) {
+			if( t_num_pending )
+				append( t_pending , t_num_pending );
+			t_num_pending = 0;
+			return *t_target;
+		}
+		
+		
+		/**
+		 * Returns the number of bytes held back, because they belong to a codepoint that is not complete yet
+		 */
+		inline size_type num_pending() const noexcept { return t_num_pending; }
+		
+		/**
+		 * Returns the basic_string the data is appended to
+		 */
+		inline string_type& target() const noexcept { return *t_target; }
+	};
+	
+	
+	/**
+	 * Reads lines (or records ending with any other ASCII delimiter) from a std::streambuf into basic_strings.
+	 * The data is read in bulk (using 'sgetn') into a buffer of the reader and appended to the line using a basic_stream_decoder.
+	 * 
+	 * @note	Since data is read ahead, the streambuf should not be read otherwise while the reader is in use
+	 */
+	template<typename ValueType, typename DataType, typename Allocator, std::size_t SSOCapacity>
+	class basic_line_reader
+	{
+	public:
+		
+		typedef basic_string<ValueType, DataType, Allocator, SSOCapacity>	string_type;
+		typedef typename string_type::data_type					data_type;
+		typedef typename string_type::size_type					size_type;
+		typedef typename string_type::allocator_type			allocator_type;
+		typedef typename string_type::heap_buffer				heap_buffer;
+		
+	protected: //! Attributes
+		
+		std::streambuf*	t_streambuf;
+		data_type		t_delimiter;
+		string_type		t_string;	// Provides the allocator for the buffer
+		heap_buffer		t_buffer;	// 'data_len' is the number of bytes read into the buffer
+		size_type		t_index;	// The index of the next byte in the buffer to return
+		
+	public:
+		
+		/**
+		 * Constructs a reader of the supplied streambuf
+		 * 
+		 * @param	streambuf	The streambuf to read from (must outlive the reader)
+		 * @param	delimiter	(Optional) The ASCII character, that ends a line
+		 * @param	buffer_size	(Optional) The number of bytes to read at once
+		 * @param	alloc		(Optional) The allocator instance to use for the buffer
+		 */
+		explicit basic_line_reader( std::streambuf& streambuf , data_type delimiter = '\n' , size_type buffer_size = 1 << 16 , const allocator_type& alloc = allocator_type() ) noexcept(TINY_UTF8_NOEXCEPT)
+			: t_streambuf( &streambuf )
+			, t_delimiter( delimiter )
+			, t_string( alloc )
+			, t_buffer( t_string.allocate_buffer( std::max<size_type>( buffer_size , 1 ) ) )
+			, t_index( 0 )
+		{}
+		
+		//! Destructor
+		~basic_line_reader() noexcept { t_string.deallocate_buffer( t_buffer ); }
+		
+		basic_line_reader( const basic_line_reader& ) = delete;
+		basic_line_reader& operator=( const basic_line_reader& ) = delete;
+		
+		
+		/**
+		 * Reads the next line (without the delimiter)
+		 * 
+		 * @param	line	The basic_string to receive the line (its previous content is discarded)
+		 * @return	False, if the end of the stream was reached before any data was read, true otherwise
+		 */
+		bool read( string_type& line ) noexcept(TINY_UTF8_NOEXCEPT) ;
+	};
+} // Namespace 'tiny_utf8'
+
+
+//! std::hash specialization
+namespace std
+{
+	template<typename V, typename D, typename A, std::size_t S>
+	struct hash<tiny_utf8::basic_string<V, D, A, S> >
+	{
+		std::size_t operator()( const tiny_utf8::basic_string<V, D, A, S>& string ) const noexcept {
+			#if defined(TINY_UTF8_HASH)
+				return TINY_UTF8_HASH( string.data() , string.size() );
+			#else
+				// Hash the inline buffer of sso strings directly, which yields the same value as hashing the data
+				if( sizeof(string.t_sso) >= 32 && string.sso_active() && ( sizeof(string.t_sso) == 32 || string.get_sso_data_len() <= 32 ) )
+					return tiny_utf8::tiny_utf8_detail::hash_block( (const unsigned char*)&string.t_sso , string.get_sso_data_len() );
+				return tiny_utf8::tiny_utf8_detail::hash_bytes( (const unsigned char*)string.data() , string.size() );
+			#endif
+		}
+	};
+	
+	template<typename V, typename D>
+	struct hash<tiny_utf8::basic_string_view<V, D> >
+	{
+		//! Yields the same value as hashing a basic_string with the same data
+		std::size_t operator()( const tiny_utf8::basic_string_view<V, D>& view ) const noexcept {
+			#if defined(TINY_UTF8_HASH)
+				return TINY_UTF8_HASH( view.data() , view.size() );
+			#else
+				return tiny_utf8::tiny_utf8_detail::hash_bytes( (const unsigned char*)view.data() , view.size() );
+			#endif
+		}
+	};
+}
+
+//! Stream Helpers
+namespace tiny_utf8
+{
+	namespace tiny_utf8_detail
+	{
+		/**
+		 * Reads a whitespace-delimited word from the supplied stream into 'str'.
+		 * Short words are collected on the stack and end up in the sso buffer of 'str'. Only once a word outgrows
+		 * the size of a basic_string, it is moved into a heap buffer, which is adopted by 'str' afterwards.
+		 * Note: Only ASCII whitespace delimits words, since the bytes of multibytes must never be mistaken as whitespace
+		 */
+		template<typename Stream, typename String>
+		Stream& read_word( Stream& stream , String& str ) noexcept(TINY_UTF8_NOEXCEPT)
+		{
+			typedef typename Stream::traits_type	traits_type;
+			typedef typename String::size_type		size_type;
+			
+			typename Stream::sentry sentry( stream ); // Skips leading whitespace
+			if( !sentry )
+				return stream;
+			
+			typename String::data_type		small_buffer[sizeof(String)]; // Large enough for any word that fits into the sso buffer
+			typename String::heap_buffer	buffer = { small_buffer , 0 , sizeof(String) };
+			size_type						max_len = stream.width() > 0 ? (size_type)stream.width() : (size_type)String::npos;
+			typename Stream::iostate		state = Stream::goodbit;
+			
+			for( typename Stream::int_type c = stream.rdbuf()->sgetc() ; ; c = stream.rdbuf()->snextc() )
+			{
+				if( traits_type::eq_int_type( c , traits_type::eof() ) ){
+					state |= Stream::eofbit;
+					break;
+				}
+				if( buffer.data_len >= max_len || c == ' ' || ( c >= '\t' && c <= '\r' ) )
+					break;
+				
+				// Move words outgrowing the small buffer to the heap
+				if( buffer.data == small_buffer ){
+					if( buffer.data_len < buffer.capacity ){
+						small_buffer[buffer.data_len++] = (typename String::data_type)c;
+						continue;
+					}
+					typename String::heap_buffer heap = { nullptr , 0 , 0 };
+					if( !str.sso_active() )
+						heap = str.release(); // Reuse the buffer of 'str'
+					if( heap.capacity < buffer.capacity * 2 ){
+						if( heap.data )
+							str.deallocate_buffer( heap );
+						heap = str.allocate_buffer( buffer.capacity * 2 );
+					}
+					std::memcpy( heap.data , small_buffer , buffer.data_len );
+					heap.data_len = buffer.data_len;
+					buffer = heap;
+				}
+				
+				// Grow the buffer, keeping space for the trailing '\0' and the lut indicator
+				if( buffer.data_len + 1 + sizeof(size_type) >= buffer.capacity ){
+					typename String::heap_buffer grown = str.allocate_buffer( buffer.capacity * 2 );
+					std::memcpy( grown.data , buffer.data , buffer.data_len );
+					grown.data_len = buffer.data_len;
+					str.deallocate_buffer( buffer );
+					buffer = grown;
+				}
+				buffer.data[buffer.data_len++] = (typename String::data_type)c;
+			}
+			
+			stream.width( 0 );
+			if( !buffer.data_len )
+				state |= Stream::failbit;
+			if( buffer.data == small_buffer )
+				str = String( typename String::string_view( small_buffer , buffer.data_len ) , str.get_allocator() );
+			else
+				str.adopt( buffer );
+			stream.setstate( state );
+			return stream;
+		}
+	}
+}
+
+//! Stream Operations
+template<typename V, typename D, typename A, std::size_t S>
+std::ostream& operator<<( std::ostream& stream , const tiny_utf8::basic_string<V, D, A, S>& str ) noexcept(TINY_UTF8_NOEXCEPT) {
+	return stream << str.cpp_str();
+}
+template<typename V, typename D>
+std::ostream& operator<<( std::ostream& stream , const tiny_utf8::basic_string_view<V, D>& view ) noexcept(TINY_UTF8_NOEXCEPT) {
+	return stream << view.cpp_str();
+}
+template<typename V, typename D, typename A, std::size_t S>
+std::istream& operator>>( std::istream& stream , tiny_utf8::basic_string<V, D, A, S>& str ) noexcept(TINY_UTF8_NOEXCEPT) {
+	return tiny_utf8::tiny_utf8_detail::read_word( stream , str );
+}
+
+
+// Implementation
+namespace tiny_utf8
+{
+	template<typename V, typename D, typename A, std::size_t S>
+	basic_string<V, D, A, S>::basic_string( basic_string<V, D, A, S>::size_type count , basic_string<V, D, A, S>::value_type cp , const typename basic_string<V, D, A, S>::allocator_type& alloc )
+		noexcept(TINY_UTF8_NOEXCEPT)
+		: A( alloc )
+		, t_sso()
+	{
+		if( !count )
+			return;
+		
+		width_type	num_bytes_per_cp = get_codepoint_bytes( cp );
+		size_type	data_len = num_bytes_per_cp * count;
+		data_type*	buffer;
+		
+		// Need to allocate a buffer?
+		if( data_len > basic_string::get_sso_capacity() )
+		{
+			// Determine the buffer size
+			size_type buffer_size	= determine_main_buffer_size( data_len );
+			buffer = this->allocate( determine_total_buffer_size( buffer_size ) );
+		#if defined(TINY_UTF8_NOEXCEPT)
+			if( !buffer )
+				return;
+		#endif
+			t_non_sso.data = buffer;
+			
+			// Set Attributes
+			set_lut_indiciator( buffer + buffer_size , num_bytes_per_cp == 1 , 0 ); // Set lut indicator
+			t_non_sso.buffer_size = buffer_size;
 			t_non_sso.data_len = data_len;
 			set_non_sso_string_len( count ); // This also disables SSO
 		}
@@ -2781,10 +6142,12 @@ namespace tiny_utf8
 		
 		// Set trailling zero (in case sso is inactive, this trailing zero also indicates, that no multibyte-tracking is enabled)
 		buffer[data_len] = 0;
+		
+		update_jump_table( 0 );
 	}
 
-	template<typename V, typename D, typename A>
-	basic_string<V, D, A>::basic_string( basic_string<V, D, A>::size_type count , data_type cp , const typename basic_string<V, D, A>::allocator_type& alloc )
+	template<typename V, typename D, typename A, std::size_t S>
+	basic_string<V, D, A, S>::basic_string( basic_string<V, D, A, S>::size_type count , data_type cp , const typename basic_string<V, D, A, S>::allocator_type& alloc )
 		noexcept(TINY_UTF8_NOEXCEPT)
 		: A( alloc )
 		, t_sso()
@@ -2816,147 +6179,651 @@ namespace tiny_utf8
 			set_sso_data_len( (unsigned char)count );
 		}
 		
-		// Fill the buffer
-		std::memset( buffer , cp , count );
-		
-		// Set trailling zero (in case sso is inactive, this trailing zero also indicates, that no multibyte-tracking is enabled)
-		buffer[count] = 0;
+		// Fill the buffer
+		std::memset( buffer , cp , count );
+		
+		// Set trailling zero (in case sso is inactive, this trailing zero also indicates, that no multibyte-tracking is enabled)
+		buffer[count] = 0;
+		
+		update_jump_table( 0 );
+	}
+
+	template<typename V, typename D, typename A, std::size_t S>
+	basic_string<V, D, A, S>::basic_string( const data_type* str , size_type pos , size_type count , size_type data_left , const typename basic_string<V, D, A, S>::allocator_type& alloc , tiny_utf8_detail::read_codepoints_tag )
+		noexcept(TINY_UTF8_NOEXCEPT)
+		: basic_string( alloc )
+	{
+		if( !count )
+			return;
+		
+		size_type	num_multibytes = 0;
+		size_type	data_len = 0;
+		size_type	string_len = 0;
+		data_type*	buffer;
+		
+		// Iterate to the nth codepoint marking the start of the string to copy
+		while( *str && string_len < pos && data_left != 0u ){
+			width_type bytes = get_codepoint_bytes( str[data_len] , data_left ); // Read number of bytes of current codepoint
+			data_left		-= bytes;
+			str				+= bytes;
+			++string_len;
+		}
+		string_len = 0;
+		
+		// Count bytes, multibytes and string length
+		while( str[data_len] && string_len < count )
+		{
+			// Read number of bytes of current codepoint
+			width_type bytes = get_codepoint_bytes( str[data_len] , data_left );
+			data_len		+= bytes;				// Increase number of bytes
+			data_left		-= bytes;				// Decrease amount of bytes left
+			string_len		+= 1;					// Increase number of codepoints
+			num_multibytes	+= bytes > 1 ? 1 : 0;	// Increase number of occoured multibytes?
+		}
+		
+		// Need heap memory?
+		if( data_len > basic_string::get_sso_capacity() )
+		{
+			if( basic_string::is_lut_worth( num_multibytes , string_len , false , false ) )
+			{
+				// Determine the buffer size (excluding the lut indicator) and the lut width
+				width_type	lut_width;
+				size_type	buffer_size	= determine_main_buffer_size( data_len , num_multibytes , &lut_width );
+				buffer = this->allocate( determine_total_buffer_size( buffer_size ) );
+			#if defined(TINY_UTF8_NOEXCEPT)
+				if( !buffer )
+					return;
+			#endif
+				t_non_sso.data = buffer;
+				
+				// Set up LUT
+				data_type*	lut_iter = basic_string::get_lut_base_ptr( buffer , buffer_size );
+			#if defined(TINY_UTF8_LAZY_LUT)
+				// Copy bytes, the lut is built by the first random access
+				(void)lut_width;
+				basic_string::set_lut_deferred( lut_iter );
+				std::memcpy( buffer , str , data_len );
+				data_type* buffer_iter = buffer + data_len;
+			#else
+				basic_string::set_lut_indiciator( lut_iter , true , num_multibytes ); // Set the LUT indicator
+				
+				// Fill the lut and copy bytes
+				data_type* buffer_iter = buffer;
+				const data_type* str_iter = str;
+				const data_type* str_end = str + data_len; // Compute End of the string
+				while( str_iter < str_end )
+				{
+					width_type bytes = get_codepoint_bytes( *str_iter , str_end - str_iter );
+					switch( bytes )
+					{
+						case 7:	buffer_iter[6] = str_iter[6]; TINY_UTF8_FALLTHROUGH // Copy data byte
+						case 6:	buffer_iter[5] = str_iter[5]; TINY_UTF8_FALLTHROUGH // Copy data byte
+						case 5:	buffer_iter[4] = str_iter[4]; TINY_UTF8_FALLTHROUGH // Copy data byte
+						case 4:	buffer_iter[3] = str_iter[3]; TINY_UTF8_FALLTHROUGH // Copy data byte
+						case 3:	buffer_iter[2] = str_iter[2]; TINY_UTF8_FALLTHROUGH // Copy data byte
+						case 2:	buffer_iter[1] = str_iter[1]; // Copy data byte
+							// Set next entry in the LUT!
+							basic_string::set_lut( lut_iter -= lut_width , lut_width , str_iter - str );
+							TINY_UTF8_FALLTHROUGH
+						case 1: buffer_iter[0] = str_iter[0]; break; // Copy data byte
+					}
+					buffer_iter	+= bytes;
+					str_iter	+= bytes;
+				}
+			#endif
+				*buffer_iter = '\0'; // Set trailing '\0'
+				
+				// Set Attributes
+				t_non_sso.buffer_size = buffer_size;
+				t_non_sso.data_len = data_len;
+				set_non_sso_string_len( string_len ); // This also disables SSO
+				
+				update_jump_table( 0 );
+				return; // We have already done everything!
+			}
+			
+			size_type buffer_size = determine_main_buffer_size( data_len );
+			buffer = t_non_sso.data = this->allocate( determine_total_buffer_size( buffer_size ) );
+			
+			// Set up LUT
+			data_type*	lut_iter = basic_string::get_lut_base_ptr( buffer , buffer_size );
+			basic_string::set_lut_indiciator( lut_iter , num_multibytes == 0 , 0 ); // Set the LUT indicator
+			
+			// Set Attributes
+			t_non_sso.buffer_size = buffer_size;
+			t_non_sso.data_len = data_len;
+			set_non_sso_string_len( string_len );
+		}
+		else{
+			buffer = t_sso.data;
+			
+			// Set Attrbutes
+			set_sso_data_len( (unsigned char)data_len );
+			
+			// Set up LUT: Not necessary, since the LUT is automatically inactive,
+			// since SSO is active and the LUT indicator shadows 't_sso.data_len', which has the LSB = 0 (=> LUT inactive).
+		}
+		
+		//! Fill the buffer
+		std::memcpy( buffer , str , data_len );
+		buffer[data_len] = '\0';
+		
+		update_jump_table( 0 );
+	}
+
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::size_type basic_string<V, D, A, S>::decode_codepoints( const data_type* data , typename basic_string<V, D, A, S>::size_type data_len , value_type* dest , typename basic_string<V, D, A, S>::size_type capacity , typename basic_string<V, D, A, S>::size_type& bytes_read , bool trusted ) noexcept
+	{
+		size_type	index = 0;
+		size_type	num_codepoints = 0;
+		
+		while( index < data_len && num_codepoints < capacity )
+		{
+		#if TINY_UTF8_HAS_SSE2
+			// Decode 16 bytes at once, if there is room for as many codepoints as they could contain
+			if( data_len - index >= 16 && capacity - num_codepoints >= 16 )
+			{
+				std::uint32_t	values[16];
+				unsigned int	ends;
+				if( size_type num_bytes = tiny_utf8_detail::decode_block( (const unsigned char*)data + index , values , ends , !trusted ) )
+				{
+					if( ends == 0xFFFFu ) // One codepoint per byte
+						for( int i = 0 ; i < 16 ; ++i )
+							dest[num_codepoints++] = (value_type)values[i];
+					else
+						for( ; ends ; ends &= ends - 1 )
+							dest[num_codepoints++] = (value_type)values[tiny_utf8_detail::ctz( ends )];
+					index += num_bytes;
+					continue;
+				}
+			}
+		#endif
+			
+			// Copy ASCII runs in bulk
+			if( !( (unsigned char)data[index] & 0x80 ) ){
+				size_type ascii_len = std::min<size_type>( tiny_utf8_detail::ascii_prefix_len( (const unsigned char*)data + index , data_len - index ) , capacity - num_codepoints );
+				for( size_type ascii_end = index + ascii_len ; index < ascii_end ; ++index )
+					dest[num_codepoints++] = (unsigned char)data[index];
+				continue;
+			}
+			
+			index += decode_utf8_and_len( data + index , dest[num_codepoints++] , data_len - index );
+		}
+		
+		bytes_read = index;
+		return num_codepoints;
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	template<typename OutputIt>
+	typename basic_string<V, D, A, S>::size_type basic_string<V, D, A, S>::decode_codepoints( const data_type* data , typename basic_string<V, D, A, S>::size_type data_len , OutputIt dest , typename basic_string<V, D, A, S>::size_type capacity , bool trusted ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		value_type	buffer[64];
+		size_type	num_codepoints = 0;
+		
+		while( data_len && num_codepoints < capacity )
+		{
+			size_type	bytes_read;
+			size_type	num_decoded = basic_string::decode_codepoints( data , data_len , buffer , std::min<size_type>( 64 , capacity - num_codepoints ) , bytes_read , trusted );
+			dest			= std::copy( buffer , buffer + num_decoded , dest );
+			data			+= bytes_read;
+			data_len		-= bytes_read;
+			num_codepoints	+= num_decoded;
+		}
+		
+		return num_codepoints;
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::size_type basic_string<V, D, A, S>::count_multibytes( const data_type* str , typename basic_string<V, D, A, S>::size_type data_len , typename basic_string<V, D, A, S>::size_type& string_len ) noexcept
+	{
+		size_type		num_multibytes = 0;
+		size_type		index = 0;
+		string_len = 0;
+		
+		while( index < data_len )
+		{
+			// Skip ASCII runs in bulk, since every byte of them is a codepoint on its own
+			if( !( (unsigned char)str[index] & 0x80 ) ){
+				size_type ascii_len = tiny_utf8_detail::ascii_prefix_len( (const unsigned char*)str + index , data_len - index );
+				index			+= ascii_len;
+				string_len		+= ascii_len;
+				continue;
+			}
+			
+			// Read number of bytes of current codepoint
+			width_type bytes = get_codepoint_bytes( str[index] , basic_string::npos );
+			index			+= bytes;				// Increase number of bytes
+			string_len		+= 1;					// Increase number of codepoints
+			num_multibytes	+= bytes > 1 ? 1 : 0;	// Increase number of occoured multibytes?
+		}
+		
+		return num_multibytes;
+	}
+
+	template<typename V, typename D, typename A, std::size_t S>
+	void basic_string<V, D, A, S>::fill_lut( data_type* lut_iter , width_type lut_width , const data_type* str , typename basic_string<V, D, A, S>::size_type data_len ) noexcept
+	{
+		TINY_UTF8_STAT( lut_builds );
+		basic_string::fill_lut( lut_iter , lut_width , str , 0 , data_len );
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::data_type* basic_string<V, D, A, S>::fill_lut( data_type* lut_iter , width_type lut_width , const data_type* str , typename basic_string<V, D, A, S>::size_type str_iter , typename basic_string<V, D, A, S>::size_type end ) noexcept
+	{
+		while( str_iter < end )
+		{
+			// Skip ASCII runs in bulk
+			if( !( (unsigned char)str[str_iter] & 0x80 ) ){
+				str_iter += tiny_utf8_detail::ascii_prefix_len( (const unsigned char*)str + str_iter , end - str_iter );
+				continue;
+			}
+			// Note: Measure the codepoint exactly like 'count_multibytes', to get exactly as many lut entries as multibytes
+			width_type bytes = get_codepoint_bytes( str[str_iter] , basic_string::npos );
+			if( bytes > 1 )
+				basic_string::set_lut( lut_iter -= lut_width , lut_width , str_iter ); // Set next entry in the LUT!
+			str_iter += bytes;
+		}
+		return lut_iter;
+	}
+
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::concat_piece basic_string<V, D, A, S>::make_concat_piece( const basic_string<V, D, A, S>& str , bool count ) noexcept
+	{
+		concat_piece piece = concat_piece();
+		piece.data = str.data();
+		piece.data_len = str.size();
+		
+		if( str.sso_inactive() )
+		{
+			const data_type* lut_base_ptr = basic_string::get_lut_base_ptr( str.t_non_sso.data , str.t_non_sso.buffer_size );
+			piece.string_len = str.get_non_sso_string_len();
+			
+			// Take over the lut entries
+			if( basic_string::is_lut_active( lut_base_ptr ) ){
+				piece.num_multibytes = basic_string::get_lut_len( lut_base_ptr );
+				piece.lut_base_ptr = lut_base_ptr;
+				piece.lut_width = basic_string::get_lut_width( str.t_non_sso.buffer_size );
+				return piece;
+			}
+			if( piece.string_len == piece.data_len ) // Only ASCII? (see 'requires_unicode')
+				return piece;
+		}
+		
+		piece.num_multibytes = count ? basic_string::count_multibytes( piece.data , piece.data_len , piece.string_len ) : basic_string::npos;
+		return piece;
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::concat_piece basic_string<V, D, A, S>::make_concat_piece( string_view view , bool count ) noexcept
+	{
+		concat_piece piece = concat_piece();
+		piece.data = view.data();
+		piece.data_len = view.size();
+		piece.num_multibytes = count ? basic_string::count_multibytes( piece.data , piece.data_len , piece.string_len ) : basic_string::npos;
+		return piece;
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::concat_piece basic_string<V, D, A, S>::make_concat_piece( value_type cp , bool ) noexcept
+	{
+		concat_piece piece = concat_piece();
+		piece.data_len = basic_string::encode_utf8( cp , piece.encoded );
+		piece.string_len = 1;
+		piece.num_multibytes = piece.data_len > 1 ? 1 : 0;
+		return piece;
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	bool basic_string<V, D, A, S>::init_concat( const concat_piece& total , data_type*& lut_iter ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		size_type	data_len = total.data_len;
+		data_type*	buffer;
+		lut_iter = nullptr;
+		
+		// Need heap memory?
+		if( data_len > basic_string::get_sso_capacity() )
+		{
+			width_type	lut_width;
+			bool		lut_worth = basic_string::is_lut_worth( total.num_multibytes , total.string_len , false , false );
+			size_type	buffer_size = lut_worth ? determine_main_buffer_size( data_len , total.num_multibytes , &lut_width ) : determine_main_buffer_size( data_len );
+			buffer = this->allocate( determine_total_buffer_size( buffer_size ) );
+		#if defined(TINY_UTF8_NOEXCEPT)
+			if( !buffer )
+				return false;
+		#endif
+			t_non_sso.data = buffer;
+			
+			// Set up LUT, whose entries are written along with the pieces
+			data_type* lut_base_ptr = basic_string::get_lut_base_ptr( buffer , buffer_size );
+			if( lut_worth ){
+				basic_string::set_lut_indiciator( lut_base_ptr , true , total.num_multibytes );
+				lut_iter = lut_base_ptr;
+			}
+			else
+				basic_string::set_lut_indiciator( lut_base_ptr , total.num_multibytes == 0 , 0 );
+			
+			// Set Attributes
+			t_non_sso.buffer_size = buffer_size;
+			t_non_sso.data_len = data_len;
+			set_non_sso_string_len( total.string_len ); // This also disables SSO
+		}
+		else{
+			buffer = t_sso.data;
+			set_sso_data_len( (unsigned char)data_len );
+		}
+		
+		buffer[data_len] = '\0';
+		return true;
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	void basic_string<V, D, A, S>::write_concat_piece( const concat_piece& piece , typename basic_string<V, D, A, S>::size_type& offset , data_type*& lut_iter ) noexcept
+	{
+		data_type* buffer = get_buffer();
+		std::memcpy( buffer + offset , piece.data ? piece.data : piece.encoded , piece.data_len );
+		
+		if( lut_iter && piece.num_multibytes )
+		{
+			width_type lut_width = basic_string::get_lut_width( t_non_sso.buffer_size );
+			
+			// Copy the lut entries of the piece (shifted by its offset) or find its multibytes
+			if( piece.lut_base_ptr ){
+				const data_type* piece_lut_iter = piece.lut_base_ptr;
+				for( size_type i = piece.num_multibytes ; i > 0 ; --i )
+					basic_string::set_lut(
+						lut_iter -= lut_width
+						, lut_width
+						, basic_string::get_lut( piece_lut_iter -= piece.lut_width , piece.lut_width ) + offset
+					);
+			}
+			else
+				lut_iter = basic_string::fill_lut( lut_iter , lut_width , buffer , offset , offset + piece.data_len );
+		}
+		
+		offset += piece.data_len;
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	basic_string<V, D, A, S>& basic_string<V, D, A, S>::adopt( data_type* buffer , typename basic_string<V, D, A, S>::size_type data_len , typename basic_string<V, D, A, S>::size_type capacity ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		clear();
+		
+		// Determine the main buffer size, whose layout (including the lut indicator and the jump table) spans exactly 'capacity' code units.
+		// Note: Capacities right after a growth of the jump table cannot be matched exactly
+		size_type buffer_size = 0;
+		if( capacity >= sizeof(indicator_type) ){
+			buffer_size = capacity - sizeof(indicator_type);
+			buffer_size -= basic_string::get_jump_table_size( buffer_size ); // Lower bound, since the jump table shrinks with the buffer
+			while( basic_string::determine_total_buffer_size( buffer_size ) < capacity )
+				buffer_size += sizeof(size_type);
+		}
+		
+		// Copy small strings into the sso buffer and strings that don't fit the layout into a new buffer
+		if( data_len <= basic_string::get_sso_capacity()
+			|| basic_string::determine_total_buffer_size( buffer_size ) != capacity
+			|| buffer_size <= data_len
+			|| (std::uintptr_t)buffer % alignof(indicator_type)
+		){
+			basic_string( buffer , data_len , (const allocator_type&)*this , tiny_utf8_detail::read_bytes_tag() ).swap( *this );
+			this->deallocate_total( buffer , capacity );
+			return *this;
+		}
+		
+		size_type	string_len;
+		size_type	num_multibytes = basic_string::count_multibytes( buffer , data_len , string_len );
+		assign_heap_buffer( buffer , buffer_size , data_len , string_len , num_multibytes );
+		return *this;
+	}
+
+	template<typename V, typename D, typename A, std::size_t S>
+	void basic_string<V, D, A, S>::assign_heap_buffer( data_type* buffer , typename basic_string<V, D, A, S>::size_type buffer_size , typename basic_string<V, D, A, S>::size_type data_len , typename basic_string<V, D, A, S>::size_type string_len , typename basic_string<V, D, A, S>::size_type num_multibytes ) noexcept
+	{
+		width_type	lut_width = basic_string::get_lut_width( buffer_size );
+		data_type*	lut_iter = basic_string::get_lut_base_ptr( buffer , buffer_size );
+		
+		// Build the lut in place, if it's worth it and fits into the spare capacity behind the trailing '\0'
+		if( basic_string::is_lut_worth( num_multibytes , string_len , false , false ) && data_len + 1 + num_multibytes * lut_width <= buffer_size ){
+			basic_string::set_lut_indiciator( lut_iter , true , num_multibytes );
+			basic_string::fill_lut( lut_iter , lut_width , buffer , data_len );
+		}
+		else
+			basic_string::set_lut_indiciator( lut_iter , num_multibytes == 0 , 0 );
+		
+		buffer[data_len] = '\0'; // Set trailing '\0'
+		
+		// Set Attributes
+		t_non_sso.data = buffer;
+		t_non_sso.buffer_size = buffer_size;
+		t_non_sso.data_len = data_len;
+		set_non_sso_string_len( string_len ); // This also disables SSO
+		
+		update_jump_table( 0 );
+	}
+
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::heap_buffer basic_string<V, D, A, S>::release() noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		heap_buffer result;
+		if( sso_inactive() )
+			result = { t_non_sso.data , t_non_sso.data_len , basic_string::determine_total_buffer_size( t_non_sso.buffer_size ) };
+		else{
+			// Move small strings to the heap
+			size_type data_len = get_sso_data_len();
+			result = allocate_buffer( data_len + 1 );
+		#if defined(TINY_UTF8_NOEXCEPT)
+			if( !result.data )
+				return result;
+		#endif
+			std::memcpy( result.data , t_sso.data , data_len );
+			result.data[data_len] = '\0';
+			result.data_len = data_len;
+		}
+		
+		// Reset to an empty string (in sso mode, which makes it not care about the buffer anymore)
+		set_sso_data_len( 0 );
+		t_sso.data[0] = 0;
+		return result;
 	}
 
-	template<typename V, typename D, typename A>
-	basic_string<V, D, A>::basic_string( const data_type* str , size_type pos , size_type count , size_type data_left , const typename basic_string<V, D, A>::allocator_type& alloc , tiny_utf8_detail::read_codepoints_tag )
-		noexcept(TINY_UTF8_NOEXCEPT)
-		: basic_string( alloc )
+	template<typename V, typename D, typename A, std::size_t S>
+	void basic_string_builder<V, D, A, S>::grow( typename basic_string_builder<V, D, A, S>::size_type buffer_size ) noexcept(TINY_UTF8_NOEXCEPT)
 	{
-		if( !count )
-			return;
+		buffer_size = string_type::round_up_to_align( buffer_size );
+		data_type* buffer = t_string.allocate( string_type::determine_total_buffer_size( buffer_size ) );
+		if( t_buffer ){
+			std::memcpy( buffer , t_buffer , t_size );
+			t_string.deallocate( t_buffer , t_buffer_size );
+		}
+		t_buffer = buffer;
+		t_buffer_size = buffer_size;
+	}
+
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string_builder<V, D, A, S>::string_type basic_string_builder<V, D, A, S>::finalize() noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		string_type result( t_string.get_allocator() );
 		
-		size_type	num_multibytes = 0;
-		size_type	data_len = 0;
-		size_type	string_len = 0;
-		data_type*	buffer;
+		// Small strings are copied into the sso buffer
+		if( t_size <= string_type::get_sso_capacity() ){
+			if( t_size )
+				string_type( t_buffer , t_size , t_string.get_allocator() , tiny_utf8_detail::read_bytes_tag() ).swap( result );
+			clear();
+			return result;
+		}
 		
-		// Iterate to the nth codepoint marking the start of the string to copy
-		while( *str && string_len < pos && data_left != 0u ){
-			width_type bytes = get_codepoint_bytes( str[data_len] , data_left ); // Read number of bytes of current codepoint
-			data_left		-= bytes;
-			str				+= bytes;
-			++string_len;
+		size_type	string_len;
+		size_type	num_multibytes = string_type::count_multibytes( t_buffer , t_size , string_len );
+		
+		// Make room for the lut, if it's worth it but more multibytes arrived than expected (or the buffer grew into a wider lut)
+		if( string_type::is_lut_worth( num_multibytes , string_len , false , false )
+			&& t_size + 1 + num_multibytes * string_type::get_lut_width( t_buffer_size ) > t_buffer_size
+		){
+			width_type	lut_width;
+			grow( string_type::determine_main_buffer_size( t_size , num_multibytes , &lut_width ) );
 		}
-		string_len = 0;
 		
-		// Count bytes, multibytes and string length
-		while( str[data_len] && string_len < count )
+		result.assign_heap_buffer( t_buffer , t_buffer_size , t_size , string_len , num_multibytes );
+		t_buffer = nullptr;
+		t_buffer_size = t_size = 0;
+		return result;
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	basic_stream_decoder<V, D, A, S>& basic_stream_decoder<V, D, A, S>::feed( const data_type* chunk , typename basic_stream_decoder<V, D, A, S>::size_type len ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		size_type index = 0;
+		
+		// Complete the codepoint held back from the last chunk
+		if( t_num_pending )
 		{
-			// Read number of bytes of current codepoint
-			width_type bytes = get_codepoint_bytes( str[data_len] , data_left );
-			data_len		+= bytes;				// Increase number of bytes
-			data_left		-= bytes;				// Decrease amount of bytes left
-			string_len		+= 1;					// Increase number of codepoints
-			num_multibytes	+= bytes > 1 ? 1 : 0;	// Increase number of occoured multibytes?
+			// Walk the pending bytes just like the data would be walked as a whole
+			size_type end = 0;
+			while( end < t_num_pending )
+				end += string_type::get_codepoint_bytes( t_pending[end] , string_type::npos );
+			
+			// Still not complete?
+			if( end > t_num_pending + len ){
+				std::memcpy( t_pending + t_num_pending , chunk , len );
+				t_num_pending += len;
+				return *this;
+			}
+			
+			index = end - t_num_pending;
+			std::memcpy( t_pending + t_num_pending , chunk , index );
+			append( t_pending , end );
+			t_num_pending = 0;
 		}
 		
-		// Need heap memory?
-		if( data_len > basic_string::get_sso_capacity() )
+		if( index >= len )
+			return *this;
+		
+		// Determine the last codepoint start, behind which no codepoint (attempts to) cross the end of the chunk.
+		// Usually, one of the last 8 indices can be proven to start a codepoint, otherwise the chunk is walked
+		size_type end = len;
+		size_type min_end = len - index > 7 ? len - 7 : index;
+		while( end > min_end && string_type::is_spanned_by_lead_byte( chunk , end , index , string_type::npos ) )
+			--end;
+		if( end == min_end && min_end != index ){
+			for( end = index ; end < len ; ){
+				size_type bytes = string_type::get_codepoint_bytes( chunk[end] , string_type::npos );
+				if( end + bytes > len )
+					break;
+				end += bytes;
+			}
+		}
+		
+		if( end > index )
+			append( chunk + index , end - index );
+		
+		// Hold back the rest
+		std::memcpy( t_pending , chunk + end , len - end );
+		t_num_pending = len - end;
+		return *this;
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	bool basic_line_reader<V, D, A, S>::read( string_type& line ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		line.clear();
+		basic_stream_decoder<V, D, A, S>	decoder( line );
+		bool							read_any = false;
+		
+		for( ;; )
 		{
-			if( basic_string::is_lut_worth( num_multibytes , string_len , false , false ) )
-			{
-				// Determine the buffer size (excluding the lut indicator) and the lut width
-				width_type	lut_width;
-				size_type	buffer_size	= determine_main_buffer_size( data_len , num_multibytes , &lut_width );
-				buffer = this->allocate( determine_total_buffer_size( buffer_size ) );
-			#if defined(TINY_UTF8_NOEXCEPT)
-				if( !buffer )
-					return;
-			#endif
-				t_non_sso.data = buffer;
-				
-				// Set up LUT
-				data_type*	lut_iter = basic_string::get_lut_base_ptr( buffer , buffer_size );
-				basic_string::set_lut_indiciator( lut_iter , true , num_multibytes ); // Set the LUT indicator
-				
-				// Fill the lut and copy bytes
-				data_type* buffer_iter = buffer;
-				const data_type* str_iter = str;
-				const data_type* str_end = str + data_len; // Compute End of the string
-				while( str_iter < str_end )
-				{
-					width_type bytes = get_codepoint_bytes( *str_iter , str_end - str_iter );
-					switch( bytes )
-					{
-						case 7:	buffer_iter[6] = str_iter[6]; TINY_UTF8_FALLTHROUGH // Copy data byte
-						case 6:	buffer_iter[5] = str_iter[5]; TINY_UTF8_FALLTHROUGH // Copy data byte
-						case 5:	buffer_iter[4] = str_iter[4]; TINY_UTF8_FALLTHROUGH // Copy data byte
-						case 4:	buffer_iter[3] = str_iter[3]; TINY_UTF8_FALLTHROUGH // Copy data byte
-						case 3:	buffer_iter[2] = str_iter[2]; TINY_UTF8_FALLTHROUGH // Copy data byte
-						case 2:	buffer_iter[1] = str_iter[1]; // Copy data byte
-							// Set next entry in the LUT!
-							basic_string::set_lut( lut_iter -= lut_width , lut_width , str_iter - str );
-							TINY_UTF8_FALLTHROUGH
-						case 1: buffer_iter[0] = str_iter[0]; break; // Copy data byte
-					}
-					buffer_iter	+= bytes;
-					str_iter	+= bytes;
+			// Refill the buffer
+			if( t_index == t_buffer.data_len ){
+				std::streamsize num_read = t_streambuf->sgetn( (char*)t_buffer.data , (std::streamsize)t_buffer.capacity );
+				t_buffer.data_len = num_read > 0 ? (size_type)num_read : 0;
+				t_index = 0;
+				if( !t_buffer.data_len ){
+					decoder.finish();
+					return read_any;
 				}
-				*buffer_iter = '\0'; // Set trailing '\0'
-				
-				// Set Attributes
-				t_non_sso.buffer_size = buffer_size;
-				t_non_sso.data_len = data_len;
-				set_non_sso_string_len( string_len ); // This also disables SSO
-				
-				return; // We have already done everything!
 			}
+			read_any = true;
 			
-			size_type buffer_size = determine_main_buffer_size( data_len );
-			buffer = t_non_sso.data = this->allocate( determine_total_buffer_size( buffer_size ) );
-			
-			// Set up LUT
-			data_type*	lut_iter = basic_string::get_lut_base_ptr( buffer , buffer_size );
-			basic_string::set_lut_indiciator( lut_iter , num_multibytes == 0 , 0 ); // Set the LUT indicator
-			
-			// Set Attributes
-			t_non_sso.buffer_size = buffer_size;
-			t_non_sso.data_len = data_len;
-			set_non_sso_string_len( string_len );
-		}
-		else{
-			buffer = t_sso.data;
-			
-			// Set Attrbutes
-			set_sso_data_len( (unsigned char)data_len );
-			
-			// Set up LUT: Not necessary, since the LUT is automatically inactive,
-			// since SSO is active and the LUT indicator shadows 't_sso.data_len', which has the LSB = 0 (=> LUT inactive).
+			// Search for the delimiter, which is ASCII and thus never part of a multibyte
+			const data_type*	begin = t_buffer.data + t_index;
+			size_type			num_bytes = t_buffer.data_len - t_index;
+			const data_type*	delimiter = (const data_type*)std::memchr( begin , (unsigned char)t_delimiter , num_bytes );
+			if( delimiter ){
+				decoder.feed( begin , delimiter - begin ).finish();
+				t_index += delimiter - begin + 1;
+				return true;
+			}
+			decoder.feed( begin , num_bytes );
+			t_index = t_buffer.data_len;
 		}
-		
-		//! Fill the buffer
-		std::memcpy( buffer , str , data_len );
-		buffer[data_len] = '\0';
 	}
 
-	template<typename V, typename D, typename A>
-	basic_string<V, D, A>::basic_string( const data_type* str , size_type data_len , const typename basic_string<V, D, A>::allocator_type& alloc , tiny_utf8_detail::read_bytes_tag )
+	template<typename V, typename D, typename A, std::size_t S>
+	basic_string<V, D, A, S>::basic_string( const data_type* str , size_type data_len , const typename basic_string<V, D, A, S>::allocator_type& alloc , tiny_utf8_detail::read_bytes_tag )
 		noexcept(TINY_UTF8_NOEXCEPT)
 		: basic_string( alloc )
 	{
 		if( !data_len )
 			return;
 		
-		size_type		num_multibytes = 0;
-		size_type		index = 0;
-		size_type		string_len = 0;
+		// Count multibytes and string length
+		size_type	string_len;
+		size_type	num_multibytes = basic_string::count_multibytes( str , data_len , string_len );
+		init_from_bytes( str , data_len , string_len , num_multibytes );
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	basic_string<V, D, A, S>::basic_string( const data_type* str , size_type data_len , validate_utf8_t , const typename basic_string<V, D, A, S>::allocator_type& alloc )
+		noexcept(TINY_UTF8_NOEXCEPT)
+		: basic_string( alloc )
+	{
+		if( !data_len )
+			return;
 		
-		// Count bytes, multibytes and string length
-		while( index < data_len )
-		{
-			// Read number of bytes of current codepoint
-			width_type bytes = get_codepoint_bytes( str[index] , basic_string::npos );
-			index			+= bytes;				// Increase number of bytes
-			string_len		+= 1;					// Increase number of codepoints
-			num_multibytes	+= bytes > 1 ? 1 : 0;	// Increase number of occoured multibytes?
+		// Valid data is counted along with the validation, malformed data has to be counted the usual way
+		size_type	string_len;
+		size_type	num_multibytes;
+		bool		valid = tiny_utf8_detail::validate_and_count( (const unsigned char*)str , data_len , string_len , num_multibytes );
+		if( !valid )
+			num_multibytes = basic_string::count_multibytes( str , data_len , string_len );
+		init_from_bytes( str , data_len , string_len , num_multibytes );
+		
+		if( valid && sso_inactive() )
+			basic_string::set_trusted( basic_string::get_lut_base_ptr( t_non_sso.data , t_non_sso.buffer_size ) );
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	bool basic_string<V, D, A, S>::validate() noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		if( sso_active() ) // Small strings are counted on the fly and never trusted
+			return is_valid_utf8();
+		
+		data_type*	lut_base_ptr = basic_string::get_lut_base_ptr( t_non_sso.data , t_non_sso.buffer_size );
+		if( basic_string::is_trusted( lut_base_ptr ) )
+			return true;
+		
+		size_type	string_len;
+		size_type	num_multibytes;
+		if( !tiny_utf8_detail::validate_and_count( (const unsigned char*)t_non_sso.data , t_non_sso.data_len , string_len , num_multibytes ) )
+			return false;
+		
+		// Check, whether the bookkeeping matches the data
+		if( string_len != get_non_sso_string_len()
+			|| ( basic_string::is_lut_active( lut_base_ptr ) && num_multibytes != basic_string::get_lut_len( lut_base_ptr ) )
+		){
+			basic_string recounted( t_non_sso.data , t_non_sso.data_len , validate_utf8 , get_allocator() );
+			if( recounted.size() != t_non_sso.data_len ) // Out of memory
+				return true;
+			*this = std::move( recounted );
+			return true;
 		}
 		
+		basic_string::set_trusted( lut_base_ptr );
+		return true;
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	void basic_string<V, D, A, S>::init_from_bytes( const data_type* str , size_type data_len , size_type string_len , size_type num_multibytes ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
 		data_type*	buffer;
 		
 		// Need heap memory?
@@ -2974,40 +6841,26 @@ namespace tiny_utf8
 			#endif
 				t_non_sso.data = buffer;
 				
-				// Set up LUT
+				// Copy bytes
+				std::memcpy( buffer , str , data_len );
+				buffer[data_len] = '\0'; // Set trailing '\0'
+				
+				// Set up LUT (or leave that to the first random access)
 				data_type*	lut_iter = basic_string::get_lut_base_ptr( buffer , buffer_size );
+			#if defined(TINY_UTF8_LAZY_LUT)
+				(void)lut_width;
+				basic_string::set_lut_deferred( lut_iter );
+			#else
 				basic_string::set_lut_indiciator( lut_iter , true , num_multibytes ); // Set the LUT indicator
-				
-				// Fill the lut and copy bytes
-				data_type* buffer_iter = buffer;
-				const data_type* str_iter = str;
-				const data_type* str_end = str + data_len; // Compute End of the string
-				while( str_iter < str_end )
-				{
-					width_type bytes = get_codepoint_bytes( *str_iter , str_end - str_iter );
-					switch( bytes )
-					{
-						case 7:	buffer_iter[6] = str_iter[6]; TINY_UTF8_FALLTHROUGH // Copy data byte
-						case 6:	buffer_iter[5] = str_iter[5]; TINY_UTF8_FALLTHROUGH // Copy data byte
-						case 5:	buffer_iter[4] = str_iter[4]; TINY_UTF8_FALLTHROUGH // Copy data byte
-						case 4:	buffer_iter[3] = str_iter[3]; TINY_UTF8_FALLTHROUGH // Copy data byte
-						case 3:	buffer_iter[2] = str_iter[2]; TINY_UTF8_FALLTHROUGH // Copy data byte
-						case 2:	buffer_iter[1] = str_iter[1]; // Copy data byte
-							// Set next entry in the LUT!
-							basic_string::set_lut( lut_iter -= lut_width , lut_width , str_iter - str );
-							TINY_UTF8_FALLTHROUGH
-						case 1: buffer_iter[0] = str_iter[0]; break; // Copy data byte
-					}
-					buffer_iter	+= bytes;
-					str_iter	+= bytes;
-				}
-				*buffer_iter = '\0'; // Set trailing '\0'
+				basic_string::fill_lut( lut_iter , lut_width , str , data_len );
+			#endif
 				
 				// Set Attributes
 				t_non_sso.buffer_size = buffer_size;
 				t_non_sso.data_len = data_len;
 				set_non_sso_string_len( string_len ); // This also disables SSO
 				
+				update_jump_table( 0 );
 				return; // We have already done everything!
 			}
 			
@@ -3036,28 +6889,133 @@ namespace tiny_utf8
 		//! Fill the buffer
 		std::memcpy( buffer , str , data_len );
 		buffer[data_len] = '\0';
+		
+		update_jump_table( 0 );
 	}
 
-	template<typename V, typename D, typename A>
-	basic_string<V, D, A>::basic_string( const value_type* str , size_type len , const typename basic_string<V, D, A>::allocator_type& alloc )
+	template<typename V, typename D, typename A, std::size_t S>
+	template<typename ParallelFor>
+	basic_string<V, D, A, S> basic_string<V, D, A, S>::from_bytes_parallel( const data_type* str , typename basic_string<V, D, A, S>::size_type data_len , typename basic_string<V, D, A, S>::size_type num_tasks , ParallelFor&& parallel_for , const typename basic_string<V, D, A, S>::allocator_type& alloc ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		num_tasks = std::min<size_type>( { num_tasks , max_parallel_tasks , data_len / min_parallel_task_size } );
+		if( num_tasks < 2 )
+			return basic_string( str , data_len , alloc , tiny_utf8_detail::read_bytes_tag() );
+		
+		// Split the data into tasks of roughly equal size, each of which starts with a codepoint.
+		// Note: Since the bounds are not spanned by any lead byte, both the serial walk and ours starting at a bound meet them exactly.
+		// Malformed data, that doesn't have such a bound nearby, is left to the previous task
+		size_type	bounds[max_parallel_tasks + 1];
+		bounds[0] = 0;
+		for( size_type i = 1 ; i < num_tasks ; ++i ){
+			size_type bound = std::max( bounds[i-1] , data_len / num_tasks * i );
+			size_type limit = std::min( bound + 64 , data_len );
+			while( bound < limit && basic_string::is_spanned_by_lead_byte( str , bound , bounds[i-1] , basic_string::npos ) )
+				++bound;
+			bounds[i] = bound < limit ? bound : bounds[i-1];
+		}
+		bounds[num_tasks] = data_len;
+		
+		// Count multibytes and codepoints of each task
+		size_type	string_lens[max_parallel_tasks];
+		size_type	num_multibytes[max_parallel_tasks];
+		parallel_for( num_tasks , [&]( size_type i ){
+			num_multibytes[i] = basic_string::count_multibytes( str + bounds[i] , bounds[i+1] - bounds[i] , string_lens[i] );
+		});
+		
+		// Sum up the results, while turning the number of multibytes into the index of the first lut entry of each task
+		size_type	string_len = 0;
+		size_type	lut_len = 0;
+		for( size_type i = 0 ; i < num_tasks ; ++i ){
+			size_type task_multibytes = num_multibytes[i];
+			num_multibytes[i] = lut_len;
+			lut_len += task_multibytes;
+			string_len += string_lens[i];
+		}
+		
+		// Allocate the buffer
+		basic_string	result( alloc );
+		width_type		lut_width = 0;
+		bool			lut_worth = basic_string::is_lut_worth( lut_len , string_len , false , false );
+		size_type		buffer_size = lut_worth ? determine_main_buffer_size( data_len , lut_len , &lut_width ) : determine_main_buffer_size( data_len );
+		data_type*		buffer = result.allocate( determine_total_buffer_size( buffer_size ) );
+	#if defined(TINY_UTF8_NOEXCEPT)
+		if( !buffer )
+			return result;
+	#endif
+		
+		// Set up the lut indicator (and the lut mode of the jump table)
+		data_type*	lut_base_ptr = basic_string::get_lut_base_ptr( buffer , buffer_size );
+		data_type*	jump_table_base_ptr = basic_string::get_jump_table_base_ptr( lut_base_ptr );
+		size_type	num_chunks = lut_worth || !lut_len ? 0 : data_len / jump_table_chunk; // Chunks are only described for inactive luts
+		if( lut_worth ){
+			TINY_UTF8_STAT( lut_builds );
+			basic_string::set_lut_indiciator( lut_base_ptr , true , lut_len );
+		}
+		else
+			basic_string::set_lut_indiciator( lut_base_ptr , lut_len == 0 , 0 );
+		
+		// Copy the data and fill either the lut or the jump table (whose chunks are assigned to the task they start in)
+		parallel_for( num_tasks , [&]( size_type i ){
+			std::memcpy( buffer + bounds[i] , str + bounds[i] , bounds[i+1] - bounds[i] );
+			if( lut_worth )
+				basic_string::fill_lut( lut_base_ptr - num_multibytes[i] * lut_width , lut_width , str , bounds[i] , bounds[i+1] );
+			else if( num_chunks )
+				basic_string::set_jump_table_chunks(
+					str , data_len , jump_table_base_ptr , bounds[i]
+					, std::min( ( bounds[i] + jump_table_chunk - 1 ) / jump_table_chunk , num_chunks )
+					, std::min( ( bounds[i+1] + jump_table_chunk - 1 ) / jump_table_chunk , num_chunks )
+				);
+		});
+		buffer[data_len] = '\0';
+		
+		// Set Attributes
+		result.t_non_sso.data = buffer;
+		result.t_non_sso.buffer_size = buffer_size;
+		result.t_non_sso.data_len = data_len;
+		result.set_non_sso_string_len( string_len ); // This also disables SSO
+		
+		// The jump table of an active lut is derived from the lut, i.e. it has to be built afterwards
+		if( num_chunks )
+			basic_string::set_jump_table_len( jump_table_base_ptr , false , num_chunks );
+		else
+			result.update_jump_table( 0 );
+		
+		return result;
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	basic_string<V, D, A, S>::basic_string( const value_type* str , size_type len , const typename basic_string<V, D, A, S>::allocator_type& alloc )
 		noexcept(TINY_UTF8_NOEXCEPT)
 		: basic_string( alloc )
 	{
-		if( !len )
-			return;
-		
+		if( len == basic_string::npos )
+			len = tiny_utf8_detail::strlen( str );
+		if( len )
+			init_from_codepoints( str , len );
+	}
+
+	template<typename V, typename D, typename A, std::size_t S>
+	template<typename ForwardIt>
+	void basic_string<V, D, A, S>::init_from_codepoints( ForwardIt first , size_type string_len ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
 		size_type		num_multibytes = 0;
 		size_type		data_len = 0;
-		size_type		string_len = 0;
 		
-		// Count bytes, mutlibytes and string length
-		while( string_len < len && ( str[string_len] || len != basic_string::npos ) )
+		// Count bytes and mutlibytes
+		ForwardIt iter = first;
+		for( size_type i = 0 ; i < string_len ; )
 		{
+			// Skip ASCII runs in bulk
+			size_type num_ascii = basic_string::skip_ascii_codepoints( iter , string_len - i );
+			data_len += num_ascii;
+			if( ( i += num_ascii ) >= string_len )
+				break;
+			
 			// Read number of bytes of current codepoint
-			width_type bytes = get_codepoint_bytes( str[string_len] );
+			width_type bytes = get_codepoint_bytes( *iter );
+			++iter, ++i;
 			
 			data_len		+= bytes;		// Increase number of bytes
-			string_len		+= 1;			// Increase number of codepoints
 			num_multibytes	+= bytes > 1 ;	// Increase number of occoured multibytes?
 		}
 		
@@ -3082,12 +7040,18 @@ namespace tiny_utf8
 				data_type* lut_iter		= basic_string::get_lut_base_ptr( buffer , buffer_size );
 				data_type* buffer_iter	= buffer;
 				basic_string::set_lut_indiciator( lut_iter , true , num_multibytes ); // Set the LUT indicator
+				TINY_UTF8_STAT( lut_builds );
 				
 				// Iterate through wide char literal
-				for( size_type i = 0 ; i < string_len ; i++ )
+				for( size_type i = 0 ; i < string_len ; )
 				{
+					// Copy ASCII runs in bulk
+					if( ( i += basic_string::encode_ascii_codepoints( first , string_len - i , buffer_iter ) ) >= string_len )
+						break;
+					
 					// Encode wide char to utf8
-					width_type codepoint_bytes = basic_string::encode_utf8( str[i] , buffer_iter );
+					width_type codepoint_bytes = basic_string::encode_utf8( *first , buffer_iter );
+					++first, ++i;
 					
 					// Push position of character to 'indices'
 					if( codepoint_bytes > 1 )
@@ -3103,6 +7067,7 @@ namespace tiny_utf8
 				t_non_sso.data_len = data_len;
 				set_non_sso_string_len( string_len );
 				
+				update_jump_table( 0 );
 				return; // We have already done everything!
 			}
 			
@@ -3131,42 +7096,49 @@ namespace tiny_utf8
 		data_type* buffer_iter = buffer;
 		
 		// Iterate through wide char literal
-		for( size_type i = 0 ; i < string_len ; i++ )
+		for( size_type i = 0 ; i < string_len ; ++first, ++i ){
+			// Copy ASCII runs in bulk
+			if( ( i += basic_string::encode_ascii_codepoints( first , string_len - i , buffer_iter ) ) >= string_len )
+				break;
 			// Encode wide char to utf8 and step forward the number of bytes it took
-			buffer_iter += basic_string::encode_utf8( str[i] , buffer_iter );
+			buffer_iter += basic_string::encode_utf8( *first , buffer_iter );
+		}
 		
 		*buffer_iter = '\0'; // Set trailing '\0'
+		
+		update_jump_table( 0 );
 	}
 
-	template<typename V, typename D, typename A>
-	typename basic_string<V, D, A>::width_type basic_string<V, D, A>::get_num_bytes_of_utf8_char_before( const data_type* data_start , size_type index ) noexcept
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::width_type basic_string<V, D, A, S>::get_num_bytes_of_utf8_char_before( const data_type* data_start , size_type index ) noexcept
 	{
 		data_start += index;
 		// Only Check the possibilities, that could appear
+		// A lead byte is only accepted, if its own width is the distance to 'index' (e.g. 1111110X is a six byte lead, wherever it is)
 		switch( index )
 		{
 			default:
-				if( ((unsigned char)data_start[-7] & 0xFE ) == 0xFC )	// 11111110 seven bytes
+				if( basic_string::get_codepoint_bytes( data_start[-7] , 7 ) == 7 )	// 11111110 seven bytes
 					return 7;
 				TINY_UTF8_FALLTHROUGH
 			case 6:
-				if( ((unsigned char)data_start[-6] & 0xFE ) == 0xFC )	// 1111110X six bytes
+				if( basic_string::get_codepoint_bytes( data_start[-6] , 6 ) == 6 )	// 1111110X six bytes
 					return 6;
 				TINY_UTF8_FALLTHROUGH
 			case 5:
-				if( ((unsigned char)data_start[-5] & 0xFC ) == 0xF8 )	// 111110XX five bytes
+				if( basic_string::get_codepoint_bytes( data_start[-5] , 5 ) == 5 )	// 111110XX five bytes
 					return 5;
 				TINY_UTF8_FALLTHROUGH
 			case 4:
-				if( ((unsigned char)data_start[-4] & 0xF8 ) == 0xF0 )	// 11110XXX four bytes
+				if( basic_string::get_codepoint_bytes( data_start[-4] , 4 ) == 4 )	// 11110XXX four bytes
 					return 4;
 				TINY_UTF8_FALLTHROUGH
 			case 3:
-				if( ((unsigned char)data_start[-3] & 0xF0 ) == 0xE0 )	// 1110XXXX three bytes
+				if( basic_string::get_codepoint_bytes( data_start[-3] , 3 ) == 3 )	// 1110XXXX three bytes
 					return 3;
 				TINY_UTF8_FALLTHROUGH
 			case 2:
-				if( ((unsigned char)data_start[-2] & 0xE0 ) == 0xC0 )	// 110XXXXX two bytes
+				if( basic_string::get_codepoint_bytes( data_start[-2] , 2 ) == 2 )	// 110XXXXX two bytes
 					return 2;
 				TINY_UTF8_FALLTHROUGH
 			case 1:
@@ -3176,8 +7148,8 @@ namespace tiny_utf8
 	}
 
 	#if !TINY_UTF8_HAS_CLZ
-	template<typename V, typename D, typename A>
-	typename basic_string<V, D, A>::width_type basic_string<V, D, A>::get_codepoint_bytes( typename basic_string<V, D, A>::data_type first_byte , typename basic_string<V, D, A>::size_type data_left ) noexcept
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::width_type basic_string<V, D, A, S>::get_codepoint_bytes( typename basic_string<V, D, A, S>::data_type first_byte , typename basic_string<V, D, A, S>::size_type data_left ) noexcept
 	{
 		// Only Check the possibilities, that could appear
 		switch( data_left )
@@ -3207,8 +7179,8 @@ namespace tiny_utf8
 	}
 	#endif // !TINY_UTF8_HAS_CLZ
 
-	template<typename V, typename D, typename A>
-	basic_string<V, D, A>& basic_string<V, D, A>::operator=( const basic_string<V, D, A>& str ) noexcept(TINY_UTF8_NOEXCEPT)
+	template<typename V, typename D, typename A, std::size_t S>
+	basic_string<V, D, A, S>& basic_string<V, D, A, S>::operator=( const basic_string<V, D, A, S>& str ) noexcept(TINY_UTF8_NOEXCEPT)
 	{
 		// Note: Self assignment is expected to be very rare. We tolerate overhead in this situation.
 		// Therefore, we right away check for sso states in 'this' and 'str'.
@@ -3220,8 +7192,11 @@ namespace tiny_utf8
 			{
 				if( &str == this )
 					return *this;
-				const data_type* str_lut_base_ptr = basic_string::get_lut_base_ptr( str.t_non_sso.data , str.t_non_sso.buffer_size );
-				if( basic_string::is_lut_active( str_lut_base_ptr ) )
+				const data_type*	str_lut_base_ptr = basic_string::get_lut_base_ptr( str.t_non_sso.data , str.t_non_sso.buffer_size );
+				indicator_type		str_lut_indicator = basic_string::load_lut_indicator( str_lut_base_ptr ); // The lut of 'str' might be built concurrently (see 'lut_deferred')
+				if( propagate_on_copy_assignment::value && !allocator_equals( str ) ) // Our buffer must be freed by our current allocator
+					goto lbl_replicate_whole_buffer;
+				if( str_lut_indicator & 0x1 )
 				{
 					width_type	lut_width = get_lut_width( t_non_sso.buffer_size ); // Lut width, if the current buffer is used
 					size_type	str_lut_len = basic_string::get_lut_len( str_lut_base_ptr );
@@ -3241,12 +7216,13 @@ namespace tiny_utf8
 							);
 						}
 						else{
-							data_type* lut_iter = basic_string::get_lut_base_ptr( t_non_sso.data , t_non_sso.buffer_size );
+							data_type*			lut_iter = basic_string::get_lut_base_ptr( t_non_sso.data , t_non_sso.buffer_size );
+							const data_type*	str_lut_iter = str_lut_base_ptr;
 							for( ; str_lut_len > 0 ; --str_lut_len )
 								basic_string::set_lut(
 									lut_iter -= lut_width
 									, lut_width
-									, basic_string::get_lut( str_lut_base_ptr -= str_lut_width , str_lut_width )
+									, basic_string::get_lut( str_lut_iter -= str_lut_width , str_lut_width )
 								);
 						}
 					}
@@ -3261,11 +7237,14 @@ namespace tiny_utf8
 				std::memcpy( t_non_sso.data , str.t_non_sso.data , str.t_non_sso.data_len + 1 );
 				basic_string::copy_lut_indicator(
 					basic_string::get_lut_base_ptr( t_non_sso.data , t_non_sso.buffer_size )
-					, str_lut_base_ptr
+					, str_lut_indicator
 				);
 				t_non_sso.data_len = str.t_non_sso.data_len;
-				t_non_sso.string_len = str.t_non_sso.string_len; // Copy the string_len bit pattern
-				(allocator_type&)*this = (const allocator_type&)str; // Copy allocator
+				set_non_sso_string_len( str.get_non_sso_string_len() );
+				this->copy_allocator( str , propagate_on_copy_assignment() ); // Copy allocator
+				update_jump_table( 0 );
+				if( basic_string::is_trusted( str_lut_base_ptr ) ) // The copy is as valid as the original
+					basic_string::set_trusted( basic_string::get_lut_base_ptr( t_non_sso.data , t_non_sso.buffer_size ) );
 				return *this;
 				
 			lbl_replicate_whole_buffer: // Replicate the whole buffer
@@ -3273,19 +7252,19 @@ namespace tiny_utf8
 			}
 				TINY_UTF8_FALLTHROUGH
 			case 2: // [sso-active] = [sso-inactive]
-				(allocator_type&)*this = (const allocator_type&)str; // Copy allocator
+				this->copy_allocator( str , propagate_on_copy_assignment() ); // Copy allocator
 				t_non_sso.data = this->allocate(  basic_string::determine_total_buffer_size( str.t_non_sso.buffer_size ) );
-				std::memcpy( t_non_sso.data , str.t_non_sso.data , str.t_non_sso.buffer_size + sizeof(indicator_type) ); // Copy data
 				t_non_sso.buffer_size = str.t_non_sso.buffer_size;
 				t_non_sso.data_len = str.t_non_sso.data_len;
-				t_non_sso.string_len = str.t_non_sso.string_len; // This also disables SSO
+				copy_heap_buffer( str ); // Copy data
+				set_non_sso_string_len( str.get_non_sso_string_len() ); // This also disables SSO
 				return *this;
 			case 1: // [sso-inactive] = [sso-active]
 				this->deallocate( t_non_sso.data , t_non_sso.buffer_size );
 				TINY_UTF8_FALLTHROUGH
 			case 0: // [sso-active] = [sso-active]
 				if( &str != this ){
-					(allocator_type&)*this = (const allocator_type&)str; // Copy allocator
+					this->copy_allocator( str , propagate_on_copy_assignment() ); // Copy allocator
 					std::memcpy( (void*)&this->t_sso , &str.t_sso , sizeof(basic_string::SSO) ); // Copy data
 				}
 				return *this;
@@ -3293,8 +7272,8 @@ namespace tiny_utf8
 		return *this;
 	}
 
-	template<typename V, typename D, typename A>
-	void basic_string<V, D, A>::shrink_to_fit() noexcept(TINY_UTF8_NOEXCEPT)
+	template<typename V, typename D, typename A, std::size_t S>
+	void basic_string<V, D, A, S>::shrink_to_fit() noexcept(TINY_UTF8_NOEXCEPT)
 	{
 		if( sso_active() )
 			return;
@@ -3307,6 +7286,7 @@ namespace tiny_utf8
 		size_type	buffer_size = get_buffer_size();
 		data_type*	buffer = get_buffer();
 		data_type*	lut_base_ptr = basic_string::get_lut_base_ptr( buffer , buffer_size );
+		bool		was_trusted = basic_string::is_trusted( lut_base_ptr );
 		size_type	required_buffer_size;
 		
 		if( is_lut_active( lut_base_ptr ) )
@@ -3326,6 +7306,7 @@ namespace tiny_utf8
 			
 			// Does the data type width change?
 			if( old_lut_width != new_lut_width ){ // Copy indices one at a time
+				TINY_UTF8_STAT( lut_width_changes );
 				basic_string::set_lut_indiciator( new_lut_base_ptr , true , lut_len );
 				for( size_type i = 0 ; i < lut_len ; i++ )
 					set_lut(
@@ -3348,18 +7329,23 @@ namespace tiny_utf8
 				return;
 			
 			t_non_sso.data = this->allocate(  determine_total_buffer_size( required_buffer_size ) ); // Allocate new buffer
+			basic_string::set_lut_indiciator( basic_string::get_lut_base_ptr( t_non_sso.data , required_buffer_size ) , false );
 		}
 		
 		// Copy BUFFER
 		std::memcpy( t_non_sso.data , buffer , data_len + 1 );
 		t_non_sso.buffer_size = required_buffer_size; // Set new buffer size
+		update_jump_table( 0 );
+		if( was_trusted ) // The data didn't change
+			basic_string::set_trusted( basic_string::get_lut_base_ptr( t_non_sso.data , required_buffer_size ) );
 		
 		// Delete old buffer
 		this->deallocate( buffer , buffer_size );
+		TINY_UTF8_STAT( reallocations );
 	}
 
-	template<typename V, typename D, typename A>
-	typename basic_string<V, D, A>::size_type basic_string<V, D, A>::get_non_sso_capacity() const noexcept
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::size_type basic_string<V, D, A, S>::get_non_sso_capacity() const noexcept
 	{
 		size_type	data_len		= t_non_sso.data_len;
 		size_type	buffer_size		= t_non_sso.buffer_size;
@@ -3380,8 +7366,8 @@ namespace tiny_utf8
 		return ( buffer_size - 1 ) * string_len / data_len;
 	}
 
-	template<typename V, typename D, typename A>
-	bool basic_string<V, D, A>::requires_unicode_sso() const noexcept
+	template<typename V, typename D, typename A, std::size_t S>
+	bool basic_string<V, D, A, S>::requires_unicode_sso() const noexcept
 	{
 		constexpr size_type mask = get_msb_mask<size_type>();
 		size_type			data_len = get_sso_data_len();
@@ -3401,8 +7387,8 @@ namespace tiny_utf8
 		return false;
 	}
 
-	template<typename V, typename D, typename A>
-	std::basic_string<typename basic_string<V, D, A>::data_type> basic_string<V, D, A>::cpp_str_bom() const noexcept
+	template<typename V, typename D, typename A, std::size_t S>
+	std::basic_string<typename basic_string<V, D, A, S>::data_type> basic_string<V, D, A, S>::cpp_str_bom() const noexcept
 	{
 		// Create std::string
 		std::basic_string<data_type>	result = std::basic_string<data_type>( size() + 3 , ' ' );
@@ -3419,11 +7405,13 @@ namespace tiny_utf8
 		return result;
 	}
 
-	template<typename V, typename D, typename A>
-	typename basic_string<V, D, A>::size_type basic_string<V, D, A>::get_num_codepoints( typename basic_string<V, D, A>::size_type index , typename basic_string<V, D, A>::size_type byte_count ) const noexcept
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::size_type basic_string<V, D, A, S>::get_num_codepoints( typename basic_string<V, D, A, S>::size_type index , typename basic_string<V, D, A, S>::size_type byte_count ) const noexcept
 	{
+		size_type			end_index = index + byte_count;
 		const data_type*	buffer;
 		size_type			data_len;
+		bool				trusted = false;
 		
 		if( sso_inactive() )
 		{
@@ -3432,63 +7420,89 @@ namespace tiny_utf8
 			size_type buffer_size			= t_non_sso.buffer_size;
 			const data_type*	lut_iter	= basic_string::get_lut_base_ptr( buffer , buffer_size );
 			
-			// Is the LUT active?
-			if( basic_string::is_lut_active( lut_iter ) )
+			// Is the LUT active (or about to be built)?
+			if( basic_string::is_lut_active( lut_iter ) || ( basic_string::is_lut_deferred( lut_iter ) && build_deferred_lut() ) )
 			{
 				size_type lut_len = basic_string::get_lut_len( lut_iter );
 				
-				if( !lut_len )
+				// 'end_index <= index' is needed because of potential integer overflow in sum
+				if( !lut_len || end_index <= index )
 					return byte_count;
 				
-				width_type			lut_width	= basic_string::get_lut_width( buffer_size );
-				const data_type*	lut_begin	= lut_iter - lut_len * lut_width;
-				size_type			end_index	= index + byte_count;
-				
-				// Iterate to the start of the relevant part of the multibyte table
-				while( lut_iter >= lut_begin ){
-					lut_iter -= lut_width; // Move cursor to the next lut entry
-					if( basic_string::get_lut( lut_iter , lut_width ) >= index )
-						break;
-				}
+				// Determine the relevant part of the multibyte table
+				width_type	lut_width	= basic_string::get_lut_width( buffer_size );
+				size_type	first		= basic_string::get_lut_rank( lut_iter , lut_width , lut_len , index );
+				size_type	last		= first + basic_string::get_lut_rank( lut_iter - first * lut_width , lut_width , lut_len - first , end_index );
 				
-				// Iterate over relevant multibyte indices
-				while( lut_iter >= lut_begin ){
-					size_type multibyte_index = basic_string::get_lut( lut_iter , lut_width );
-					if( multibyte_index >= end_index )
-						break;
-					byte_count -= basic_string::get_codepoint_bytes( buffer[multibyte_index] , data_len - multibyte_index ) - 1; // Subtract only the utf8 data bytes
-					lut_iter -= lut_width; // Move cursor to the next lut entry
-				}
+				// Subtract only the utf8 data bytes of the relevant multibytes (if there are many, use the jump table)
+				if( last - first > jump_table_stride )
+					byte_count -= get_lut_prefix_data_bytes( last ) - get_lut_prefix_data_bytes( first );
+				else
+					byte_count -= basic_string::get_lut_data_bytes( buffer , data_len , lut_iter , lut_width , first , last );
 				
 				// Now byte_count is the number of codepoints
 				return byte_count;
 			}
+			
+			TINY_UTF8_STAT( linear_scans );
+			trusted = basic_string::is_trusted( lut_iter );
+			
+			// Use the jump table to skip all chunks, whose codepoints are all located within the fragment (it's built along with a deferred lut)
+			if( basic_string::get_jump_table_size( buffer_size ) && !basic_string::is_lut_deferred( lut_iter ) )
+			{
+				const data_type*	jump_table_base_ptr = basic_string::get_jump_table_base_ptr( lut_iter );
+				size_type			num_chunks = basic_string::get_jump_table_len( jump_table_base_ptr , false );
+				size_type			chunk = index / jump_table_chunk + 1;
+				
+				if( chunk < num_chunks )
+				{
+					// Walk to the first codepoint of the next chunk
+					size_type chunk_start = basic_string::get_jump_table_chunk_start( jump_table_base_ptr , chunk );
+					if( index < end_index ){
+						size_type num_codepoints;
+						size_type next_index = basic_string::walk_codepoints( buffer , index , std::min( chunk_start , end_index ) , end_index , num_codepoints );
+						byte_count -= next_index - index - num_codepoints;
+						index = next_index;
+					}
+					
+					// Note: We might have missed the chunk start, if 'index' didn't point to the start of a codepoint
+					if( index == chunk_start ){
+						for( size_type next_start ; chunk + 1 < num_chunks && ( next_start = basic_string::get_jump_table_chunk_start( jump_table_base_ptr , chunk + 1 ) ) <= end_index ; ++chunk ){
+							byte_count -= next_start - index - basic_string::get_jump_table_chunk_len( jump_table_base_ptr , chunk );
+							index = next_start;
+						}
+					}
+				}
+			}
 		}
 		else{
 			buffer = t_sso.data;
 			data_len = get_sso_data_len();
 		}
 		
-		// Procedure: Reduce the byte count by the number of data bytes within multibytes
-		const data_type*	buffer_iter = buffer + index;
-		const data_type*	fragment_end = buffer_iter + byte_count;
+		// Trusted data between two codepoint starts: Every byte but the continuation bytes starts a codepoint
+		if( trusted && index < end_index && end_index <= data_len
+			&& ( (unsigned char)buffer[index] & 0xC0 ) != 0x80 && ( (unsigned char)buffer[end_index] & 0xC0 ) != 0x80
+		)
+			return byte_count - tiny_utf8_detail::count_continuation_bytes( (const unsigned char*)buffer + index , end_index - index );
 		
-		// Iterate the data byte by byte...
-		while( buffer_iter < fragment_end ){
-			width_type bytes = basic_string::get_codepoint_bytes( *buffer_iter , fragment_end - buffer_iter );
-			buffer_iter += bytes;
-			byte_count -= bytes - 1;
+		// Procedure: Reduce the byte count by the number of data bytes within multibytes
+		if( index < end_index ){
+			size_type num_codepoints;
+			byte_count -= basic_string::walk_codepoints( buffer , index , end_index , end_index , num_codepoints ) - index - num_codepoints;
 		}
 		
 		// Now byte_count is the number of codepoints
 		return byte_count;
 	}
 
-	template<typename V, typename D, typename A>
-	typename basic_string<V, D, A>::size_type basic_string<V, D, A>::get_num_bytes_from_start( typename basic_string<V, D, A>::size_type cp_count ) const noexcept
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::size_type basic_string<V, D, A, S>::get_num_bytes_from_start( typename basic_string<V, D, A, S>::size_type cp_count ) const noexcept
 	{
 		const data_type*	buffer;
 		size_type			data_len;
+		size_type			num_bytes = 0;
+		bool				trusted = false;
 		
 		if( sso_inactive() )
 		{
@@ -3497,14 +7511,39 @@ namespace tiny_utf8
 			size_type			buffer_size	= t_non_sso.buffer_size;
 			const data_type*	lut_iter	= basic_string::get_lut_base_ptr( buffer , buffer_size );
 			
-			// Is the lut active?
-			if( basic_string::is_lut_active( lut_iter ) )
+			// Is the lut active (or about to be built)?
+			if( basic_string::is_lut_active( lut_iter ) || ( basic_string::is_lut_deferred( lut_iter ) && build_deferred_lut() ) )
 			{
 				// Reduce the byte count by the number of data bytes within multibytes
-				width_type lut_width = basic_string::get_lut_width( buffer_size );
+				width_type	lut_width	= basic_string::get_lut_width( buffer_size );
+				size_type	lut_len		= basic_string::get_lut_len( lut_iter );
+				
+				// Use the jump table to skip all strides of the lut, whose multibytes are all located before the codepoint
+				if( basic_string::get_jump_table_size( buffer_size ) )
+				{
+					const data_type*	jump_table_base_ptr = basic_string::get_jump_table_base_ptr( lut_iter );
+					size_type			num_strides = 0;
+					size_type			data_bytes = 0;
+					
+					// Binary search for the last jump table entry that points to a multibyte before the codepoint.
+					// Note: 'multibyte_index - data_bytes' is the (strictly increasing) codepoint index of the multibyte
+					for( size_type len = basic_string::get_jump_table_len( jump_table_base_ptr , true ) ; len > 0 ; )
+					{
+						size_type half = len / 2;
+						size_type cur_data_bytes = basic_string::get_lut( basic_string::get_jump_table_entry_ptr( jump_table_base_ptr , lut_width , num_strides + half ) , lut_width );
+						if( basic_string::get_lut_entry( lut_iter , lut_width , ( num_strides + half + 1 ) * jump_table_stride ) - cur_data_bytes < cp_count )
+							num_strides += half + 1, len -= half + 1, data_bytes = cur_data_bytes;
+						else
+							len = half;
+					}
+					
+					cp_count	+= data_bytes;
+					lut_iter	-= num_strides * jump_table_stride * lut_width;
+					lut_len		-= num_strides * jump_table_stride;
+				}
 				
 				// Iterate over relevant multibyte indices
-				for( size_type lut_len = basic_string::get_lut_len( lut_iter ) ; lut_len-- > 0 ; )
+				while( lut_len-- > 0 )
 				{
 					size_type multibyte_index = basic_string::get_lut( lut_iter -= lut_width , lut_width );
 					if( multibyte_index >= cp_count )
@@ -3512,7 +7551,24 @@ namespace tiny_utf8
 					cp_count += basic_string::get_codepoint_bytes( buffer[multibyte_index] , data_len - multibyte_index ) - 1; // Subtract only the utf8 data bytes
 				}
 				
-				return cp_count;
+				return cp_count;
+			}
+			
+			TINY_UTF8_STAT( linear_scans );
+			trusted = basic_string::is_trusted( lut_iter );
+			
+			// Use the jump table to skip all chunks, whose codepoints are all located before the codepoint (it's built along with a deferred lut)
+			if( basic_string::get_jump_table_size( buffer_size ) && !basic_string::is_lut_deferred( lut_iter ) )
+			{
+				const data_type*	jump_table_base_ptr = basic_string::get_jump_table_base_ptr( lut_iter );
+				size_type			num_chunks = basic_string::get_jump_table_len( jump_table_base_ptr , false );
+				size_type			chunk = 0;
+				
+				if( num_chunks ){
+					for( size_type chunk_len ; chunk + 1 < num_chunks && ( chunk_len = basic_string::get_jump_table_chunk_len( jump_table_base_ptr , chunk ) ) <= cp_count ; ++chunk )
+						cp_count -= chunk_len;
+					num_bytes = basic_string::get_jump_table_chunk_start( jump_table_base_ptr , chunk );
+				}
 			}
 		}
 		else{
@@ -3520,19 +7576,29 @@ namespace tiny_utf8
 			data_len = get_sso_data_len();
 		}
 		
-		size_type num_bytes = 0;
+		// Walk over well-formed data in bulk (without any checks, if the data is trusted)
+		if( num_bytes < data_len ){
+			std::size_t num_codepoints;
+			num_bytes += trusted
+				? tiny_utf8_detail::count_valid_codepoints( (const unsigned char*)buffer + num_bytes , data_len - num_bytes , cp_count , num_codepoints )
+				: tiny_utf8_detail::count_codepoints( (const unsigned char*)buffer + num_bytes , data_len - num_bytes , cp_count , num_codepoints );
+			cp_count -= num_codepoints;
+		}
+		
 		while( cp_count-- > 0 && num_bytes <= data_len )
 			num_bytes += get_codepoint_bytes( buffer[num_bytes] , data_len - num_bytes );
 		
 		return num_bytes;
 	}
 
-	template<typename V, typename D, typename A>
-	typename basic_string<V, D, A>::size_type basic_string<V, D, A>::get_num_bytes( typename basic_string<V, D, A>::size_type index , typename basic_string<V, D, A>::size_type cp_count ) const noexcept
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::size_type basic_string<V, D, A, S>::get_num_bytes( typename basic_string<V, D, A, S>::size_type index , typename basic_string<V, D, A, S>::size_type cp_count ) const noexcept
 	{
 		size_type			potential_end_index = index + cp_count;
+		size_type			orig_index = index;
 		const data_type*	buffer;
 		size_type			data_len;
+		bool				trusted = false;
 		
 		// Procedure: Reduce the byte count by the number of utf8 data bytes
 		if( sso_inactive() )
@@ -3546,10 +7612,9 @@ namespace tiny_utf8
 			if( potential_end_index > data_len || potential_end_index < index )
 				return data_len - index;
 			
-			// Is the lut active?
-			if( basic_string::is_lut_active( lut_iter ) )
+			// Is the lut active (or about to be built)?
+			if( basic_string::is_lut_active( lut_iter ) || ( basic_string::is_lut_deferred( lut_iter ) && build_deferred_lut() ) )
 			{
-				size_type orig_index = index;
 				size_type lut_len = basic_string::get_lut_len( lut_iter );
 				
 				if( !lut_len )
@@ -3558,15 +7623,42 @@ namespace tiny_utf8
 				// Reduce the byte count by the number of data bytes within multibytes
 				width_type			lut_width = basic_string::get_lut_width( buffer_size );
 				const data_type*	lut_begin = lut_iter - lut_len * lut_width;
-				
-				// Iterate to the start of the relevant part of the multibyte table
-				for( lut_iter -= lut_width /* Move to first entry */ ; lut_iter >= lut_begin ; lut_iter -= lut_width )
-					if( basic_string::get_lut( lut_iter , lut_width ) >= index )
-						break;
+				size_type			first = basic_string::get_lut_rank( lut_iter , lut_width , lut_len , index );
 				
 				// Add at least as many bytes as codepoints
 				index += cp_count;
 				
+				// Use the jump table to skip all strides of the lut, whose multibytes are all located before the end of the range
+				if( basic_string::get_jump_table_size( buffer_size ) )
+				{
+					const data_type*	jump_table_base_ptr = basic_string::get_jump_table_base_ptr( lut_iter );
+					size_type			num_strides = ( first + jump_table_stride - 1 ) / jump_table_stride; // Only use entries at or after 'first'
+					size_type			num_valid = basic_string::get_jump_table_len( jump_table_base_ptr , true );
+					
+					if( num_strides < num_valid )
+					{
+						// Note: 'multibyte_index - data_bytes' is the (strictly increasing) codepoint index of the multibyte
+						size_type target = index - get_lut_prefix_data_bytes( first ); // Codepoint index of the end of the range
+						
+						// Binary search for the last jump table entry that points to a multibyte before the end of the range
+						for( size_type len = num_valid - num_strides ; len > 0 ; )
+						{
+							size_type half = len / 2;
+							size_type data_bytes = basic_string::get_lut( basic_string::get_jump_table_entry_ptr( jump_table_base_ptr , lut_width , num_strides + half ) , lut_width );
+							if( basic_string::get_lut_entry( lut_iter , lut_width , ( num_strides + half + 1 ) * jump_table_stride ) - data_bytes < target ){
+								num_strides += half + 1, len -= half + 1;
+								first = num_strides * jump_table_stride;
+								index = target + data_bytes;
+							}
+							else
+								len = half;
+						}
+					}
+				}
+				
+				// Iterate to the start of the relevant part of the multibyte table
+				lut_iter -= ( first + 1 ) * lut_width; // Move to first entry
+				
 				// Iterate over relevant multibyte indices
 				while( lut_iter >= lut_begin ){
 					size_type multibyte_index = basic_string::get_lut( lut_iter , lut_width );
@@ -3578,6 +7670,35 @@ namespace tiny_utf8
 				
 				return index - orig_index;
 			}
+			
+			TINY_UTF8_STAT( linear_scans );
+			trusted = basic_string::is_trusted( lut_iter );
+			
+			// Use the jump table to skip all chunks, whose codepoints are all located within the range (it's built along with a deferred lut)
+			if( basic_string::get_jump_table_size( buffer_size ) && !basic_string::is_lut_deferred( lut_iter ) )
+			{
+				const data_type*	jump_table_base_ptr = basic_string::get_jump_table_base_ptr( lut_iter );
+				size_type			num_chunks = basic_string::get_jump_table_len( jump_table_base_ptr , false );
+				size_type			chunk = index / jump_table_chunk + 1;
+				
+				if( chunk < num_chunks )
+				{
+					// Walk to the first codepoint of the next chunk
+					size_type	chunk_start = basic_string::get_jump_table_chunk_start( jump_table_base_ptr , chunk );
+					std::size_t	num_codepoints;
+					index += tiny_utf8_detail::count_codepoints( (const unsigned char*)buffer + index , chunk_start - index , cp_count , num_codepoints );
+					cp_count -= num_codepoints;
+					for( ; index < chunk_start && cp_count > 0 ; --cp_count )
+						index += get_codepoint_bytes( buffer[index] , data_len - index );
+					
+					// Note: We might have missed the chunk start, if 'index' didn't point to the start of a codepoint
+					if( index == chunk_start ){
+						for( size_type chunk_len ; chunk + 1 < num_chunks && ( chunk_len = basic_string::get_jump_table_chunk_len( jump_table_base_ptr , chunk ) ) <= cp_count ; ++chunk )
+							cp_count -= chunk_len;
+						index = basic_string::get_jump_table_chunk_start( jump_table_base_ptr , chunk );
+					}
+				}
+			}
 		}
 		else{
 			buffer = t_sso.data;
@@ -3588,7 +7709,14 @@ namespace tiny_utf8
 				return data_len - index;
 		}
 		
-		size_type orig_index = index;
+		// Walk over well-formed data in bulk (without any checks, if the data is trusted and 'index' starts a codepoint)
+		if( index < data_len ){
+			std::size_t num_codepoints;
+			index += trusted && ( (unsigned char)buffer[index] & 0xC0 ) != 0x80
+				? tiny_utf8_detail::count_valid_codepoints( (const unsigned char*)buffer + index , data_len - index , cp_count , num_codepoints )
+				: tiny_utf8_detail::count_codepoints( (const unsigned char*)buffer + index , data_len - index , cp_count , num_codepoints );
+			cp_count -= num_codepoints;
+		}
 		
 		// Procedure: Reduce the byte count by the number of utf8 data bytes
 		while( cp_count-- > 0 && index <= data_len )
@@ -3597,8 +7725,177 @@ namespace tiny_utf8
 		return index - orig_index;
 	}
 
-	template<typename V, typename D, typename A>
-	basic_string<V, D, A> basic_string<V, D, A>::raw_substr( typename basic_string<V, D, A>::size_type index , typename basic_string<V, D, A>::size_type byte_count ) const noexcept(TINY_UTF8_NOEXCEPT)
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::size_type basic_string<V, D, A, S>::walk_codepoints( const data_type* buffer , typename basic_string<V, D, A, S>::size_type index , typename basic_string<V, D, A, S>::size_type stop_index , typename basic_string<V, D, A, S>::size_type end_index , typename basic_string<V, D, A, S>::size_type& num_codepoints ) noexcept
+	{
+		num_codepoints = 0;
+		while( index < stop_index )
+		{
+			// Count well-formed data in bulk
+			std::size_t num_bulk_codepoints;
+			index += tiny_utf8_detail::count_codepoints( (const unsigned char*)buffer + index , stop_index - index , basic_string::npos , num_bulk_codepoints );
+			num_codepoints += num_bulk_codepoints;
+			
+			// Iterate the following (malformed or final) block byte by byte...
+			for( size_type block_end = std::min<size_type>( index + 16 , stop_index ) ; index < block_end ; ++num_codepoints )
+				index += basic_string::get_codepoint_bytes( buffer[index] , end_index - index );
+		}
+		return index;
+	}
+
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::size_type basic_string<V, D, A, S>::get_lut_prefix_data_bytes( typename basic_string<V, D, A, S>::size_type num_entries ) const noexcept
+	{
+		const data_type*	buffer			= t_non_sso.data;
+		size_type			buffer_size		= t_non_sso.buffer_size;
+		const data_type*	lut_base_ptr	= basic_string::get_lut_base_ptr( buffer , buffer_size );
+		width_type			lut_width		= basic_string::get_lut_width( buffer_size );
+		size_type			first			= 0;
+		size_type			data_bytes		= 0;
+		
+		// Start at the last jump table entry before 'num_entries'
+		if( basic_string::get_jump_table_size( buffer_size ) )
+		{
+			const data_type*	jump_table_base_ptr = basic_string::get_jump_table_base_ptr( lut_base_ptr );
+			size_type			num_strides = std::min( num_entries / jump_table_stride , basic_string::get_jump_table_len( jump_table_base_ptr , true ) );
+			if( num_strides ){
+				data_bytes	= basic_string::get_lut( basic_string::get_jump_table_entry_ptr( jump_table_base_ptr , lut_width , num_strides - 1 ) , lut_width );
+				first		= num_strides * jump_table_stride;
+			}
+		}
+		
+		return data_bytes + basic_string::get_lut_data_bytes( buffer , t_non_sso.data_len , lut_base_ptr , lut_width , first , num_entries );
+	}
+
+	template<typename V, typename D, typename A, std::size_t S>
+	void basic_string<V, D, A, S>::update_jump_table( typename basic_string<V, D, A, S>::size_type first_changed_byte ) noexcept
+	{
+		if( sso_active() )
+			return;
+		
+		size_type	buffer_size			= t_non_sso.buffer_size;
+		data_type*	buffer				= t_non_sso.data;
+		data_type*	lut_base_ptr		= basic_string::get_lut_base_ptr( buffer , buffer_size );
+		
+		// Since every modification of the data ends up here, the data is no longer known to be valid
+		basic_string::reset_trusted( lut_base_ptr );
+		
+		// Does the buffer have a jump table?
+		if( !basic_string::get_jump_table_size( buffer_size ) )
+			return;
+		
+		// A deferred lut rebuilds the jump table as well
+		if( basic_string::is_lut_deferred( lut_base_ptr ) ){
+			basic_string::set_jump_table_len( basic_string::get_jump_table_base_ptr( lut_base_ptr ) , false , 0 );
+			return;
+		}
+		
+		bool lut_active = basic_string::is_lut_active( lut_base_ptr );
+		basic_string::update_jump_table( buffer , buffer_size , t_non_sso.data_len , lut_active , lut_active ? basic_string::get_lut_len( lut_base_ptr ) : 0 , first_changed_byte );
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	void basic_string<V, D, A, S>::update_jump_table( data_type* buffer , typename basic_string<V, D, A, S>::size_type buffer_size , typename basic_string<V, D, A, S>::size_type data_len , bool lut_active , typename basic_string<V, D, A, S>::size_type lut_len , typename basic_string<V, D, A, S>::size_type first_changed_byte ) noexcept
+	{
+		data_type*	lut_base_ptr		= basic_string::get_lut_base_ptr( buffer , buffer_size );
+		data_type*	jump_table_base_ptr	= basic_string::get_jump_table_base_ptr( lut_base_ptr );
+		size_type	num_valid			= first_changed_byte ? basic_string::get_jump_table_len( jump_table_base_ptr , lut_active ) : 0;
+		
+		// Note: The width of a codepoint at the end of the data also depends on the data length (it might be truncated)
+		first_changed_byte -= std::min<size_type>( first_changed_byte , 7 );
+		
+		if( lut_active )
+		{
+			width_type	lut_width	= basic_string::get_lut_width( buffer_size );
+			size_type	num_entries	= lut_len ? ( lut_len - 1 ) / jump_table_stride : 0; // An entry is only useful, if there is a lut entry following its stride
+			
+			// Keep all entries, whose strides only reference multibytes before the first changed byte.
+			// Checking the last multibyte of each stride from the back (instead of a binary search over the lut)
+			// makes appending O(1), while other modifications recompute all entries it passes anyway.
+			num_valid = std::min( num_valid , num_entries );
+			while( num_valid && basic_string::get_lut_entry( lut_base_ptr , lut_width , num_valid * jump_table_stride - 1 ) >= first_changed_byte )
+				--num_valid;
+			
+			// Compute the remaining entries
+			size_type data_bytes = num_valid ? basic_string::get_lut( basic_string::get_jump_table_entry_ptr( jump_table_base_ptr , lut_width , num_valid - 1 ) , lut_width ) : 0;
+			for( size_type i = num_valid ; i < num_entries ; ++i ){
+				data_bytes += basic_string::get_lut_data_bytes( buffer , data_len , lut_base_ptr , lut_width , i * jump_table_stride , ( i + 1 ) * jump_table_stride );
+				basic_string::set_lut( basic_string::get_jump_table_entry_ptr( jump_table_base_ptr , lut_width , i ) , lut_width , data_bytes );
+			}
+			
+			basic_string::set_jump_table_len( jump_table_base_ptr , true , num_entries );
+		}
+		else
+		{
+			size_type	num_entries	= data_len / jump_table_chunk; // Only describe chunks, that are filled entirely
+			
+			// Keep all entries, whose chunks end before the first changed byte
+			num_valid = std::min( num_valid , first_changed_byte / jump_table_chunk );
+			num_valid = std::min( num_valid , num_entries );
+			if( num_valid == num_entries ){ // E.g. after appending to a partially filled chunk
+				basic_string::set_jump_table_len( jump_table_base_ptr , false , num_entries );
+				return;
+			}
+			
+			// Recompute the last valid entry as well, since it tells us, where the first codepoint of the next chunk starts
+			size_type	chunk	= num_valid ? num_valid - 1 : 0;
+			size_type	iter	= chunk ? basic_string::get_jump_table_chunk_start( jump_table_base_ptr , chunk ) : 0;
+			basic_string::set_jump_table_chunks( buffer , data_len , jump_table_base_ptr , iter , chunk , num_entries );
+			
+			basic_string::set_jump_table_len( jump_table_base_ptr , false , num_entries );
+		}
+	}
+	
+	#if defined(TINY_UTF8_LAZY_LUT)
+	template<typename V, typename D, typename A, std::size_t S>
+	bool basic_string<V, D, A, S>::build_deferred_lut() const noexcept
+	{
+		static_assert( sizeof(std::atomic<indicator_type>) == sizeof(indicator_type) , "tiny_utf8: TINY_UTF8_LAZY_LUT requires a lock-free std::atomic<size_type>" );
+		
+		data_type*	buffer			= t_non_sso.data;
+		size_type	buffer_size		= t_non_sso.buffer_size;
+		size_type	data_len		= t_non_sso.data_len;
+		data_type*	lut_base_ptr	= basic_string::get_lut_base_ptr( buffer , buffer_size );
+		std::atomic<indicator_type>& indicator = *reinterpret_cast<std::atomic<indicator_type>*>( lut_base_ptr );
+		
+		// Only the thread that marks the lut as building builds it, all others keep using the data in the meantime
+		indicator_type value = indicator.load( std::memory_order_acquire );
+		if( ( value & ( lut_building | lut_deferred | 0x1 ) ) != lut_deferred || !indicator.compare_exchange_strong( value , value | lut_building , std::memory_order_acquire ) )
+			return value & 0x1;
+		
+		TINY_UTF8_STAT( lut_builds );
+		
+		// The data might have been modified since the lut was deferred, so check again, if it's worth it and fits
+		size_type	string_len;
+		size_type	lut_len		= basic_string::count_multibytes( buffer , data_len , string_len );
+		width_type	lut_width	= basic_string::get_lut_width( buffer_size );
+		bool		lut_active	= !lut_len || ( basic_string::is_lut_worth( lut_len , string_len , false , false ) && data_len + 1 + lut_len * lut_width <= buffer_size );
+		if( lut_active )
+			basic_string::fill_lut( lut_base_ptr , lut_width , buffer , data_len );
+		else
+			lut_len = 0;
+		if( basic_string::get_jump_table_size( buffer_size ) )
+			basic_string::update_jump_table( buffer , buffer_size , data_len , lut_active , lut_len , 0 );
+		
+		// Publish the lut and the jump table
+		indicator.store( ( lut_len << 2 ) | ( value & 0x2 ) | ( lut_active ? 0x1 : 0x0 ) , std::memory_order_release );
+		return lut_active;
+	}
+	#endif
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	void basic_string<V, D, A, S>::set_jump_table_chunks( const data_type* buffer , typename basic_string<V, D, A, S>::size_type data_len , data_type* jump_table_base_ptr , typename basic_string<V, D, A, S>::size_type iter , typename basic_string<V, D, A, S>::size_type first , typename basic_string<V, D, A, S>::size_type last ) noexcept
+	{
+		basic_string::walk_codepoints( buffer , data_len , iter , first * jump_table_chunk ); // Skip the data before the first chunk
+		for( size_type chunk = first ; chunk < last ; ++chunk ){
+			size_type offset			= iter - chunk * jump_table_chunk;
+			size_type num_codepoints	= basic_string::walk_codepoints( buffer , data_len , iter , ( chunk + 1 ) * jump_table_chunk );
+			basic_string::set_jump_table_chunk( jump_table_base_ptr , chunk , num_codepoints , offset );
+		}
+	}
+			
+	template<typename V, typename D, typename A, std::size_t S>
+	basic_string<V, D, A, S> basic_string<V, D, A, S>::raw_substr( typename basic_string<V, D, A, S>::size_type index , typename basic_string<V, D, A, S>::size_type byte_count ) const noexcept(TINY_UTF8_NOEXCEPT)
 	{
 		// Bound checks...
 		size_type data_len = size();
@@ -3645,24 +7942,11 @@ namespace tiny_utf8
 		// Count the number of SUBSTRING Multibytes and codepoints
 		if( lut_active )
 		{
+			size_type lut_len = basic_string::get_lut_len( lut_base_ptr );
 			lut_width	= basic_string::get_lut_width( buffer_size );
-			mb_index	= 0;
-			const data_type* lut_begin	= lut_base_ptr - lut_width * basic_string::get_lut_len( lut_base_ptr );
-			const data_type* lut_iter	= lut_base_ptr;
-			for( lut_iter -= lut_width; lut_iter >= lut_begin ; lut_iter -= lut_width ){
-				if( basic_string::get_lut( lut_iter , lut_width ) >= index )
-					break;
-				mb_index++;
-			}
-			substr_cps = byte_count; // Add at least as many bytes as codepoints
-			for( ; lut_iter >= lut_begin ; lut_iter -= lut_width ){ // Iterate over relevant multibyte indices
-				size_type multibyte_index = basic_string::get_lut( lut_iter , lut_width );
-				if( multibyte_index >= end_index )
-					break;
-				substr_cps -= basic_string::get_codepoint_bytes( buffer[multibyte_index] , data_len - multibyte_index ); // Actually '- 1', but see[4]
-				++substr_mbs;
-			}
-			substr_cps += substr_mbs; // [4]: We subtracted all bytes of the relevant multibytes. We therefore need to re-add substr_mbs codepoints.
+			mb_index	= basic_string::get_lut_rank( lut_base_ptr , lut_width , lut_len , index );
+			substr_mbs	= basic_string::get_lut_rank( lut_base_ptr , lut_width , lut_len , end_index ) - mb_index;
+			substr_cps	= get_num_codepoints( index , byte_count );
 		}
 		else
 		{
@@ -3715,13 +7999,15 @@ namespace tiny_utf8
 							, basic_string::get_lut( lut_iter -= lut_width , lut_width ) - index
 						);
 			}
-			else // Fill the lut by iterating over the substrings data
+			else{ // Fill the lut by iterating over the substrings data
+				TINY_UTF8_STAT( lut_builds );
 				for( size_type	substr_iter = 0 ; substr_iter < byte_count ; ){
 					width_type bytes = get_codepoint_bytes( substr_buffer[substr_iter] , byte_count - substr_iter );
 					if( bytes > 1 )
 						basic_string::set_lut( substr_lut_base_ptr -= substr_lut_width , substr_lut_width , substr_iter );
 					substr_iter += bytes;
 				}
+			}
 		}
 		else // Set substring lut mode
 			basic_string::set_lut_indiciator( substr_lut_base_ptr , substr_mbs == 0 , 0 );
@@ -3732,12 +8018,13 @@ namespace tiny_utf8
 		result.t_non_sso.data_len = byte_count;
 		result.t_non_sso.buffer_size = substr_buffer_size;
 		result.set_non_sso_string_len( substr_cps );
+		result.update_jump_table( 0 );
 		
 		return result;
 	}
 
-	template<typename V, typename D, typename A>
-	basic_string<V, D, A>& basic_string<V, D, A>::append( const basic_string<V, D, A>& app ) noexcept(TINY_UTF8_NOEXCEPT)
+	template<typename V, typename D, typename A, std::size_t S>
+	basic_string<V, D, A, S>& basic_string<V, D, A, S>::append( const basic_string<V, D, A, S>& app ) noexcept(TINY_UTF8_NOEXCEPT)
 	{
 		// Will add nothing?
 		bool app_sso_inactive = app.sso_inactive();
@@ -3757,9 +8044,6 @@ namespace tiny_utf8
 			return *this;
 		}
 		
-		//! Ok, obviously no small string, we have to update the data, the lut and the number of codepoints
-		
-		
 		// Count codepoints and multibytes of insertion
 		bool				app_lut_active;
 		const data_type*	app_buffer;
@@ -3799,6 +8083,44 @@ namespace tiny_utf8
 			}
 		}
 		
+		return append_data(
+			app_buffer
+			, app_data_len
+			, app_string_len
+			, app_lut_len
+			, app_lut_active ? app_lut_base_ptr : nullptr
+			, app_lut_active ? basic_string::get_lut_width( app_buffer_size ) : 0
+		);
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::size_type basic_string<V, D, A, S>::append_bytes( const data_type* str , typename basic_string<V, D, A, S>::size_type data_len , typename basic_string<V, D, A, S>::size_type lut_len_hint ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		size_type old_data_len	= size();
+		size_type new_data_len	= old_data_len + data_len;
+		size_type app_string_len;
+		
+		// Will be sso string?
+		if( new_data_len <= basic_string::get_sso_capacity() ){
+			std::memmove( t_sso.data + old_data_len , str , data_len ); // The data might be part of this string
+			t_sso.data[new_data_len] = '\0'; // Trailing '\0'
+			set_sso_data_len( (unsigned char)new_data_len ); // Adjust size
+			return basic_string::count_multibytes( t_sso.data + old_data_len , data_len , app_string_len );
+		}
+		
+		size_type app_lut_len = basic_string::count_multibytes( str , data_len , app_string_len );
+		append_data( str , data_len , app_string_len , app_lut_len , nullptr , 0 , lut_len_hint );
+		return app_lut_len;
+	}
+	
+	template<typename V, typename D, typename A, std::size_t S>
+	basic_string<V, D, A, S>& basic_string<V, D, A, S>::append_data( const data_type* app_buffer , typename basic_string<V, D, A, S>::size_type app_data_len , typename basic_string<V, D, A, S>::size_type app_string_len , typename basic_string<V, D, A, S>::size_type app_lut_len , const data_type* app_lut_base_ptr , typename basic_string<V, D, A, S>::width_type app_lut_width , typename basic_string<V, D, A, S>::size_type lut_len_hint ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		//! Ok, obviously no small string, we have to update the data, the lut and the number of codepoints
+		size_type	old_data_len	= size();
+		size_type	new_data_len	= old_data_len + app_data_len;
+		bool		app_lut_active	= app_lut_base_ptr != nullptr;
+		
 		// Count codepoints and multibytes of this string
 		data_type*	old_buffer;
 		data_type*	old_lut_base_ptr; // Ignore uninitialized warning, see [3]
@@ -3818,6 +8140,16 @@ namespace tiny_utf8
 			old_lut_active = basic_string::is_lut_active( old_lut_base_ptr );
 			if( old_lut_active )
 				old_lut_len = basic_string::get_lut_len( old_lut_base_ptr );
+			// An inactive lut means we hold too many multibytes. Don't count them, if a lut still won't be worth it afterwards.
+			// The number of multibytes is then only overestimated, which keeps repeated appends to such strings linear.
+			else if( !basic_string::is_lut_worth( basic_string::get_min_lut_len( old_data_len , old_string_len ) + app_lut_len , old_string_len + app_string_len , false )
+				|| ( // The hint tells us, that a lut won't be worth it, and the overestimation agrees, that we won't build one
+					lut_len_hint != basic_string::npos
+					&& !basic_string::is_lut_worth( lut_len_hint + app_lut_len , old_string_len + app_string_len , false )
+					&& !basic_string::is_lut_worth( old_data_len - old_string_len + app_lut_len , old_string_len + app_string_len , false )
+				)
+			)
+				old_lut_len = old_data_len - old_string_len;
 			else{
 				old_lut_len = 0;
 				for( size_type iter	= 0 ; iter < old_data_len ; ){
@@ -3850,8 +8182,12 @@ namespace tiny_utf8
 		// Indices Table worth the memory loss?
 		// If the ratio of indices/codepoints is lower 5/8 and we have a LUT -> keep it
 		// If we don't have a LUT, it has to drop below 3/8 for us to start one
-		if( basic_string::is_lut_worth( new_lut_len , new_string_len , old_lut_active , old_sso_inactive ) )
+		if( basic_string::is_lut_worth( new_lut_len , new_string_len , old_lut_active , old_sso_inactive ) ){
 			new_buffer_size	= determine_main_buffer_size( new_data_len , new_lut_len , &new_lut_width );
+			// The size of a reused buffer determines the lut width, which might exceed the one estimated for the new size
+			if( new_buffer_size <= old_buffer_size )
+				new_buffer_size = determine_main_buffer_size( new_data_len , new_lut_len , basic_string::get_lut_width( old_buffer_size ) );
+		}
 		else{
 			new_lut_width = 0;
 			new_buffer_size = determine_main_buffer_size( new_data_len );
@@ -3869,12 +8205,23 @@ namespace tiny_utf8
 				// Make sure, the lut width stays the same, because we still have the same buffer size
 				new_lut_width = basic_string::get_lut_width( old_buffer_size );
 				
+				// Fill the lut with the current INDICES, if there wasn't one
+				if( !old_lut_active ){
+					TINY_UTF8_STAT( lut_builds );
+					data_type*	lut_iter = old_lut_base_ptr; // 'old_lut_base_ptr' is initialized as 'old_sso_inactive' is true (see [3])
+					for( size_type iter = 0 ; iter < old_data_len ; ){
+						width_type bytes = get_codepoint_bytes( old_buffer[iter] , old_data_len - iter );
+						if( bytes > 1 )
+							basic_string::set_lut( lut_iter -= new_lut_width , new_lut_width , iter );
+						iter += bytes;
+					}
+				}
+				
 				// Append new INDICES
 				data_type*		lut_dest_iter = old_lut_base_ptr - old_lut_len * new_lut_width; // 'old_lut_base_ptr' is initialized as 'old_sso_inactive' is true (see [3])
 				if( app_lut_active )
 				{
-					width_type	app_lut_width = basic_string::get_lut_width( app_buffer_size );
-					const data_type*	app_lut_iter = app_lut_base_ptr; // 'app_lut_base_ptr' is initialized as soon as 'app_lut_active' is set to true
+					const data_type*	app_lut_iter = app_lut_base_ptr;
 					while( app_lut_len-- > 0 )
 						basic_string::set_lut(
 							lut_dest_iter -= new_lut_width
@@ -3927,6 +8274,7 @@ namespace tiny_utf8
 					// Copy all old INDICES
 					if( new_lut_width != old_lut_width )
 					{
+						TINY_UTF8_STAT( lut_width_changes );
 						data_type*	lut_iter = old_lut_base_ptr;
 						data_type*	new_lut_iter = new_lut_base_ptr;
 						size_type	num_indices = old_lut_len;
@@ -3946,6 +8294,7 @@ namespace tiny_utf8
 				}
 				else // We need to fill these indices manually...
 				{
+					TINY_UTF8_STAT( lut_builds );
 					data_type*	new_lut_iter	= new_lut_base_ptr;
 					size_type	iter			= 0;
 					while( iter < old_data_len ){ // Fill lut with indices BEFORE insertion
@@ -3960,7 +8309,6 @@ namespace tiny_utf8
 				data_type*		lut_dest_iter = new_lut_base_ptr - old_lut_len * new_lut_width;
 				if( app_lut_active )
 				{
-					width_type	app_lut_width = basic_string::get_lut_width( app_buffer_size );
 					const data_type*	app_lut_iter = app_lut_base_ptr;
 					while( app_lut_len-- > 0 )
 						basic_string::set_lut(
@@ -3985,8 +8333,12 @@ namespace tiny_utf8
 				basic_string::set_lut_indiciator( new_lut_base_ptr , new_lut_len == 0 , 0 );
 		
 			// Delete the old buffer?
-			if( old_sso_inactive )
+			if( old_sso_inactive ){
+				TINY_UTF8_STAT( reallocations );
 				this->deallocate( old_buffer , old_buffer_size );
+			}
+			else
+				TINY_UTF8_STAT( sso_to_heap );
 			
 			// Set new Attributes
 			t_non_sso.data			= new_buffer;
@@ -3996,12 +8348,13 @@ namespace tiny_utf8
 		// Adjust Attributes
 		t_non_sso.data_len = new_data_len;
 		set_non_sso_string_len( new_string_len );
+		update_jump_table( new_buffer_size <= old_buffer_size ? old_data_len : 0 ); // A new buffer needs a new jump table
 		
 		return *this;
 	}
 
-	template<typename V, typename D, typename A>
-	basic_string<V, D, A>& basic_string<V, D, A>::raw_insert( typename basic_string<V, D, A>::size_type index , const basic_string<V, D, A>& str ) noexcept(TINY_UTF8_NOEXCEPT)
+	template<typename V, typename D, typename A, std::size_t S>
+	basic_string<V, D, A, S>& basic_string<V, D, A, S>::raw_insert( typename basic_string<V, D, A, S>::size_type index , const basic_string<V, D, A, S>& str ) noexcept(TINY_UTF8_NOEXCEPT)
 	{
 		// Bound checks...
 		size_type old_data_len = size();
@@ -4090,17 +8443,23 @@ namespace tiny_utf8
 			old_buffer_size	= t_non_sso.buffer_size;
 			old_buffer		= t_non_sso.data;
 			old_string_len	= get_non_sso_string_len();
-			size_type iter	= 0;
-			while( iter < index ){ // Count multibytes and codepoints BEFORE insertion
-				width_type bytes = get_codepoint_bytes( old_buffer[iter] , old_data_len - iter );
-				mb_index += bytes > 1; iter += bytes;
-			}
-			// Count TOTAL multibytes
 			old_lut_base_ptr = basic_string::get_lut_base_ptr( old_buffer , old_buffer_size );
 			old_lut_active = basic_string::is_lut_active( old_lut_base_ptr );
-			if( old_lut_active )
+			
+			// Count multibytes BEFORE insertion and TOTAL multibytes
+			if( old_lut_active ){
 				old_lut_len = basic_string::get_lut_len( old_lut_base_ptr );
+				mb_index = basic_string::get_lut_rank( old_lut_base_ptr , basic_string::get_lut_width( old_buffer_size ) , old_lut_len , index );
+			}
+			// Too many multibytes for a lut (see 'append'): Overestimate them, if a lut still won't be worth it afterwards
+			else if( !basic_string::is_lut_worth( basic_string::get_min_lut_len( old_data_len , old_string_len ) + str_lut_len , old_string_len + str_string_len , false ) )
+				old_lut_len = old_data_len - old_string_len;
 			else{
+				size_type iter	= 0;
+				while( iter < index ){ // Count multibytes and codepoints BEFORE insertion
+					width_type bytes = get_codepoint_bytes( old_buffer[iter] , old_data_len - iter );
+					mb_index += bytes > 1; iter += bytes;
+				}
 				old_lut_len = mb_index;
 				while( iter < old_data_len ){
 					width_type bytes = get_codepoint_bytes( old_buffer[iter] , old_data_len - iter );
@@ -4135,8 +8494,12 @@ namespace tiny_utf8
 		width_type	new_lut_width; // [2] ; 0 signalizes, that we don't need a lut
 		
 		// Indices Table worth the memory loss?
-		if( basic_string::is_lut_worth( new_lut_len , new_string_len , old_lut_active , old_sso_inactive ) )
+		if( basic_string::is_lut_worth( new_lut_len , new_string_len , old_lut_active , old_sso_inactive ) ){
 			new_buffer_size	= determine_main_buffer_size( new_data_len , new_lut_len , &new_lut_width );
+			// The size of a reused buffer determines the lut width, which might exceed the one estimated for the new size
+			if( new_buffer_size <= old_buffer_size )
+				new_buffer_size = determine_main_buffer_size( new_data_len , new_lut_len , basic_string::get_lut_width( old_buffer_size ) );
+		}
 		else{
 			new_lut_width = 0;
 			new_buffer_size = determine_main_buffer_size( new_data_len );
@@ -4158,12 +8521,7 @@ namespace tiny_utf8
 				if( old_lut_active )
 				{
 					// Offset all indices
-					data_type*	lut_iter = old_lut_base_ptr - mb_index * new_lut_width; // 'old_lut_base_ptr' is initialized as soon as 'old_lut_active' is set to true
-					size_type	num_indices = old_lut_len - mb_index;
-					while( num_indices-- > 0 ){
-						lut_iter -= new_lut_width;
-						basic_string::set_lut( lut_iter , new_lut_width , basic_string::get_lut( lut_iter , new_lut_width ) + str_data_len );
-					}
+					basic_string::shift_lut( old_lut_base_ptr - mb_index * new_lut_width , new_lut_width , old_lut_len - mb_index , str_data_len ); // 'old_lut_base_ptr' is initialized as soon as 'old_lut_active' is set to true
 					
 					// Copy INDICES from AFTER insertion
 					// We only need to copy them, if the number of multibytes in the inserted part has changed
@@ -4180,6 +8538,7 @@ namespace tiny_utf8
 				}
 				else // We need to fill the lut manually...
 				{
+					TINY_UTF8_STAT( lut_builds );
 					// Fill INDICES BEFORE insertion
 					size_type	iter		= 0;
 					data_type*	lut_iter	= old_lut_base_ptr;
@@ -4265,6 +8624,7 @@ namespace tiny_utf8
 					// Copy all INDICES BEFORE the insertion
 					if( new_lut_width != old_lut_width )
 					{
+						TINY_UTF8_STAT( lut_width_changes );
 						data_type*		lut_iter = old_lut_base_ptr;
 						data_type*		new_lut_iter = new_lut_base_ptr;
 						size_type	num_indices = mb_index;
@@ -4296,6 +8656,7 @@ namespace tiny_utf8
 				}
 				else // We need to fill the lut manually...
 				{
+					TINY_UTF8_STAT( lut_builds );
 					// Fill INDICES BEFORE insertion
 					size_type	iter		= 0;
 					data_type*		lut_iter	= new_lut_base_ptr;
@@ -4345,8 +8706,12 @@ namespace tiny_utf8
 				basic_string::set_lut_indiciator( new_lut_base_ptr , new_lut_len == 0 , 0 );
 		
 			// Delete the old buffer?
-			if( old_sso_inactive )
+			if( old_sso_inactive ){
+				TINY_UTF8_STAT( reallocations );
 				this->deallocate( old_buffer , old_buffer_size );
+			}
+			else
+				TINY_UTF8_STAT( sso_to_heap );
 			
 			// Set new Attributes
 			t_non_sso.data		= new_buffer;
@@ -4356,12 +8721,13 @@ namespace tiny_utf8
 		// Adjust Attributes
 		t_non_sso.data_len	= new_data_len;
 		set_non_sso_string_len( new_string_len );
+		update_jump_table( new_buffer_size <= old_buffer_size ? index : 0 ); // A new buffer needs a new jump table
 		
 		return *this;
 	}
 
-	template<typename V, typename D, typename A>
-	basic_string<V, D, A>& basic_string<V, D, A>::raw_replace( typename basic_string<V, D, A>::size_type index , typename basic_string<V, D, A>::size_type replaced_len , const basic_string<V, D, A>& repl ) noexcept(TINY_UTF8_NOEXCEPT)
+	template<typename V, typename D, typename A, std::size_t S>
+	basic_string<V, D, A, S>& basic_string<V, D, A, S>::raw_replace( typename basic_string<V, D, A, S>::size_type index , typename basic_string<V, D, A, S>::size_type replaced_len , const basic_string<V, D, A, S>& repl ) noexcept(TINY_UTF8_NOEXCEPT)
 	{
 		// Bound checks...
 		size_type old_data_len = size();
@@ -4405,10 +8771,11 @@ namespace tiny_utf8
 				std::memcpy( t_sso.data + index + repl_data_len , old_buffer + end_index , old_data_len - end_index );
 				
 				this->deallocate( old_buffer , old_buffer_size ); // Delete the old buffer
+				TINY_UTF8_STAT( heap_to_sso );
 			}
 			// Copy AFTER replaced part, if it has moved in position
 			else if( new_data_len != old_data_len )
-				std::memmove( t_sso.data + index + repl_data_len , t_sso.data + index + replaced_len , old_data_len - index );
+				std::memmove( t_sso.data + index + repl_data_len , t_sso.data + index + replaced_len , old_data_len - end_index );
 			
 			// Copy REPLACEMENT (Note: Since the resulting string is small, the replacement must be small as well!)
 			std::memcpy( t_sso.data + index , repl.t_sso.data , repl_data_len );
@@ -4476,23 +8843,36 @@ namespace tiny_utf8
 			old_buffer_size	= t_non_sso.buffer_size;
 			old_buffer		= t_non_sso.data;
 			old_string_len	= get_non_sso_string_len();
-			size_type iter	= 0;
-			while( iter < index ){ // Count multibytes and codepoints BEFORE replacement
-				width_type bytes = get_codepoint_bytes( old_buffer[iter] , old_data_len - iter );
-				mb_index += bytes > 1; iter += bytes;
-			}
-			while( iter < end_index ){ // Count REPLACED multibytes and codepoints
+			old_lut_base_ptr = basic_string::get_lut_base_ptr( old_buffer , old_buffer_size );
+			old_lut_active = basic_string::is_lut_active( old_lut_base_ptr );
+			
+			// Count REPLACED multibytes and codepoints
+			for( size_type iter = index ; iter < end_index ; ){
 				width_type bytes = get_codepoint_bytes( old_buffer[iter] , old_data_len - iter );
 				replaced_mbs += bytes > 1; iter += bytes; ++replaced_cps;
 			}
-			// Count TOTAL multibytes
-			old_lut_base_ptr = basic_string::get_lut_base_ptr( old_buffer , old_buffer_size );
-			old_lut_active = basic_string::is_lut_active( old_lut_base_ptr );
-			if( old_lut_active )
+			
+			// Count multibytes BEFORE replacement and TOTAL multibytes
+			size_type kept_data_len = old_data_len - replaced_len;
+			size_type kept_string_len = old_string_len - replaced_cps;
+			if( old_lut_active ){
 				old_lut_len = basic_string::get_lut_len( old_lut_base_ptr );
+				mb_index = basic_string::get_lut_rank( old_lut_base_ptr , basic_string::get_lut_width( old_buffer_size ) , old_lut_len , index );
+			}
+			// Too many multibytes for a lut (see 'append'): Overestimate them, if a lut still won't be worth it afterwards
+			else if(
+				basic_string::get_min_lut_len( kept_data_len , kept_string_len ) + repl_lut_len
+				&& !basic_string::is_lut_worth( basic_string::get_min_lut_len( kept_data_len , kept_string_len ) + repl_lut_len , kept_string_len + repl_string_len , false )
+			)
+				old_lut_len = kept_data_len - kept_string_len + replaced_mbs;
 			else{
+				size_type iter = 0;
+				while( iter < index ){ // Count multibytes and codepoints BEFORE replacement
+					width_type bytes = get_codepoint_bytes( old_buffer[iter] , old_data_len - iter );
+					mb_index += bytes > 1; iter += bytes;
+				}
 				old_lut_len = mb_index + replaced_mbs;
-				while( iter < old_data_len ){
+				for( iter = end_index ; iter < old_data_len ; ){
 					width_type bytes = get_codepoint_bytes( old_buffer[iter] , old_data_len - iter );
 					old_lut_len += bytes > 1; iter += bytes;
 				}
@@ -4531,8 +8911,12 @@ namespace tiny_utf8
 		
 		
 		// Indices Table worth the memory loss?
-		if( basic_string::is_lut_worth( new_lut_len , new_string_len , old_lut_active , old_sso_inactive ) )
+		if( basic_string::is_lut_worth( new_lut_len , new_string_len , old_lut_active , old_sso_inactive ) ){
 			new_buffer_size	= determine_main_buffer_size( new_data_len , new_lut_len , &new_lut_width );
+			// The size of a reused buffer determines the lut width, which might exceed the one estimated for the new size
+			if( new_buffer_size <= old_buffer_size )
+				new_buffer_size = determine_main_buffer_size( new_data_len , new_lut_len , basic_string::get_lut_width( old_buffer_size ) );
+		}
 		else{
 			new_lut_width = 0;
 			new_buffer_size = determine_main_buffer_size( new_data_len );
@@ -4544,6 +8928,14 @@ namespace tiny_utf8
 			// [3] At this point, 'old_sso_inactive' MUST be true, because else,
 			// the resulting string would have sso active (which is handled way above)
 			
+			// If the data shrinks, move it BEFORE updating the lut, because the lut might grow into the old data
+			// Note: The moved data can't overlap with the old lut, since it ends before the old data did
+			const data_type* after_buffer = old_buffer; // Data AFTER the replacement, addressable by old indices
+			if( delta_len < 0 ){
+				std::memmove( old_buffer + index + repl_data_len , old_buffer + end_index , old_data_len - end_index );
+				after_buffer += delta_len;
+			}
+			
 			// Need to fill the lut? (see [2])
 			if( new_lut_width )
 			{
@@ -4556,14 +8948,8 @@ namespace tiny_utf8
 					size_type	mb_end_index = mb_index + replaced_mbs;
 					
 					// Need to offset all indices? (This can be, if the replacement data has different size as the replaced data)
-					if( delta_len ){
-						data_type*	lut_iter = old_lut_base_ptr - mb_end_index * new_lut_width; // 'old_lut_base_ptr' is initialized as soon as 'old_lut_active' is set to true
-						size_type	num_indices = old_lut_len - mb_end_index;
-						while( num_indices-- > 0 ){
-							lut_iter -= new_lut_width;
-							basic_string::set_lut( lut_iter , new_lut_width , basic_string::get_lut( lut_iter , new_lut_width ) + delta_len );
-						}
-					}
+					if( delta_len ) // 'old_lut_base_ptr' is initialized as soon as 'old_lut_active' is set to true
+						basic_string::shift_lut( old_lut_base_ptr - mb_end_index * new_lut_width , new_lut_width , old_lut_len - mb_end_index , delta_len );
 					
 					// Copy INDICES from AFTER replacement
 					// We only need to copy them, if the number of multibytes in the replaced part has changed
@@ -4581,6 +8967,7 @@ namespace tiny_utf8
 				}
 				else // We need to fill the lut manually...
 				{
+					TINY_UTF8_STAT( lut_builds );
 					// Fill INDICES BEFORE replacement
 					size_type	iter		= 0;
 					data_type*	lut_iter	= old_lut_base_ptr;
@@ -4595,7 +8982,7 @@ namespace tiny_utf8
 					iter += replaced_len;
 					lut_iter -= repl_lut_len * new_lut_width;
 					while( iter < old_data_len ){
-						width_type bytes = get_codepoint_bytes( old_buffer[iter] , old_data_len - iter );
+						width_type bytes = get_codepoint_bytes( after_buffer[iter] , old_data_len - iter );
 						if( bytes > 1 )
 							basic_string::set_lut( lut_iter -= new_lut_width , new_lut_width , iter + delta_len );
 						iter += bytes;
@@ -4632,7 +9019,8 @@ namespace tiny_utf8
 			
 			// Move BUFFER from AFTER the replacement (Note: We don't need to copy before it, because the buffer hasn't changed)
 			if( new_data_len != old_data_len ){
-				std::memmove( old_buffer + index + repl_data_len , old_buffer + end_index , old_data_len - end_index );
+				if( delta_len > 0 )
+					std::memmove( old_buffer + index + repl_data_len , old_buffer + end_index , old_data_len - end_index );
 				t_non_sso.data_len = new_data_len;
 				old_buffer[new_data_len] = '\0'; // Trailing '\0'
 			}
@@ -4671,6 +9059,7 @@ namespace tiny_utf8
 					// Copy all INDICES BEFORE the replacement
 					if( new_lut_width != old_lut_width )
 					{
+						TINY_UTF8_STAT( lut_width_changes );
 						data_type*	lut_iter = old_lut_base_ptr;
 						data_type*	new_lut_iter = new_lut_base_ptr;
 						size_type	num_indices = mb_index;
@@ -4710,6 +9099,7 @@ namespace tiny_utf8
 				}
 				else // We need to fill the lut manually...
 				{
+					TINY_UTF8_STAT( lut_builds );
 					// Fill INDICES BEFORE replacement
 					size_type	iter		= 0;
 					data_type*	lut_iter	= new_lut_base_ptr;
@@ -4760,8 +9150,12 @@ namespace tiny_utf8
 				basic_string::set_lut_indiciator( new_lut_base_ptr , new_lut_len == 0 , 0 );
 		
 			// Delete the old buffer?
-			if( old_sso_inactive )
+			if( old_sso_inactive ){
+				TINY_UTF8_STAT( reallocations );
 				this->deallocate( old_buffer , old_buffer_size );
+			}
+			else
+				TINY_UTF8_STAT( sso_to_heap );
 			
 			// Set new Attributes
 			t_non_sso.data		= new_buffer;
@@ -4771,12 +9165,97 @@ namespace tiny_utf8
 		
 		// Adjust string length
 		set_non_sso_string_len( new_string_len );
+		update_jump_table( new_buffer_size <= old_buffer_size ? index : 0 ); // A new buffer needs a new jump table
 		
 		return *this;
 	}
 
-	template<typename V, typename D, typename A>
-	basic_string<V, D, A>& basic_string<V, D, A>::raw_erase( typename basic_string<V, D, A>::size_type index , typename basic_string<V, D, A>::size_type len ) noexcept(TINY_UTF8_NOEXCEPT)
+	template<typename V, typename D, typename A, std::size_t S>
+	template<typename Pair>
+	typename basic_string<V, D, A, S>::size_type basic_string<V, D, A, S>::find_replacement( const data_type* buffer , typename basic_string<V, D, A, S>::size_type data_len , typename basic_string<V, D, A, S>::size_type index , const Pair* replacements , typename basic_string<V, D, A, S>::size_type num_replacements , const std::uint64_t (&first_bytes)[4] , typename basic_string<V, D, A, S>::size_type& which ) noexcept
+	{
+		// A single pattern is searched for by the engine of 'raw_find'
+		if( num_replacements == 1 ){
+			which = 0;
+			size_type result = index < data_len ? tiny_utf8_detail::find_bytes(
+				(const unsigned char*)buffer + index
+				, data_len - index
+				, (const unsigned char*)replacements->first.data()
+				, replacements->first.size()
+			) : basic_string::npos;
+			return result == basic_string::npos ? basic_string::npos : index + result;
+		}
+		
+		// Otherwise, only compare the patterns at positions holding the first byte of one of them
+		for( ; index < data_len ; ++index )
+		{
+			unsigned char byte = (unsigned char)buffer[index];
+			if( !( ( first_bytes[byte >> 6] >> ( byte & 63 ) ) & 0x1 ) )
+				continue;
+			for( which = 0 ; which < num_replacements ; ++which ){
+				size_type pattern_size = replacements[which].first.size();
+				if( pattern_size && pattern_size <= data_len - index && !std::memcmp( buffer + index , replacements[which].first.data() , pattern_size ) )
+					return index;
+			}
+		}
+		return basic_string::npos;
+	}
+
+	template<typename V, typename D, typename A, std::size_t S>
+	template<typename Pair>
+	basic_string<V, D, A, S>& basic_string<V, D, A, S>::replace_all( const Pair* replacements , typename basic_string<V, D, A, S>::size_type num_replacements ) noexcept(TINY_UTF8_NOEXCEPT)
+	{
+		const data_type*	buffer = get_buffer();
+		size_type			data_len = size();
+		
+		// Collect the first bytes of all patterns (empty patterns match nothing)
+		std::uint64_t		first_bytes[4] = {};
+		bool				any_pattern = false;
+		for( size_type i = 0 ; i < num_replacements ; ++i )
+			if( replacements[i].first.size() ){
+				unsigned char byte = (unsigned char)replacements[i].first.data()[0];
+				first_bytes[byte >> 6] |= std::uint64_t(1) << ( byte & 63 );
+				any_pattern = true;
+			}
+		if( !any_pattern || !data_len )
+			return *this;
+		
+		// First pass: Determine the size and the number of multibytes of the result
+		size_type	which;
+		size_type	num_matches = 0;
+		size_type	new_data_len = data_len;
+		size_type	new_lut_len = basic_string::count_multibytes( *this );
+		for( size_type index = find_replacement( buffer , data_len , 0 , replacements , num_replacements , first_bytes , which )
+			; index != basic_string::npos
+			; index = find_replacement( buffer , data_len , index + replacements[which].first.size() , replacements , num_replacements , first_bytes , which )
+		){
+			const basic_string& pattern = replacements[which].first;
+			const basic_string& repl = replacements[which].second;
+			new_data_len += repl.size() - pattern.size();
+			new_lut_len += basic_string::count_multibytes( repl ) - basic_string::count_multibytes( pattern );
+			++num_matches;
+		}
+		if( !num_matches )
+			return *this;
+		
+		// Second pass: Write the result into a buffer of the computed size
+		basic_string_builder<V, D, A, S> builder( new_data_len , new_lut_len , get_allocator() );
+		size_type last_end = 0;
+		for( size_type index = find_replacement( buffer , data_len , 0 , replacements , num_replacements , first_bytes , which )
+			; index != basic_string::npos
+			; index = find_replacement( buffer , data_len , last_end , replacements , num_replacements , first_bytes , which )
+		){
+			builder.append( buffer + last_end , index - last_end );
+			builder.append( replacements[which].second );
+			last_end = index + replacements[which].first.size();
+		}
+		builder.append( buffer + last_end , data_len - last_end );
+		
+		return *this = builder.finalize();
+	}
+
+	template<typename V, typename D, typename A, std::size_t S>
+	basic_string<V, D, A, S>& basic_string<V, D, A, S>::raw_erase( typename basic_string<V, D, A, S>::size_type index , typename basic_string<V, D, A, S>::size_type len ) noexcept(TINY_UTF8_NOEXCEPT)
 	{
 		// Bound checks...
 		size_type old_data_len = size();
@@ -4818,10 +9297,11 @@ namespace tiny_utf8
 				std::memcpy( t_sso.data + index , old_buffer + end_index , old_data_len - end_index );
 				
 				this->deallocate( old_buffer , old_buffer_size ); // Delete the old buffer
+				TINY_UTF8_STAT( heap_to_sso );
 			}
 			// Move the part AFTER the removal
 			else
-				std::memmove( t_sso.data + index , t_sso.data + index + len , old_data_len - index );
+				std::memmove( t_sso.data + index , t_sso.data + index + len , old_data_len - end_index );
 			
 			// Finish the new string object
 			t_sso.data[new_data_len] = '\0'; // Trailing '\0'
@@ -4848,26 +9328,16 @@ namespace tiny_utf8
 		{
 			size_type	old_lut_len = basic_string::get_lut_len( old_lut_base_ptr );
 			width_type	old_lut_width = basic_string::get_lut_width( old_buffer_size );
-			size_type	mb_end_index = 0;
+			size_type	mb_end_index = basic_string::get_lut_rank( old_lut_base_ptr , old_lut_width , old_lut_len , index ); // Multibytes BEFORE erased part
 			size_type	replaced_mbs = 0;
-			size_type	iter	= 0;
-			while( iter < index ){ // Count multibytes and codepoints BEFORE erased part
-				width_type bytes = get_codepoint_bytes( old_buffer[iter] , old_data_len - iter );
-				mb_end_index += bytes > 1; iter += bytes;
-			}
-			while( iter < end_index ){ // Count REPLACED multibytes and codepoints
+			for( size_type iter = index ; iter < end_index ; ){ // Count REPLACED multibytes and codepoints
 				width_type bytes = get_codepoint_bytes( old_buffer[iter] , old_data_len - iter );
 				replaced_mbs += bytes > 1; iter += bytes; ++replaced_cps;
 			}
 			mb_end_index += replaced_mbs;
 			
 			// Offset all indices
-			data_type*	lut_iter = old_lut_base_ptr - mb_end_index * old_lut_width;
-			size_type	num_indices = old_lut_len - mb_end_index;
-			while( num_indices-- > 0 ){
-				lut_iter -= old_lut_width;
-				basic_string::set_lut( lut_iter , old_lut_width , basic_string::get_lut( lut_iter , old_lut_width ) - len );
-			}
+			basic_string::shift_lut( old_lut_base_ptr - mb_end_index * old_lut_width , old_lut_width , old_lut_len - mb_end_index , 0 - len );
 			
 			// Copy INDICES AFTER erased part
 			// We only need to move them, if the number of multibytes in the replaced part has changed
@@ -4886,10 +9356,7 @@ namespace tiny_utf8
 		}
 		// The lut was inactive => only update the string length
 		else{
-			size_type iter = 0;
-			while( iter < index )
-				iter += get_codepoint_bytes( old_buffer[iter] , old_data_len - iter );
-			while( iter < end_index ){
+			for( size_type iter = index ; iter < end_index ; ){
 				iter += get_codepoint_bytes( old_buffer[iter] , old_data_len - iter );
 				++replaced_cps;
 			}
@@ -4900,195 +9367,106 @@ namespace tiny_utf8
 		
 		// Adjust string length
 		set_non_sso_string_len( get_non_sso_string_len() - replaced_cps );
+		update_jump_table( index );
 		
 		return *this;
 	}
 
-	template<typename V, typename D, typename A>
-	typename basic_string<V, D, A>::size_type basic_string<V, D, A>::raw_rfind( typename basic_string<V, D, A>::value_type cp , typename basic_string<V, D, A>::size_type index ) const noexcept {
-		if( index >= size() )
-			index = raw_back_index();
-		for( difference_type it = index ; it >= 0 ; it -= get_index_pre_bytes( it ) )
-			if( raw_at(it) == cp )
-				return it;
-		return basic_string::npos;
-	}
-
-	template<typename V, typename D, typename A>
-	typename basic_string<V, D, A>::size_type basic_string<V, D, A>::find_first_of( const typename basic_string<V, D, A>::value_type* str , typename basic_string<V, D, A>::size_type start_pos ) const noexcept
-	{
-		if( start_pos >= length() )
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::size_type basic_string<V, D, A, S>::find_codepoint( const data_type* buffer , typename basic_string<V, D, A, S>::size_type my_size , typename basic_string<V, D, A, S>::value_type cp , typename basic_string<V, D, A, S>::size_type index ) noexcept {
+		if( index >= my_size )
 			return basic_string::npos;
 		
-		for( const_iterator it = get( start_pos ), end = cend() ; it < end ; ++it, ++start_pos )
-		{
-			const value_type*	tmp = str;
-			value_type			cur = *it;
-			do{
-				if( cur == *tmp )
-					return start_pos;
-			}while( *++tmp );
-		}
-		
-		return basic_string::npos;
-	}
-
-	template<typename V, typename D, typename A>
-	typename basic_string<V, D, A>::size_type basic_string<V, D, A>::raw_find_first_of( const typename basic_string<V, D, A>::value_type* str , typename basic_string<V, D, A>::size_type index ) const noexcept
-	{
-		if( index >= size() )
-			return basic_string::npos;
+		// Encode the codepoint once and search for its bytes
+		data_type			encoded[8];
+		width_type			cp_bytes = basic_string::encode_utf8( cp , encoded );
 		
-		for( const_iterator it = raw_get(index), end = cend() ; it < end ; ++it )
+		while( index < my_size )
 		{
-			const value_type*	tmp = str;
-			value_type			cur = *it;
-			do{
-				if( cur == *tmp )
-					return it.get_index();
-			}while( *++tmp );
+			size_type hit = tiny_utf8_detail::find_bytes( (const unsigned char*)buffer + index , my_size - index , (const unsigned char*)encoded , cp_bytes );
+			if( hit == basic_string::npos )
+				return basic_string::npos;
+			hit += index;
+			
+			// Make sure, the hit is not located within another codepoint
+			index = basic_string::get_codepoint_start_from( buffer , index , hit , my_size );
+			if( index == hit )
+				return hit;
 		}
-		
 		return basic_string::npos;
 	}
 
-	template<typename V, typename D, typename A>
-	typename basic_string<V, D, A>::size_type basic_string<V, D, A>::find_last_of( const typename basic_string<V, D, A>::value_type* str , typename basic_string<V, D, A>::size_type start_pos ) const noexcept
-	{
-		const_reverse_iterator  it;
-		size_type               string_len = length();
-		if( start_pos >= string_len ){
-			it = crbegin();
-			start_pos = string_len - 1;
-		}
-		else
-			it = rget( start_pos );
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::size_type basic_string<V, D, A, S>::rfind_codepoint( const data_type* buffer , typename basic_string<V, D, A, S>::size_type my_size , typename basic_string<V, D, A, S>::value_type cp , typename basic_string<V, D, A, S>::size_type index ) noexcept {
+		data_type			encoded[8];
+		width_type			cp_bytes = basic_string::encode_utf8( cp , encoded );
 		
-		for( const_reverse_iterator rend = crend() ; it != rend ; ++it, --start_pos ){
-			const value_type*	tmp = str;
-			value_type			cur = *it;
-			do{
-				if( cur == *tmp )
-					return start_pos;
-			}while( *++tmp );
+		// Search backwards for the encoded codepoint, skipping hits that are located within another codepoint
+		for( size_type hit ; ; index = hit - 1 ){
+			hit = tiny_utf8_detail::rfind_bytes( (const unsigned char*)buffer , my_size , (const unsigned char*)encoded , cp_bytes , index );
+			if( hit == basic_string::npos || !basic_string::is_spanned_by_lead_byte( buffer , hit , 0 , my_size ) )
+				return hit;
 		}
-		
-		return basic_string::npos;
 	}
 
-	template<typename V, typename D, typename A>
-	typename basic_string<V, D, A>::size_type basic_string<V, D, A>::raw_find_last_of( const typename basic_string<V, D, A>::value_type* str , typename basic_string<V, D, A>::size_type index ) const noexcept
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::size_type basic_string<V, D, A, S>::find_first_of_codepoint( const data_type* buffer , typename basic_string<V, D, A, S>::size_type my_size , const matcher_type& set , typename basic_string<V, D, A, S>::size_type index , bool negate ) noexcept
 	{
-		if( empty() )
-			return basic_string::npos;
-		
-		if( index >= size() )
-			index = raw_back_index();
-		
-		for( difference_type it = index ; it >= 0 ; it -= get_index_pre_bytes( it ) ){
-			const value_type*	tmp = str;
-			value_type			cur = raw_at(it);
-			do{
-				if( cur == *tmp )
-					return it;
-			}while( *++tmp );
-		}
+		const unsigned char*	data = (const unsigned char*)buffer;
 		
-		return basic_string::npos;
-	}
-
-	template<typename V, typename D, typename A>
-	typename basic_string<V, D, A>::size_type basic_string<V, D, A>::find_first_not_of( const typename basic_string<V, D, A>::value_type* str , typename basic_string<V, D, A>::size_type start_pos ) const noexcept
-	{
-		if( start_pos >= length() )
+		// Without non-ASCII members, matches can only be ASCII bytes: Search for them and validate each hit afterwards
+		if( !negate && !set.num_others ){
+			while( index < my_size ){
+				size_type hit = index + set.find_ascii_member( data + index , my_size - index );
+				if( hit >= my_size )
+					break;
+				index = basic_string::get_codepoint_start_from( buffer , index , hit , my_size );
+				if( index == hit )
+					return hit;
+			}
 			return basic_string::npos;
-		
-		for( const_iterator it = get(start_pos) , end = cend() ; it != end ; ++it, ++start_pos ){
-			const value_type*	tmp = str;
-			value_type			cur = *it;
-			do{
-				if( cur == *tmp )
-					goto continue2;
-			}while( *++tmp );
-			return start_pos;
-			continue2:;
 		}
 		
-		return basic_string::npos;
-	}
-
-	template<typename V, typename D, typename A>
-	typename basic_string<V, D, A>::size_type basic_string<V, D, A>::raw_find_first_not_of( const typename basic_string<V, D, A>::value_type* str , typename basic_string<V, D, A>::size_type index ) const noexcept
-	{
-		if( index >= size() )
-			return basic_string::npos;
-		
-		for( const_iterator it = raw_get(index), end = cend() ; it < end ; ++it )
+		while( index < my_size )
 		{
-			const value_type*	tmp = str;
-			value_type			cur = *it;
-			do{
-				if( cur == *tmp )
-					goto continue2;
-			}while( *++tmp );
-			return it.get_index();
-			continue2:;
+			// Skip ASCII runs, whose membership does not differ from 'negate'
+			index += set.ascii_span( data + index , my_size - index , negate );
+			if( index >= my_size )
+				break;
+			if( data[index] < 0x80 )
+				return index;
+			
+			value_type	cp;
+			width_type	cp_bytes = basic_string::decode_utf8_and_len( buffer + index , cp , my_size - index );
+			if( set.contains( cp ) != negate )
+				return index;
+			index += cp_bytes;
 		}
 		
 		return basic_string::npos;
 	}
 
-	template<typename V, typename D, typename A>
-	typename basic_string<V, D, A>::size_type basic_string<V, D, A>::find_last_not_of( const typename basic_string<V, D, A>::value_type* str , typename basic_string<V, D, A>::size_type start_pos ) const noexcept
+	template<typename V, typename D, typename A, std::size_t S>
+	typename basic_string<V, D, A, S>::size_type basic_string<V, D, A, S>::raw_find_last_of( const matcher_type& set , typename basic_string<V, D, A, S>::size_type index , bool negate ) const noexcept
 	{
 		if( empty() )
 			return basic_string::npos;
 		
-		const_reverse_iterator  end = rend(), it;
-		size_type               string_len = length();
-		if( start_pos >= string_len ){
-			it = crbegin();
-			start_pos = string_len - 1;
-		}
-		else
-			it = rget( start_pos );
-		
-		for( ; it < end ; ++it, --start_pos ){
-			const value_type*	tmp = str;
-			value_type			cur = *it;
-			do{
-				if( cur == *tmp )
-					goto continue2;
-			}while( *++tmp );
-			return start_pos;
-			continue2:;
-		}
-		
-		return basic_string::npos;
-	}
-
-	template<typename V, typename D, typename A>
-	typename basic_string<V, D, A>::size_type basic_string<V, D, A>::raw_find_last_not_of( const typename basic_string<V, D, A>::value_type* str , typename basic_string<V, D, A>::size_type index ) const noexcept
-	{
-		if( empty() )
-			return basic_string::npos;
+		size_type			my_size = size();
+		const data_type*	buffer = get_buffer();
 		
-		if( index >= size() )
+		if( index >= my_size )
 			index = raw_back_index();
 		
 		for( difference_type it = index ; it >= 0 ; it -= get_index_pre_bytes( it ) )
 		{
-			const value_type*	tmp = str;
-			value_type			cur = raw_at(it);
-			
-			do{
-				if( cur == *tmp )
-					goto continue2;
-			}while( *++tmp );
-			
-			return it; // It will be either non-negative or -1, which equals basic_string::npos!
-			
-			continue2:;
+			unsigned char	first_byte = (unsigned char)buffer[it];
+			value_type		cp;
+			bool			is_member = first_byte < 0x80
+				? set.contains_ascii( first_byte )
+				: ( basic_string::decode_utf8_and_len( buffer + it , cp , my_size - it ) , set.contains( cp ) );
+			if( is_member != negate )
+				return it;
 		}
 		
 		return basic_string::npos;
@@ -3,6 +3,7 @@
 
 #include <gmock/gmock.h>
 
+#include <cstddef>
 #include <memory>
 
 #include <tinyutf8/tinyutf8.h>
@@ -20,6 +21,10 @@ public:
 	}
 };
 
+// basic_string storing (at least) CAPACITY code units inline
+template<std::size_t CAPACITY>
+using SSO_String = tiny_utf8::basic_string<char32_t, char, std::allocator<char>, CAPACITY>;
+
 }
 // namespace Helpers_SSOTestUtils
 
@@ -2,6 +2,7 @@
 #define MOCK_NOTHROWALLOCATOR_H_
 
 #include <cstddef>
+#include <type_traits>
 
 template<typename T = char>
 class NoThrowAllocator
@@ -62,4 +63,74 @@ constexpr bool operator!= (const NoThrowAllocator<T>&, const NoThrowAllocator<U>
 	return false;
 }
 
+// Monotonic arena: Memory is handed out sequentially and only freed as a whole
+struct NoThrowArena
+{
+	alignas(std::max_align_t) unsigned char buffer[4096];
+	std::size_t used = 0;
+	std::size_t num_allocations = 0;
+	std::size_t num_deallocations = 0;
+};
+
+// Stateful allocator obtaining its memory from a NoThrowArena (does not propagate, just like std::pmr::polymorphic_allocator)
+template<typename T = char>
+class NoThrowArenaAllocator
+{
+public:
+	using value_type = T;
+	using propagate_on_container_copy_assignment = std::false_type;
+	using propagate_on_container_move_assignment = std::false_type;
+	using propagate_on_container_swap = std::false_type;
+	using is_always_equal = std::false_type;
+
+	template <class Other>
+	struct rebind
+	{
+		using other = NoThrowArenaAllocator<Other>;
+	};
+
+	explicit NoThrowArenaAllocator(NoThrowArena& arena) noexcept
+		: arena(&arena)
+	{
+	}
+
+	template<typename U>
+	NoThrowArenaAllocator(const NoThrowArenaAllocator<U>& other) noexcept
+		: arena(other.arena)
+	{
+	}
+
+	T* allocate(std::size_t n) noexcept
+	{
+		std::size_t size = (n * sizeof(T) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+		if (arena->used + size > sizeof(arena->buffer))
+			return nullptr;
+		T* result = reinterpret_cast<T*>(arena->buffer + arena->used);
+		arena->used += size;
+		arena->num_allocations++;
+		return result;
+	}
+
+	void deallocate(T* p, std::size_t n) noexcept
+	{
+		(void)p;
+		(void)n;
+		arena->num_deallocations++;
+	}
+
+	NoThrowArena* arena;
+};
+
+template<typename T, typename U>
+bool operator== (const NoThrowArenaAllocator<T>& lhs, const NoThrowArenaAllocator<U>& rhs) noexcept
+{
+	return lhs.arena == rhs.arena;
+}
+
+template<typename T, typename U>
+bool operator!= (const NoThrowArenaAllocator<T>& lhs, const NoThrowArenaAllocator<U>& rhs) noexcept
+{
+	return lhs.arena != rhs.arena;
+}
+
 #endif // MOCK_NOTHROWALLOCATOR_H_
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include <tinyutf8/tinyutf8.h>
+
+#include "mocks/mock_nothrowallocator.h"
+
+// Count all allocations that go through the global operator new (atomically, since allocations might happen on any thread)
+// This replaces the operator for the whole executable, which is why this file is built into one of its own
+static std::atomic<std::size_t> num_global_allocations(0);
+
+void* operator new(std::size_t size)
+{
+	num_global_allocations++;
+	if (void* result = std::malloc(size ? size : 1))
+		return result;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+using arena_string = tiny_utf8::basic_string<char32_t, char, NoThrowArenaAllocator<char>>;
+
+TEST(TinyUTF8, Allocator_ArenaWithoutGlobalAllocation)
+{
+	NoThrowArena arena;
+	NoThrowArena other_arena;
+	NoThrowArenaAllocator<char> alloc(arena);
+	NoThrowArenaAllocator<char> other_alloc(other_arena);
+
+	const std::size_t global_allocations = num_global_allocations.load();
+	{
+		arena_string short_str(U"Hello ツ", alloc);
+		arena_string long_str(U"This string is too long for SSO: ツ♫ ツ♫ ツ♫ ツ♫ ツ♫", alloc);
+		EXPECT_TRUE(short_str.sso_active());
+		EXPECT_FALSE(long_str.sso_active());
+		EXPECT_EQ(arena.num_allocations, 1);
+
+		// Copy construction and modification stay within the arena
+		arena_string copy(long_str);
+		copy += arena_string(U" and some more text", alloc);
+		copy.insert(5, U'ツ');
+		EXPECT_EQ(copy.get_allocator(), alloc);
+		EXPECT_EQ(other_arena.num_allocations, 0);
+
+		// Copy and move assignment do not propagate the allocator
+		arena_string other(other_alloc);
+		other = long_str;
+		EXPECT_EQ(other, long_str);
+		EXPECT_EQ(other.get_allocator(), other_alloc);
+		EXPECT_EQ(other_arena.num_allocations, 1);
+
+		other = std::move(copy);
+		EXPECT_TRUE(other.starts_with(U"This ツstring"));
+		EXPECT_EQ(other.get_allocator(), other_alloc);
+		EXPECT_EQ(other_arena.num_allocations, 2);
+
+		// The allocator-extended move constructor takes over the buffer only, if the allocators are equal
+		const std::size_t arena_allocations = arena.num_allocations;
+		arena_string moved(std::move(long_str), alloc);
+		EXPECT_EQ(arena.num_allocations, arena_allocations);
+		EXPECT_TRUE(long_str.empty());
+
+		arena_string moved_elsewhere(std::move(moved), other_alloc);
+		EXPECT_EQ(moved_elsewhere, U"This string is too long for SSO: ツ♫ ツ♫ ツ♫ ツ♫ ツ♫");
+		EXPECT_EQ(moved_elsewhere.get_allocator(), other_alloc);
+		EXPECT_EQ(other_arena.num_allocations, 3);
+
+		// Swapping strings with equal allocators simply exchanges the buffers
+		other.swap(moved_elsewhere);
+		EXPECT_EQ(other, U"This string is too long for SSO: ツ♫ ツ♫ ツ♫ ツ♫ ツ♫");
+		EXPECT_EQ(other_arena.num_allocations, 3);
+	}
+	EXPECT_EQ(num_global_allocations.load(), global_allocations);
+	EXPECT_EQ(arena.num_allocations, arena.num_deallocations);
+	EXPECT_EQ(other_arena.num_allocations, other_arena.num_deallocations);
+}
+
+TEST(TinyUTF8, Allocator_StreamExtraction)
+{
+	NoThrowArena arena;
+	NoThrowArenaAllocator<char> alloc(arena);
+	const std::string long_word(300, 'a');
+	std::istringstream stream(" short ツ♫\t" + long_word + " tiny");
+
+	{
+		// Short words are read into the sso buffer without any allocation
+		arena_string str(alloc);
+		stream >> str;
+		EXPECT_EQ(str, U"short");
+		stream >> str;
+		EXPECT_EQ(str, U"ツ♫");
+		EXPECT_TRUE(str.sso_active());
+		EXPECT_EQ(arena.num_allocations, 0);
+
+		// Only words outgrowing the sso buffer end up on the heap
+		stream >> str;
+		EXPECT_EQ(str.cpp_str(), long_word);
+		EXPECT_FALSE(str.sso_active());
+		EXPECT_GE(arena.num_allocations, 1);
+
+		stream >> str;
+		EXPECT_EQ(str, U"tiny");
+		EXPECT_TRUE(str.sso_active());
+	}
+	EXPECT_EQ(arena.num_allocations, arena.num_deallocations);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <tinyutf8/tinyutf8.h>
+
+static std::string generate_text(std::size_t num_pieces)
+{
+	const char* pieces[] = { "Hello World ", "\xC3\xA4", "\xE3\x83\x84", "\xF0\x9F\x98\x80" };
+	std::string text;
+	for (std::size_t i = 0; i < num_pieces; i++)
+		text += pieces[i * 7 % 4];
+	return text;
+}
+
+static void expect_consistent(const tiny_utf8::string& str, const tiny_utf8::string& expected)
+{
+	ASSERT_EQ(str, expected);
+	EXPECT_EQ(str.length(), expected.length());
+	EXPECT_EQ(str.requires_unicode(), expected.requires_unicode());
+	for (std::size_t i = 0; i < expected.length(); i += 7) {
+		EXPECT_EQ(str[i], expected[i]) << i;
+		EXPECT_EQ(str.get_num_bytes_from_start(i), expected.get_num_bytes_from_start(i)) << i;
+	}
+	EXPECT_EQ(str.get_num_codepoints(0, str.size()), expected.length());
+}
+
+TEST(TinyUTF8, Concat_Pieces)
+{
+	tiny_utf8::string text(generate_text(500));
+	tiny_utf8::string ascii("Only ASCII, but on the heap to have no lut at all");
+	tiny_utf8::string small(U"ツä");
+	ASSERT_TRUE(text.lut_active());
+
+	// Strings with and without lut, views, literals and codepoints
+	tiny_utf8::string str = tiny_utf8::concat(text, small, U'😀', ascii, "\xE2\x99\xAB", text.substr_view(3, 100), text, small);
+	tiny_utf8::string expected = text + small + U'😀' + ascii + "\xE2\x99\xAB" + text.substr(3, 100) + text + small;
+	expect_consistent(str, expected);
+	EXPECT_TRUE(str.lut_active());
+
+	// Results fitting the inline buffer
+	tiny_utf8::string sso = tiny_utf8::concat(small, U'a', "b", small);
+	EXPECT_TRUE(sso.sso_active());
+	expect_consistent(sso, tiny_utf8::string(U"ツäabツä"));
+	EXPECT_EQ(tiny_utf8::concat(), tiny_utf8::string());
+	EXPECT_EQ(tiny_utf8::concat(tiny_utf8::string(), ""), tiny_utf8::string());
+
+	// Only ASCII
+	tiny_utf8::string plain = tiny_utf8::concat(ascii, U' ', ascii);
+	expect_consistent(plain, ascii + U' ' + ascii);
+	EXPECT_FALSE(plain.requires_unicode());
+
+	// Dense multibytes, whose lut isn't worth it
+	std::string cjk;
+	for (int i = 0; i < 300; i++)
+		cjk += "\xE3\x83\x84";
+	tiny_utf8::string dense(cjk);
+	expect_consistent(tiny_utf8::concat(dense, U'ツ', dense), dense + U'ツ' + dense);
+
+	// Other specializations
+	tiny_utf8::basic_string<char32_t, char, std::allocator<char>, 64> wide = tiny_utf8::basic_string<char32_t, char, std::allocator<char>, 64>::concat(U'ä', "bc");
+	EXPECT_TRUE(wide.sso_active());
+	EXPECT_EQ(wide.length(), 3u);
+}
+
+TEST(TinyUTF8, Concat_Join)
+{
+	tiny_utf8::string text(generate_text(400));
+	std::vector<tiny_utf8::string> parts = { text, tiny_utf8::string(U"ツ"), tiny_utf8::string(), text.substr(50, 60) };
+
+	tiny_utf8::string expected = parts[0] + U"→" + parts[1] + U"→" + parts[2] + U"→" + parts[3];
+	expect_consistent(tiny_utf8::join(parts, U'→'), expected);
+	expect_consistent(tiny_utf8::join(parts, "\xE2\x86\x92"), expected);
+	expect_consistent(tiny_utf8::join(parts, tiny_utf8::string(U"→")), expected);
+
+	// Split ranges are joined back into the original
+	tiny_utf8::string csv(U"name;ツ;;straße;♫ and some more text, so the string is not small;");
+	expect_consistent(tiny_utf8::join(csv.split(U';'), U';'), csv);
+	expect_consistent(tiny_utf8::join(csv.split(U';'), ""), tiny_utf8::string(U"nameツstraße♫ and some more text, so the string is not small"));
+	expect_consistent(tiny_utf8::join(text.split(U'ツ'), U'ツ'), text);
+
+	// Edge cases
+	EXPECT_EQ(tiny_utf8::join(std::vector<tiny_utf8::string>(), U','), tiny_utf8::string());
+	EXPECT_EQ(tiny_utf8::join(std::vector<tiny_utf8::string>(1, text), U','), text);
+	std::vector<tiny_utf8::string_view> views = { "a", "b", "c" };
+	expect_consistent(tiny_utf8::join(views, text), tiny_utf8::string("a") + text + "b" + text + "c");
+}
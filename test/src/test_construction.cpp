@@ -1,7 +1,15 @@
 ﻿#include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <sstream>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include <tinyutf8/tinyutf8.h>
 
@@ -47,6 +55,104 @@ TEST(TinyUTF8, CTor_TakeALiteral_SSOAndNoSSO)
 
 }
 
+TEST(TinyUTF8, CTor_ConfigurableSSOCapacity)
+{
+	using sso_string = Helpers_SSOTestUtils::SSO_String<64>;
+
+	EXPECT_EQ(Helpers_SSOTestUtils::SSO_Capacity<sso_string>::get_sso_capacity(), 64u);
+	EXPECT_EQ(Helpers_SSOTestUtils::SSO_Capacity<tiny_utf8::string>::get_sso_capacity(), sizeof(tiny_utf8::string) - 1);
+	EXPECT_TRUE((std::is_same<Helpers_SSOTestUtils::SSO_String<Helpers_SSOTestUtils::SSO_Capacity<tiny_utf8::string>::get_sso_capacity()>, tiny_utf8::string>::value));
+	EXPECT_EQ(Helpers_SSOTestUtils::SSO_Capacity<Helpers_SSOTestUtils::SSO_String<4>>::get_sso_capacity(), sizeof(tiny_utf8::string) - 1); // Never less than the default
+	EXPECT_GT(sizeof(sso_string), 64u);
+
+	// 60 bytes of mixed UTF-8 are stored inline
+	const char* url = "https://example.org/straße/ツ/♫?query=äöü&name=Jürgen";
+	sso_string str(url);
+	ASSERT_EQ(str.size(), std::strlen(url));
+	EXPECT_GT(str.size(), sizeof(tiny_utf8::string));
+	EXPECT_TRUE(str.sso_active());
+	EXPECT_TRUE(str.requires_unicode());
+	EXPECT_EQ(str.length(), tiny_utf8::string(url).length());
+	EXPECT_EQ(str[24], U'ß');
+	EXPECT_EQ(str.find(U'♫'), 29u);
+	EXPECT_EQ(str.cpp_str(), url);
+	EXPECT_EQ(std::hash<sso_string>()(str), std::hash<tiny_utf8::string>()(tiny_utf8::string(url)));
+	EXPECT_EQ(tiny_utf8::string_view(str), tiny_utf8::string(url));
+
+	// Growing beyond the capacity moves the data to the heap
+	sso_string copy(str);
+	copy.append(U" and some more text to leave the inline buffer ✓");
+	EXPECT_FALSE(copy.sso_active());
+	EXPECT_EQ(copy.length(), str.length() + 48);
+	EXPECT_EQ(copy.back(), U'✓');
+	EXPECT_EQ(copy.substr(0, str.length()), str);
+	EXPECT_TRUE(copy.substr(0, str.length()).sso_active());
+	copy.erase(str.length(), 48);
+	EXPECT_EQ(copy, str);
+	EXPECT_EQ(std::hash<sso_string>()(copy), std::hash<sso_string>()(str));
+
+	// Swapping and moving between both layouts
+	sso_string heap(U"Hello ツ, this string is definitely longer than 64 bytes and lives on the heap");
+	sso_string small(U"Hello ツ");
+	EXPECT_FALSE(heap.sso_active());
+	heap.swap(small);
+	EXPECT_EQ(heap, U"Hello ツ");
+	EXPECT_TRUE(heap.sso_active());
+	EXPECT_EQ(small.length(), 77u);
+	sso_string moved(std::move(small));
+	EXPECT_EQ(moved.length(), 77u);
+	moved = std::move(str);
+	EXPECT_TRUE(moved.sso_active());
+	EXPECT_EQ(moved.cpp_str(), url);
+
+	std::stringstream stream;
+	stream << moved;
+	EXPECT_EQ(stream.str(), url);
+
+	// Copy-assigning heap strings to inline ones and back
+	using large_sso_string = Helpers_SSOTestUtils::SSO_String<127>;
+	large_sso_string hello("hello");
+	large_sso_string long_text(std::string(200, 'x') + "ツ");
+	ASSERT_FALSE(long_text.sso_active());
+	hello = long_text;
+	EXPECT_FALSE(hello.sso_active());
+	EXPECT_EQ(hello.size(), 203u);
+	EXPECT_EQ(hello.length(), 201u);
+	EXPECT_EQ(hello, long_text);
+	large_sso_string other(std::string(300, 'y'));
+	other = long_text;
+	EXPECT_FALSE(other.sso_active());
+	EXPECT_EQ(other.size(), 203u);
+	EXPECT_EQ(other.back(), U'ツ');
+	other = large_sso_string(url);
+	EXPECT_TRUE(other.sso_active());
+	EXPECT_EQ(other.cpp_str(), url);
+	hello = large_sso_string(long_text.substr(0, 150));
+	EXPECT_EQ(hello.length(), 150u);
+
+	// Builders, decoders and everything built on them produce strings of the same capacity
+	sso_string replaced(url);
+	replaced.replace_all(U"ä", U"ae");
+	EXPECT_TRUE(replaced.sso_active());
+	EXPECT_EQ(replaced.find(U"aeöü"), tiny_utf8::string(url).find(U'ä'));
+	tiny_utf8::basic_string_builder<char32_t, char, std::allocator<char>, 64> builder;
+	builder.append(url, std::strlen(url)).append(U'✓');
+	sso_string built = builder.finalize();
+	EXPECT_TRUE(built.sso_active());
+	EXPECT_EQ(built.back(), U'✓');
+	sso_string decoded;
+	{
+		tiny_utf8::basic_stream_decoder<char32_t, char, std::allocator<char>, 64> decoder(decoded);
+		decoder.feed(url, 25).feed(url + 25, std::strlen(url) - 25);
+		decoder.finish();
+	}
+	EXPECT_EQ(decoded.cpp_str(), url);
+	std::stringstream lines(std::string(url) + "\nsecond line");
+	tiny_utf8::basic_line_reader<char32_t, char, std::allocator<char>, 64> reader(*lines.rdbuf());
+	ASSERT_TRUE(reader.read(decoded));
+	EXPECT_EQ(decoded.cpp_str(), url);
+}
+
 TEST(TinyUTF8, CTor_TakeALiteralWithMaxCodePoints)
 {
 	tiny_utf8::string str(U"ツ♫", 1);
@@ -59,6 +165,44 @@ TEST(TinyUTF8, CTor_TakeALiteralWithMaxCodePoints)
 	EXPECT_EQ(static_cast<uint64_t>(str[0]), 12484);
 }
 
+TEST(TinyUTF8, CTor_TakeAUserDefinedLiteral)
+{
+	using namespace tiny_utf8::literals;
+
+#if __cplusplus >= 201402L
+	// The metadata is computed at compile time
+	constexpr tiny_utf8::string_literal key = "TEST: ツ♫"_tu8;
+	static_assert(key.length() == 8 && key.size() == 12 && key.num_multibytes() == 2, "literal metadata is not computed correctly");
+#else
+	const tiny_utf8::string_literal key = "TEST: ツ♫"_tu8;
+#endif
+	tiny_utf8::string str(key);
+
+	EXPECT_EQ(key.length(), 8);
+	EXPECT_EQ(key.num_multibytes(), 2);
+	EXPECT_EQ(str.length(), 8);
+	EXPECT_EQ(str.size(), 12);
+	EXPECT_TRUE(str.sso_active());
+	EXPECT_EQ(str, tiny_utf8::string(U"TEST: ツ♫"));
+
+	// Long literals get the same lut as if their codepoints had been counted at runtime
+	tiny_utf8::string long_str = "This literal is too long for SSO: ツ♫ ツ♫ ツ♫ ツ♫ ツ♫ and contains some multibytes"_tu8;
+	tiny_utf8::string expected(U"This literal is too long for SSO: ツ♫ ツ♫ ツ♫ ツ♫ ツ♫ and contains some multibytes");
+
+	EXPECT_FALSE(long_str.sso_active());
+	EXPECT_EQ(long_str.lut_active(), expected.lut_active());
+	EXPECT_EQ(long_str.length(), expected.length());
+	EXPECT_EQ(long_str, expected);
+	for (std::size_t i = 0; i < expected.length(); i++)
+		EXPECT_EQ(long_str[i], expected[i]);
+
+	// Malformed data is measured like at runtime too
+	const char malformed[] = "\xE3\x83 \xFF\x80 long enough to not fit into the SSO buffer";
+	EXPECT_EQ(tiny_utf8::string_literal(malformed).length(), tiny_utf8::string(malformed).length());
+
+	EXPECT_TRUE(tiny_utf8::string(""_tu8).empty());
+}
+
 TEST(TinyUTF8, CTor_TakeAnAnsiString)
 {
 	const std::string ansi_str("Loewen, Boeren, Voegel und Koefer sind Tiere.");
@@ -86,3 +230,410 @@ TEST(TinyUTF8, CopyCTor)
 	EXPECT_FALSE(str.lut_active());
 	EXPECT_EQ(static_cast<uint64_t>(str[8]), 32);
 }
+
+TEST(TinyUTF8, CopyAssign_IntoLargerBuffer)
+{
+	// The target buffers have 16 and 32 bit wide luts, while the one of the source is 8 bit wide
+	for (int target_length : { 1000, 50000 }) {
+		std::u32string source, target;
+		for (int i = 0; i < 50; i++)
+			source += i % 5 ? U'a' : U'ä';
+		for (int i = 0; i < target_length; i++)
+			target += i % 3 ? U'b' : U'ツ';
+		tiny_utf8::string expected(source.c_str());
+		tiny_utf8::string str(target.c_str());
+		ASSERT_TRUE(expected.lut_active());
+
+		// The lut (with all of its entries) is copied into the existing buffer
+		str = expected;
+		EXPECT_EQ(str.lut_active(), expected.lut_active());
+		for (std::size_t i = 0; i < source.size(); i++) {
+			EXPECT_EQ(str[i], source[i]) << i;
+			EXPECT_EQ(str.get_num_bytes_from_start(i), expected.get_num_bytes_from_start(i)) << i;
+		}
+		EXPECT_TRUE(std::equal(str.rbegin(), str.rend(), source.rbegin()));
+		EXPECT_EQ(str.find(U'ä', 1), 5u);
+		str.erase(3, 20);
+		source.erase(3, 20);
+		EXPECT_EQ(str, tiny_utf8::string(source.c_str()));
+		for (std::size_t i = 0; i < source.size(); i++)
+			EXPECT_EQ(str[i], source[i]) << i;
+	}
+}
+
+TEST(TinyUTF8, CTor_TakeAMixedString_ASCIIRuns)
+{
+	// ASCII runs of varying length (crossing the 8, 16 and 32 byte blocks) interleaved with multibytes
+	std::string bytes;
+	std::size_t expected_length = 0;
+	for( std::size_t run = 0 ; run < 70 ; run += 7 ){
+		bytes.append( run , 'a' );
+		bytes.append( "\xC3\xA4" );		// ä
+		bytes.append( "\xE3\x83\x84" );	// ツ
+		expected_length += run + 2;
+	}
+	bytes.append( 40 , 'z' );
+	expected_length += 40;
+
+	tiny_utf8::string str( bytes.data() , bytes.size() );
+
+	EXPECT_EQ(str.size(), bytes.size());
+	EXPECT_EQ(str.length(), expected_length);
+	EXPECT_FALSE(str.sso_active());
+	EXPECT_EQ(str.cpp_str(), bytes);
+	EXPECT_EQ(static_cast<uint64_t>(str[0]), 0xE4);
+	EXPECT_EQ(static_cast<uint64_t>(str[1]), 12484);
+	EXPECT_EQ(static_cast<uint64_t>(str[expected_length - 41]), 12484);
+	EXPECT_EQ(static_cast<uint64_t>(str[expected_length - 1]), 'z');
+}
+
+TEST(TinyUTF8, CountCodepoints_Malformed)
+{
+	// Well-formed multibytes spanning several 16 byte blocks
+	std::string valid;
+	for (std::size_t i = 0; i < 20; ++i)
+		valid.append("a\xC3\xA4\xE3\x83\x84\xF0\x9F\x98\x84");
+	tiny_utf8::string str(valid);
+	EXPECT_EQ(str.length(), 80);
+	EXPECT_EQ(str.get_num_codepoints(10, 100), 40);
+	EXPECT_EQ(str.get_num_bytes(10, 40), 100);
+
+	// A stray continuation byte counts as a codepoint on its own
+	str = tiny_utf8::string(std::string(40, 'a') + "\x80" + std::string(20, 'b'));
+	EXPECT_EQ(str.get_num_codepoints(0, str.size()), 61);
+	EXPECT_EQ(str.get_num_bytes_from_start(41), 41);
+
+	// A lead byte swallows the announced number of bytes, no matter what follows
+	str = tiny_utf8::string(std::string(30, 'a') + "\xE3" "ab" + std::string(30, 'b'));
+	EXPECT_EQ(str.get_num_codepoints(0, str.size()), 61);
+	EXPECT_EQ(str.get_num_bytes_from_start(31), 33);
+
+	// Lead bytes truncated by the end of the range count as single bytes
+	str = tiny_utf8::string(std::string(20, 'a') + "\xF0\x9F");
+	EXPECT_EQ(str.length(), 22);
+	EXPECT_TRUE(str.sso_active());
+	str = tiny_utf8::string(std::string(20, 'a') + "\xE3\x83\x84");
+	EXPECT_EQ(str.get_num_codepoints(0, 22), 22);
+	EXPECT_EQ(str.get_num_codepoints(0, 23), 21);
+}
+
+TEST(TinyUTF8, CTor_TakeCodepointRanges)
+{
+	// ASCII runs of varying length (crossing the 8 and 16 codepoint blocks) interleaved with multibytes
+	std::u32string codepoints;
+	for (std::size_t run = 0; run < 60; run += 5)
+	{
+		codepoints.append(run, U'a');
+		codepoints.append(U"ä€😄");
+	}
+	std::string expected;
+	for (std::size_t run = 0; run < 60; run += 5)
+	{
+		expected.append(run, 'a');
+		expected.append("\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x84");
+	}
+
+	tiny_utf8::string from_pointer(codepoints.data(), codepoints.size());
+	tiny_utf8::string from_range(codepoints.begin(), codepoints.end());
+	std::list<char32_t> list(codepoints.begin(), codepoints.end());
+	tiny_utf8::string from_list(list.begin(), list.end());
+	std::istringstream stream("104 105 8364");
+	tiny_utf8::string from_stream((std::istream_iterator<std::uint32_t>(stream)), std::istream_iterator<std::uint32_t>());
+
+	EXPECT_EQ(from_pointer.cpp_str(), expected);
+	EXPECT_EQ(from_pointer.length(), codepoints.size());
+	EXPECT_EQ(from_range, from_pointer);
+	EXPECT_EQ(from_list, from_pointer);
+	EXPECT_EQ(from_range.lut_active(), from_pointer.lut_active());
+	for (std::size_t i = 0; i < codepoints.size(); ++i)
+		EXPECT_EQ(static_cast<uint64_t>(from_range[i]), static_cast<uint64_t>(codepoints[i]));
+	EXPECT_EQ(from_stream, tiny_utf8::string(U"hi€"));
+
+	// Pure ASCII and short (SSO) input
+	std::u32string ascii(100, U'x');
+	EXPECT_EQ(tiny_utf8::string(ascii.begin(), ascii.end()).cpp_str(), std::string(100, 'x'));
+	EXPECT_EQ(tiny_utf8::string({ U'a', U'ツ' }).cpp_str(), "a\xE3\x83\x84");
+	EXPECT_TRUE(tiny_utf8::string(ascii.begin(), ascii.begin() + 3).sso_active());
+}
+
+TEST(TinyUTF8, AdoptAndReleaseBuffers)
+{
+	std::string text;
+	for (std::size_t i = 0; i < 50; ++i)
+		text.append("Hello \xE3\x83\x84 World ");
+
+	// Capacity with room for the lut: The data is used in place and the lut is built behind it
+	tiny_utf8::string str;
+	tiny_utf8::string::heap_buffer buffer = str.allocate_buffer(text.size() * 2);
+	std::memcpy(buffer.data, text.data(), text.size());
+	str.adopt(buffer.data, text.size(), buffer.capacity);
+	EXPECT_EQ(str.data(), buffer.data);
+	EXPECT_EQ(str.cpp_str(), text);
+	EXPECT_EQ(str.length(), 50 * 14);
+	EXPECT_TRUE(str.lut_active());
+	EXPECT_EQ(static_cast<uint64_t>(str[14 * 49 + 6]), 12484);
+
+	// Released buffers keep their data and can be adopted again
+	tiny_utf8::string::heap_buffer released = str.release();
+	EXPECT_EQ(released.data, buffer.data);
+	EXPECT_EQ(released.data_len, text.size());
+	EXPECT_EQ(released.data[released.data_len], '\0');
+	EXPECT_TRUE(str.empty());
+	tiny_utf8::string other;
+	other.adopt(released);
+	EXPECT_EQ(other.data(), buffer.data);
+	EXPECT_EQ(other.cpp_str(), text);
+
+	// Without spare capacity, the string is lut-less, but behaves the same
+	buffer = str.allocate_buffer(text.size() + 1 + sizeof(tiny_utf8::string::size_type));
+	std::memcpy(buffer.data, text.data(), text.size());
+	str.adopt(buffer.data, text.size(), buffer.capacity);
+	EXPECT_EQ(str.data(), buffer.data);
+	EXPECT_FALSE(str.lut_active());
+	EXPECT_EQ(str, other);
+	EXPECT_EQ(static_cast<uint64_t>(str[14 * 49 + 6]), 12484);
+	str.append(U"♫");
+	EXPECT_EQ(str.length(), 50 * 14 + 1);
+
+	// Small strings are copied into the string object, while releasing moves them to the heap
+	buffer = str.allocate_buffer(64);
+	std::memcpy(buffer.data, "abc", 3);
+	str.adopt(buffer.data, 3, buffer.capacity);
+	EXPECT_TRUE(str.sso_active());
+	EXPECT_EQ(str, "abc");
+	released = str.release();
+	EXPECT_EQ(std::string(released.data), "abc");
+	str.deallocate_buffer(released);
+}
+
+TEST(TinyUTF8, StreamExtraction)
+{
+	std::string word(300, 'a');
+	word += "\xE3\x83\x84";
+	std::istringstream stream("  short " + word + "\t\xC3\xA4 rest");
+	tiny_utf8::string str;
+
+	stream >> str;
+	EXPECT_EQ(str, "short");
+	stream >> str;
+	EXPECT_EQ(str.cpp_str(), word);
+	EXPECT_EQ(str.length(), 301);
+	stream >> str;
+	EXPECT_EQ(str, tiny_utf8::string(U"ä"));
+	stream.width(2);
+	stream >> str;
+	EXPECT_EQ(str, "re");
+	stream >> str;
+	EXPECT_EQ(str, "st");
+	EXPECT_TRUE(stream.eof());
+	EXPECT_FALSE(stream.fail());
+	stream >> str;
+	EXPECT_TRUE(stream.fail());
+}
+
+TEST(TinyUTF8, StreamDecoder)
+{
+	std::uint32_t seed = 7;
+	auto random = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+
+	std::string mixed, malformed;
+	while (mixed.size() < 5000)
+		mixed += random() % 4 ? "text " : "\xE3\x83\x84\xF0\x9F\x98\x80\xC3\xA4";
+	while (malformed.size() < 5000)
+		malformed += (char)(random() % 3 ? 0x80 + random() % 0x80 : random());
+	std::string unsplittable(300, '\xFF');
+
+	for (const std::string* input : { &mixed, &malformed, &unsplittable })
+		for (std::size_t max_chunk : { 1, 2, 3, 5, 64, 1000 })
+		{
+			const tiny_utf8::string whole(*input);
+			tiny_utf8::string str;
+			{
+				tiny_utf8::stream_decoder decoder(str);
+				for (std::size_t i = 0; i < input->size();) {
+					std::size_t len = std::min<std::size_t>(1 + random() % max_chunk, input->size() - i);
+					decoder.feed(input->data() + i, len);
+					EXPECT_LT(decoder.num_pending(), 16u);
+					i += len;
+				}
+			} // Finishes decoding
+
+			// Codepoints are counted exactly like the data was appended at once
+			EXPECT_EQ(str.cpp_str(), *input);
+			ASSERT_EQ(str.length(), whole.length());
+			for (std::size_t i = 0; i < whole.length(); i += 7)
+				EXPECT_EQ(str[i], whole[i]);
+		}
+
+	// Codepoints split across chunks are held back
+	tiny_utf8::string str("Hello");
+	tiny_utf8::stream_decoder decoder(str);
+	decoder.feed("\xE3", 1).feed("\x83", 1);
+	EXPECT_EQ(decoder.num_pending(), 2);
+	EXPECT_EQ(str, "Hello");
+	decoder.feed("\x84 ", 2);
+	EXPECT_EQ(decoder.num_pending(), 0);
+	EXPECT_EQ(str, tiny_utf8::string(U"Helloツ "));
+
+	// Truncated data is appended as is, once the decoder is finished
+	decoder.feed("\xF0\x9F", 2);
+	EXPECT_EQ(str.length(), 7);
+	EXPECT_EQ(decoder.finish().length(), 9);
+
+	// Errors are reported by 'finish' only, the destructor drops them (it may run during stack unwinding)
+	EXPECT_TRUE(std::is_nothrow_destructible<tiny_utf8::stream_decoder>::value);
+}
+
+TEST(TinyUTF8, LineReader)
+{
+	std::string text;
+	std::vector<std::string> lines;
+	for (int i = 0; i < 200; i++) {
+		lines.push_back(std::string(i * 7 % 100, 'a') + (i % 3 ? "\xE3\x83\x84" : "") + std::to_string(i));
+		text += lines.back() + "\n";
+	}
+	lines.push_back("last line without delimiter \xC3\xA4");
+	text += lines.back();
+
+	// Small buffers split lines and codepoints
+	for (std::size_t buffer_size : { 1, 2, 5, 1 << 16 })
+	{
+		std::istringstream stream(text);
+		tiny_utf8::line_reader reader(*stream.rdbuf(), '\n', buffer_size);
+		tiny_utf8::string line;
+		std::size_t num_lines = 0;
+		while (reader.read(line)) {
+			ASSERT_LT(num_lines, lines.size());
+			EXPECT_EQ(line.cpp_str(), lines[num_lines]);
+			EXPECT_EQ(line.length(), tiny_utf8::string(lines[num_lines]).length());
+			num_lines++;
+		}
+		EXPECT_EQ(num_lines, lines.size());
+		EXPECT_FALSE(reader.read(line));
+		EXPECT_TRUE(line.empty());
+	}
+
+	// Empty records
+	std::istringstream stream(";;\xC3\xA4;");
+	tiny_utf8::line_reader reader(*stream.rdbuf(), ';');
+	tiny_utf8::string record("previous content");
+	EXPECT_TRUE(reader.read(record));
+	EXPECT_TRUE(record.empty());
+	EXPECT_TRUE(reader.read(record));
+	EXPECT_TRUE(reader.read(record));
+	EXPECT_EQ(record, tiny_utf8::string(U"ä"));
+	EXPECT_FALSE(reader.read(record));
+}
+
+TEST(TinyUTF8, StringBuilder)
+{
+	// Small results end up in the sso buffer
+	tiny_utf8::string_builder small;
+	small.append("Hi ");
+	small += U'ツ';
+	tiny_utf8::string small_str = small.finalize();
+	EXPECT_EQ(small_str, tiny_utf8::string(U"Hi ツ"));
+	EXPECT_TRUE(small_str.sso_active());
+	EXPECT_TRUE(small.empty());
+
+	// Mostly ASCII with a few multibytes: The lut is built on finalize
+	std::u32string			reference;
+	tiny_utf8::string_builder	builder(4000, 400);
+	const std::size_t		capacity = builder.capacity();
+	const tiny_utf8::string	fragment(U"ä and text ");
+	for (std::size_t i = 0; i < 200; ++i)
+	{
+		builder.append(fragment);
+		builder += U"♫, ";
+		reference += U"ä and text ♫, ";
+	}
+	EXPECT_EQ(builder.capacity(), capacity);
+	EXPECT_EQ(builder.view().length(), reference.length());
+
+	tiny_utf8::string str = builder.finalize();
+	EXPECT_TRUE(builder.empty());
+	EXPECT_TRUE(str.lut_active());
+	ASSERT_EQ(str.length(), reference.length());
+	EXPECT_EQ(str, tiny_utf8::string(reference.c_str()));
+	for (std::size_t i = 0; i < reference.length(); i += 11)
+		EXPECT_EQ(str[i], reference[i]);
+
+	// More multibytes than expected: The builder makes room for the lut once
+	tiny_utf8::string_builder unexpected;
+	for (std::size_t i = 0; i < 100; ++i)
+		unexpected.append(U'ツ').append("abcdefghijklmnop");
+	str = unexpected.finalize();
+	EXPECT_TRUE(str.lut_active());
+	EXPECT_EQ(str.length(), 1700);
+	EXPECT_EQ(str[1699], U'p');
+	EXPECT_EQ(str[1683], U'ツ');
+}
+
+// Exposes the initialized parts of the heap buffer of a string (data, lut and jump table), to compare its layout byte by byte
+struct LayoutInspector : tiny_utf8::string
+{
+	static std::string get_layout(const tiny_utf8::string& str)
+	{
+		if (str.sso_active())
+			return str.cpp_str();
+		const NON_SSO&	non_sso = str.*(&LayoutInspector::t_non_sso);
+		const char*		lut_base_ptr = get_lut_base_ptr(non_sso.data, non_sso.buffer_size);
+		const bool		lut_active = is_lut_active(lut_base_ptr);
+		const width_type lut_width = get_lut_width(non_sso.buffer_size);
+		const size_type	lut_len = lut_active ? get_lut_len(lut_base_ptr) : 0;
+
+		std::string layout(non_sso.data, non_sso.data_len + 1);
+		layout.append(lut_base_ptr - lut_len * lut_width, lut_len * lut_width + sizeof(indicator_type));
+		if (get_jump_table_size(non_sso.buffer_size))
+		{
+			const char* jump_table_base_ptr = get_jump_table_base_ptr(lut_base_ptr);
+			const size_type entry_width = lut_active ? lut_width : sizeof(std::uint16_t);
+			layout.append(jump_table_base_ptr, sizeof(indicator_type) + get_jump_table_len(jump_table_base_ptr, lut_active) * entry_width);
+		}
+		return layout;
+	}
+};
+
+TEST(TinyUTF8, FromBytesParallel)
+{
+	std::uint32_t seed = 42;
+	auto random = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+
+	std::string ascii, mixed, multibytes, malformed;
+	while (ascii.size() < (1u << 20) + 13)
+		ascii += "Lorem ipsum dolor sit amet. ";
+	while (mixed.size() < (1u << 20) + 7)
+		mixed += random() % 16 ? "text " : "\xE3\x83\x84\xF0\x9F\x98\x80 ";
+	while (multibytes.size() < (1u << 19) + 5)
+		multibytes += random() % 4 ? "\xE3\x83\x84" : "\xC3\xA4";
+	while (malformed.size() < (1u << 19))
+		malformed += (char)random();
+	std::string unsplittable(1u << 19, '\xFF'); // No byte starts a codepoint, that is not spanned by a previous one
+
+	// Runs the tasks serially in reverse order
+	auto reverse_for = [](std::size_t num_tasks, const std::function<void(std::size_t)>& task) {
+		while (num_tasks)
+			task(--num_tasks);
+	};
+
+	for (const std::string* input : { &ascii, &mixed, &multibytes, &malformed, &unsplittable })
+	{
+		const tiny_utf8::string serial(*input);
+		const std::string layout = LayoutInspector::get_layout(serial);
+
+		const tiny_utf8::string reversed = tiny_utf8::string::from_bytes_parallel(input->data(), input->size(), 7, reverse_for);
+		EXPECT_EQ(LayoutInspector::get_layout(reversed), layout);
+		EXPECT_EQ(reversed.length(), serial.length());
+
+		const tiny_utf8::string threaded = tiny_utf8::string::from_bytes_parallel(input->data(), input->size(), 4);
+		EXPECT_EQ(LayoutInspector::get_layout(threaded), layout);
+		EXPECT_EQ(threaded.lut_active(), serial.lut_active());
+	}
+	EXPECT_TRUE(tiny_utf8::string(mixed).lut_active());
+	EXPECT_FALSE(tiny_utf8::string(multibytes).lut_active());
+
+	// Small inputs are constructed serially
+	tiny_utf8::string small = tiny_utf8::string::from_bytes_parallel("Hello \xE3\x83\x84", 9);
+	EXPECT_EQ(small, tiny_utf8::string(U"Hello ツ"));
+	EXPECT_EQ(small[6], U'ツ');
+}
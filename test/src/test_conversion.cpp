@@ -1,6 +1,10 @@
 ﻿#include <gtest/gtest.h>
 
+#include <cstdint>
+#include <iterator>
+#include <random>
 #include <string>
+#include <vector>
 
 #include <tinyutf8/tinyutf8.h>
 
@@ -18,3 +22,101 @@ TEST(TinyUTF8, ToWideLiteral)
 		++it_fwd;
 	}
 }
+
+// Decodes byte by byte like tiny-utf8 does: Malformed lead bytes and truncated codepoints are decoded as single bytes.
+// A string might count a truncated codepoint once, which is why its codepoints are limited to its length.
+static std::u32string decode_bytewise(const std::string& data, std::size_t max_codepoints = (std::size_t)-1)
+{
+	std::u32string result;
+	for (std::size_t i = 0; i < data.size() && result.size() < max_codepoints;)
+	{
+		unsigned char lead = static_cast<unsigned char>(data[i]);
+		std::size_t bytes = 0;
+		while (bytes < 8 && (lead << bytes) & 0x80)
+			++bytes;
+		if (bytes == 0 || bytes > data.size() - i)
+			bytes = 1;
+		char32_t cp = bytes > 1 ? lead & (0x7F >> bytes) : lead;
+		for (std::size_t j = 1; j < bytes; ++j)
+			cp = (cp << 6) | (static_cast<unsigned char>(data[i + j]) & 0x3F);
+		result.push_back(cp);
+		i += bytes;
+	}
+	return result;
+}
+
+TEST(TinyUTF8, ToCodepoints)
+{
+	// Mix well-formed codepoints of 1 to 7 bytes with malformed bytes
+	const char* const pieces[] = { "a", "Hello ", "\xC3\xA4", "\xE3\x83\x84", "\xF0\x9F\x98\x80", "\xFC\x80\x80\x80\x80\x80", "\xFE\x83\xBF\xBF\xBF\xBF\xBF", "\x80", "\xE3\x83", "\xFF" };
+	std::mt19937 random(42);
+
+	for (int round = 0; round < 500; ++round)
+	{
+		std::string data;
+		int num_pieces = static_cast<int>(random() % 40);
+		bool malformed = round % 2;
+		for (int i = 0; i < num_pieces; ++i)
+			data += pieces[random() % (malformed ? 10 : 5)];
+
+		tiny_utf8::string str(data);
+		std::u32string expected = decode_bytewise(data, str.length());
+		EXPECT_EQ(expected, std::u32string(str.begin(), str.end()));
+
+		// Into a buffer
+		std::u32string result(expected.size(), U'\0');
+		EXPECT_EQ(str.to_codepoints(&result[0]), expected.size());
+		EXPECT_EQ(result, expected);
+
+		// With limited capacity
+		std::size_t capacity = expected.size() / 2;
+		std::u32string partial(expected.size(), U'\0');
+		EXPECT_EQ(str.to_codepoints(&partial[0], capacity), capacity);
+		EXPECT_EQ(partial.substr(0, capacity), expected.substr(0, capacity));
+		EXPECT_EQ(partial.substr(capacity), std::u32string(expected.size() - capacity, U'\0'));
+
+		// Into an output iterator, from a view and from raw bytes
+		std::vector<char32_t> vec;
+		EXPECT_EQ(tiny_utf8::string_view(str).to_codepoints(std::back_inserter(vec)), expected.size());
+		EXPECT_EQ(std::u32string(vec.begin(), vec.end()), expected);
+
+		std::u32string raw_expected = decode_bytewise(data);
+		std::u32string raw(raw_expected.size() + 1, U'\0');
+		EXPECT_EQ(tiny_utf8::to_codepoints(data.data(), data.size(), &raw[0]), raw_expected.size());
+		EXPECT_EQ(raw.substr(0, raw_expected.size()), raw_expected);
+		EXPECT_EQ(raw_expected.size(), tiny_utf8::string_view(data.data(), data.size()).length());
+	}
+
+	// A truncated codepoint at the end of a heap string is counted once, so no more than 'length()' codepoints may be written
+	tiny_utf8::string truncated(std::string(40, 'x') + "\xF0\x9F");
+	std::u32string buffer(truncated.length() + 1, U'\0');
+	EXPECT_EQ(truncated.to_codepoints(&buffer[0]), truncated.length());
+	EXPECT_EQ(buffer.substr(0, truncated.length()), std::u32string(truncated.begin(), truncated.end()));
+	EXPECT_EQ(buffer.back(), U'\0');
+	EXPECT_EQ(tiny_utf8::string_view(truncated).to_codepoints(&buffer[0]), truncated.length());
+}
+
+TEST(TinyUTF8, Hash)
+{
+	std::hash<tiny_utf8::string> hasher;
+
+	// Hashing the buffer of sso strings yields the same value as hashing their data
+	for (std::size_t len = 0; len < 80; ++len)
+	{
+		std::string bytes;
+		for (std::size_t i = 0; i < len; ++i)
+			bytes.push_back(static_cast<char>('a' + i % 26));
+		tiny_utf8::string sso(bytes);
+		EXPECT_EQ(hasher(sso), tiny_utf8::tiny_utf8_detail::hash_bytes(reinterpret_cast<const unsigned char*>(bytes.data()), len));
+
+		// Garbage behind the data of a string does not matter
+		tiny_utf8::string erased(bytes + "XYZ");
+		erased.erase(erased.length() - 3, 3);
+		EXPECT_EQ(hasher(erased), hasher(sso));
+	}
+
+	// Embedded zeros and the length are taken into account
+	EXPECT_NE(hasher(tiny_utf8::string(std::string("a\0", 2))), hasher(tiny_utf8::string("a")));
+	EXPECT_NE(hasher(tiny_utf8::string(std::string(40, 'a'))), hasher(tiny_utf8::string(std::string(41, 'a'))));
+	EXPECT_NE(hasher(tiny_utf8::string(U"Löwe")), hasher(tiny_utf8::string(U"Lowe")));
+}
@@ -44,3 +44,80 @@ TEST(TinyUTF8, IteratorAccess)
 		++it_fwd;
 	}
 }
+
+TEST(TinyUTF8, ConstIteratorCachedByteIndex)
+{
+	// Enough multibytes for the string to not have a lookup table
+	tiny_utf8::string tmp;
+	for( int i = 0 ; i < 50 ; ++i )
+		tmp += U"aツ♫ä";
+	const tiny_utf8::string str = tmp;
+
+	EXPECT_FALSE(str.sso_active());
+	EXPECT_FALSE(str.lut_active());
+
+	// Forward
+	std::size_t index = 0;
+	for( tiny_utf8::string::const_iterator it = str.begin() ; it != str.end() ; ++it, ++index ){
+		EXPECT_EQ(static_cast<uint64_t>(*it), static_cast<uint64_t>(str.at(index)));
+		EXPECT_EQ(it.get_raw_index(), (tiny_utf8::string::difference_type)str.get_num_bytes_from_start(index));
+	}
+	EXPECT_EQ(index, str.length());
+
+	// Backward
+	for( tiny_utf8::string::const_reverse_iterator it = str.rbegin() ; it != str.rend() ; ++it )
+		EXPECT_EQ(static_cast<uint64_t>(*it), static_cast<uint64_t>(str.at(--index)));
+	EXPECT_EQ(index, 0);
+
+	// Random access and postfix operators
+	tiny_utf8::string::const_iterator it = str.begin() + 101;
+	EXPECT_EQ(static_cast<uint64_t>(*it), static_cast<uint64_t>(str.at(101)));
+	EXPECT_EQ(static_cast<uint64_t>(*it++), static_cast<uint64_t>(str.at(101)));
+	EXPECT_EQ(static_cast<uint64_t>(*it), static_cast<uint64_t>(str.at(102)));
+	it -= 90;
+	EXPECT_EQ(static_cast<uint64_t>(*it), static_cast<uint64_t>(str.at(12)));
+	it = it - 10;
+	EXPECT_EQ(static_cast<uint64_t>(*it--), static_cast<uint64_t>(str.at(2)));
+	EXPECT_EQ(static_cast<uint64_t>(*it), static_cast<uint64_t>(str.at(1)));
+	EXPECT_EQ(str.end() - it, (tiny_utf8::string::difference_type)str.length() - 1);
+
+	// Mutable iterators can still be used to modify the string in place
+	tmp.erase( std::remove( tmp.begin() , tmp.end() , U'ツ' ) , tmp.end() );
+	EXPECT_EQ(tmp.length(), 150);
+	EXPECT_EQ(tmp.find(U'ツ'), tiny_utf8::string::npos);
+	EXPECT_EQ(static_cast<uint64_t>(tmp[148]), static_cast<uint64_t>(U'♫'));
+}
+
+TEST(TinyUTF8, ConstIteratorSixAndSevenByteCodepoints)
+{
+	const char32_t six = 0x4000000; // 1111110X lead
+	const char32_t seven = 0x80000000; // 11111110 lead
+	const char32_t codepoints[] = { U'a', U'b', six, U'c', U'd', seven, U'e', six, seven, U'ツ', U'f' };
+	const std::size_t num_codepoints = sizeof(codepoints) / sizeof(codepoints[0]);
+
+	// Both layouts
+	tiny_utf8::string tmp;
+	for (char32_t cp : codepoints)
+		tmp += cp;
+	const tiny_utf8::string short_str = tiny_utf8::string(U"ab") + six + U"cd";
+	const tiny_utf8::string str = tmp + tmp + tmp;
+
+	EXPECT_EQ(short_str.size(), 10u);
+	EXPECT_EQ(static_cast<uint64_t>(*(short_str.end() - 2)), static_cast<uint64_t>(U'c'));
+	EXPECT_EQ(static_cast<uint64_t>(*(short_str.end() - 3)), static_cast<uint64_t>(six));
+	EXPECT_EQ(static_cast<uint64_t>(*short_str.rbegin()), static_cast<uint64_t>(U'd'));
+
+	ASSERT_EQ(str.length(), num_codepoints * 3);
+	std::size_t index = str.length();
+	for (tiny_utf8::string::const_reverse_iterator it = str.rbegin(); it != str.rend(); ++it) {
+		--index;
+		EXPECT_EQ(static_cast<uint64_t>(*it), static_cast<uint64_t>(codepoints[index % num_codepoints])) << index;
+	}
+	EXPECT_EQ(index, 0u);
+	tiny_utf8::string::const_iterator it = str.end();
+	for (index = str.length(); index-- > 0; ) {
+		--it;
+		EXPECT_EQ(it.get_raw_index(), (tiny_utf8::string::difference_type)str.get_num_bytes_from_start(index)) << index;
+	}
+	EXPECT_TRUE(it == str.begin());
+}
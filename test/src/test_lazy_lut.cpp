@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Built as a separate executable, since all translation units of a program have to agree on TINY_UTF8_LAZY_LUT
+#include <tinyutf8/tinyutf8.h>
+
+static std::string generate_text(std::size_t num_pieces)
+{
+	const char* pieces[] = { "Hello World ", "\xC3\xA4", "\xE3\x83\x84", "\xF0\x9F\x98\x80" };
+	std::string text;
+	for (std::size_t i = 0; i < num_pieces; i++)
+		text += pieces[i * 7 % 4];
+	return text;
+}
+
+TEST(TinyUTF8, LazyLUT_BuiltOnFirstAccess)
+{
+	std::string data = generate_text(2000);
+	std::u32string codepoints;
+	for (char32_t cp : tiny_utf8::string(data))
+		codepoints += cp;
+
+	tiny_utf8::string str(data);
+	EXPECT_FALSE(str.lut_active());
+
+	// Printing, hashing and comparing don't need the lut
+	EXPECT_EQ(str.cpp_str(), data);
+	EXPECT_EQ(std::hash<tiny_utf8::string>()(str), std::hash<tiny_utf8::string>()(tiny_utf8::string(data)));
+	EXPECT_TRUE(str == tiny_utf8::string(data));
+	EXPECT_FALSE(str.lut_active());
+
+	// Random access does
+	EXPECT_EQ(str[1234], codepoints[1234]);
+	EXPECT_TRUE(str.lut_active());
+	EXPECT_EQ(str.length(), codepoints.size());
+	for (std::size_t i = 0; i < codepoints.size(); i += 97)
+		EXPECT_EQ(str[i], codepoints[i]) << i;
+	EXPECT_EQ(str.get_num_codepoints(0, str.size()), codepoints.size());
+	EXPECT_EQ(str.get_num_bytes(0, codepoints.size()), data.size());
+
+	// Strings whose lut isn't worth it stay without one
+	std::string cjk;
+	for (int i = 0; i < 2000; i++)
+		cjk += "\xE3\x83\x84";
+	tiny_utf8::string dense(cjk);
+	EXPECT_FALSE(dense.lut_active());
+	EXPECT_EQ(dense[1500], U'ツ');
+	EXPECT_FALSE(dense.lut_active());
+	EXPECT_EQ(dense.get_num_bytes_from_start(1500), 4500u);
+	EXPECT_EQ(dense.length(), 2000u);
+}
+
+TEST(TinyUTF8, LazyLUT_CopyAndModify)
+{
+	std::string data = generate_text(3000);
+	tiny_utf8::string eager(data);
+	eager[0]; // Builds the lut
+
+	// Copies of deferred strings are deferred as well
+	tiny_utf8::string deferred(data);
+	tiny_utf8::string copy(deferred);
+	EXPECT_FALSE(copy.lut_active());
+	tiny_utf8::string assigned;
+	assigned = deferred;
+	EXPECT_FALSE(assigned.lut_active());
+	tiny_utf8::string same_size(generate_text(3000));
+	same_size = deferred;
+	EXPECT_EQ(same_size[2999], eager[2999]);
+	EXPECT_EQ(copy[2222], eager[2222]);
+	EXPECT_EQ(assigned.length(), eager.length());
+
+	// Copies of built luts take them over
+	tiny_utf8::string built_copy(eager);
+	EXPECT_TRUE(built_copy.lut_active());
+	EXPECT_EQ(built_copy[2999], eager[2999]);
+
+	// Modifying a deferred string rebuilds the lut from the modified data
+	tiny_utf8::string modified(data);
+	modified.raw_replace(0, 12, "\xE3\x83\x84\xE3\x83\x84\xE3\x83\x84\xE3\x83\x84");
+	eager.raw_replace(0, 12, "\xE3\x83\x84\xE3\x83\x84\xE3\x83\x84\xE3\x83\x84");
+	modified.append(U"ツ and the end");
+	eager.append(U"ツ and the end");
+	modified.erase(100, 50);
+	eager.erase(100, 50);
+	ASSERT_EQ(modified, eager);
+	for (std::size_t i = 0; i < eager.length(); i += 13)
+		EXPECT_EQ(modified[i], eager[i]) << i;
+	EXPECT_EQ(modified.get_num_codepoints(100, 5000), eager.get_num_codepoints(100, 5000));
+}
+
+TEST(TinyUTF8, LazyLUT_ConcurrentReaders)
+{
+	std::string data = generate_text(20000);
+	tiny_utf8::string eager(data);
+	std::vector<char32_t> expected;
+	for (std::size_t i = 0; i < eager.length(); i += 101)
+		expected.push_back(eager[i]);
+
+	for (int round = 0; round < 20; round++) {
+		const tiny_utf8::string shared(data);
+		std::vector<std::thread> threads;
+		std::vector<int> mismatches(4, 0);
+		for (int t = 0; t < 4; t++)
+			threads.emplace_back([&shared, &eager, &expected, &mismatches, t]() {
+				for (std::size_t i = 0; i < expected.size(); i++) {
+					std::size_t j = (i + t * expected.size() / 4) % expected.size(); // Each thread starts elsewhere
+					mismatches[t] += shared[j * 101] != expected[j];
+					mismatches[t] += shared.get_num_bytes_from_start(j * 101) != eager.get_num_bytes_from_start(j * 101);
+				}
+				mismatches[t] += shared.length() != eager.length();
+			});
+		for (std::thread& thread : threads)
+			thread.join();
+		for (int t = 0; t < 4; t++)
+			EXPECT_EQ(mismatches[t], 0) << round << " " << t;
+		EXPECT_TRUE(shared.lut_active());
+	}
+}
@@ -1,6 +1,7 @@
 ﻿#include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cstring>
 #include <string>
 
 #include <tinyutf8/tinyutf8.h>
@@ -86,6 +87,32 @@ TEST(TinyUTF8, AppendAndShrinkString)
 	EXPECT_TRUE(str.lut_active());
 }
 
+TEST(TinyUTF8, ShrinkStringWithoutLUT)
+{
+	// Too many multibytes for a lut: The new buffer of shrink_to_fit needs an indicator of its own
+	std::u32string		reference;
+	for (std::size_t i = 0; i < 2000; ++i)
+		reference.push_back(U"日本語のテキストa"[i % 9]);
+	tiny_utf8::string	str(reference.c_str());
+	str.append(std::u32string(3000, U'ツ').c_str());
+	str.erase(reference.length(), 3000);
+	ASSERT_FALSE(str.lut_active());
+
+	std::size_t capacity = str.capacity();
+	str.shrink_to_fit();
+	EXPECT_LT(str.capacity(), capacity);
+	EXPECT_FALSE(str.lut_active());
+	EXPECT_FALSE(str.trusted());
+	ASSERT_EQ(str.length(), reference.length());
+	for (std::size_t i = 0; i < reference.length(); i += 7)
+		EXPECT_EQ(str[i], reference[i]) << i;
+
+	str.append(U"more ツ");
+	reference.append(U"more ツ");
+	EXPECT_EQ(str, tiny_utf8::string(reference.c_str()));
+	EXPECT_EQ(str.back(), U'ツ');
+}
+
 TEST(TinyUTF8, EraseString)
 {
 	tiny_utf8::string str = U"Hello ツ World ♫";
@@ -179,3 +206,250 @@ TEST(TinyUTF8, ReplaceString)
 	EXPECT_EQ(str.length(), 15);
 	EXPECT_TRUE(str.requires_unicode());
 }
+
+// Applies the same edits to a large string and its reference, checking random access and index conversions after each of them
+static void manipulate_large_string(std::u32string reference, const char32_t* replacement)
+{
+	tiny_utf8::string	str(reference.c_str());
+
+	auto check = [&]() {
+		ASSERT_EQ(str.length(), reference.length());
+		for (std::size_t i = 0; i < reference.length(); i += 13)
+		{
+			EXPECT_EQ(str[i], reference[i]);
+
+			// Convert between codepoint and byte ranges [i, j)
+			std::size_t j = i + (reference.length() - i) / 2;
+			std::size_t begin = str.get_num_bytes_from_start(i);
+			std::size_t end = str.get_num_bytes_from_start(j);
+			EXPECT_EQ(str.get_num_codepoints(begin, end - begin), j - i);
+			EXPECT_EQ(str.get_num_bytes(begin, j - i), end - begin);
+		}
+		EXPECT_EQ(str.substr(1500, 700), tiny_utf8::string(reference.substr(1500, 700).c_str()));
+	};
+	check();
+
+	str.append(U"ツ♫ääää");
+	reference.append(U"ツ♫ääää");
+	check();
+
+	str.insert(100, U"😄😄😄");
+	reference.insert(100, U"😄😄😄");
+	check();
+
+	str.erase(1000, 300);
+	reference.erase(1000, 300);
+	check();
+
+	str.replace(200, 30, replacement);
+	reference.replace(200, 30, replacement);
+	check();
+
+	tiny_utf8::string copy = str;
+	str = tiny_utf8::string(std::string(4000, 'x'));
+	str = copy;
+	check();
+
+	str.shrink_to_fit();
+	check();
+}
+
+TEST(TinyUTF8, ManipulateLargeLUTString)
+{
+	// Build a string large enough to have a lut together with its jump table
+	std::u32string		reference;
+	for (std::size_t i = 0; i < 3000; ++i)
+		reference.push_back(i % 7 ? U'a' + i % 26 : U"äツ♫😄"[i % 4]);
+	EXPECT_TRUE(tiny_utf8::string(reference.c_str()).lut_active());
+
+	// Replace ASCII by multibytes in-place: The data shrinks, while the lut grows
+	manipulate_large_string(reference, U"ツツツツ");
+}
+
+TEST(TinyUTF8, ReplaceSmallString)
+{
+	tiny_utf8::string str(U"Hello World ツ abcdefgh");
+
+	str.replace(1, 9, U"12345678");
+	EXPECT_EQ(str, tiny_utf8::string(U"H12345678d ツ abcdefgh"));
+	EXPECT_TRUE(str.sso_active());
+
+	str.replace(1, 8, U"1234567890");
+	EXPECT_EQ(str, tiny_utf8::string(U"H1234567890d ツ abcdefgh"));
+	EXPECT_TRUE(str.sso_active());
+}
+
+TEST(TinyUTF8, EraseSmallString)
+{
+	// Only the bytes behind the erased part (including the trailing '\0') may be moved
+	tiny_utf8::string str(U"Hello World ツ abcdefgh");
+	ASSERT_TRUE(str.sso_active());
+
+	str.erase(1, 9);
+	EXPECT_EQ(str, tiny_utf8::string(U"Hd ツ abcdefgh"));
+	EXPECT_EQ(str.size(), std::strlen(str.c_str()));
+	str.raw_erase(str.size() - 3, 3);
+	EXPECT_EQ(str, tiny_utf8::string(U"Hd ツ abcde"));
+	EXPECT_EQ(str.size(), std::strlen(str.c_str()));
+	str.erase(3, 1);
+	EXPECT_EQ(str, tiny_utf8::string(U"Hd  abcde"));
+	EXPECT_FALSE(str.requires_unicode());
+	EXPECT_TRUE(str.sso_active());
+}
+
+TEST(TinyUTF8, ReplaceInPlace_ShrinkingDataGrowingLUT)
+{
+	// Replacing ASCII by fewer bytes of multibytes fits into the buffer, but adds lut entries behind the data
+	std::u32string		reference;
+	for (std::size_t i = 0; i < 600; ++i)
+		reference.push_back(i % 20 ? U'a' + i % 26 : U'ä');
+	tiny_utf8::string	str(reference.c_str());
+	ASSERT_TRUE(str.lut_active());
+
+	for (std::size_t pos = 10; pos < 400; pos += 97)
+	{
+		const char* buffer = str.data();
+		str.replace(pos, 16, U"ツツツツ");
+		reference.replace(pos, 16, U"ツツツツ");
+		EXPECT_EQ(str.data(), buffer); // In place
+		ASSERT_EQ(str.length(), reference.length());
+		for (std::size_t i = 0; i < reference.length(); ++i)
+			EXPECT_EQ(str[i], reference[i]) << i;
+	}
+	EXPECT_TRUE(str.lut_active());
+	EXPECT_EQ(str, tiny_utf8::string(reference.c_str()));
+}
+
+TEST(TinyUTF8, ManipulateLargeMultibyteString)
+{
+	// Build a string with too many multibytes for a lut, large enough to be indexed by chunks
+	std::u32string		reference;
+	for (std::size_t i = 0; i < 3000; ++i)
+		reference.push_back(i % 5 ? U"日本語のテキスト"[i % 8] : U'a' + i % 26);
+	EXPECT_FALSE(tiny_utf8::string(reference.c_str()).lut_active());
+
+	manipulate_large_string(reference, U"abc");
+}
+
+TEST(TinyUTF8, BuildDocumentIncrementally)
+{
+	// Mostly ASCII fragments keep a lut, mostly CJK fragments don't
+	const char32_t* fragments[2][3] = {
+		{ U"Some text ", U"with ツ ", U"and ♫ in it. " },
+		{ U"日本語の", U"テキスト", U"です。a" }
+	};
+	for (std::size_t idx = 0; idx < 2; ++idx)
+	{
+		const char32_t**	fragment = fragments[idx];
+		std::u32string		reference;
+		tiny_utf8::string	str;
+		for (std::size_t i = 0; i < 2000; ++i)
+		{
+			str += fragment[i % 3];
+			reference += fragment[i % 3];
+
+			// Edit in the middle every now and then
+			if (i % 250 == 249)
+			{
+				std::size_t pos = reference.length() / 3;
+				str.insert(pos, U"ä😄");
+				reference.insert(pos, U"ä😄");
+				str.erase(pos / 2, 5);
+				reference.erase(pos / 2, 5);
+				str.replace(pos * 2, 3, U"xツ");
+				reference.replace(pos * 2, 3, U"xツ");
+			}
+		}
+		EXPECT_EQ(str.lut_active(), idx == 0);
+		ASSERT_EQ(str.length(), reference.length());
+		EXPECT_EQ(str, tiny_utf8::string(reference.c_str()));
+		for (std::size_t i = 0; i < reference.length(); i += 7)
+			EXPECT_EQ(str[i], reference[i]);
+	}
+}
+
+TEST(TinyUTF8, PushBackIndexedString)
+{
+	// Appending only updates the last entries of the jump table: Check it while the string grows (with and without a lut)
+	const char32_t* codepoints[2] = { U"abcdefghijklmnopqrsä", U"日本語のテキストa" };
+	for (std::size_t idx = 0; idx < 2; ++idx)
+	{
+		std::u32string		reference;
+		tiny_utf8::string	str;
+		for (std::size_t i = 0; i < 6000; ++i)
+		{
+			char32_t cp = codepoints[idx][i % std::char_traits<char32_t>::length(codepoints[idx])];
+			str.push_back(cp);
+			reference.push_back(cp);
+			if (i % 499 == 0)
+			{
+				ASSERT_EQ(str.length(), reference.length());
+				for (std::size_t j = 0; j < reference.length(); j += 37)
+					EXPECT_EQ(str[j], reference[j]) << i << ' ' << j;
+				EXPECT_EQ(str.back(), cp);
+			}
+		}
+		EXPECT_EQ(str.lut_active(), idx == 0);
+		EXPECT_EQ(str, tiny_utf8::string(reference.c_str()));
+	}
+}
+
+TEST(TinyUTF8, ReuseBufferWithWiderLUT)
+{
+	// Buffers above 64KiB have wider lut entries than the size of their data and lut alone suggests
+	std::u32string		reference = std::u32string(62500, U'a') + std::u32string(800, U'ä');
+	tiny_utf8::string	str(reference.c_str());
+	ASSERT_TRUE(str.lut_active());
+
+	// Reuse the buffer for less data, whose lut would fit into a smaller buffer with narrower lut entries
+	str.erase(0, 30000);
+	reference.erase(0, 30000);
+	str.append(std::u32string(5300, U'ä').c_str());
+	reference.append(5300, U'ä');
+	str.insert(100, std::u32string(100, U'ツ').c_str());
+	reference.insert(100, 100, U'ツ');
+	str.replace(200, 10, std::u32string(100, U'ツ').c_str());
+	reference.replace(200, 10, 100, U'ツ');
+
+	ASSERT_EQ(str.length(), reference.length());
+	EXPECT_EQ(str, tiny_utf8::string(reference.c_str()));
+	for (std::size_t i = 0; i < reference.length(); i += 101)
+		EXPECT_EQ(str[i], reference[i]);
+}
+
+TEST(TinyUTF8, ReplaceAll)
+{
+	tiny_utf8::string str(U"ツ a ツツ b ツ");
+	str.replace_all(U"ツ", U"♫♫");
+	EXPECT_EQ(str, tiny_utf8::string(U"♫♫ a ♫♫♫♫ b ♫♫"));
+
+	// Non-overlapping occurences from left to right, empty patterns match nothing
+	str = U"aaaaa";
+	str.replace_all(U"aa", U"b");
+	EXPECT_EQ(str, tiny_utf8::string(U"bba"));
+	str.replace_all(U"", U"x");
+	EXPECT_EQ(str, tiny_utf8::string(U"bba"));
+	str.replace_all(U"c", U"x");
+	EXPECT_EQ(str, tiny_utf8::string(U"bba"));
+
+	// Escape a large text with several patterns at once: The lut of the result is built once
+	std::u32string		reference;
+	std::u32string		escaped;
+	for (std::size_t i = 0; i < 500; ++i)
+	{
+		reference += U"<ä href=\"ツ\">&</ä>";
+		escaped += U"&lt;ä href=&quot;ツ&quot;&gt;&amp;&lt;/ä&gt;";
+	}
+	str = tiny_utf8::string(reference.c_str());
+	str.replace_all({ { "&", "&amp;" }, { "<", "&lt;" }, { ">", "&gt;" }, { "\"", "&quot;" } });
+	EXPECT_TRUE(str.lut_active());
+	ASSERT_EQ(str.length(), escaped.length());
+	EXPECT_EQ(str, tiny_utf8::string(escaped.c_str()));
+	for (std::size_t i = 0; i < escaped.length(); i += 7)
+		EXPECT_EQ(str[i], escaped[i]);
+
+	// The pattern listed first wins, replacements are not scanned again
+	str = U"abcabc";
+	str.replace_all({ { U"ab", U"b" }, { U"abc", U"x" }, { U"b", U"ab" } });
+	EXPECT_EQ(str, tiny_utf8::string(U"bcbc"));
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tinyutf8/mapped_string.h>
+
+static void write_file(const char* path, const std::string& data)
+{
+	std::FILE* file = std::fopen(path, "wb");
+	ASSERT_NE(file, nullptr);
+	ASSERT_EQ(std::fwrite(data.data(), 1, data.size(), file), data.size());
+	std::fclose(file);
+}
+
+// Mixes all codepoint widths (and optionally some malformed bytes), so that codepoints span the boundaries of index chunks
+static std::string generate_data(std::size_t num_pieces, bool malformed)
+{
+	const std::vector<std::string> pieces = {
+		"a", "Hello World ", "\xC3\xA4", "\xE3\x83\x84", "\xE2\x99\xAB", "\xF0\x9F\x98\x80", "\n", "\x80", "\xFF"
+	};
+	std::mt19937 rng(7);
+	std::string data;
+	for (std::size_t i = 0; i < num_pieces; i++)
+		data += pieces[rng() % 64 || !malformed ? rng() % 7 : 7 + rng() % 2];
+	return data;
+}
+
+TEST(TinyUTF8, MappedString_Access)
+{
+	const char* path = "tinyutf8_mapped_string_access.txt";
+	std::string data = generate_data(60000, true);
+	write_file(path, data);
+
+	tiny_utf8::string expected(data);
+	tiny_utf8::mapped_string str(path);
+	ASSERT_TRUE(str.is_open());
+	EXPECT_EQ(str.size(), data.size());
+	EXPECT_EQ(str, tiny_utf8::string_view(expected));
+
+	// Random accesses build the index lazily
+	std::mt19937 rng(42);
+	EXPECT_FALSE(str.index_complete());
+	for (std::size_t i = 0; i < 500; i++) {
+		std::size_t index = rng() % (expected.length() / 4);
+		EXPECT_EQ(str[index], expected[index]) << index;
+		EXPECT_EQ(str.get_num_bytes_from_start(index), expected.get_num_bytes_from_start(index)) << index;
+	}
+	EXPECT_FALSE(str.index_complete());
+
+	EXPECT_EQ(str.length(), expected.length());
+	EXPECT_TRUE(str.index_complete());
+	EXPECT_EQ(str.front(), expected.front());
+	EXPECT_EQ(str.back(), expected.back());
+	for (std::size_t i = 0; i < 500; i++) {
+		std::size_t index = rng() % expected.length();
+		std::size_t byte_index = rng() % data.size();
+		std::size_t len = rng() % 10000;
+		EXPECT_EQ(str.at(index), expected.at(index)) << index;
+		EXPECT_EQ(str.raw_at(byte_index), expected.raw_at(byte_index)) << byte_index;
+		EXPECT_EQ(str.substr(index, len), expected.substr(index, len)) << index << " " << len;
+		EXPECT_EQ(str.substr(index, len).length(), expected.substr(index, len).length()) << index << " " << len;
+		EXPECT_EQ(str.get_num_codepoints(0, expected.get_num_bytes_from_start(index)), index);
+		EXPECT_EQ(str.raw_substr(byte_index, len), expected.raw_substr(byte_index, len));
+	}
+	EXPECT_EQ(str.substr(expected.length()), tiny_utf8::string_view());
+
+	// Search
+	EXPECT_EQ(str.find(U'😀'), expected.find(U'😀'));
+	EXPECT_EQ(str.find(U'😀', 30000), expected.find(U'😀', 30000));
+	EXPECT_EQ(str.find("\xE3\x83\x84\xE2\x99\xAB", 20000), expected.find(U"ツ♫", 20000));
+	EXPECT_EQ(str.rfind(U'ä'), expected.rfind(U'ä'));
+	EXPECT_EQ(str.rfind("Hello", 40000), expected.rfind(U"Hello", 40000));
+	EXPECT_EQ(str.raw_find('\n', 1000), expected.raw_find(U'\n', 1000));
+	EXPECT_EQ(str.find(U'€'), tiny_utf8::mapped_string::npos);
+
+	// Iterators
+	EXPECT_TRUE(std::equal(str.begin(), str.end(), expected.begin()));
+	EXPECT_TRUE(std::equal(str.raw_begin(), str.raw_end(), expected.raw_begin()));
+	EXPECT_EQ(str.end() - str.begin(), (std::ptrdiff_t)expected.length());
+	EXPECT_EQ(*(str.begin() + 12345), expected[12345]);
+	EXPECT_EQ((str.raw_begin() + 20000).get_index(), (expected.raw_begin() + 20000).get_index());
+
+	str.close();
+	EXPECT_FALSE(str.is_open());
+	EXPECT_TRUE(str.empty());
+	std::remove(path);
+}
+
+TEST(TinyUTF8, MappedString_Sidecar)
+{
+	const char* path = "tinyutf8_mapped_string_sidecar.txt";
+	const char* index_path = "tinyutf8_mapped_string_sidecar.txt.idx";
+	std::string data = generate_data(40000, false);
+	write_file(path, data);
+	tiny_utf8::string expected(data);
+
+	{
+		tiny_utf8::mapped_string str(path);
+		ASSERT_TRUE(str.is_open());
+		EXPECT_FALSE(str.load_index(index_path));
+		EXPECT_EQ(str[1000], expected[1000]);
+		EXPECT_TRUE(str.save_index(index_path));
+		EXPECT_TRUE(str.index_complete());
+	}
+
+	// Warm start
+	tiny_utf8::mapped_string str(path);
+	ASSERT_TRUE(str.is_open());
+	EXPECT_FALSE(str.index_complete());
+	EXPECT_TRUE(str.load_index(index_path));
+	EXPECT_TRUE(str.index_complete());
+	EXPECT_EQ(str.length(), expected.length());
+	for (std::size_t i = 0; i < expected.length(); i += 997)
+		EXPECT_EQ(str[i], expected[i]) << i;
+	EXPECT_TRUE(std::equal(str.rbegin(), str.rend(), expected.rbegin()));
+	EXPECT_EQ(*(str.rbegin() + 5000), *(expected.rbegin() + 5000));
+
+	// Moving keeps the index
+	tiny_utf8::mapped_string moved(std::move(str));
+	EXPECT_FALSE(str.is_open());
+	EXPECT_TRUE(moved.index_complete());
+	EXPECT_EQ(moved.length(), expected.length());
+
+	// Sidecar files of other data are rejected
+	moved.close();
+	data[data.size() / 2] = 'x';
+	data += "more data";
+	write_file(path, data);
+	ASSERT_TRUE(moved.open(path));
+	EXPECT_FALSE(moved.load_index(index_path));
+	EXPECT_FALSE(moved.index_complete());
+	EXPECT_EQ(moved.length(), tiny_utf8::string(data).length());
+
+	// So are truncated ones
+	write_file(index_path, "TNYU8IDX");
+	EXPECT_FALSE(moved.load_index(index_path));
+
+	moved.close();
+	std::remove(path);
+	std::remove(index_path);
+}
+
+TEST(TinyUTF8, MappedString_Empty)
+{
+	tiny_utf8::mapped_string closed;
+	EXPECT_FALSE(closed);
+	EXPECT_FALSE(closed.open("tinyutf8_mapped_string_does_not_exist.txt"));
+	EXPECT_EQ(closed.length(), 0u);
+	EXPECT_FALSE(closed.save_index("tinyutf8_mapped_string_does_not_exist.txt.idx"));
+
+	const char* path = "tinyutf8_mapped_string_empty.txt";
+	write_file(path, "");
+	tiny_utf8::mapped_string str(std::string{path});
+	ASSERT_TRUE(str);
+	EXPECT_TRUE(str.empty());
+	EXPECT_EQ(str.length(), 0u);
+	EXPECT_TRUE(str.begin() == str.end());
+	EXPECT_EQ(str.find(U'a'), tiny_utf8::mapped_string::npos);
+	EXPECT_EQ(str.substr(0), tiny_utf8::string_view());
+	str.close();
+	std::remove(path);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <tinyutf8/tinyutf8.h>
+
+// The pmr typedefs only exist, if the standard library provides <memory_resource> (C++17)
+#if defined(__cpp_lib_memory_resource)
+
+// Memory resource counting the allocations made through it
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+	std::size_t num_allocations = 0;
+	std::size_t num_deallocations = 0;
+
+private:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		num_allocations++;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+	void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+	{
+		num_deallocations++;
+		std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+};
+
+TEST(TinyUTF8, PMR_Propagation)
+{
+	static_assert(std::is_same<tiny_utf8::pmr::string::allocator_type, std::pmr::polymorphic_allocator<char>>::value, "pmr::string has to use polymorphic allocators");
+
+	CountingResource resource;
+	CountingResource other_resource;
+	const char32_t* const text = U"This string is too long for SSO: ツ♫ ツ♫ ツ♫ ツ♫ ツ♫";
+	{
+		tiny_utf8::pmr::string short_str(U"Hello ツ", &resource);
+		tiny_utf8::pmr::string str(text, &resource);
+		EXPECT_TRUE(short_str.sso_active());
+		EXPECT_EQ(resource.num_allocations, 1u);
+		EXPECT_EQ(str.get_allocator().resource(), &resource);
+
+		// Copies obtain the default resource, unless one is supplied
+		tiny_utf8::pmr::string copy(str);
+		EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+		tiny_utf8::pmr::string other_copy(str, &other_resource);
+		EXPECT_EQ(other_copy.get_allocator().resource(), &other_resource);
+		EXPECT_EQ(other_resource.num_allocations, 1u);
+		EXPECT_EQ(other_copy, str);
+
+		// Moving keeps the resource and the buffer
+		const char* buffer = str.data();
+		tiny_utf8::pmr::string moved(std::move(str));
+		EXPECT_EQ(moved.get_allocator().resource(), &resource);
+		EXPECT_EQ(moved.data(), buffer);
+		EXPECT_EQ(resource.num_allocations, 1u);
+
+		// Assignments don't propagate the resource
+		tiny_utf8::pmr::string assigned(&other_resource);
+		assigned = moved;
+		EXPECT_EQ(assigned.get_allocator().resource(), &other_resource);
+		EXPECT_EQ(other_resource.num_allocations, 2u);
+		EXPECT_EQ(assigned, moved);
+	}
+	EXPECT_EQ(resource.num_deallocations, resource.num_allocations);
+	EXPECT_EQ(other_resource.num_deallocations, other_resource.num_allocations);
+}
+
+TEST(TinyUTF8, PMR_MoveBetweenUnequalResources)
+{
+	CountingResource resource;
+	CountingResource other_resource;
+	{
+		tiny_utf8::pmr::string str(U"This string is too long for SSO: ツ♫ ツ♫ ツ♫ ツ♫ ツ♫", &resource);
+		tiny_utf8::pmr::string expected(str, &resource);
+		tiny_utf8::pmr::string target(U"Some other string, that is long enough to not be small.", &other_resource);
+		EXPECT_EQ(resource.num_allocations, 2u);
+		EXPECT_EQ(other_resource.num_allocations, 1u);
+
+		// The data has to be copied into the resource of the target
+		target = std::move(str);
+		EXPECT_EQ(target.get_allocator().resource(), &other_resource);
+		EXPECT_EQ(target, expected);
+		EXPECT_EQ(target.length(), expected.length());
+		EXPECT_EQ(target[36], U'ツ');
+		EXPECT_EQ(other_resource.num_allocations, 2u);
+		EXPECT_EQ(other_resource.num_deallocations, 1u);
+		EXPECT_EQ(resource.num_allocations, 2u);
+
+		// Small strings don't need any memory of the target
+		tiny_utf8::pmr::string small(U"Hello ツ", &resource);
+		target = std::move(small);
+		EXPECT_EQ(target, U"Hello ツ");
+		EXPECT_TRUE(target.sso_active());
+		EXPECT_EQ(other_resource.num_allocations, 2u);
+	}
+	EXPECT_EQ(resource.num_deallocations, resource.num_allocations);
+	EXPECT_EQ(other_resource.num_deallocations, other_resource.num_allocations);
+}
+
+#endif // defined(__cpp_lib_memory_resource)
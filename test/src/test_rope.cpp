@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tinyutf8/rope.h>
+
+static std::string generate_text(std::mt19937& rng, std::size_t num_pieces)
+{
+	const std::vector<std::string> pieces = {
+		"a", "Hello World ", "\xC3\xA4", "\xE3\x83\x84", "\xE2\x99\xAB", "\xF0\x9F\x98\x80", "\n"
+	};
+	std::string text;
+	for (std::size_t i = 0; i < num_pieces; i++)
+		text += pieces[rng() % pieces.size()];
+	return text;
+}
+
+TEST(TinyUTF8, Rope_Construction)
+{
+	std::mt19937 rng(1);
+	std::string data = generate_text(rng, 5000);
+	tiny_utf8::string str(data);
+
+	tiny_utf8::rope rope(str);
+	EXPECT_EQ(rope.size(), str.size());
+	EXPECT_EQ(rope.length(), str.length());
+	EXPECT_EQ(rope.str(), str);
+	EXPECT_EQ(rope.cpp_str(), data);
+	EXPECT_TRUE(rope == tiny_utf8::string_view(str));
+	EXPECT_LT(rope.compare("zzz"), 0);
+	EXPECT_EQ(rope.compare(data.substr(0, 100).c_str()), 1);
+	EXPECT_EQ(rope.compare((data + "x").c_str()), -1);
+
+	// Strings fitting into a chunk are taken over
+	tiny_utf8::string small(U"Hello ツ, this string is moved into the rope");
+	const char* buffer = small.data();
+	tiny_utf8::rope moved(std::move(small));
+	EXPECT_EQ(moved.length(), 43u);
+	EXPECT_EQ(moved.str(), U"Hello ツ, this string is moved into the rope");
+	std::size_t num_chunks = 0;
+	moved.for_each_chunk([&](tiny_utf8::string_view chunk) { num_chunks++; EXPECT_EQ(chunk.data(), buffer); });
+	EXPECT_EQ(num_chunks, 1u);
+
+	// Copies are deep
+	tiny_utf8::rope copy(rope);
+	copy.erase(0, 1000);
+	EXPECT_EQ(rope.str(), str);
+	EXPECT_EQ(copy.str(), str.substr(1000));
+
+	tiny_utf8::rope empty;
+	EXPECT_TRUE(empty.empty());
+	EXPECT_EQ(empty.length(), 0u);
+	EXPECT_EQ(empty.str(), tiny_utf8::string());
+	EXPECT_TRUE(empty.begin() == empty.end());
+	EXPECT_TRUE(empty == "");
+}
+
+TEST(TinyUTF8, Rope_RandomEdits)
+{
+	std::mt19937 rng(2);
+	tiny_utf8::string expected(generate_text(rng, 3000));
+	tiny_utf8::rope rope(expected);
+
+	for (int i = 0; i < 3000; i++) {
+		std::size_t pos = rng() % (expected.length() + 1);
+		switch (rng() % 4) {
+		case 0: { // Typing
+			tiny_utf8::string text(generate_text(rng, 1 + rng() % 3));
+			expected.insert(pos, text);
+			rope.insert(pos, text);
+			break;
+		}
+		case 1: { // Pasting
+			tiny_utf8::string text(generate_text(rng, rng() % 800));
+			expected.insert(pos, text);
+			rope.insert(pos, text);
+			break;
+		}
+		case 2: { // Deleting
+			std::size_t len = rng() % 8 ? rng() % 4 : rng() % 3000;
+			expected.erase(pos, std::min(len, expected.length() - pos));
+			rope.erase(pos, len);
+			break;
+		}
+		default: { // Replacing
+			std::size_t len = std::min<std::size_t>(rng() % 20, expected.length() - pos);
+			tiny_utf8::string text(generate_text(rng, rng() % 10));
+			expected.replace(pos, len, text);
+			rope.replace(pos, len, text);
+			break;
+		}
+		}
+		ASSERT_EQ(rope.length(), expected.length()) << i;
+		ASSERT_EQ(rope.size(), expected.size()) << i;
+		if (!expected.empty()) {
+			std::size_t index = rng() % expected.length();
+			ASSERT_EQ(rope[index], expected[index]) << i;
+		}
+		if (i % 100 == 0) {
+			ASSERT_EQ(rope.str(), expected) << i;
+		}
+	}
+	EXPECT_EQ(rope.str(), expected);
+
+	std::size_t num_chunks = 0;
+	rope.for_each_chunk([&](tiny_utf8::string_view chunk) {
+		num_chunks++;
+		EXPECT_LE(chunk.size(), (std::size_t)tiny_utf8::rope::max_chunk_bytes);
+		EXPECT_FALSE(chunk.empty());
+	});
+	EXPECT_GE(num_chunks, expected.size() / tiny_utf8::rope::max_chunk_bytes);
+}
+
+TEST(TinyUTF8, Rope_Access)
+{
+	std::mt19937 rng(3);
+	tiny_utf8::string expected(generate_text(rng, 4000));
+	tiny_utf8::rope rope(expected);
+	for (int i = 0; i < 200; i++) {
+		std::size_t pos = rng() % expected.length();
+		expected.insert(pos, U'ツ');
+		rope.insert(pos, U'ツ');
+	}
+	rope.replace(10, U'ä');
+	expected.replace(10, U'ä');
+
+	for (int i = 0; i < 500; i++) {
+		std::size_t index = rng() % expected.length();
+		std::size_t len = std::min<std::size_t>(rng() % 3000, expected.length() - index);
+		std::size_t byte_index = expected.get_num_bytes_from_start(index);
+		EXPECT_EQ(rope.at(index), expected.at(index));
+		EXPECT_EQ(rope.raw_at(byte_index), expected.raw_at(byte_index));
+		EXPECT_EQ(rope.get_num_bytes_from_start(index), byte_index);
+		EXPECT_EQ(rope.get_num_codepoints(0, byte_index), index);
+		EXPECT_EQ(rope.get_num_bytes(byte_index, len), expected.get_num_bytes(byte_index, len));
+		EXPECT_EQ(rope.substr(index, len), expected.substr(index, len));
+	}
+	EXPECT_EQ(rope.front(), expected.front());
+	EXPECT_EQ(rope.back(), expected.back());
+	EXPECT_EQ(rope.substr(expected.length()), tiny_utf8::string());
+	EXPECT_EQ(rope.get_num_bytes(100, tiny_utf8::rope::npos), expected.size() - 100);
+
+	// Iterators
+	EXPECT_TRUE(std::equal(rope.begin(), rope.end(), expected.begin()));
+	EXPECT_TRUE(std::equal(rope.rbegin(), rope.rend(), expected.rbegin()));
+	EXPECT_TRUE(std::equal(rope.raw_begin(), rope.raw_end(), expected.raw_begin()));
+	EXPECT_TRUE(std::equal(rope.raw_rbegin(), rope.raw_rend(), expected.raw_rbegin()));
+	EXPECT_EQ(rope.end() - rope.begin(), (std::ptrdiff_t)expected.length());
+	EXPECT_EQ(*(rope.begin() + 3333), expected[3333]);
+	EXPECT_EQ(*(rope.rbegin() + 3333), *(expected.rbegin() + 3333));
+	EXPECT_EQ((rope.raw_begin() + 5000).get_index(), (expected.raw_begin() + 5000).get_index());
+	EXPECT_EQ(*(rope.end() - 1), expected.back());
+}
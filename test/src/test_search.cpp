@@ -1,5 +1,7 @@
 ﻿#include <gtest/gtest.h>
 
+#include <string>
+
 #include <tinyutf8/tinyutf8.h>
 
 TEST(TinyUTF8, FindSubstr)
@@ -35,3 +37,127 @@ TEST(TinyUTF8, StartsEndsWith)
 	EXPECT_EQ(str.starts_with(tiny_utf8::string(starts_with_positive)), true);
 	EXPECT_EQ(str.starts_with(tiny_utf8::string(starts_with_negative)), false);
 }
+
+TEST(TinyUTF8, FindPattern)
+{
+	tiny_utf8::string str = U"Hello World ツ♫ Hello ツ♫";
+
+	EXPECT_EQ(str.find(tiny_utf8::string(U"ツ♫")), 12);
+	EXPECT_EQ(str.find(tiny_utf8::string(U"ツ♫"), 13), 21);
+	EXPECT_EQ(str.find(tiny_utf8::string(U"ツ♫!")), tiny_utf8::string::npos);
+	EXPECT_EQ(str.raw_find(tiny_utf8::string(U"ツ♫")), 12);
+	EXPECT_EQ(str.raw_find("Hello", 1), 19);
+	EXPECT_EQ(str.rfind(tiny_utf8::string(U"Hello")), 15);
+	EXPECT_EQ(str.rfind(tiny_utf8::string(U"Hello"), 14), 0);
+	EXPECT_EQ(str.rfind(tiny_utf8::string(U"ツ♫")), 21);
+	EXPECT_EQ(str.raw_rfind("Hello"), 19);
+	EXPECT_EQ(str.raw_rfind("Hello", 18), 0);
+	EXPECT_EQ(str.raw_rfind("xyz"), tiny_utf8::string::npos);
+}
+
+TEST(TinyUTF8, FindPattern_EmbeddedZeros)
+{
+	tiny_utf8::string str(std::string("abc\0def\0ghi", 11));
+
+	EXPECT_EQ(str.size(), 11);
+	EXPECT_EQ(str.find(tiny_utf8::string("ghi")), 8);
+	EXPECT_EQ(str.raw_find("\0g", 0, 2), 7);
+	EXPECT_EQ(str.raw_find(tiny_utf8::string(std::string("c\0d", 3))), 2);
+	EXPECT_EQ(str.rfind("\0", tiny_utf8::string::npos, 1), 7);
+	EXPECT_EQ(str.raw_rfind("\0", 6, 1), 3);
+}
+
+TEST(TinyUTF8, FindPattern_LongNeedle)
+{
+	// Long haystack with many near-matches, so candidates pass the first/last byte filter
+	std::string haystack;
+	for (std::size_t i = 0; i < 50; ++i)
+		haystack.append("ab\xE3\x83\x84" "cdefghijklmnopqrstuvwxyz0123456789-");
+	std::string needle = "ab\xE3\x83\x84" "cdefghijklmnopqrstuvwxyz0123456789+";
+	tiny_utf8::string str(haystack);
+	tiny_utf8::string pattern(needle);
+
+	EXPECT_EQ(str.find(pattern), tiny_utf8::string::npos);
+	EXPECT_EQ(str.rfind(pattern), tiny_utf8::string::npos);
+
+	str.append(pattern);
+	str.append(tiny_utf8::string(haystack));
+	EXPECT_EQ(str.raw_find(pattern), haystack.size());
+	EXPECT_EQ(str.raw_rfind(pattern), haystack.size());
+	EXPECT_EQ(str.find(pattern), 50 * 38);
+	EXPECT_EQ(str.rfind(pattern), 50 * 38);
+	EXPECT_EQ(str.raw_rfind(pattern, haystack.size() - 1), tiny_utf8::string::npos);
+	EXPECT_EQ(str.raw_find(pattern, haystack.size() + 1), tiny_utf8::string::npos);
+}
+
+TEST(TinyUTF8, FindCodepoint_ByteSearch)
+{
+	// Delimiters within a long multibyte string
+	std::string bytes;
+	for (std::size_t i = 0; i < 100; ++i)
+		bytes.append("\xE3\x83\x84\xE3\x83\x84,");
+	tiny_utf8::string str(bytes);
+
+	EXPECT_EQ(str.raw_find(U','), 6);
+	EXPECT_EQ(str.raw_find(U',', 7), 13);
+	EXPECT_EQ(str.find(U',', 3), 5);
+	EXPECT_EQ(str.raw_find(U'ツ', 7), 7);
+	EXPECT_EQ(str.raw_rfind(U','), bytes.size() - 1);
+	EXPECT_EQ(str.raw_rfind(U',', bytes.size() - 2), bytes.size() - 8);
+	EXPECT_EQ(str.rfind(U'ツ'), 298);
+	EXPECT_EQ(str.raw_find(U'a'), tiny_utf8::string::npos);
+
+	// Bytes swallowed by a malformed lead byte are not found
+	str = tiny_utf8::string(std::string("\xE3" ",a,b"));
+	EXPECT_EQ(str.raw_find(U','), 3);
+	EXPECT_EQ(str.find(U','), 1);
+}
+
+TEST(TinyUTF8, FindFirstOf_CodepointSet)
+{
+	std::string bytes;
+	for (std::size_t i = 0; i < 20; ++i)
+		bytes.append("lorem ipsum\xE3\x83\x84;dolor\t");
+	tiny_utf8::string str(bytes);
+	tiny_utf8::codepoint_set delimiters(U" \t\r\n,;:");
+	tiny_utf8::codepoint_set with_multibyte{ U';', U'ツ' };
+
+	EXPECT_TRUE(delimiters.contains(U'\t'));
+	EXPECT_FALSE(delimiters.contains(U'ツ'));
+	EXPECT_EQ(str.find_first_of(delimiters), 5);
+	EXPECT_EQ(str.find_first_of(U" \t\r\n,;:", 6), 12);
+	EXPECT_EQ(str.raw_find_first_of(delimiters, 6), 14);
+	EXPECT_EQ(str.raw_find_first_of(with_multibyte), 11);
+	EXPECT_EQ(str.find_first_not_of(U"lorem "), 6);
+	EXPECT_EQ(str.raw_find_first_not_of(tiny_utf8::codepoint_set(U"lorem ipsu")), 11);
+	EXPECT_EQ(str.find_last_of(with_multibyte), str.length() - 7);
+	EXPECT_EQ(str.raw_find_last_of(U"\t", bytes.size() - 2), bytes.size() - 22);
+	EXPECT_EQ(str.find_last_not_of(U"dolr\t"), str.length() - 7);
+	EXPECT_EQ(str.raw_find_last_not_of(delimiters), bytes.size() - 2);
+	EXPECT_EQ(str.find_first_of(U"xyz"), tiny_utf8::string::npos);
+
+	// Copies keep their own members
+	tiny_utf8::codepoint_set copy = with_multibyte;
+	with_multibyte = delimiters;
+	EXPECT_TRUE(copy.contains(U'ツ'));
+	EXPECT_FALSE(with_multibyte.contains(U'ツ'));
+}
+
+TEST(TinyUTF8, FindFirstOf_NonASCIIString)
+{
+	tiny_utf8::string str(U"abc ä ö ü ß ツ ♫ 😀 end");
+
+	// Few non-ASCII members (with duplicates) are sorted for the search, more of them are searched linearly
+	const char32_t* few = U"😀ツäツ";
+	const char32_t* many = U"αβγδεζηθικλμνξοπρστυφχψω♫";
+	EXPECT_EQ(str.find_first_of(few), 4);
+	EXPECT_EQ(str.find_last_of(few), 16);
+	EXPECT_EQ(str.find_first_not_of(U"abc äöü"), 10);
+	EXPECT_EQ(str.find_first_of(many), 14);
+	EXPECT_EQ(str.raw_find_first_of(many), tiny_utf8::string(U"abc ä ö ü ß ツ ").size());
+	EXPECT_EQ(str.find_first_of(U"αβγδεζηθικλμνξοπρστυφχψω"), tiny_utf8::string::npos);
+	for (std::size_t i = 0; i < str.length(); ++i) {
+		EXPECT_EQ(str.find_first_of(few, i), str.find_first_of(tiny_utf8::codepoint_set(few), i));
+		EXPECT_EQ(str.find_first_of(many, i), str.find_first_of(tiny_utf8::codepoint_set(many), i));
+	}
+}
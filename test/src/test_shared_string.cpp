@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <tinyutf8/shared_string.h>
+
+TEST(TinyUTF8, SharedString_Copy)
+{
+	tiny_utf8::string original(U"This string is long enough to live on the heap: ツ♫😀 ä and some more text");
+	const char* buffer = original.data();
+	tiny_utf8::shared_string str(std::move(original));
+	EXPECT_EQ(str.data(), buffer); // Taken over without copying
+	EXPECT_EQ(str.use_count(), 1u);
+
+	tiny_utf8::shared_string copy(str);
+	tiny_utf8::shared_string assigned;
+	assigned = copy;
+	EXPECT_EQ(str.use_count(), 3u);
+	EXPECT_EQ(copy.data(), buffer);
+	EXPECT_EQ(assigned.c_str(), buffer);
+	EXPECT_EQ(copy.length(), str.length());
+	EXPECT_EQ(copy[48], U'ツ');
+	EXPECT_EQ(copy.at(50), U'😀');
+	EXPECT_EQ(copy.find(U'ä'), 52u);
+	EXPECT_EQ(copy.substr(48, 3), U"ツ♫😀");
+	EXPECT_TRUE(copy == str);
+	EXPECT_TRUE(copy == U"This string is long enough to live on the heap: ツ♫😀 ä and some more text");
+	EXPECT_EQ(*copy, str.get());
+	EXPECT_EQ(std::hash<tiny_utf8::shared_string>()(copy), std::hash<tiny_utf8::string>()(str.get()));
+	EXPECT_EQ(copy.use_count(), 3u); // None of the above detached
+
+	// Modifying detaches
+	copy.append(U" ✓");
+	EXPECT_NE(copy.data(), buffer);
+	EXPECT_EQ(copy.use_count(), 1u);
+	EXPECT_EQ(str.use_count(), 2u);
+	EXPECT_EQ(copy.length(), str.length() + 2);
+	EXPECT_EQ(copy.back(), U'✓');
+	EXPECT_EQ(str.data(), buffer);
+	EXPECT_EQ(assigned.back(), U't');
+
+	// Unique strings are modified in place
+	copy.erase(0, 5);
+	copy.insert(0, U"That ");
+	copy.replace(0, 4, U"Th¡s");
+	copy.push_back(U'!');
+	copy += "?";
+	EXPECT_EQ(copy.use_count(), 1u);
+	EXPECT_EQ(copy.cpp_str(), "Th\xC2\xA1s string is long enough to live on the heap: \xE3\x83\x84\xE2\x99\xAB\xF0\x9F\x98\x80 \xC3\xA4 and some more text \xE2\x9C\x93!?");
+
+	// Moving keeps the buffer
+	tiny_utf8::shared_string moved(std::move(assigned));
+	EXPECT_EQ(moved.data(), buffer);
+	EXPECT_EQ(str.use_count(), 2u);
+	moved.clear();
+	EXPECT_TRUE(moved.empty());
+	EXPECT_EQ(str.use_count(), 1u);
+	EXPECT_EQ(str.data(), buffer);
+}
+
+TEST(TinyUTF8, SharedString_Small)
+{
+	// Small strings are held inline
+	tiny_utf8::shared_string str("Hello ツ");
+	tiny_utf8::shared_string copy(str);
+	EXPECT_TRUE(copy->sso_active());
+	EXPECT_EQ(copy.use_count(), 1u);
+	EXPECT_NE(copy.data(), str.data());
+	EXPECT_EQ(copy, str);
+	copy.mutate()[6] = U'♫';
+	EXPECT_EQ(copy.get(), U"Hello ♫");
+	EXPECT_EQ(str.get(), U"Hello ツ");
+
+	tiny_utf8::shared_string empty;
+	EXPECT_TRUE(empty.empty());
+	EXPECT_EQ(empty.length(), 0u);
+	EXPECT_TRUE(empty.begin() == empty.end());
+	EXPECT_TRUE(empty < str);
+}
+
+TEST(TinyUTF8, SharedString_Grown)
+{
+	// A small string, that outgrows the sso buffer, is shared by its copies from then on
+	tiny_utf8::shared_string str("Hello ツ");
+	str.append(U" - this string is now long enough to live on the heap!");
+	EXPECT_FALSE(str->sso_active());
+	tiny_utf8::shared_string copy(str);
+	EXPECT_EQ(copy.data(), str.data());
+	EXPECT_EQ(str.use_count(), 2u);
+	EXPECT_EQ(copy.get(), U"Hello ツ - this string is now long enough to live on the heap!");
+
+	// Through 'mutate', that happens with the next modification
+	tiny_utf8::shared_string other("Hello ツ");
+	other.mutate().append(U" - this string is now long enough to live on the heap!");
+	other.mutate();
+	tiny_utf8::shared_string other_copy(other);
+	EXPECT_EQ(other_copy.data(), other.data());
+	EXPECT_EQ(other.use_count(), 2u);
+	EXPECT_EQ(other_copy, copy);
+}
+
+TEST(TinyUTF8, SharedString_Threads)
+{
+	tiny_utf8::shared_string str(tiny_utf8::string(1000, U'ツ'));
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; i++) {
+		threads.emplace_back([str]() {
+			std::vector<tiny_utf8::shared_string> copies(1000, str);
+			for (tiny_utf8::shared_string& copy : copies)
+				EXPECT_EQ(copy.data(), str.data());
+			copies[0].push_back(U'!');
+			EXPECT_EQ(copies[0].length(), 1001u);
+		});
+	}
+	for (std::thread& thread : threads)
+		thread.join();
+	EXPECT_EQ(str.use_count(), 1u);
+	EXPECT_EQ(str.length(), 1000u);
+}
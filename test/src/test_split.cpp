@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <tinyutf8/tinyutf8.h>
+
+template<typename Range>
+static std::vector<std::string> tokens(const Range& range)
+{
+	std::vector<std::string> result;
+	for (tiny_utf8::string_view token : range)
+		result.push_back(token.cpp_str());
+	return result;
+}
+
+TEST(TinyUTF8, Split_Delimiters)
+{
+	tiny_utf8::string str(U"name;ツ;;straße;♫ and some more text, so the string is not small;");
+
+	// By codepoint
+	std::vector<std::string> expected = { "name", "ツ", "", "straße", "♫ and some more text, so the string is not small", "" };
+	EXPECT_EQ(tokens(str.split(U';')), expected);
+
+	// By pattern
+	tiny_utf8::string csv(U"a→→b→c→→→→");
+	EXPECT_EQ(tokens(csv.split("→→")), (std::vector<std::string>{ "a", "b→c", "", "" }));
+	EXPECT_EQ(tokens(csv.split(U'→')), (std::vector<std::string>{ "a", "", "b", "c", "", "", "", "" }));
+	EXPECT_EQ(tokens(csv.split("")), std::vector<std::string>{ csv.cpp_str() });
+
+	// By any codepoint of a set
+	tiny_utf8::string words(U"one two\tthree,ツ four♫five");
+	std::vector<std::string> expected_words = { "one", "two", "three", "ツ", "four", "five" };
+	EXPECT_EQ(tokens(words.split_any(U" \t,♫")), expected_words);
+	tiny_utf8::codepoint_set set(U"♫, \t");
+	EXPECT_EQ(tokens(words.split_any(set)), expected_words);
+	EXPECT_EQ(tokens(words.split_any(U" ")), (std::vector<std::string>{ "one", "two\tthree,ツ", "four♫five" }));
+
+	// Edge cases
+	EXPECT_EQ(tokens(tiny_utf8::string().split(U',')), std::vector<std::string>{ "" });
+	EXPECT_EQ(tokens(tiny_utf8::string(U",").split(U',')), (std::vector<std::string>{ "", "" }));
+	EXPECT_EQ(tokens(tiny_utf8::string(U"no delimiter").split(U',')), std::vector<std::string>{ "no delimiter" });
+
+	// Views can be split as well
+	tiny_utf8::string_view view = str.substr_view(5, 9);
+	EXPECT_EQ(tokens(view.split(U';')), (std::vector<std::string>{ "ツ", "", "straße" }));
+	EXPECT_EQ(tokens(view.split_any(U"ß;")), (std::vector<std::string>{ "ツ", "", "stra", "e" }));
+}
+
+TEST(TinyUTF8, Split_Iterators)
+{
+	tiny_utf8::string str(U"ä\tbb\tツツツ\t\t😀end of line, which is long enough");
+	tiny_utf8::split_range range = str.split(U'\t');
+	EXPECT_EQ(range.source().data(), str.data());
+
+	// Tokens are views into the string, whose byte and codepoint offsets are known
+	std::vector<std::size_t> raw_indices, indices;
+	for (tiny_utf8::split_range::iterator it = range.begin(); it != range.end(); ++it) {
+		EXPECT_EQ((*it).data(), str.data() + it.raw_index());
+		raw_indices.push_back(it.raw_index());
+		if (it.raw_index() % 2 == 0) // Codepoint offsets are counted only when asked for
+			indices.push_back(it.index());
+	}
+	EXPECT_EQ(raw_indices, (std::vector<std::size_t>{ 0, 3, 6, 16, 17 }));
+	EXPECT_EQ(indices, (std::vector<std::size_t>{ 0, 5, 9 }));
+
+	tiny_utf8::split_range::iterator it = range.begin();
+	tiny_utf8::split_range::iterator copy = it++;
+	EXPECT_EQ(*copy, tiny_utf8::string_view("ä"));
+	EXPECT_EQ(*it, tiny_utf8::string_view("bb"));
+	EXPECT_EQ(it.index(), 2u);
+	EXPECT_EQ(copy.index(), 0u);
+	EXPECT_TRUE(copy != it);
+	EXPECT_TRUE(++copy == it);
+	EXPECT_EQ(range.end().index(), tiny_utf8::split_range::npos);
+
+	// Delimiters within malformed data are found exactly like raw_find does (never inside of a multibyte)
+	tiny_utf8::string malformed("a\xE3\x83,b\xF0\x9F\x98\x80,c");
+	EXPECT_EQ(tokens(malformed.split(U',')), (std::vector<std::string>{ "a\xE3\x83,b\xF0\x9F\x98\x80", "c" }));
+	EXPECT_EQ((*malformed.split(U',').begin()).size(), malformed.raw_find(U','));
+	EXPECT_EQ(tokens(malformed.split(U'😀')), (std::vector<std::string>{ "a\xE3\x83,b", ",c" }));
+}
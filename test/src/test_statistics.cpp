@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+// Built as a separate executable, since all translation units of a program have to agree on TINY_UTF8_STATS
+#include <tinyutf8/tinyutf8.h>
+
+TEST(TinyUTF8, Statistics_CountHotPathEvents)
+{
+	tiny_utf8::reset_statistics();
+	{
+		tiny_utf8::string str(U"This string is too long for SSO: ツ♫");
+		EXPECT_FALSE(str.sso_active());
+		EXPECT_TRUE(str.lut_active());
+	}
+	tiny_utf8::statistics stats = tiny_utf8::get_statistics();
+	EXPECT_EQ(stats.allocations, 1);
+	EXPECT_EQ(stats.deallocations, 1);
+	EXPECT_EQ(stats.lut_builds, 1);
+	EXPECT_EQ(stats.lut_drops, 0);
+
+	// SSO <-> heap transitions
+	tiny_utf8::reset_statistics();
+	tiny_utf8::string str(U"Hello ツ");
+	str += U" and some more text that does not fit into the SSO buffer";
+	str.erase(7, str.length() - 7);
+	EXPECT_TRUE(str.sso_active());
+	stats = tiny_utf8::get_statistics();
+	EXPECT_EQ(stats.sso_to_heap, 1);
+	EXPECT_EQ(stats.heap_to_sso, 1);
+	EXPECT_EQ(stats.allocations, stats.deallocations);
+
+	// Growing a string with a lut eventually needs wider lut entries
+	tiny_utf8::reset_statistics();
+	tiny_utf8::string grown(U"This string is too long for SSO: ツ♫");
+	for (int i = 0; i < 20; i++)
+		grown += U"ツ and some ASCII text ";
+	stats = tiny_utf8::get_statistics();
+	EXPECT_TRUE(grown.lut_active());
+	EXPECT_GT(stats.reallocations, 0);
+	EXPECT_GT(stats.lut_width_changes, 0);
+	EXPECT_EQ(stats.linear_scans, 0);
+
+	// Strings consisting of multibytes only don't get a lut and need linear scans for random access
+	tiny_utf8::reset_statistics();
+	std::u32string multibytes(40, U'ツ');
+	tiny_utf8::string no_lut(multibytes.data(), multibytes.size());
+	EXPECT_FALSE(no_lut.lut_active());
+	EXPECT_EQ(no_lut[20], U'ツ');
+	stats = tiny_utf8::get_statistics();
+	EXPECT_EQ(stats.lut_drops, 1);
+	EXPECT_EQ(stats.linear_scans, 1);
+
+	// ASCII-only strings don't need any scan
+	tiny_utf8::reset_statistics();
+	tiny_utf8::string ascii(std::string(100, 'a'));
+	EXPECT_EQ(ascii[50], U'a');
+	EXPECT_EQ(tiny_utf8::get_statistics().linear_scans, 0);
+}
+
+TEST(TinyUTF8, Statistics_ThreadLocal)
+{
+	tiny_utf8::reset_statistics();
+	tiny_utf8::string str(U"This string is too long for SSO: ツ♫");
+
+	std::size_t other_thread_allocations = 0;
+	std::thread thread([&other_thread_allocations]() {
+		tiny_utf8::string other(U"Another string that is too long for SSO: ツ♫");
+		tiny_utf8::string copy(other);
+		other_thread_allocations = tiny_utf8::get_statistics().allocations;
+	});
+	thread.join();
+
+	EXPECT_EQ(other_thread_allocations, 2);
+	EXPECT_EQ(tiny_utf8::get_statistics().allocations, 1);
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tinyutf8/tinyutf8.h>
+
+// Straightforward RFC 3629 validator to compare against
+static bool reference_is_valid_utf8(const std::string& str)
+{
+	std::size_t i = 0;
+	while (i < str.size())
+	{
+		unsigned char lead = static_cast<unsigned char>(str[i]);
+		std::size_t len;
+		uint32_t cp;
+		if (lead < 0x80) { i++; continue; }
+		else if (lead >= 0xC2 && lead <= 0xDF) { len = 2; cp = lead & 0x1F; }
+		else if (lead >= 0xE0 && lead <= 0xEF) { len = 3; cp = lead & 0x0F; }
+		else if (lead >= 0xF0 && lead <= 0xF4) { len = 4; cp = lead & 0x07; }
+		else return false;
+		if (i + len > str.size())
+			return false;
+		for (std::size_t j = 1; j < len; j++) {
+			unsigned char c = static_cast<unsigned char>(str[i + j]);
+			if ((c & 0xC0) != 0x80)
+				return false;
+			cp = (cp << 6) | (c & 0x3F);
+		}
+		if ((len == 3 && cp < 0x800) || (len == 4 && cp < 0x10000) || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+			return false;
+		i += len;
+	}
+	return true;
+}
+
+TEST(TinyUTF8, Validation_Sequences)
+{
+	const std::vector<std::string> valid = {
+		"", "a", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xE3\x83\x84", "\xED\x9F\xBF", "\xEE\x80\x80",
+		"\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF3\xBF\xBF\xBF", "\xF4\x8F\xBF\xBF", "\xE2\x99\xAB\xF0\x9F\x98\x80"
+	};
+	const std::vector<std::string> invalid = {
+		"\x80", "\xBF", "\xC0\x80", "\xC1\xBF", "\xC2", "\xC2\x41", "\xE0\x80\x80", "\xE0\x9F\xBF", "\xE3\x83",
+		"\xED\xA0\x80", "\xED\xBF\xBF", "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80",
+		"\xF8\x88\x80\x80\x80", "\xFF", "\xE3\x83\x84\x84", "\xF0\x9F\x98"
+	};
+
+	// Embed every sequence at different offsets, so it is checked by every lane and across block boundaries
+	for (std::size_t offset = 0; offset <= 40; offset++)
+		for (std::size_t padding : {std::size_t(0), std::size_t(1), std::size_t(37)}) {
+			for (const std::string& seq : valid) {
+				std::string data = std::string(offset, 'x') + seq + std::string(padding, 'y');
+				EXPECT_TRUE(tiny_utf8::is_valid_utf8(data.data(), data.size())) << offset << " " << padding;
+			}
+			for (const std::string& seq : invalid) {
+				std::string data = std::string(offset, 'x') + seq + std::string(padding, 'y');
+				EXPECT_FALSE(tiny_utf8::is_valid_utf8(data.data(), data.size())) << offset << " " << padding;
+			}
+		}
+}
+
+TEST(TinyUTF8, Validation_Random)
+{
+	const std::vector<std::string> pieces = {
+		"a", "Hello World ", "\xC3\xA4", "\xE3\x83\x84", "\xE2\x99\xAB", "\xF0\x9F\x98\x80",
+		"\x80", "\xC0", "\xE3\x83", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xFF"
+	};
+	std::mt19937 rng(42);
+	for (int i = 0; i < 2000; i++) {
+		std::string data;
+		std::size_t num_pieces = rng() % 64;
+		bool allow_invalid = i % 2;
+		for (std::size_t j = 0; j < num_pieces; j++)
+			data += pieces[rng() % (allow_invalid && rng() % 16 == 0 ? pieces.size() : 6)];
+
+		tiny_utf8::string str(data, tiny_utf8::validate_utf8);
+		bool expected = reference_is_valid_utf8(data);
+		EXPECT_EQ(tiny_utf8::is_valid_utf8(data.data(), data.size()), expected);
+		EXPECT_EQ(str.is_valid_utf8(), expected);
+		EXPECT_EQ(tiny_utf8::string_view(str).is_valid_utf8(), expected);
+
+		// The validating constructor counts exactly like the usual one
+		tiny_utf8::string unchecked(data);
+		EXPECT_EQ(str, unchecked);
+		EXPECT_EQ(str.length(), unchecked.length());
+		EXPECT_EQ(str.requires_unicode(), unchecked.requires_unicode());
+		EXPECT_EQ(str.trusted(), expected && !str.sso_active());
+	}
+}
+
+TEST(TinyUTF8, Validation_TrustedLifecycle)
+{
+	std::string data = "This string is too long for SSO: \xE3\x83\x84\xE2\x99\xAB \xE3\x83\x84\xE2\x99\xAB \xF0\x9F\x98\x80";
+	tiny_utf8::string str(data, tiny_utf8::validate_utf8);
+	EXPECT_TRUE(str.trusted());
+
+	// Copies of trusted strings are trusted
+	tiny_utf8::string copy(str);
+	EXPECT_TRUE(copy.trusted());
+	tiny_utf8::string assigned(U"Some other string, that is long enough to not be small.");
+	assigned = str;
+	EXPECT_TRUE(assigned.trusted());
+
+	// Modifications reset the trusted bit
+	str.append(U"ツ");
+	EXPECT_FALSE(str.trusted());
+	EXPECT_TRUE(str.is_valid_utf8());
+	EXPECT_TRUE(str.validate());
+	EXPECT_TRUE(str.trusted());
+
+	// Shrinking doesn't change the data
+	str.append(std::string(4096, 'x'));
+	str.erase(str.length() - 4096, 4096);
+	EXPECT_FALSE(str.trusted());
+	EXPECT_TRUE(str.validate());
+	std::size_t capacity = str.capacity();
+	str.shrink_to_fit();
+	EXPECT_LT(str.capacity(), capacity);
+	EXPECT_TRUE(str.trusted());
+
+	// Invalid data and small strings are never trusted
+	tiny_utf8::string invalid(data + "\xC0", tiny_utf8::validate_utf8);
+	EXPECT_FALSE(invalid.trusted());
+	EXPECT_FALSE(invalid.validate());
+	EXPECT_FALSE(invalid.trusted());
+	tiny_utf8::string small("\xE3\x83\x84", 3, tiny_utf8::validate_utf8);
+	EXPECT_TRUE(small.sso_active());
+	EXPECT_FALSE(small.trusted());
+	EXPECT_TRUE(small.validate());
+	EXPECT_FALSE(small.trusted());
+}
+
+TEST(TinyUTF8, Validation_RecountsJoinedCodepoints)
+{
+	// Each piece ends resp. starts with a fragment of "ツ", that is counted on its own until the pieces are validated together
+	std::string head;
+	std::string tail = "\x84";
+	for (int i = 0; i < 40; i++) {
+		head += "a\xE3\x83\x84\xC3\xA4";
+		tail += i % 2 ? "b\xC3\xA4" : "c";
+	}
+	head += "\xE3\x83";
+	tiny_utf8::string str = tiny_utf8::string(head) + tiny_utf8::string(tail);
+	tiny_utf8::string expected(head + tail);
+	ASSERT_EQ(str.size(), expected.size());
+	EXPECT_EQ(str.length(), expected.length() + 1);
+
+	EXPECT_TRUE(str.validate());
+	EXPECT_TRUE(str.trusted());
+	EXPECT_EQ(str.length(), expected.length());
+	EXPECT_EQ(str.lut_active(), expected.lut_active());
+	for (std::size_t i = 0; i < expected.length(); i++)
+		EXPECT_EQ(str[i], expected[i]);
+	EXPECT_EQ(str.back(), U'ä');
+	EXPECT_EQ(str.find(U'ツ', 100), expected.find(U'ツ', 100));
+	EXPECT_EQ(str.substr(110, 30), expected.substr(110, 30));
+}
+
+TEST(TinyUTF8, Validation_TrustedFastPaths)
+{
+	// Mostly multibyte string without a lut, so all index translations walk the data
+	std::string data;
+	for (int i = 0; i < 300; i++)
+		data += i % 7 ? "\xE3\x83\x84\xC3\xA4" : "ab\xF0\x9F\x98\x80";
+	tiny_utf8::string trusted(data, tiny_utf8::validate_utf8);
+	tiny_utf8::string untrusted(data);
+	ASSERT_TRUE(trusted.trusted());
+	ASSERT_FALSE(untrusted.trusted());
+
+	for (std::size_t i = 0; i < untrusted.length(); i += 13) {
+		EXPECT_EQ(trusted[i], untrusted[i]);
+		EXPECT_EQ(trusted.substr(i, 17), untrusted.substr(i, 17));
+	}
+	EXPECT_EQ(trusted.find(U"ab😀", 400), untrusted.find(U"ab😀", 400));
+	EXPECT_EQ(trusted.rfind(U'ä'), untrusted.rfind(U'ä'));
+
+	std::u32string trusted_codepoints(trusted.length(), U'\0');
+	std::u32string untrusted_codepoints(untrusted.length(), U'\0');
+	EXPECT_EQ(trusted.to_codepoints(&trusted_codepoints[0]), trusted.length());
+	EXPECT_EQ(untrusted.to_codepoints(&untrusted_codepoints[0]), untrusted.length());
+	EXPECT_EQ(trusted_codepoints, untrusted_codepoints);
+}
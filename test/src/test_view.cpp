@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include <tinyutf8/tinyutf8.h>
+
+TEST(TinyUTF8, StringView_Access)
+{
+	tiny_utf8::string str(U"Hello ツ World, hello ♫ World! This string is long enough to not be small.");
+	tiny_utf8::string_view view(str);
+
+	EXPECT_EQ(view.data(), str.data());
+	EXPECT_EQ(view.size(), str.size());
+	EXPECT_EQ(view.length(), str.length());
+	EXPECT_EQ(static_cast<uint64_t>(view[6]), 12484);
+	EXPECT_EQ(static_cast<uint64_t>(view.raw_at(6)), 12484);
+	EXPECT_EQ(static_cast<uint64_t>(view.front()), 'H');
+	EXPECT_EQ(static_cast<uint64_t>(view.back()), '.');
+
+	// Iterators behave like the ones of basic_string
+	std::u32string forward(view.begin(), view.end());
+	std::u32string backward(view.rbegin(), view.rend());
+	EXPECT_EQ(forward.size(), str.length());
+	EXPECT_EQ(tiny_utf8::string(forward.begin(), forward.end()), str);
+	EXPECT_EQ(std::u32string(backward.rbegin(), backward.rend()), forward);
+	EXPECT_EQ(view.raw_end() - view.raw_begin(), static_cast<std::ptrdiff_t>(str.length()));
+	EXPECT_EQ(std::u32string(view.raw_begin(), view.raw_end()), forward);
+
+	// Views don't need to be null-terminated
+	tiny_utf8::string_view part = str.substr_view(6, 7);
+	EXPECT_EQ(part.data(), str.data() + 6);
+	EXPECT_EQ(part.length(), 7);
+	EXPECT_EQ(part.size(), 9);
+	EXPECT_EQ(part.cpp_str(), "ツ World");
+	EXPECT_EQ(tiny_utf8::string(part), tiny_utf8::string(U"ツ World"));
+	EXPECT_EQ(std::u32string(part.begin(), part.end()), U"ツ World");
+	EXPECT_EQ(static_cast<uint64_t>(part.back()), 'd');
+	EXPECT_EQ(part.substr(1).cpp_str(), " World");
+	EXPECT_EQ(part.raw_substr(3, 3).cpp_str(), " Wo");
+	EXPECT_EQ(str.raw_substr_view(6, 3).cpp_str(), "ツ");
+	EXPECT_EQ(str.substr_view(str.length()).size(), 0);
+
+	tiny_utf8::string_view trimmed = part;
+	trimmed.remove_prefix(2);
+	trimmed.remove_suffix(2);
+	EXPECT_EQ(trimmed.cpp_str(), "Wor");
+	EXPECT_EQ(trimmed.length(), 3);
+
+	EXPECT_TRUE(tiny_utf8::string_view().empty());
+	EXPECT_EQ(tiny_utf8::string_view().length(), 0);
+}
+
+TEST(TinyUTF8, StringView_SearchAndCompare)
+{
+	tiny_utf8::string str(U"Hello ツ World, hello ♫ World! This string is long enough to not be small.");
+	tiny_utf8::string_view view = str.substr_view(6);
+
+	EXPECT_EQ(view.find(U'♫'), str.find(U'♫') - 6);
+	EXPECT_EQ(view.raw_find(U'♫'), str.raw_find(U'♫') - 6);
+	EXPECT_EQ(view.find("World"), 2);
+	EXPECT_EQ(view.find("World", 3), 17);
+	EXPECT_EQ(view.rfind("World"), 17);
+	EXPECT_EQ(view.rfind(U'W', 16), 2);
+	EXPECT_EQ(view.raw_rfind("World", 4), 4);
+	EXPECT_EQ(view.find("ツ", 1), tiny_utf8::string_view::npos);
+	EXPECT_EQ(view.substr(0, 7).find("ld,"), tiny_utf8::string_view::npos);
+
+	// basic_string accepts views wherever it accepts strings
+	tiny_utf8::string_view world = view.substr(2, 5);
+	EXPECT_EQ(str.find(world), 8);
+	EXPECT_EQ(str.raw_find(world), 10);
+	EXPECT_EQ(str.rfind(world), 23);
+	EXPECT_EQ(str.raw_rfind(world), 27);
+	EXPECT_TRUE(str.starts_with(str.substr_view(0, 3)));
+	EXPECT_TRUE(str.ends_with(str.substr_view(str.length() - 6)));
+	EXPECT_FALSE(str.ends_with(world));
+	EXPECT_TRUE(str == tiny_utf8::string_view(str));
+	EXPECT_TRUE(str < world);
+	EXPECT_EQ(str.compare(str.substr_view(0)), 0);
+
+	// Comparison of views
+	EXPECT_TRUE(world == "World");
+	EXPECT_TRUE(world == str.substr_view(23, 5));
+	EXPECT_TRUE(world != view);
+	EXPECT_TRUE(world < "Worldwide");
+	EXPECT_TRUE(world > "Wor");
+	EXPECT_TRUE(view.starts_with(U'ツ'));
+	EXPECT_TRUE(view.starts_with("ツ Wo"));
+	EXPECT_TRUE(view.ends_with(U'.'));
+	EXPECT_TRUE(view.ends_with("small."));
+	EXPECT_FALSE(world.ends_with("Worlds"));
+
+	// Views hash like strings
+	std::hash<tiny_utf8::string> string_hasher;
+	std::hash<tiny_utf8::string_view> view_hasher;
+	EXPECT_EQ(view_hasher(world), string_hasher(tiny_utf8::string(world)));
+	EXPECT_EQ(view_hasher(world), view_hasher(str.substr_view(23, 5)));
+	EXPECT_EQ(view_hasher(view), string_hasher(str.substr(6)));
+	EXPECT_NE(view_hasher(world), view_hasher(view));
+}